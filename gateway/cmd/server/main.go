@@ -95,6 +95,9 @@ func main() {
 	v1 := router.Group("/api/v1")
 	{
 		v1.POST("/ingest", handlers.IngestPacket)
+		// Multi-frame ingest: the ground station coalesces a burst of
+		// accepted frames into one request; per-frame statuses come back.
+		v1.POST("/ingest/batch", handlers.IngestBatch)
 
 		// VOID-135b: bouncer drains pending receipts here, TXes each
 		// PacketC via LoRa, then ACKs back. Routes always mount — if
@@ -103,7 +106,9 @@ func main() {
 		// rather than a 404.
 		egress := v1.Group("/egress")
 		egress.GET("/pending", handlers.HandleEgressPending)
+		egress.GET("/watch", handlers.HandleEgressWatch)
 		egress.POST("/ack", handlers.HandleEgressAck)
+		egress.POST("/ack/batch", handlers.HandleEgressAckBatch)
 	}
 
 	log.Println("🚀 VOID Enterprise Gateway listening on :8080")
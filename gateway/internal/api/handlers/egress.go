@@ -2,6 +2,8 @@ package handlers
 
 import (
 	"net/http"
+	"strconv"
+	"time"
 
 	"github.com/Tiny-Innovations-Group/void-protocol-oss/gateway/internal/core/receipt"
 	"github.com/gin-gonic/gin"
@@ -20,18 +22,37 @@ import (
 // so polling reuses that plumbing — no HTTP server on the bouncer side.
 //
 // Wire shape:
-//   GET  /api/v1/egress/pending     → 200 JSON array of receipt.Record
+//   GET  /api/v1/egress/pending[?limit=<n>]
+//                                   → 200 JSON array of receipt.Record
 //                                     (bare array for minimal-JSON C++
-//                                     parsing), capped at EgressPageSize.
+//                                     parsing), capped at ?limit
+//                                     (default EgressPageSize, at most
+//                                     EgressPageMax). 400 on a bad limit.
 //   POST /api/v1/egress/ack         → 200 on success / idempotent-success
 //                                     Body: {"payment_id", "settlement_tx_hash"}
 //                                     400 on bad JSON / missing fields
 //                                     404 on unknown dedup key
 //                                     503 if EgressStore isn't wired
+//   POST /api/v1/egress/ack/batch   → 200 {"results":[<status>, ...]}
+//                                     Body: bare array of ack objects,
+//                                     1..EgressAckBatchMax entries. One
+//                                     status per entry, in order, with
+//                                     the single-ACK codes (200/400/404/
+//                                     500); one fsync for the batch.
+//                                     400 on bad JSON / empty / too many
+//                                     503 if EgressStore isn't wired
+//   GET  /api/v1/egress/watch?after=<seq>&wait_ms=<ms>[&limit=<n>]
+//                                   → 200 bare array like /pending, each
+//                                     record with its "seq" cursor, only
+//                                     cursors > after. Held open up to
+//                                     wait_ms (cap EgressWatchMaxWait)
+//                                     until one exists; [] on timeout.
+//                                     400 on a bad query value
+//                                     503 if EgressStore isn't wired
 // Non-goals for this endpoint (handled elsewhere):
 //   - auth (flat-sat; bouncer and gateway share a local network)
-//   - pagination cursor (page size 10 is enough for a solo sat; the
-//     bouncer drains the queue in subsequent polls)
+//   - pagination cursor on /pending (the bouncer drains the queue in
+//     subsequent polls — /watch carries the cursor)
 
 // EgressStore is the package-level *receipt.Store the egress handlers
 // read/write. cmd/server/main.go sets this at startup when the receipt
@@ -39,13 +60,35 @@ import (
 // 503 — still serving HTTP but the persistence layer isn't up yet.
 var EgressStore *receipt.Store
 
-// EgressPageSize caps the GET /pending response. Tuned for the flat-sat
-// (single satellite, single-digit settlements in flight at once). Phase B
-// may add a paginated cursor if the drain loop can't keep up.
+// EgressPageSize caps the GET /pending and /watch responses when the
+// caller gives no ?limit. Tuned for the flat-sat (single satellite,
+// single-digit settlements in flight at once) and for bouncers that
+// predate ?limit, which buffer the whole response.
 const EgressPageSize = 10
 
+// EgressPageMax bounds ?limit. Current bouncers parse the response as it
+// streams in and ask for 256, so a post-outage backlog drains in a few
+// long pages instead of one request per 10 receipts.
+const EgressPageMax = 1000
+
+// egressPageLimit reads ?limit (1..EgressPageMax, default
+// EgressPageSize). On a bad value it writes the 400 and returns false.
+func egressPageLimit(c *gin.Context) (int, bool) {
+	raw := c.Query("limit")
+	if raw == "" {
+		return EgressPageSize, true
+	}
+	n, err := strconv.ParseUint(raw, 10, 32)
+	if err != nil || n == 0 || n > EgressPageMax {
+		c.AbortWithStatusJSON(http.StatusBadRequest,
+			gin.H{"error": "limit must be 1..1000"})
+		return 0, false
+	}
+	return int(n), true
+}
+
 // HandleEgressPending is the GET /api/v1/egress/pending handler.
-// Returns up to EgressPageSize pending receipts (oldest first) as a
+// Returns up to ?limit pending receipts (oldest first) as a
 // bare JSON array. Always 200 when the store is configured (empty
 // array on no pending); 503 when not configured.
 func HandleEgressPending(c *gin.Context) {
@@ -54,7 +97,11 @@ func HandleEgressPending(c *gin.Context) {
 			gin.H{"error": "egress pipeline not configured"})
 		return
 	}
-	records := EgressStore.PendingRecords(EgressPageSize)
+	limit, ok := egressPageLimit(c)
+	if !ok {
+		return
+	}
+	records := EgressStore.PendingRecords(limit)
 	if records == nil {
 		records = []receipt.Record{} // make sure we emit "[]" not "null"
 	}
@@ -101,4 +148,113 @@ func HandleEgressAck(c *gin.Context) {
 		return
 	}
 	c.JSON(http.StatusOK, gin.H{"status": "dispatched"})
-}
\ No newline at end of file
+}
+
+// EgressAckBatchMax caps one POST /ack/batch. Well above the 16 the
+// bouncer sends per batch while a page streams in.
+const EgressAckBatchMax = 64
+
+// HandleEgressAckBatch is the POST /api/v1/egress/ack/batch handler.
+// Same semantics as HandleEgressAck per entry, so the bouncer can ACK a
+// whole poll round in one round trip; the store writes the flipped
+// lines with a single fsync.
+func HandleEgressAckBatch(c *gin.Context) {
+	if EgressStore == nil {
+		c.AbortWithStatusJSON(http.StatusServiceUnavailable,
+			gin.H{"error": "egress pipeline not configured"})
+		return
+	}
+	var reqs []ackRequest
+	if err := c.ShouldBindJSON(&reqs); err != nil {
+		c.AbortWithStatusJSON(http.StatusBadRequest,
+			gin.H{"error": "invalid JSON"})
+		return
+	}
+	if len(reqs) == 0 || len(reqs) > EgressAckBatchMax {
+		c.AbortWithStatusJSON(http.StatusBadRequest,
+			gin.H{"error": "batch must hold 1..64 acks"})
+		return
+	}
+
+	results := make([]int, len(reqs))
+	keys := make([]receipt.DispatchKey, 0, len(reqs))
+	idx := make([]int, 0, len(reqs)) // keys[j] belongs to reqs[idx[j]]
+	for i, req := range reqs {
+		if req.PaymentID == "" || req.SettlementTxHash == "" {
+			results[i] = http.StatusBadRequest
+			continue
+		}
+		keys = append(keys, receipt.DispatchKey{
+			PaymentID:        req.PaymentID,
+			SettlementTxHash: req.SettlementTxHash,
+		})
+		idx = append(idx, i)
+	}
+	for j, err := range EgressStore.MarkDispatchedBatch(keys) {
+		switch {
+		case err == nil:
+			results[idx[j]] = http.StatusOK
+		case err == receipt.ErrUnknown:
+			results[idx[j]] = http.StatusNotFound
+		default:
+			results[idx[j]] = http.StatusInternalServerError
+		}
+	}
+	c.JSON(http.StatusOK, gin.H{"results": results})
+}
+
+// EgressWatchMaxWait caps ?wait_ms on GET /watch. The bouncer asks for
+// 4 s (its HTTP client gives up on a silent connection after 5 s).
+const EgressWatchMaxWait = 30 * time.Second
+
+// HandleEgressWatch is the GET /api/v1/egress/watch handler: the
+// long-poll form of /pending. It answers as soon as a PENDING receipt
+// with a cursor above ?after exists — immediately when one already
+// does, so a backlog drains page after page — or with [] once ?wait_ms
+// passes. The bouncer resumes from the highest cursor it handled, so
+// receipts it already sent are never offered again.
+func HandleEgressWatch(c *gin.Context) {
+	if EgressStore == nil {
+		c.AbortWithStatusJSON(http.StatusServiceUnavailable,
+			gin.H{"error": "egress pipeline not configured"})
+		return
+	}
+	after, err := strconv.ParseUint(c.DefaultQuery("after", "0"), 10, 64)
+	if err != nil {
+		c.AbortWithStatusJSON(http.StatusBadRequest,
+			gin.H{"error": "after must be an unsigned integer"})
+		return
+	}
+	waitMs, err := strconv.ParseUint(c.DefaultQuery("wait_ms", "0"), 10, 32)
+	if err != nil {
+		c.AbortWithStatusJSON(http.StatusBadRequest,
+			gin.H{"error": "wait_ms must be an unsigned integer"})
+		return
+	}
+	limit, ok := egressPageLimit(c)
+	if !ok {
+		return
+	}
+	wait := time.Duration(waitMs) * time.Millisecond
+	if wait > EgressWatchMaxWait {
+		wait = EgressWatchMaxWait
+	}
+
+	timer := time.NewTimer(wait)
+	defer timer.Stop()
+	expired := wait == 0
+	for {
+		records, appended := EgressStore.PendingAfter(after, limit)
+		if len(records) > 0 || expired {
+			c.JSON(http.StatusOK, records)
+			return
+		}
+		select {
+		case <-appended:
+		case <-timer.C:
+			expired = true
+		case <-c.Request.Context().Done():
+			return // bouncer went away
+		}
+	}
+}
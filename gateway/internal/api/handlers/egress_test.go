@@ -3,11 +3,13 @@ package handlers_test
 import (
 	"bytes"
 	"encoding/json"
+	"fmt"
 	"io"
 	"net/http"
 	"net/http/httptest"
 	"path/filepath"
 	"testing"
+	"time"
 
 	"github.com/Tiny-Innovations-Group/void-protocol-oss/gateway/internal/api/handlers"
 	"github.com/Tiny-Innovations-Group/void-protocol-oss/gateway/internal/core/receipt"
@@ -67,7 +69,7 @@ func withEgressStore(t *testing.T) *receipt.Store {
 	return s
 }
 
-// newEgressRouter exposes the two VOID-135b endpoints via the same
+// newEgressRouter exposes the VOID-135b endpoints via the same
 // gin.Engine pattern cmd/server/main.go uses.
 func newEgressRouter() *gin.Engine {
 	gin.SetMode(gin.TestMode)
@@ -75,6 +77,8 @@ func newEgressRouter() *gin.Engine {
 	g := r.Group("/api/v1/egress")
 	g.GET("/pending", handlers.HandleEgressPending)
 	g.POST("/ack", handlers.HandleEgressAck)
+	g.POST("/ack/batch", handlers.HandleEgressAckBatch)
+	g.GET("/watch", handlers.HandleEgressWatch)
 	return r
 }
 
@@ -196,6 +200,36 @@ func TestEgress_PendingCapsAtPageSize(t *testing.T) {
 	}
 }
 
+func TestEgress_PendingHonoursLimit(t *testing.T) {
+	store := withEgressStore(t)
+	for i := 0; i < 30; i++ {
+		_ = store.Append(sampleTestRecord(fmt.Sprintf("p%02d", i), fmt.Sprintf("0x%02d", i)))
+	}
+	r := newEgressRouter()
+
+	var got []receipt.Record
+	w := httpGET(t, r, "/api/v1/egress/pending?limit=25")
+	if err := json.Unmarshal(w.Body.Bytes(), &got); err != nil || len(got) != 25 {
+		t.Fatalf("limit=25: got %d records (%v), want 25", len(got), err)
+	}
+	if got[24].PaymentID != "p24" {
+		t.Fatalf("order: last is %q, want p24", got[24].PaymentID)
+	}
+	for _, bad := range []string{"0", "-3", "x", "1001"} {
+		if w := httpGET(t, r, "/api/v1/egress/pending?limit="+bad); w.Code != http.StatusBadRequest {
+			t.Errorf("limit=%s: got %d, want 400", bad, w.Code)
+		}
+	}
+	w = httpGET(t, r, "/api/v1/egress/watch?after=20&limit=5")
+	got = nil
+	if err := json.Unmarshal(w.Body.Bytes(), &got); err != nil || len(got) != 5 {
+		t.Fatalf("watch limit=5: got %d records (%v), want 5", len(got), err)
+	}
+	if w := httpGET(t, r, "/api/v1/egress/watch?limit=0"); w.Code != http.StatusBadRequest {
+		t.Errorf("watch limit=0: got %d, want 400", w.Code)
+	}
+}
+
 func TestEgress_NoStoreConfiguredReturns503(t *testing.T) {
 	handlers.EgressStore = nil
 	r := newEgressRouter()
@@ -276,4 +310,110 @@ func TestEgress_AckMissingFieldsReturns400(t *testing.T) {
 	if w.Code != http.StatusBadRequest {
 		t.Fatalf("status: got %d, want 400", w.Code)
 	}
-}
\ No newline at end of file
+}
+
+func TestEgress_AckBatchPerEntryResults(t *testing.T) {
+	store := withEgressStore(t)
+	_ = store.Append(sampleTestRecord("a", "0xA"))
+	_ = store.Append(sampleTestRecord("b", "0xB"))
+
+	r := newEgressRouter()
+	w := httpPOST(t, r, "/api/v1/egress/ack/batch", []map[string]string{
+		{"payment_id": "a", "settlement_tx_hash": "0xA"},
+		{"payment_id": "nope", "settlement_tx_hash": "0xzero"},
+		{"payment_id": "b"},
+		{"payment_id": "b", "settlement_tx_hash": "0xB"},
+	})
+	if w.Code != http.StatusOK {
+		b, _ := io.ReadAll(w.Body)
+		t.Fatalf("status: got %d, want 200. body=%s", w.Code, string(b))
+	}
+	var resp struct {
+		Results []int `json:"results"`
+	}
+	if err := json.Unmarshal(w.Body.Bytes(), &resp); err != nil {
+		t.Fatalf("decode: %v", err)
+	}
+	want := []int{200, 404, 400, 200}
+	if fmt.Sprint(resp.Results) != fmt.Sprint(want) {
+		t.Fatalf("results: got %v, want %v", resp.Results, want)
+	}
+	if n := len(store.PendingRecords(10)); n != 0 {
+		t.Errorf("PendingRecords after batch ACK: got %d, want 0", n)
+	}
+}
+
+func TestEgress_AckBatchRejectsEmptyAndOversize(t *testing.T) {
+	withEgressStore(t)
+	r := newEgressRouter()
+	if w := httpPOST(t, r, "/api/v1/egress/ack/batch", "[]"); w.Code != http.StatusBadRequest {
+		t.Errorf("empty batch: got %d, want 400", w.Code)
+	}
+	big := make([]map[string]string, handlers.EgressAckBatchMax+1)
+	for i := range big {
+		big[i] = map[string]string{"payment_id": "x", "settlement_tx_hash": "0xX"}
+	}
+	if w := httpPOST(t, r, "/api/v1/egress/ack/batch", big); w.Code != http.StatusBadRequest {
+		t.Errorf("oversize batch: got %d, want 400", w.Code)
+	}
+	if w := httpPOST(t, r, "/api/v1/egress/ack/batch", "{not valid json"); w.Code != http.StatusBadRequest {
+		t.Errorf("malformed: got %d, want 400", w.Code)
+	}
+}
+
+func TestEgress_WatchReturnsRecordsPastCursor(t *testing.T) {
+	store := withEgressStore(t)
+	for _, id := range []string{"alpha", "bravo", "charlie"} {
+		_ = store.Append(sampleTestRecord(id, "0x"+id))
+	}
+	r := newEgressRouter()
+
+	w := httpGET(t, r, "/api/v1/egress/watch?after=1&wait_ms=0")
+	if w.Code != http.StatusOK {
+		t.Fatalf("status: got %d, want 200", w.Code)
+	}
+	var got []struct {
+		Seq       uint64 `json:"seq"`
+		PaymentID string `json:"payment_id"`
+	}
+	if err := json.Unmarshal(w.Body.Bytes(), &got); err != nil {
+		t.Fatalf("decode: %v", err)
+	}
+	if len(got) != 2 || got[0].Seq != 2 || got[0].PaymentID != "bravo" || got[1].Seq != 3 {
+		t.Fatalf("records: got %+v, want bravo(2), charlie(3)", got)
+	}
+}
+
+func TestEgress_WatchHoldsUntilReceiptIsWritten(t *testing.T) {
+	store := withEgressStore(t)
+	r := newEgressRouter()
+
+	go func() {
+		time.Sleep(50 * time.Millisecond)
+		_ = store.Append(sampleTestRecord("late", "0xlate"))
+	}()
+	start := time.Now()
+	w := httpGET(t, r, "/api/v1/egress/watch?after=0&wait_ms=5000")
+	if w.Code != http.StatusOK {
+		t.Fatalf("status: got %d, want 200", w.Code)
+	}
+	if took := time.Since(start); took > 2*time.Second {
+		t.Fatalf("long-poll took %v — not woken by Append", took)
+	}
+	if !bytes.Contains(w.Body.Bytes(), []byte(`"seq":1`)) {
+		t.Fatalf("body: got %s, want the new receipt", w.Body.String())
+	}
+}
+
+func TestEgress_WatchTimesOutEmptyAndRejectsBadQuery(t *testing.T) {
+	withEgressStore(t)
+	r := newEgressRouter()
+
+	w := httpGET(t, r, "/api/v1/egress/watch?after=0&wait_ms=20")
+	if w.Code != http.StatusOK || string(bytes.TrimSpace(w.Body.Bytes())) != "[]" {
+		t.Fatalf("timeout: got %d %q, want 200 []", w.Code, w.Body.String())
+	}
+	if w := httpGET(t, r, "/api/v1/egress/watch?after=-1"); w.Code != http.StatusBadRequest {
+		t.Errorf("bad after: got %d, want 400", w.Code)
+	}
+}
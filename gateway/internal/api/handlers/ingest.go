@@ -113,9 +113,20 @@ func bodyOffsetZero(raw []byte, isSnlp bool) (byte, bool) {
 	return raw[headerLen], true
 }
 
+// frameVerdict carries a rejection out of the per-frame checks. A zero
+// status means no check has rejected the frame yet.
+type frameVerdict struct {
+	status int
+	body   gin.H
+}
+
+func (v *frameVerdict) reject(status int, body gin.H) {
+	v.status, v.body = status, body
+}
+
 // handlePayloadBody processes the packet body and returns true if handled, false if unknown type.
 // We pass rawData as a pointer to the slice to avoid unnecessary copying, though slices are already descriptors.
-func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packetSize int, isSnlp bool) bool {
+func handlePayloadBody(body interface{}, rawData *[]byte, v *frameVerdict, packetSize int, isSnlp bool) bool {
 	switch b := body.(type) {
 	case *protocol.VoidProtocol_HeartbeatBody:
 		lat := float64(b.LatFixed) / 10000000.0
@@ -149,7 +160,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		if packetSize < void_protocol.PacketBBodyLen {
 			log.Printf("level=warn event=packetb.bounds_fail sat_id=%d packet_size=%d min=%d",
 				b.SatId, packetSize, void_protocol.PacketBBodyLen)
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet too short for signature verification"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Packet too short for signature verification"})
 			return true // Return true because we successfully identified the type, even if it failed validation
 		}
 
@@ -167,7 +178,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		// sender could retry; a bad signature is a content defect.
 		if err := security.VerifyPacketSignature(b.SatId, messageBytes, b.Signature.Raw); err != nil {
 			log.Printf("level=warn event=packetb.sig_fail sat_id=%d err=%q", b.SatId, err.Error())
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Invalid Cryptographic Signature"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Invalid Cryptographic Signature"})
 			return true // ⛔ BOUNCE THE HACKER
 		}
 		// VOID-052: once structurally sound and sig-verified, hand the
@@ -185,7 +196,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 
 		if packetSize < 98 {
 			log.Printf("⛔ REJECTED: Packet C too short for signature verification")
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet too short for signature verification"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Packet too short for signature verification"})
 			return true
 		}
 
@@ -199,7 +210,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		// FIX: Check err != nil instead of !bool
 		if err := security.VerifyPacketSignature(sellerSatID, messageBytes, b.Signature.Raw); err != nil {
 			log.Printf("⛔ REJECTED: %v", err) // Log the actual error from the verifier
-			c.AbortWithStatusJSON(http.StatusUnauthorized, gin.H{"error": "Invalid Cryptographic Signature"})
+			v.reject(http.StatusUnauthorized, gin.H{"error": "Invalid Cryptographic Signature"})
 			return true // ⛔ BOUNCE THE HACKER
 		}
 
@@ -221,14 +232,14 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		magic, ok := bodyOffsetZero(*rawData, isSnlp)
 		if !ok {
 			log.Printf("⛔ REJECTED: dispatch_122 frame too short to read body magic")
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Dispatch_122 frame too short for magic byte"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Dispatch_122 frame too short for magic byte"})
 			return true
 		}
 		switch inner := b.Content.(type) {
 		case *protocol.VoidProtocol_PacketDBody:
 			if magic != magicPacketD {
 				log.Printf("⛔ REJECTED: Packet D magic mismatch: got 0x%02X, want 0x%02X", magic, magicPacketD)
-				c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet D magic byte mismatch (F-03)"})
+				v.reject(http.StatusBadRequest, gin.H{"error": "Packet D magic byte mismatch (F-03)"})
 				return true
 			}
 			// VOID-122: CRC-first — reject any bit-flip inside the CRC-
@@ -236,7 +247,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 			crcOffset := packetSize - void_protocol.PacketDCrcOffsetFromEnd
 			if err := void_protocol.ValidateFrameCRC32(*rawData, crcOffset); err != nil {
 				log.Printf("level=warn event=packetd.crc_fail err=%q", err.Error())
-				c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet D CRC mismatch (VOID-122)"})
+				v.reject(http.StatusBadRequest, gin.H{"error": "Packet D CRC mismatch (VOID-122)"})
 				return true
 			}
 			log.Printf("   📦 DELIVERY (D)  | Mule SatID: %d | Downlink TS: %d",
@@ -245,7 +256,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		case *protocol.VoidProtocol_PacketAckBodySnlp:
 			if magic != magicPacketAck {
 				log.Printf("⛔ REJECTED: Packet ACK (SNLP) magic mismatch: got 0x%02X, want 0x%02X", magic, magicPacketAck)
-				c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet ACK magic byte mismatch (F-03)"})
+				v.reject(http.StatusBadRequest, gin.H{"error": "Packet ACK magic byte mismatch (F-03)"})
 				return true
 			}
 			// VOID-122: CRC-first — reject any bit-flip inside the CRC-
@@ -253,7 +264,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 			crcOffset := packetSize - void_protocol.PacketAckCrcOffsetFromEnd
 			if err := void_protocol.ValidateFrameCRC32(*rawData, crcOffset); err != nil {
 				log.Printf("level=warn event=packetack.crc_fail err=%q", err.Error())
-				c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet ACK CRC mismatch (VOID-122)"})
+				v.reject(http.StatusBadRequest, gin.H{"error": "Packet ACK CRC mismatch (VOID-122)"})
 				return true
 			}
 			log.Printf("   ✅ COMMAND ACK   | Target TxID: %d | Status: %d | Freq: %d Hz",
@@ -269,12 +280,12 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		magic, ok := bodyOffsetZero(*rawData, isSnlp)
 		if !ok {
 			log.Printf("⛔ REJECTED: Packet ACK frame too short to read body magic")
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet ACK frame too short for magic byte"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Packet ACK frame too short for magic byte"})
 			return true
 		}
 		if magic != magicPacketAck {
 			log.Printf("⛔ REJECTED: Packet ACK magic mismatch: got 0x%02X, want 0x%02X", magic, magicPacketAck)
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet ACK magic byte mismatch (F-03)"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Packet ACK magic byte mismatch (F-03)"})
 			return true
 		}
 		// VOID-122: CRC-first gate — same semantics as the SNLP path
@@ -282,7 +293,7 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 		crcOffset := packetSize - void_protocol.PacketAckCrcOffsetFromEnd
 		if err := void_protocol.ValidateFrameCRC32(*rawData, crcOffset); err != nil {
 			log.Printf("level=warn event=packetack.crc_fail err=%q", err.Error())
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Packet ACK CRC mismatch (VOID-122)"})
+			v.reject(http.StatusBadRequest, gin.H{"error": "Packet ACK CRC mismatch (VOID-122)"})
 			return true
 		}
 		log.Printf("   ✅ COMMAND ACK   | Target TxID: %d | Status: %d | Freq: %d Hz",
@@ -294,25 +305,24 @@ func handlePayloadBody(body interface{}, rawData *[]byte, c *gin.Context, packet
 	}
 }
 
-func IngestPacket(c *gin.Context) {
-	// 1. Read the raw binary bytes from the request
-	rawData, err := io.ReadAll(c.Request.Body)
-	if err != nil || len(rawData) == 0 {
-		c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Missing binary payload"})
-		return
+// ingestFrame runs one raw frame through every ingest check and returns
+// the status and JSON body POST /ingest answers with. Shared with
+// IngestBatch so the two routes apply identical rules.
+func ingestFrame(rawData []byte) (int, gin.H) {
+	if len(rawData) == 0 {
+		return http.StatusBadRequest, gin.H{"error": "Missing binary payload"}
 	}
 
-	// 2. Pass the raw bytes into the Kaitai Parser
+	// 1. Pass the raw bytes into the Kaitai Parser
 	stream := kaitai.NewStream(bytes.NewReader(rawData))
 	packet := protocol.NewVoidProtocol()
-	err = packet.Read(stream, nil, packet)
+	err := packet.Read(stream, nil, packet)
 
 	log.Printf("📥 RAW INGEST: Received %d bytes", len(rawData))
 
 	if err != nil {
 		log.Printf("⛔ BOUNCE: Malformed Protocol Frame: %v", err)
-		c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Invalid Void Protocol Frame"})
-		return
+		return http.StatusBadRequest, gin.H{"error": "Invalid Void Protocol Frame"}
 	}
 
 	packetSize := len(rawData)
@@ -329,8 +339,7 @@ func IngestPacket(c *gin.Context) {
 	}
 	if ccsdsVersion != 0 {
 		log.Printf("⛔ BOUNCE: Unknown CCSDS version %d — only Version 1 (0b000) accepted", ccsdsVersion)
-		c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Unknown CCSDS version — only Version 1 accepted"})
-		return
+		return http.StatusBadRequest, gin.H{"error": "Unknown CCSDS version — only Version 1 accepted"}
 	}
 
 	tier := "Enterprise (CCSDS)"
@@ -340,28 +349,45 @@ func IngestPacket(c *gin.Context) {
 
 	log.Printf("📥 ADMIT: %s Frame | Size: %d bytes | SatID: %d", tier, packetSize, apid)
 
-	// 3. 🔍 Process Payload Body and Security Checks
+	// 2. 🔍 Process Payload Body and Security Checks
 	// VOID-112: reject anything that didn't route to a known body type
 	// (nil Body, truncated frame, or unsupported payload_len). This is
 	// the final bounds gate — refusing before any downstream cast or
 	// settlement logic runs.
-	if !handlePayloadBody(packet.Body, &rawData, c, packetSize, isSnlp) {
+	var verdict frameVerdict
+	if !handlePayloadBody(packet.Body, &rawData, &verdict, packetSize, isSnlp) {
 		log.Printf("⛔ BOUNCE: Unknown or truncated payload body")
-		if !c.IsAborted() {
-			c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Unsupported or truncated Void Protocol frame"})
+		if verdict.status == 0 {
+			return http.StatusBadRequest, gin.H{"error": "Unsupported or truncated Void Protocol frame"}
 		}
-		return
 	}
 
 	// TODO: Hit the Blockchain L2 Settlement here
 
-	// Only send the success response if the context hasn't been aborted by a security failure
-	if !c.IsAborted() {
-		c.JSON(http.StatusOK, gin.H{
-			"status":  "success",
-			"message": "Packet parsed and accepted",
-			"sat_id":  apid,
-			"tier":    tier,
-		})
+	// Only report success if no security check rejected the frame
+	if verdict.status != 0 {
+		return verdict.status, verdict.body
+	}
+	return http.StatusOK, gin.H{
+		"status":  "success",
+		"message": "Packet parsed and accepted",
+		"sat_id":  apid,
+		"tier":    tier,
+	}
+}
+
+func IngestPacket(c *gin.Context) {
+	// Read the raw binary bytes from the request
+	rawData, err := io.ReadAll(c.Request.Body)
+	if err != nil {
+		c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Missing binary payload"})
+		return
+	}
+
+	status, body := ingestFrame(rawData)
+	if status != http.StatusOK {
+		c.AbortWithStatusJSON(status, body)
+		return
 	}
+	c.JSON(status, body)
 }
@@ -0,0 +1,77 @@
+package handlers
+
+import (
+	"encoding/binary"
+	"io"
+	"log"
+	"net/http"
+
+	"github.com/gin-gonic/gin"
+)
+
+// Batch ingest (POST /api/v1/ingest/batch). The ground station
+// coalesces bouncer-accepted frames during a busy pass and sends them
+// in one request instead of one POST per frame.
+//
+// Request body (Content-Type: application/x-void-frames):
+//
+//	{ len:u16_le | frame[len] } × N,  1 <= N <= MaxBatchFrames
+//
+// Response: 200 {"results":[<status>, ...]} with one HTTP-style status
+// per frame, in order — exactly the status POST /ingest would have
+// returned for that frame on its own. A malformed envelope (bad length
+// prefix, empty, too many frames) is a 400 for the whole batch.
+const (
+	MaxBatchFrames = 64
+	maxBatchBytes  = MaxBatchFrames * (2 + 1024)
+)
+
+// splitBatch validates the length-prefixed envelope and returns the
+// frames as sub-slices of raw (no copies).
+func splitBatch(raw []byte) ([][]byte, bool) {
+	frames := make([][]byte, 0, 8)
+	for off := 0; off < len(raw); {
+		if len(raw)-off < 2 || len(frames) == MaxBatchFrames {
+			return nil, false
+		}
+		n := int(binary.LittleEndian.Uint16(raw[off:]))
+		off += 2
+		if n == 0 || len(raw)-off < n {
+			return nil, false
+		}
+		frames = append(frames, raw[off:off+n])
+		off += n
+	}
+	return frames, len(frames) > 0
+}
+
+func IngestBatch(c *gin.Context) {
+	raw, err := io.ReadAll(io.LimitReader(c.Request.Body, maxBatchBytes+1))
+	if err != nil || len(raw) == 0 || len(raw) > maxBatchBytes {
+		c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Missing or oversized batch payload"})
+		return
+	}
+	frames, ok := splitBatch(raw)
+	if !ok {
+		c.AbortWithStatusJSON(http.StatusBadRequest, gin.H{"error": "Malformed batch envelope"})
+		return
+	}
+
+	// Each frame runs through the same ingestFrame as POST /ingest, so
+	// CRC, magic-byte, signature and settlement rules cannot drift
+	// between the two routes.
+	results := make([]int, len(frames))
+	accepted := 0
+	for i, frame := range frames {
+		results[i], _ = ingestFrame(frame)
+		if results[i] == http.StatusOK {
+			accepted++
+		}
+	}
+
+	log.Printf("📦 BATCH INGEST: %d frame(s), %d accepted", len(frames), accepted)
+	c.JSON(http.StatusOK, gin.H{
+		"accepted": accepted,
+		"results":  results,
+	})
+}
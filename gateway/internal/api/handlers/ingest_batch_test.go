@@ -0,0 +1,102 @@
+package handlers_test
+
+import (
+	"bytes"
+	"encoding/binary"
+	"encoding/json"
+	"net/http"
+	"net/http/httptest"
+	"testing"
+
+	"github.com/Tiny-Innovations-Group/void-protocol-oss/gateway/internal/api/handlers"
+	"github.com/gin-gonic/gin"
+)
+
+func newBatchRouter() *gin.Engine {
+	r := gin.New()
+	r.POST("/ingest/batch", handlers.IngestBatch)
+	return r
+}
+
+// batchBody builds the { len:u16_le | frame } × N envelope.
+func batchBody(frames ...[]byte) []byte {
+	var buf bytes.Buffer
+	for _, f := range frames {
+		var n [2]byte
+		binary.LittleEndian.PutUint16(n[:], uint16(len(f)))
+		buf.Write(n[:])
+		buf.Write(f)
+	}
+	return buf.Bytes()
+}
+
+func postBatch(t *testing.T, r *gin.Engine, body []byte) *httptest.ResponseRecorder {
+	t.Helper()
+	req := httptest.NewRequest(http.MethodPost, "/ingest/batch", bytes.NewReader(body))
+	req.Header.Set("Content-Type", "application/x-void-frames")
+	w := httptest.NewRecorder()
+	r.ServeHTTP(w, req)
+	return w
+}
+
+// TestIngestBatchPerFrameResults — each frame gets the status the
+// single-frame route would give it: the golden Packet B (both tiers)
+// is accepted, a truncated buffer is rejected, and one bad frame does
+// not fail its neighbours.
+func TestIngestBatchPerFrameResults(t *testing.T) {
+	registerTestPubKey(t)
+	r := newBatchRouter()
+
+	snlp := loadGoldenPacketB(t, "snlp")
+	ccsds := loadGoldenPacketB(t, "ccsds")
+	w := postBatch(t, r, batchBody(snlp, make([]byte, 50), ccsds))
+	if w.Code != http.StatusOK {
+		t.Fatalf("batch: got %d, want 200. body=%s", w.Code, w.Body.String())
+	}
+
+	var resp struct {
+		Accepted int   `json:"accepted"`
+		Results  []int `json:"results"`
+	}
+	if err := json.Unmarshal(w.Body.Bytes(), &resp); err != nil {
+		t.Fatalf("decode response: %v (%s)", err, w.Body.String())
+	}
+	want := []int{http.StatusOK, http.StatusBadRequest, http.StatusOK}
+	if len(resp.Results) != len(want) {
+		t.Fatalf("results: got %v, want %v", resp.Results, want)
+	}
+	for i := range want {
+		if resp.Results[i] != want[i] {
+			t.Errorf("frame %d: got %d, want %d", i, resp.Results[i], want[i])
+		}
+	}
+	if resp.Accepted != 2 {
+		t.Errorf("accepted: got %d, want 2", resp.Accepted)
+	}
+}
+
+// TestIngestBatchRejectsMalformedEnvelope — a length prefix that runs
+// past the body, a zero-length frame, or an empty body is a 400 for the
+// whole batch; no frame is processed.
+func TestIngestBatchRejectsMalformedEnvelope(t *testing.T) {
+	r := newBatchRouter()
+	cases := map[string][]byte{
+		"empty":       {},
+		"short len":   {0x05},
+		"overrun":     {0x10, 0x00, 0x1D, 0x01},
+		"zero length": {0x00, 0x00},
+	}
+	for name, body := range cases {
+		if w := postBatch(t, r, body); w.Code != http.StatusBadRequest {
+			t.Errorf("%s: got %d, want 400", name, w.Code)
+		}
+	}
+
+	tooMany := make([][]byte, handlers.MaxBatchFrames+1)
+	for i := range tooMany {
+		tooMany[i] = []byte{0x1D}
+	}
+	if w := postBatch(t, r, batchBody(tooMany...)); w.Code != http.StatusBadRequest {
+		t.Errorf("too many frames: got %d, want 400", w.Code)
+	}
+}
@@ -64,7 +64,9 @@ var ErrUnknown = errors.New("receipt: unknown payment_id + settlement_tx_hash")
 //
 // Order matters: records and order are kept in sync so
 // PendingRecords returns entries in append order (oldest first —
-// fairness for the bouncer's drain loop).
+// fairness for the bouncer's drain loop). A record's 1-based position
+// in that order is its cursor (CursorRecord.Seq): monotonic, and
+// stable across restarts because reload replays the file in order.
 type Store struct {
 	path string
 
@@ -72,6 +74,10 @@ type Store struct {
 	file    *os.File
 	records map[string]Record // key = dedupKey, value = latest seen Record
 	order   []string          // dedupKeys in first-append order, for fair drain
+
+	// appended is closed (and replaced) by every successful Append so
+	// long-poll readers can wait for new receipts; see PendingAfter.
+	appended chan struct{}
 }
 
 // NewStore opens (creating if needed) the JSONL file at path, scans
@@ -90,8 +96,9 @@ func NewStore(path string) (*Store, error) {
 	s := &Store{
 		path:    path,
 		file:    f,
-		records: make(map[string]Record),
-		order:   make([]string, 0, 64),
+		records:  make(map[string]Record),
+		order:    make([]string, 0, 64),
+		appended: make(chan struct{}),
 	}
 	if err := s.loadRecords(); err != nil {
 		_ = f.Close()
@@ -177,6 +184,8 @@ func (s *Store) Append(rec Record) error {
 	}
 	s.records[key] = rec
 	s.order = append(s.order, key)
+	close(s.appended)
+	s.appended = make(chan struct{})
 	return nil
 }
 
@@ -206,6 +215,74 @@ func (s *Store) MarkDispatched(paymentID, txHash string) error {
 	return nil
 }
 
+// DispatchKey is one (payment_id, settlement_tx_hash) pair for
+// MarkDispatchedBatch.
+type DispatchKey struct {
+	PaymentID        string
+	SettlementTxHash string
+}
+
+// MarkDispatchedBatch is MarkDispatched for several keys under one lock,
+// one write and one fsync. errs[i] is what MarkDispatched would have
+// returned for keys[i]; a write or fsync failure is reported against
+// every key that needed a new line (none of them are flipped in memory).
+func (s *Store) MarkDispatchedBatch(keys []DispatchKey) []error {
+	errs := make([]error, len(keys))
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	var (
+		buf     []byte
+		flipped = make(map[string]Record)
+		pending []int // indices whose outcome depends on the fsync
+	)
+	for i, k := range keys {
+		key := dedupKey(k.PaymentID, k.SettlementTxHash)
+		if _, ok := flipped[key]; ok {
+			pending = append(pending, i) // repeated in this batch
+			continue
+		}
+		rec, ok := s.records[key]
+		if !ok {
+			errs[i] = ErrUnknown
+			continue
+		}
+		if rec.DispatchStatus == StatusDispatched {
+			continue
+		}
+		rec.DispatchStatus = StatusDispatched
+		line, err := json.Marshal(rec)
+		if err != nil {
+			errs[i] = fmt.Errorf("receipt: marshal: %w", err)
+			continue
+		}
+		buf = append(append(buf, line...), '\n')
+		flipped[key] = rec
+		pending = append(pending, i)
+	}
+	if len(buf) == 0 {
+		return errs
+	}
+
+	var err error
+	if _, werr := s.file.Write(buf); werr != nil {
+		err = fmt.Errorf("receipt: write %s: %w", s.path, werr)
+	} else if serr := s.file.Sync(); serr != nil {
+		err = fmt.Errorf("receipt: fsync %s: %w", s.path, serr)
+	}
+	if err != nil {
+		for _, i := range pending {
+			errs[i] = err
+		}
+		return errs
+	}
+	for key, rec := range flipped {
+		s.records[key] = rec
+	}
+	return errs
+}
+
 // PendingRecords returns up to `limit` records currently in
 // PENDING state, in append order (oldest first). The slice is a
 // fresh copy — callers may sort / filter it without affecting store
@@ -234,6 +311,37 @@ func (s *Store) PendingRecords(limit int) []Record {
 	return out
 }
 
+// CursorRecord is a Record plus its cursor, as served by GET
+// /api/v1/egress/watch. Seq starts at 1 and only grows.
+type CursorRecord struct {
+	Seq uint64 `json:"seq"`
+	Record
+}
+
+// PendingAfter returns up to `limit` PENDING records whose cursor is
+// greater than `after`, oldest first, starting the scan at `after`
+// rather than the head of the log. It also returns a channel that is
+// closed by the next Append, taken under the same lock so a caller
+// that finds nothing cannot miss a receipt written in between. The
+// slice is never nil.
+func (s *Store) PendingAfter(after uint64, limit int) ([]CursorRecord, <-chan struct{}) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+
+	out := make([]CursorRecord, 0, limit)
+	if after >= uint64(len(s.order)) {
+		return out, s.appended
+	}
+	for i := int(after); i < len(s.order) && len(out) < limit; i++ {
+		rec, ok := s.records[s.order[i]]
+		if !ok || rec.DispatchStatus != StatusPending {
+			continue
+		}
+		out = append(out, CursorRecord{Seq: uint64(i) + 1, Record: rec})
+	}
+	return out, s.appended
+}
+
 // Close flushes and releases the underlying file handle. Safe to call
 // multiple times. After Close all write methods will error.
 func (s *Store) Close() error {
@@ -276,6 +276,98 @@ func TestStore_MarkDispatchedUnknownReturnsErrUnknown(t *testing.T) {
 	}
 }
 
+// TestStore_MarkDispatchedBatchPerKeyResults — known keys flip, an
+// already-dispatched key is a no-op, an unknown key gets ErrUnknown, and
+// the flips survive a reload.
+func TestStore_MarkDispatchedBatchPerKeyResults(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "receipts.json")
+	s, err := NewStore(path)
+	if err != nil {
+		t.Fatalf("NewStore: %v", err)
+	}
+	for _, id := range []string{"a", "b", "c"} {
+		if err := s.Append(sampleRecord(id, "0x"+id)); err != nil {
+			t.Fatalf("Append %s: %v", id, err)
+		}
+	}
+	if err := s.MarkDispatched("c", "0xc"); err != nil {
+		t.Fatalf("MarkDispatched: %v", err)
+	}
+
+	errs := s.MarkDispatchedBatch([]DispatchKey{
+		{"a", "0xa"}, {"nope", "0x0"}, {"c", "0xc"}, {"b", "0xb"}, {"a", "0xa"},
+	})
+	want := []error{nil, ErrUnknown, nil, nil, nil}
+	for i := range want {
+		if errs[i] != want[i] {
+			t.Errorf("errs[%d]: got %v, want %v", i, errs[i], want[i])
+		}
+	}
+	if n := len(s.PendingRecords(10)); n != 0 {
+		t.Errorf("PendingRecords after batch: got %d, want 0", n)
+	}
+	_ = s.Close()
+
+	s2, err := NewStore(path)
+	if err != nil {
+		t.Fatalf("reload: %v", err)
+	}
+	defer s2.Close()
+	if n := len(s2.PendingRecords(10)); n != 0 {
+		t.Errorf("PendingRecords after reload: got %d, want 0", n)
+	}
+}
+
+// TestStore_PendingAfterCursorAndWakeup — cursors are 1-based append
+// positions, dispatched records are skipped, the page is capped, and
+// the returned channel closes on the next Append.
+func TestStore_PendingAfterCursorAndWakeup(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "receipts.json")
+	s, err := NewStore(path)
+	if err != nil {
+		t.Fatalf("NewStore: %v", err)
+	}
+	defer s.Close()
+	for _, id := range []string{"a", "b", "c", "d"} {
+		if err := s.Append(sampleRecord(id, "0x"+id)); err != nil {
+			t.Fatalf("Append %s: %v", id, err)
+		}
+	}
+	if err := s.MarkDispatched("b", "0xb"); err != nil {
+		t.Fatalf("MarkDispatched: %v", err)
+	}
+
+	got, _ := s.PendingAfter(0, 2)
+	if len(got) != 2 || got[0].Seq != 1 || got[1].Seq != 3 || got[1].PaymentID != "c" {
+		t.Fatalf("PendingAfter(0, 2): got %+v", got)
+	}
+	got, _ = s.PendingAfter(3, 10)
+	if len(got) != 1 || got[0].Seq != 4 {
+		t.Fatalf("PendingAfter(3, 10): got %+v", got)
+	}
+
+	got, appended := s.PendingAfter(4, 10)
+	if len(got) != 0 || got == nil {
+		t.Fatalf("PendingAfter(4, 10): got %#v, want empty non-nil", got)
+	}
+	select {
+	case <-appended:
+		t.Fatal("appended closed before any Append")
+	default:
+	}
+	if err := s.Append(sampleRecord("e", "0xe")); err != nil {
+		t.Fatalf("Append e: %v", err)
+	}
+	select {
+	case <-appended:
+	default:
+		t.Fatal("appended not closed by Append")
+	}
+	if got, _ = s.PendingAfter(4, 10); len(got) != 1 || got[0].Seq != 5 {
+		t.Fatalf("PendingAfter(4, 10) after Append: got %+v", got)
+	}
+}
+
 func TestStore_PendingRecordsInOrderAndCapped(t *testing.T) {
 	path := filepath.Join(t.TempDir(), "receipts.json")
 	s, err := NewStore(path)
@@ -0,0 +1,294 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      bench_egress_json.cpp
+ * Desc:      Micro-benchmark: the one-pass structural-index egress
+ *            scanner against the per-key re-walking scanner it
+ *            replaced, on 10 / 100 / 1000-record /watch bodies.
+ *            Built with -DGROUND_STATION_BENCH=ON.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "egress_json.h"
+
+// The previous scanner, verbatim: find_object_end, then one
+// find_and_extract_key walk from the record start per wanted key.
+namespace baseline {
+using egress::EgressPacketCHexMaxLen;
+using egress::EgressPaymentIdMaxLen;
+using egress::EgressTxHashMaxLen;
+using egress::Record;
+namespace {
+
+// Skip JSON whitespace (spaces, tabs, newlines, CR). Returns new pos.
+size_t skip_ws(const char* body, size_t pos, size_t end) {
+    while (pos < end) {
+        const char c = body[pos];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+        ++pos;
+    }
+    return pos;
+}
+
+// Extract a JSON string value. `pos` MUST point at the opening `"`.
+// Copies the body into `out` (bounded by out_max-1 + a trailing NUL).
+// Advances `pos` past the closing quote on success.
+// Returns true on success, false on overflow / unterminated literal.
+bool extract_string(const char* body, size_t& pos, size_t end,
+                    char* out, size_t out_max) {
+    if (out_max == 0) return false;
+    if (pos >= end || body[pos] != '"') return false;
+    ++pos; // skip opening quote
+    size_t written = 0;
+    while (pos < end) {
+        char c = body[pos];
+        if (c == '"') {
+            // Closing quote — terminate output.
+            if (written >= out_max) return false;
+            out[written] = '\0';
+            ++pos;
+            return true;
+        }
+        // Pass-through after backslash (handles \\" in arbitrary JSON,
+        // though the gateway's fields never emit escapes).
+        if (c == '\\' && pos + 1 < end) {
+            ++pos;
+            c = body[pos];
+        }
+        if (written + 1 >= out_max) return false; // overflow (leave room for NUL)
+        out[written] = c;
+        ++written;
+        ++pos;
+    }
+    return false; // unterminated string
+}
+
+// Locate `"<key>"` inside [start, end) and step past the colon.
+// Returns the index of the value's first byte, or `end` if the key is
+// absent / not followed by a colon. Scans linearly; O(end-start) per key.
+size_t find_key_value(const char* body, size_t start, size_t end,
+                      const char* key_literal) {
+    const size_t key_len = std::strlen(key_literal);
+    size_t pos = start;
+    while (pos < end) {
+        // Advance to the next `"` — might be a key quote or a value quote.
+        while (pos < end && body[pos] != '"') ++pos;
+        if (pos >= end) return end;
+
+        // Check that a full "<key>" fits in the remaining window.
+        if (pos + 1 + key_len + 1 > end) return end;
+
+        if (body[pos + 1 + key_len] == '"' &&
+            std::memcmp(&body[pos + 1], key_literal, key_len) == 0) {
+            // Matched "<key>". Step past the closing quote of the key,
+            // skip ws, expect ':', skip ws.
+            pos += 1 + key_len + 1;
+            pos = skip_ws(body, pos, end);
+            if (pos >= end || body[pos] != ':') return end;
+            ++pos;
+            return skip_ws(body, pos, end);
+        }
+
+        // False positive (different key or value string) — step past
+        // the current quote and keep scanning. Because the quote we
+        // matched might be the OPEN quote of a value (which could
+        // itself contain a `:` that would confuse naive parsers),
+        // advance to the matching closing quote first.
+        ++pos;
+        while (pos < end) {
+            const char c = body[pos];
+            if (c == '\\' && pos + 1 < end) { pos += 2; continue; }
+            if (c == '"') { ++pos; break; }
+            ++pos;
+        }
+    }
+    return end;
+}
+
+// Locate `"<key>"` and extract its JSON string value into `out`.
+bool find_and_extract_key(const char* body, size_t start, size_t end,
+                          const char* key_literal,
+                          char* out, size_t out_max) {
+    size_t pos = find_key_value(body, start, end, key_literal);
+    if (pos >= end) return false;
+    return extract_string(body, pos, end, out, out_max);
+}
+
+// Optional unsigned integer field. Absent → `out` = 0, true. Present
+// but not 1..20 digits that fit in uint64_t → false.
+bool find_and_extract_u64(const char* body, size_t start, size_t end,
+                          const char* key_literal, uint64_t& out) {
+    out = 0;
+    size_t pos = find_key_value(body, start, end, key_literal);
+    if (pos >= end) return true;
+    size_t digits = 0;
+    while (pos < end && body[pos] >= '0' && body[pos] <= '9') {
+        const uint64_t d = static_cast<uint64_t>(body[pos] - '0');
+        if (out > (UINT64_MAX - d) / 10u) return false;
+        out = out * 10u + d;
+        ++pos;
+        ++digits;
+    }
+    return digits > 0;
+}
+
+// Find the index one past the matching `}` for an object opening at
+// `pos` (which MUST be `{`). Handles quoted strings and escapes so a
+// `}` inside a string doesn't fool the brace counter. Returns
+// body_len on unmatched / unterminated input.
+size_t find_object_end(const char* body, size_t pos, size_t end) {
+    if (pos >= end || body[pos] != '{') return end;
+    int depth = 0;
+    bool in_string = false;
+    while (pos < end) {
+        const char c = body[pos];
+        if (in_string) {
+            if (c == '\\' && pos + 1 < end) { pos += 2; continue; }
+            if (c == '"') in_string = false;
+            ++pos;
+            continue;
+        }
+        if (c == '"')       { in_string = true; ++pos; continue; }
+        else if (c == '{')  { ++depth; }
+        else if (c == '}')  { --depth; if (depth == 0) { return pos + 1; } }
+        ++pos;
+    }
+    return end; // unmatched
+}
+
+} // anonymous namespace
+
+int parse_pending_response(const char* body,
+                           size_t      body_len,
+                           Record*     out,
+                           size_t      max_records) {
+    if (!body || body_len == 0 || !out || max_records == 0) return -1;
+
+    size_t pos = skip_ws(body, 0, body_len);
+    if (pos >= body_len || body[pos] != '[') return -1;
+    ++pos;
+    pos = skip_ws(body, pos, body_len);
+
+    // Empty array — 0 records, valid response.
+    if (pos < body_len && body[pos] == ']') return 0;
+
+    size_t count = 0;
+    while (pos < body_len) {
+        pos = skip_ws(body, pos, body_len);
+        if (pos >= body_len || body[pos] != '{') return -1;
+
+        const size_t obj_start = pos;
+        const size_t obj_end   = find_object_end(body, pos, body_len);
+        if (obj_end >= body_len && (obj_end == body_len && body[body_len - 1] != '}')) {
+            return -1;
+        }
+        if (obj_end == body_len) return -1;
+
+        Record& r = out[count];
+        // Zero each bucket's first byte so partial-extract still leaves
+        // a valid C string.
+        r.payment_id[0]         = '\0';
+        r.settlement_tx_hash[0] = '\0';
+        r.packet_c_hex[0]       = '\0';
+
+        if (!find_and_extract_key(body, obj_start, obj_end, "payment_id",
+                                  r.payment_id, EgressPaymentIdMaxLen))
+            return -1;
+        if (!find_and_extract_key(body, obj_start, obj_end, "settlement_tx_hash",
+                                  r.settlement_tx_hash, EgressTxHashMaxLen))
+            return -1;
+        if (!find_and_extract_key(body, obj_start, obj_end, "packet_c_hex",
+                                  r.packet_c_hex, EgressPacketCHexMaxLen))
+            return -1;
+        if (!find_and_extract_u64(body, obj_start, obj_end, "seq", r.seq))
+            return -1;
+
+        ++count;
+        pos = obj_end;
+
+        // Cap reached — stop even if more records remain.
+        if (count >= max_records) {
+            return static_cast<int>(count);
+        }
+
+        pos = skip_ws(body, pos, body_len);
+        if (pos >= body_len) return -1;
+        if (body[pos] == ',') {
+            ++pos;
+            continue;
+        }
+        if (body[pos] == ']') {
+            return static_cast<int>(count);
+        }
+        return -1;
+    }
+    return -1;
+}
+
+} // namespace baseline
+
+namespace {
+
+volatile uint64_t g_sink = 0;
+
+// One /watch record in the gateway's field order (CursorRecord).
+std::string make_body(size_t records) {
+    std::string body = "[";
+    const std::string packet_c(224, 'a');
+    for (size_t i = 1; i <= records; ++i) {
+        char rec[768];
+        std::snprintf(rec, sizeof(rec),
+                      "%s{\"seq\":%zu,\"payment_id\":\"628239210071410091616057965%zu\","
+                      "\"settlement_tx_hash\":\"0x%064zx\",\"sat_id\":3405691582,"
+                      "\"amount\":\"420000000\",\"asset_id\":1,"
+                      "\"wallet\":\"0x70997970C51812dc3A010C7d01b50e0d17dc79C8\","
+                      "\"packet_c_hex\":\"%s\",\"block_number\":%zu,"
+                      "\"ts_ms\":1710000100000,\"dispatch_status\":\"PENDING\"}",
+                      i == 1 ? "" : ",", i, i, i, packet_c.c_str(), 1000 + i);
+        body += rec;
+    }
+    return body + "]";
+}
+
+template <typename Fn>
+double ns_per_call(size_t iters, Fn fn) {
+    fn();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; ++i) fn();
+    const auto t1 = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+           static_cast<double>(iters);
+}
+
+egress::Record g_records[1000];
+
+} // namespace
+
+int main() {
+    for (size_t n : {size_t{10}, size_t{100}, size_t{1000}}) {
+        const std::string body  = make_body(n);
+        const size_t      iters = 200000 / n;
+        const double before = ns_per_call(iters, [&] {
+            g_sink = g_sink + static_cast<uint64_t>(baseline::parse_pending_response(
+                                  body.data(), body.size(), g_records, n));
+        });
+        const double after = ns_per_call(iters, [&] {
+            g_sink = g_sink + static_cast<uint64_t>(egress::parse_pending_response(
+                                  body.data(), body.size(), g_records, n));
+        });
+        std::printf("%4zu records (%7zu B)  re-walk %10.0f ns  indexed %10.0f ns  (%5.2fx, %6.0f MB/s)\n",
+                    n, body.size(), before, after, before / after,
+                    static_cast<double>(body.size()) * 1e3 / after);
+    }
+    return 0;
+}
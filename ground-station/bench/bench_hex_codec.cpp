@@ -0,0 +1,308 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      bench_hex_codec.cpp
+ * Desc:      Micro-benchmarks: SIMD hex codec and line framer against
+ *            the code they replaced on the serial and egress paths, and
+ *            against the codec's own scalar fallback. Built with
+ *            -DGROUND_STATION_BENCH=ON.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Workloads are the production shapes: a 112-byte PacketC decode
+ * (224 hex chars, egress), a 192-byte PacketB decode (serial RX), the
+ * PACKET_C_TX: / PACKET_ACK_TX: line encodes, and a 64 KiB burst of
+ * "PACKET_B:<hex>\r\n" lines as drain_radio() sees it from the serial
+ * port. The "baseline" column is the pre-codec code, copied verbatim
+ * below; speed-ups are SIMD against it.
+ * -------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "hex_codec.h"
+#include "line_framer.h"
+
+// The code the codec replaced, verbatim except that the TX encoders
+// return the line length instead of writing it to the serial port.
+namespace baseline {
+
+constexpr size_t kPacketCSize   = 112; // egress::EgressPacketCSize
+constexpr size_t kPacketAckSize = 136; // ack_builder::kPacketAckSize
+
+// main.cpp: PACKET_B: lines, one strtol per byte.
+void hex_to_bin(const char* hex, uint8_t* bin_out, size_t max_len) {
+    size_t len = std::strlen(hex);
+    for (size_t i = 0; i < len && (i / 2) < max_len; i += 2) {
+        char byte_str[3] = {hex[i], hex[i+1], '\0'};
+        bin_out[i/2] = static_cast<uint8_t>(std::strtol(byte_str, nullptr, 16));
+    }
+}
+
+// egress_hex.cpp: egress PacketC decode.
+namespace {
+
+// Table-free nibble decode. Returns a negative value on a non-hex byte
+// so the caller can fail-closed without branching on ranges.
+int nibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // anonymous namespace
+
+bool hex_decode(const char*  hex,
+                size_t       hex_len,
+                uint8_t*     out,
+                size_t       out_cap) {
+    if (hex == nullptr || out == nullptr) return false;
+    if ((hex_len & 1u) != 0u) return false;                 // odd length
+    const size_t need = hex_len / 2u;
+    if (need > out_cap) return false;                       // overflow
+    for (size_t i = 0; i < need; ++i) {
+        const int hi = nibble(hex[i * 2u]);
+        const int lo = nibble(hex[i * 2u + 1u]);
+        if (hi < 0 || lo < 0) return false;                 // non-hex
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+// main.cpp lora_tx_via_serial(): the PACKET_C_TX: line.
+size_t packet_c_tx_line(const uint8_t* data, size_t len, char* out) {
+    static constexpr size_t kPrefixLen = 13; // "PACKET_C_TX:"
+    static constexpr size_t kMaxHex    = kPacketCSize * 2;
+    static constexpr size_t kLineCap   = kPrefixLen + kMaxHex + 2; // +\n +\0
+    char line[kLineCap];
+    std::snprintf(line, sizeof(line), "PACKET_C_TX:");
+    static const char kDigits[] = "0123456789abcdef";
+    for (size_t i = 0; i < len && i < kPacketCSize; ++i) {
+        line[kPrefixLen + i * 2]     = kDigits[(data[i] >> 4) & 0x0Fu];
+        line[kPrefixLen + i * 2 + 1] = kDigits[data[i] & 0x0Fu];
+    }
+    const size_t line_len = kPrefixLen + len * 2u;
+    line[line_len]     = '\n';
+    line[line_len + 1] = '\0';
+
+    std::memcpy(out, line, line_len + 1);
+    return line_len + 1;
+}
+
+// main.cpp lora_tx_ack_via_serial(): the PACKET_ACK_TX: line.
+size_t packet_ack_tx_line(const uint8_t* data, size_t len, char* out) {
+    static constexpr char   kPrefix[]  = "PACKET_ACK_TX:";
+    static constexpr size_t kPrefixLen = sizeof(kPrefix) - 1;
+    static constexpr size_t kMaxHex    = kPacketAckSize * 2;
+    static constexpr size_t kLineCap   = kPrefixLen + kMaxHex + 2; // +\n +\0
+
+    if (len != kPacketAckSize) return 0;
+
+    char line[kLineCap];
+    std::memcpy(line, kPrefix, kPrefixLen);
+    static const char kDigits[] = "0123456789abcdef";
+    for (size_t i = 0; i < len; ++i) {
+        line[kPrefixLen + i * 2]     = kDigits[(data[i] >> 4) & 0x0Fu];
+        line[kPrefixLen + i * 2 + 1] = kDigits[data[i] & 0x0Fu];
+    }
+    const size_t line_len = kPrefixLen + len * 2u;
+    line[line_len]     = '\n';
+    line[line_len + 1] = '\0';
+
+    std::memcpy(out, line, line_len + 1);
+    return line_len + 1;
+}
+
+// main.cpp: the byte-at-a-time line accumulator before LineFramer.
+template <size_t N>
+struct ByteLineBuffer {
+    char   buf[N];
+    size_t idx = 0;
+
+    template <typename OnLine>
+    void feed(const uint8_t* data, size_t len, OnLine on_line) {
+        for (size_t i = 0; i < len; ++i) {
+            const char c = static_cast<char>(data[i]);
+            if (c == '\n' || c == '\r') {
+                if (idx > 0) {
+                    buf[idx] = '\0';
+                    on_line(buf, idx);
+                    idx = 0;
+                }
+            } else if (idx < N - 1) {
+                buf[idx++] = c;
+            }
+        }
+    }
+};
+
+} // namespace baseline
+
+namespace {
+
+volatile uint64_t g_sink = 0;
+
+using EncodeFn = size_t (*)(const uint8_t* in, size_t len, char* out, size_t out_cap);
+
+// radio_send_frame()'s ASCII branch: "<tag><hex>\n" with `encode`.
+size_t tx_line(EncodeFn encode, const char* tag, const uint8_t* data, size_t len, char* out,
+               size_t out_cap) {
+    const size_t tag_len  = std::strlen(tag);
+    std::memcpy(out, tag, tag_len);
+    const size_t line_len = tag_len + encode(data, len, out + tag_len, out_cap - tag_len);
+    out[line_len] = '\n';
+    return line_len + 1;
+}
+
+template <typename Fn>
+double ns_per_op(size_t iters, Fn fn) {
+    fn(); // warm-up (also resolves the codec backend)
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; ++i) fn();
+    const auto t1 = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+           static_cast<double>(iters);
+}
+
+// A negative `scalar_ns` means the row has no scalar-codec variant.
+void report(const char* name, double baseline_ns, double scalar_ns, double simd_ns,
+            size_t bytes) {
+    char scalar[16] = "      -";
+    if (scalar_ns >= 0) std::snprintf(scalar, sizeof(scalar), "%9.1f", scalar_ns);
+    std::printf("%-30s baseline %9.1f ns  scalar %s ns  simd %9.1f ns  (%6.2fx, %7.0f MB/s)\n",
+                name, baseline_ns, scalar, simd_ns, baseline_ns / simd_ns,
+                static_cast<double>(bytes) * 1e3 / simd_ns);
+}
+
+} // namespace
+
+int main() {
+    std::printf("hex_codec backend: %s\n\n", hex_codec::backend());
+
+    uint8_t bytes[192];
+    for (size_t i = 0; i < sizeof(bytes); ++i) bytes[i] = static_cast<uint8_t>(i * 37u + 11u);
+    char hex[2 * sizeof(bytes) + 1]; // NUL-terminated for hex_to_bin()
+    hex[hex_codec::encode_scalar(bytes, sizeof(bytes), hex, sizeof(hex))] = '\0';
+
+    const size_t kIters = 2000000;
+    uint8_t      out[sizeof(bytes)];
+    char         line[64 + sizeof(hex)];
+
+    report("decode PacketC (224 chars)",
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + baseline::hex_decode(hex, 224, out, sizeof(out)) + out[7];
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + hex_codec::decode_scalar(hex, 224, out, sizeof(out)) + out[7];
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + hex_codec::decode(hex, 224, out, sizeof(out)) + out[7];
+           }),
+           224);
+    report("decode PacketB (384 chars)",
+           ns_per_op(kIters / 10, [&] {
+               baseline::hex_to_bin(hex, out, sizeof(out));
+               g_sink = g_sink + out[7];
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + hex_codec::decode_scalar(hex, 384, out, sizeof(out)) + out[7];
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + hex_codec::decode(hex, 384, out, sizeof(out)) + out[7];
+           }),
+           384);
+    report("PACKET_C_TX line (112 B)",
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + baseline::packet_c_tx_line(bytes, 112, line) +
+                        static_cast<uint8_t>(line[20]);
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + tx_line(hex_codec::encode_scalar, "PACKET_C_TX:", bytes, 112,
+                                         line, sizeof(line)) +
+                        static_cast<uint8_t>(line[20]);
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + tx_line(hex_codec::encode, "PACKET_C_TX:", bytes, 112, line,
+                                         sizeof(line)) +
+                        static_cast<uint8_t>(line[20]);
+           }),
+           112);
+    report("PACKET_ACK_TX line (136 B)",
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + baseline::packet_ack_tx_line(bytes, 136, line) +
+                        static_cast<uint8_t>(line[20]);
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + tx_line(hex_codec::encode_scalar, "PACKET_ACK_TX:", bytes, 136,
+                                         line, sizeof(line)) +
+                        static_cast<uint8_t>(line[20]);
+           }),
+           ns_per_op(kIters, [&] {
+               g_sink = g_sink + tx_line(hex_codec::encode, "PACKET_ACK_TX:", bytes, 136, line,
+                                         sizeof(line)) +
+                        static_cast<uint8_t>(line[20]);
+           }),
+           136);
+
+    // 64 KiB serial burst of PacketB lines, framed then decoded.
+    static uint8_t burst[65536];
+    static uint8_t work[sizeof(burst)];
+    size_t         fill = 0;
+    static const char kTag[] = "PACKET_B:";
+    while (fill + (sizeof(kTag) - 1) + 2 * 96 + 2 <= sizeof(burst)) {
+        std::memcpy(burst + fill, kTag, sizeof(kTag) - 1);
+        fill += sizeof(kTag) - 1;
+        std::memcpy(burst + fill, hex, 2 * 96);
+        fill += 2 * 96;
+        burst[fill++] = '\r';
+        burst[fill++] = '\n';
+    }
+    const size_t kBurstIters = 2000;
+    const auto   on_line     = [&](char* l, size_t len) {
+        const char* payload = l + sizeof(kTag) - 1;
+        g_sink = g_sink + hex_codec::decode(payload, len - (sizeof(kTag) - 1), out, sizeof(out));
+        return true;
+    };
+    const auto on_line_baseline = [&](char* l, size_t) {
+        baseline::hex_to_bin(l + sizeof(kTag) - 1, out, sizeof(out));
+        g_sink = g_sink + out[7];
+    };
+    baseline::ByteLineBuffer<512> before;
+    line_framer::LineFramer<512>  after;
+    report("frame+decode 64 KiB burst",
+           ns_per_op(kBurstIters / 10, [&] { before.feed(burst, fill, on_line_baseline); }),
+           -1,
+           ns_per_op(kBurstIters, [&] {
+               // The framer writes NULs in place; drain_radio() reads into
+               // a scratch buffer the same way.
+               std::memcpy(work, burst, fill);
+               after.feed(work, fill, on_line);
+           }),
+           fill);
+
+    // The old accumulator found line ends one byte at a time as it
+    // copied; that copy is the baseline for the EOL scan.
+    static uint8_t plain[4096];
+    std::memset(plain, 'a', sizeof(plain));
+    plain[sizeof(plain) - 1] = '\n';
+    baseline::ByteLineBuffer<sizeof(plain)> scan;
+    report("find_eol 4 KiB",
+           ns_per_op(kIters / 10, [&] {
+               scan.feed(plain, sizeof(plain), [](char*, size_t len) { g_sink = g_sink + len; });
+           }),
+           ns_per_op(kIters / 10, [&] {
+               g_sink = g_sink + line_framer::find_eol_scalar(plain, sizeof(plain));
+           }),
+           ns_per_op(kIters / 10, [&] {
+               g_sink = g_sink + line_framer::find_eol(plain, sizeof(plain));
+           }),
+           sizeof(plain));
+    return 0;
+}
@@ -15,6 +15,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "security_context.h"
+
 // The journey-to-HAB plaintext alpha runs the SNLP tier exclusively.
 // CCSDS-tier ACK framing is intentionally deferred — not in-scope for
 // TRL 4 (see docs/journey_to_hab_plain_text.md non-goals).
@@ -24,6 +26,7 @@ static constexpr size_t  kPacketAckSize      = 136;  // SNLP PacketAck_t
 static constexpr size_t  kEncTunnelSize      = 96;   // SNLP TunnelData_t
 static constexpr uint8_t kPacketAckMagic     = 0xAC; // F-03 body-offset-0 magic
 static constexpr uint8_t kAckStatusVerified  = 0x01; // RECEIVED_VERIFIED
+static constexpr uint16_t kTunnelCmdUnlock   = 0x0001; // UNLOCK / DISPENSE
 
 // Inputs needed to fully determine a PacketAck frame. Header-level
 // values (APID, sync word, sec flag, seq_count) are held constant
@@ -45,6 +48,22 @@ struct AckInputs {
 // deterministic input set.
 bool build(const AckInputs& in, uint8_t* out, size_t out_cap);
 
+// Fields of the TunnelData_t carried in enc_tunnel (Acknowledgment-spec
+// §C). The header (APID = Sat A) and CRC are derived.
+struct TunnelInputs {
+    uint64_t block_nonce;  // replay protection
+    uint16_t cmd_code;     // kTunnelCmdUnlock
+    uint16_t ttl;          // seconds
+};
+
+// Writes exactly kEncTunnelSize bytes of SNLP TunnelData_t to `out`:
+// ground_sig is `signer`'s Ed25519 signature over header..ttl (bytes
+// 0-27), then the inner CRC32 over bytes 0-91. Returns false if
+// `out_cap < kEncTunnelSize` or `signer` is not initialised. Plaintext:
+// the alpha tunnel is not encrypted. Thread-safe.
+bool build_tunnel(const TunnelInputs& in, const security_context::Identity& signer,
+                  uint8_t* out, size_t out_cap);
+
 }  // namespace ack_builder
 
 #endif  // VOID_ACK_BUILDER_H
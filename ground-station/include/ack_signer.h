@@ -0,0 +1,146 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      ack_signer.h
+ * Desc:      Bounded worker pool that signs TunnelData ground_sig and
+ *            builds finished PacketAck frames off the ingest thread.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Every ACK carries a ground-signed TunnelData_t in enc_tunnel, so each
+ * settlement costs one Ed25519 sign. The reactor thread submit()s a job
+ * and goes back to reading; a worker builds the tunnel, signs it, wraps
+ * it in the PacketAck and publishes the frame to its completion ring.
+ * The reactor picks finished frames up with drain() when notify_fd()
+ * turns readable.
+ *
+ * Each worker owns two SPSC rings (spsc_ring.h): jobs in, frames out.
+ * submit() round-robins over the workers and skips full ones, so
+ * throughput scales with the worker count and nothing is locked on the
+ * fast path. A worker takes a job only when its completion ring has
+ * room: an undrained consumer backs jobs up until submit() refuses
+ * them, and the caller builds that ACK inline. Workers are pinned to
+ * their own cores where the OS allows, leaving core 0 to ingest.
+ *
+ * One thread calls submit(), one thread calls drain() (the same one in
+ * main.cpp). Completions from different workers may arrive out of
+ * submission order; the job's tag identifies it.
+ * -------------------------------------------------------------------------*/
+
+#ifndef ACK_SIGNER_H
+#define ACK_SIGNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "ack_builder.h"
+#include "security_context.h"
+#include "spsc_ring.h"
+
+namespace ack_signer {
+
+constexpr size_t   kMaxWorkers = 8;
+constexpr size_t   kQueueSlots = 32;   // per worker and direction; power of two
+constexpr uint32_t kIdleWaitMs = 250;  // parked wake-up bound
+
+struct Job {
+    uint32_t                  tag;     // returned with the frame (main: radio port)
+    ack_builder::AckInputs    ack;     // enc_tunnel is overwritten
+    ack_builder::TunnelInputs tunnel;
+};
+
+struct Done {
+    uint32_t tag;
+    bool     ok;  // false: build or sign failed, frame is not sendable
+    uint8_t  frame[ack_builder::kPacketAckSize];
+};
+
+// Called on the drain() thread for every finished frame.
+using DoneFn = void (*)(const Done& done, void* user);
+
+struct Stats {
+    uint64_t submitted; // jobs accepted by submit()
+    uint64_t full;      // submit() found every queue full
+    uint64_t signed_;   // frames built by the workers
+    uint64_t failed;    // ... of which failed to build or sign
+    uint64_t drained;   // frames handed to a DoneFn
+};
+
+// Build + sign one ACK on the calling thread, as a worker would.
+// Returns false if the tunnel could not be signed or the frame built.
+bool build_signed(const Job& job, const security_context::Identity& id,
+                  uint8_t out[ack_builder::kPacketAckSize]);
+
+class SignerPool {
+public:
+    // `id` must be initialised and outlive the pool.
+    explicit SignerPool(const security_context::Identity& id);
+    ~SignerPool();
+
+    SignerPool(const SignerPool&)            = delete;
+    SignerPool& operator=(const SignerPool&) = delete;
+
+    // Runs `workers` signing threads (clamped to 1..kMaxWorkers) until
+    // stop(). False if already running or the notify pipe failed.
+    bool start(size_t workers);
+
+    // Signs what fits in the completion rings and joins. Frames not yet
+    // drained stay available to drain().
+    void stop();
+
+    // Producer side. Never blocks; false when not running or every
+    // worker's queue is full.
+    bool submit(const Job& job);
+
+    // Consumer side: hands every finished frame to `fn`. Returns how
+    // many.
+    size_t drain(DoneFn fn, void* user);
+
+    // Readable when drain() has frames; -1 where there is no pipe
+    // (poll drain() on a timer instead).
+    int notify_fd() const { return notify_rd_; }
+
+    size_t workers() const { return count_; }
+    bool   running() const { return running_; }
+    Stats  stats() const;
+
+private:
+    struct Worker {
+        SpscRing<Job, kQueueSlots>  jobs;
+        SpscRing<Done, kQueueSlots> done;
+        std::thread                 thread;
+        std::atomic<bool>           parked;
+        std::mutex                  mu;
+        std::condition_variable     cv;
+    };
+
+    void run(Worker& w, size_t core);
+    void wake(Worker& w);
+    void notify();
+
+    const security_context::Identity& id_;
+    Worker                            workers_[kMaxWorkers];
+    size_t                            count_;
+    size_t                            next_;
+    bool                              running_;
+    std::atomic<bool>                 stop_;
+    std::atomic<bool>                 signaled_;
+    int                               notify_rd_;
+    int                               notify_wr_;
+
+    std::atomic<uint64_t> submitted_;
+    std::atomic<uint64_t> full_;
+    std::atomic<uint64_t> signed_;
+    std::atomic<uint64_t> failed_;
+    std::atomic<uint64_t> drained_;
+};
+
+} // namespace ack_signer
+
+#endif // ACK_SIGNER_H
@@ -15,20 +15,148 @@
 #include <cstdint>
 #include <cstddef>
 // CMake target_include_directories handles the path resolution
-#include "void_packets.h" 
+#include "void_packets.h"
+#include "frame_dispatch.h"
+#include "replay_window.h"
+#include "security_context.h"
+
+// Per-frame outcome of the firewall. Ordered by the stage that
+// rejected the frame — cheap structural checks run first so a bad
+// frame never pays for an Ed25519 verify.
+enum class BouncerVerdict : uint8_t {
+    kAccepted = 0,
+    kBadSize,          // not exactly sizeof(PacketB_t) of either tier
+    kBadHeader,        // sync / version / APID / packet_len / type (frame_dispatch)
+    kBadCrc,           // global_crc mismatch (RF bit-flip / truncation)
+    kUnknownSat,       // no registered Ed25519 key for PacketB.sat_id
+    kStale,            // epoch_ts more than kFreshnessMs from the ground clock
+    kReplay,           // epoch_ts already used by this sat, or behind its window
+    kReplayTableFull,  // first frame of a sat and no replay slot left for it
+    kBadSignature,     // Ed25519 verify failed
+    kOutputTooSmall,   // caller's cleartext buffer can't hold enc_payload
+    kNoSession,        // CCSDS payload and no active session key for the sat
+};
+
+// One PacketB frame handed to process_batch(). Non-owning view; the
+// caller keeps `buf` alive for the duration of the call.
+struct BouncerFrame {
+    const uint8_t* buf;
+    size_t         len;
+};
+
+// A frame decrypt_batch() may rewrite in place.
+struct BouncerMutableFrame {
+    uint8_t* buf;
+    size_t   len;
+};
 
 class Bouncer {
+public:
+    // Fixed-capacity identity registry (no heap). Flat-sat registers a
+    // single key; 32 covers a full TinyGS-style pass with headroom.
+    static constexpr size_t kMaxRegisteredSats = 32;
+
+    // Upper bound on frames per process_batch() call — sized to one
+    // 4 KiB serial burst of hex-encoded PacketBs with headroom.
+    static constexpr size_t kMaxBatch = 32;
+
+    static constexpr size_t kPubKeySize = 32;
+
+    // Replay tracker slots: up to 3/4 of this many (sat_id, tier)
+    // windows, 56 B each — 3.5 MiB, so a Bouncer wants static storage.
+    static constexpr size_t kReplaySlots = 65536;
+
+    // |ground clock - epoch_ts| allowed when a clock is set.
+    static constexpr uint64_t kFreshnessMs = 60000;
+
+    // Wall-clock source in Unix ms, the epoch_ts time base.
+    using Clock = uint64_t (*)();
+
 private:
-    uint8_t _session_key[32];
+    // Per-sat session keys, shared with whichever thread runs the
+    // handshakes. Not owned; nullptr until set_session_store().
+    security_context::SessionStore* _sessions;
+    uint64_t (*_session_clock)();
+
+    struct SatKey {
+        uint32_t sat_id;
+        uint8_t  pub[kPubKeySize];
+        bool     used;
+    };
+    SatKey _keys[kMaxRegisteredSats];
+
+    const uint8_t* find_sat_key(uint32_t sat_id) const;
+
+    // Per-sat epoch_ts windows (see replay_window.h). Consulted before
+    // the signature check, advanced only by verified frames.
+    replay_window::Tracker<kReplaySlots> _replay;
+    Clock                                _clock;
+
+    // What admit() needs to advance the replay window once a frame
+    // has been accepted.
+    struct Admission {
+        uint32_t sat_id;
+        uint8_t  tier;
+        uint64_t epoch;
+        uint32_t crc;
+    };
+
+    // Size + header + CRC + registry + freshness + replay + signature.
+    // Shared by process_packet() and process_batch() so both paths apply
+    // identical rules. The tier (LoRa SNLP / S-band CCSDS) is probed once
+    // from the sync word, then check_frame_as<T> runs with every offset
+    // resolved at compile time. Fills `adm` when the frame is accepted.
+    BouncerVerdict check_frame(const uint8_t* buf, size_t len, Admission* adm) const;
+
+    template <frame_dispatch::Tier T>
+    BouncerVerdict check_frame_as(const uint8_t* buf, size_t len, Admission* adm) const;
+
+    // Records an accepted frame in its sat's replay window; a
+    // retransmit spends one of its epoch's kMaxRetransmits.
+    BouncerVerdict admit(const Admission& adm);
+
+    // admit() for a byte-identical copy of a frame verified earlier in
+    // the same batch: no second verify, but kReplay once the epoch has
+    // no retransmits left.
+    BouncerVerdict admit_copy(const Admission& adm);
 
 public:
     Bouncer();
 
+    // --- Identity Registry ---
+    // Registers (or replaces) the Ed25519 public key for `sat_id`.
+    // Returns false if len != kPubKeySize or the registry is full.
+    bool register_sat_key(uint32_t sat_id, const uint8_t* pubkey, size_t len);
+    void clear_sat_keys();
+
     // --- Signature Validation ---
-    bool validate_signature(const uint8_t* data, size_t data_len, const uint8_t* signature, size_t sig_len) const;
-    
+    // Ed25519 verify of `signature` over data[0..data_len) against the
+    // key registered for `sat_id`. False on unknown sat or bad sig.
+    bool validate_signature(uint32_t sat_id,
+                            const uint8_t* data, size_t data_len,
+                            const uint8_t* signature, size_t sig_len) const;
+
     // --- Decrypt Payload ---
-    bool decrypt_payload(const uint8_t* enc, size_t enc_len, uint8_t* out, size_t out_len) const;
+    // CCSDS enc_payload is ChaCha20 under the sat's session key with the
+    // VOID-110 nonce sat_id || epoch_ts (SecurityManager::encryptPacketB).
+    // SNLP payloads are plaintext by law (Protocol-spec-SNLP.md) and pass
+    // through, as does every payload while no session store is set (the
+    // plaintext alpha). `out` may equal `enc`.
+    BouncerVerdict decrypt_payload(frame_dispatch::Tier tier, uint32_t sat_id, uint64_t epoch_ts,
+                                   const uint8_t* enc, size_t enc_len,
+                                   uint8_t* out, size_t out_len) const;
+
+    // Decrypts enc_payload inside an accepted PacketB frame, in place.
+    // The frame no longer verifies afterwards: keep the received bytes
+    // if they still have to be forwarded.
+    BouncerVerdict decrypt_in_place(uint8_t* buf, size_t len) const;
+
+    // In-place decrypt of every frame whose verdict is kAccepted (as left
+    // by process_batch() over the same frames). Frames of one sat share
+    // a single session-key lookup; a frame with no key turns kNoSession.
+    // Returns the number of frames still kAccepted; 0 if count > kMaxBatch.
+    size_t decrypt_batch(const BouncerMutableFrame* frames, size_t count,
+                         BouncerVerdict* verdicts) const;
 
     // --- Packet Structure Validation ---
     // Template methods must be implemented in the header
@@ -38,12 +166,44 @@ public:
         return len == sizeof(T);
     }
 
+    // --- Replay Protection ---
+    // Each sat's epoch_ts must be new: a frame re-using an accepted
+    // epoch (or older than the sat's replay window) is rejected before
+    // any signature work. A byte-identical copy of an accepted frame is
+    // the sat re-sending for a lost ACK and is accepted again.
+    //
+    // With a clock set, epoch_ts must also lie within kFreshnessMs of
+    // it. Off by default: flat-sat GPS stubs do not run on wall time.
+    void set_clock(Clock now_ms) { _clock = now_ms; }
+    void clear_replay_state() { _replay.clear(); }
+
     // --- Bouncer Main Entry ---
-    bool process_packet(const uint8_t* buf, size_t len, uint8_t* out, size_t out_max) const;
+    bool process_packet(const uint8_t* buf, size_t len, uint8_t* out, size_t out_max);
+
+    // --- Batch Entry (burst during a pass) ---
+    // Runs up to kMaxBatch PacketB frames through the firewall in one
+    // call and writes one verdict per frame into `verdicts` (which must
+    // hold `count` entries). A bad frame never poisons its neighbours.
+    // Byte-identical frames inside the batch (LoRa retransmits of the
+    // same payment) are verified once; each copy after the first is a
+    // retransmit and becomes kReplay past kMaxRetransmits. Frames
+    // are admitted in order, so a later frame re-using an earlier one's
+    // epoch_ts is a kReplay.
+    // Returns the number of kAccepted frames; 0 if count > kMaxBatch.
+    size_t process_batch(const BouncerFrame* frames, size_t count,
+                         BouncerVerdict* verdicts);
 
     // --- Session Key Management ---
-    void set_session_key(const uint8_t* key, size_t len);
-    void clear_session_key();
+    // Session keys are looked up per sat_id in `store`, which must
+    // outlive the Bouncer; `now_ms` is the clock its TTLs were installed
+    // against. Either as nullptr returns to plaintext pass-through.
+    void set_session_store(security_context::SessionStore* store, uint64_t (*now_ms)()) {
+        _sessions      = (now_ms != nullptr) ? store : nullptr;
+        _session_clock = now_ms;
+    }
 };
 
-#endif // BOUNCER_H
\ No newline at end of file
+// Short log label for a verdict ("accepted", "bad-crc", …).
+const char* bouncer_verdict_name(BouncerVerdict v);
+
+#endif // BOUNCER_H
@@ -14,6 +14,7 @@
 #define EGRESS_JSON_H
 
 #include <cstddef>
+#include <cstdint>
 
 namespace egress {
 
@@ -36,10 +37,15 @@ static constexpr size_t EgressPacketCHexMaxLen = 240;
 // All string fields are NUL-terminated C strings with bounded capacity.
 // The scanner MUST write the NUL on every successful parse and MUST
 // refuse any input where a value would overflow its bucket.
+//
+// `seq` is the gateway's monotonically increasing receipt cursor, sent
+// only by GET /api/v1/egress/watch; 0 when the field is absent (the
+// plain /pending response).
 struct Record {
-    char payment_id[EgressPaymentIdMaxLen];
-    char settlement_tx_hash[EgressTxHashMaxLen];
-    char packet_c_hex[EgressPacketCHexMaxLen];
+    char     payment_id[EgressPaymentIdMaxLen];
+    char     settlement_tx_hash[EgressTxHashMaxLen];
+    char     packet_c_hex[EgressPacketCHexMaxLen];
+    uint64_t seq;
 };
 
 // Parses a bare JSON array of records from `body` (length `body_len`).
@@ -57,14 +63,112 @@ struct Record {
 //   - any required field (payment_id, settlement_tx_hash,
 //     packet_c_hex) absent from a record
 //   - any string value exceeds its bucket length
+//   - a `seq` present but not a plain unsigned integer
 //   - unterminated string literal
 //
 // The scanner is LINEAR in body_len and writes NO heap allocations.
+// `out` is filled in order as records complete; on a negative return
+// the entries already written are unspecified too.
 int parse_pending_response(const char* body,
                            size_t      body_len,
                            Record*     out,
                            size_t      max_records);
 
+// Records the bouncer asks for per /pending or /watch response. The
+// body is parsed as it streams in (PendingStreamParser), so this bounds
+// how long one response takes to handle, not memory. Gateways that
+// predate the `limit` query answer at most 10.
+static constexpr size_t EgressStreamPageMax = 256;
+
+// Push form of parse_pending_response() for a body that arrives in
+// pieces. Each record is handed to `on_record` as soon as its closing
+// brace is fed, so the caller can act on it while later bytes are
+// still in flight; memory use is this object, whatever the body size.
+// Same validation and fail-closed bucket bounds as the one-shot form,
+// which is a thin wrapper around this class.
+class PendingStreamParser {
+public:
+    // Return false to stop parsing (status() becomes kStopped). The
+    // record is only valid during the call.
+    using OnRecord = bool (*)(const Record& rec, void* user);
+
+    enum class Status : uint8_t {
+        kMore,    // array not closed yet — feed more
+        kDone,    // closing ']' seen; anything after it is ignored
+        kStopped, // on_record returned false
+        kError,   // malformed input; nothing further is parsed
+    };
+
+    PendingStreamParser(OnRecord on_record, void* user);
+
+    // Parses the next `len` bytes. Returns the status after them; once
+    // it is not kMore, further feeds are ignored.
+    Status feed(const char* data, size_t len);
+
+    Status status() const { return status_; }
+    size_t records() const { return records_; }
+
+private:
+    // Where the parser is in `[ {"key":value,...}, ... ]`.
+    enum class State : uint8_t {
+        kArrayOpen,   // expect '['
+        kFirstRecord, // expect '{' or ']'
+        kRecord,      // after ',' — expect '{'
+        kFirstKey,    // after '{' — expect '"'
+        kKey,         // after ',' inside a record — expect '"'
+        kKeyClose,    // inside a key — expect its closing '"'
+        kColon,       // expect ':'
+        kValue,       // after ':' — string, object/array, or a scalar up to ',' / '}'
+        kStringClose, // inside a value string — expect its closing '"'
+        kNested,      // inside an object/array value — track depth only
+        kAfterValue,  // expect ',' or '}'
+        kAfterRecord, // expect ',' or ']'
+    };
+    static constexpr size_t kKeyMax = 24; // longer than any key we match
+
+    void absorb(const char* s, size_t n); // bytes between structural chars
+    bool on_structural(char c, const char* gap, size_t gap_len);
+    bool end_scalar();
+    bool end_record();
+    void fail() { status_ = Status::kError; }
+
+    OnRecord on_record_;
+    void*    user_;
+    Status   status_;
+    State    state_;
+    size_t   records_;
+
+    // Structural index carry between blocks / feeds.
+    uint64_t in_string_;
+    uint64_t escape_carry_;
+
+    Record   rec_;
+    uint8_t  found_;   // fields seen in rec_
+    uint8_t  field_;   // key whose value is being parsed
+    size_t   depth_;   // kNested
+    char     key_[kKeyMax];
+    size_t   key_len_; // kKeyMax + 1 once too long to match any key
+    char*    out_;     // bucket the current string value fills, or NULL
+    size_t   out_cap_;
+    size_t   out_len_;
+    bool     escape_;  // previous value byte was a backslash
+    bool     scalar_seen_; // non-whitespace in the scalar so far
+    bool     scalar_bad_;  // `seq` scalar is not a plain uint64
+    bool     scalar_done_; // whitespace after the scalar's digits
+};
+
+// One (payment_id, settlement_tx_hash) pair for POST
+// /api/v1/egress/ack/batch. Points into a Record; not owned.
+struct AckItem {
+    const char* payment_id;
+    const char* settlement_tx_hash;
+};
+
+// Pulls the integers out of `"results":[a,b,...]` in a gateway batch
+// response (ingest/batch, egress/ack/batch). Returns the count parsed,
+// or -1 if the key/array is missing, malformed, or longer than `cap`.
+int parse_batch_results(const char* json, size_t len, int* out, size_t cap);
+
 } // namespace egress
 
 #endif // EGRESS_JSON_H
\ No newline at end of file
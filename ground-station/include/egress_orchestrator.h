@@ -23,9 +23,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 
 #include "egress_hex.h"
 #include "egress_json.h"
+#include "egress_poll_client.h"
+#include "http_pool.h"
 
 namespace egress {
 
@@ -36,27 +39,51 @@ namespace egress {
 // only ACKs successfully-transmitted records.
 using LoraTxFn = bool (*)(const uint8_t* data, size_t len, void* user);
 
-// Per-tick soft cap. Matches the gateway's GET /pending cap of 10,
-// so one tick drains at most 10 receipts. Keeping the cap local
-// (not shared with gateway/internal/api/handlers) because the
-// bouncer must be self-consistent even if the gateway's cap
-// changes — sanity backstop, not a coupling.
+// Page size of gateways that predate the `limit` query: they answer
+// at most 10 records whatever the bouncer asks for, so a page of
+// exactly 10 is also treated as "more may be waiting".
 constexpr size_t EgressMaxPerTick = 10;
 
+// A tick whose page came back full and fully ACKed fetches again at
+// once instead of waiting a poll interval per page. Bounded so a
+// gateway that keeps producing can't hold the caller's thread forever.
+constexpr size_t EgressMaxDrainRounds = 16;
+
+// watch() result: the gateway has no /watch route (404/405).
+constexpr int EgressWatchUnsupported = -2;
+
 // SNLP PacketC frame size — sourced from void_packets_snlp.h
 // (14 B header + 98 B body block = 112 B). Duplicated here as a
 // compile-time constant so the orchestrator can own its decode
 // buffer without pulling the full C++ packet headers in.
 constexpr size_t EgressPacketCSize = 112;
 
-// Template parameter `Client` must expose two methods with the
-// following signatures (duck-typed — no inheritance required):
+// Template parameter `Client` must expose these methods (duck-typed —
+// no inheritance required):
 //
-//   bool fetch_pending(uint8_t* body, size_t cap, size_t& len,
+//   bool fetch_pending(http_pool::BodySink sink, void* user,
+//                      int& status_code);
+//   bool watch_pending(uint64_t after, uint32_t wait_ms,
+//                      http_pool::BodySink sink, void* user,
 //                      int& status_code);
 //   bool ack_dispatched(const char* payment_id,
 //                       const char* settlement_tx_hash,
 //                       int& status_code);
+//   bool ack_dispatched_batch(const AckItem* items, size_t n,
+//                             int* results, int& status_code);
+//
+// The poll methods deliver the response body to `sink` in pieces as
+// it arrives; `status_code` must be set before the first call. The
+// orchestrator parses each piece with a PendingStreamParser and
+// transmits every record as soon as its object closes, so a long
+// backlog goes out while the rest of the page is still on the wire
+// and memory use does not depend on the page size.
+//
+// The batch form is preferred: one round trip per EgressAckBatchMax
+// records instead of one per record. A 404/405 on it means the gateway
+// predates the route; the orchestrator then switches to
+// ack_dispatched() for good. watch_pending is only needed by clients
+// driven through watch().
 //
 // Production plugs in `EgressPollClient`. Tests plug in a
 // MockHttpClient struct with matching methods.
@@ -66,77 +93,260 @@ public:
     EgressOrchestrator(Client&  client,
                        LoraTxFn tx_fn,
                        void*    tx_user)
-        : client_(client), tx_fn_(tx_fn), tx_user_(tx_user) {}
+        : client_(client), tx_fn_(tx_fn), tx_user_(tx_user),
+          cursor_(0), batch_ack_(true), stalled_(false) {}
 
     // Run ONE poll round:
-    //   1. fetch_pending
-    //   2. parse JSON array
-    //   3. for each record: hex-decode PacketC → LoRa TX → ACK
+    //   1. fetch_pending, streaming the body into the parser
+    //   2. for each record as it closes: hex-decode PacketC → LoRa TX
+    //   3. ACK what was transmitted, EgressAckBatchMax at a time
+    // and repeat while the page came back full and every record in it
+    // was ACKed (backlog deeper than one page), up to
+    // EgressMaxDrainRounds pages.
     // Returns:
     //   >= 0  — records dispatched AND acked this tick (may be less
     //           than the number parsed if TX/ACK failed for some)
-    //   < 0   — parse error / transport error on the GET (no records
-    //           were touched)
+    //   < 0   — parse error / transport error on the first GET before
+    //           any record was dispatched
+    // Records dispatched before a mid-page error are still ACKed.
     int tick() {
-        uint8_t body[RESPONSE_BUF_SIZE];
-        size_t  body_len    = 0;
-        int     status_code = 0;
-        if (!client_.fetch_pending(body, sizeof(body), body_len, status_code)) {
-            // Transport failure — caller's poll loop retries next tick.
-            return -1;
+        int total = 0;
+        for (size_t round = 0; round < EgressMaxDrainRounds; ++round) {
+            Page page(*this, false);
+            const bool ok = client_.fetch_pending(&on_body, &page, page.status) ||
+                            page.parser.status() == PendingStreamParser::Status::kStopped;
+            flush(page);
+            total += page.done;
+            if (ok && page.status != 200) {
+                // Non-OK status (503 if gateway not configured, etc.) — no
+                // records to dispatch, but also NOT a hard error that
+                // should propagate up.
+                return total;
+            }
+            if (!ok || !page.complete()) {
+                // Transport failure or malformed / truncated JSON — the
+                // caller's poll loop retries next tick.
+                return (round == 0 && page.dispatched == 0) ? -1 : total;
+            }
+            if (!page_full(page.parser.records()) ||
+                page.done < static_cast<int>(page.parser.records())) {
+                break;
+            }
         }
-        if (status_code != 200) {
-            // Non-OK status (503 if gateway not configured, etc.) — no
-            // records to dispatch, but also NOT a hard error that
-            // should propagate up.
-            return 0;
+        return total;
+    }
+
+    // Long-poll round against GET /watch: asks for pending receipts
+    // past the cursor, letting the gateway hold the request up to
+    // `wait_ms` until one is written, then TX + batch-ACK as tick()
+    // does. The cursor moves past everything handled, so records
+    // already sent are never offered again; a record whose TX or ACK
+    // round trip failed rewinds it so the gateway re-offers that one.
+    // A full page comes back immediately on the next call, so a
+    // backlog drains back to back.
+    // Returns:
+    //   >= 0  — records dispatched AND acked
+    //   EgressWatchUnsupported — gateway has no /watch; use tick()
+    //   < 0   — transport / HTTP / parse error; records handled before
+    //           it are still ACKed and the cursor moves past them
+    // After an error, or when watch_stalled(), wait a poll interval
+    // before calling again — the gateway would answer at once.
+    int watch(uint32_t wait_ms) {
+        Page page(*this, true);
+        stalled_ = false;
+        const bool ok = client_.watch_pending(cursor_, wait_ms, &on_body, &page, page.status) ||
+                        page.parser.status() == PendingStreamParser::Status::kStopped;
+        flush(page);
+        if (page.newest > cursor_) cursor_ = page.newest;
+        if (page.retry != 0) {
+            cursor_  = page.retry - 1;
+            stalled_ = true;
+        }
+        if (page.status == 404 || page.status == 405) return EgressWatchUnsupported;
+        if (!ok || page.status != 200 || page.bad_cursor || !page.complete()) {
+            return -1;
         }
+        return page.done;
+    }
+
+    // Highest receipt cursor handled by watch(); 0 before the first.
+    uint64_t cursor() const { return cursor_; }
+    // The last watch() left a record to retry (TX or ACK failed).
+    bool watch_stalled() const { return stalled_; }
+
+    // False once the gateway has answered 404/405 to a batch ACK.
+    bool batch_ack_enabled() const { return batch_ack_; }
+
+private:
+    // What an ACK needs of a transmitted record; the parser's Record is
+    // only valid during its callback.
+    struct Sent {
+        char     payment_id[EgressPaymentIdMaxLen];
+        char     settlement_tx_hash[EgressTxHashMaxLen];
+        uint64_t seq;
+    };
+
+    // State of one /pending or /watch response while it streams in.
+    struct Page {
+        Page(EgressOrchestrator& o, bool watch_mode)
+            : self(o), parser(&on_record, this), status(0), watch(watch_mode),
+              bad_cursor(false), newest(0), retry(0), n_sent(0), dispatched(0), done(0) {}
 
-        Record recs[EgressMaxPerTick];
-        const int parsed = parse_pending_response(
-            reinterpret_cast<const char*>(body),
-            body_len,
-            recs,
-            EgressMaxPerTick);
-        if (parsed < 0) {
-            return -1; // malformed JSON; bail so a transient
-                       // corruption doesn't stick
+        // The whole array was parsed (or the page cap was reached).
+        bool complete() const {
+            return parser.status() == PendingStreamParser::Status::kDone ||
+                   parser.status() == PendingStreamParser::Status::kStopped;
         }
 
-        int dispatched_and_acked = 0;
-        for (int i = 0; i < parsed; ++i) {
-            const Record& r = recs[i];
-
-            uint8_t frame[EgressPacketCSize];
-            const char* hex    = r.packet_c_hex;
-            size_t      hexlen = 0;
-            while (hex[hexlen] != '\0' && hexlen < EgressPacketCHexMaxLen) {
-                ++hexlen;
-            }
-            if (hexlen != EgressPacketCSize * 2u) {
-                std::printf("[EGRESS] skip %s: hex len %zu != %zu\n",
-                            r.payment_id, hexlen, EgressPacketCSize * 2u);
-                continue;
-            }
-            if (!hex_decode(hex, hexlen, frame, sizeof(frame))) {
-                std::printf("[EGRESS] skip %s: hex decode failed\n",
-                            r.payment_id);
-                continue;
+        EgressOrchestrator& self;
+        PendingStreamParser parser;
+        int                 status;
+        bool                watch;      // records must carry seq > cursor_
+        bool                bad_cursor; // watch: a record at or below the cursor
+        uint64_t            newest;     // watch: highest seq handled
+        uint64_t            retry;      // lowest seq whose TX or ACK failed (0 = none)
+        Sent                sent[EgressAckBatchMax];
+        size_t              n_sent;     // transmitted, ACK not yet sent
+        size_t              dispatched; // transmitted in total
+        int                 done;       // transmitted and ACKed
+    };
+
+    // More may be waiting behind a page of this size.
+    static bool page_full(size_t parsed) {
+        return parsed == EgressStreamPageMax || parsed == EgressMaxPerTick;
+    }
+
+    // http_pool::BodySink. Error bodies are read and dropped so the
+    // connection stays usable; a parse error or a full page stops the
+    // read (the pool then closes the connection).
+    static bool on_body(const uint8_t* data, size_t len, void* user) {
+        Page& page = *static_cast<Page*>(user);
+        if (page.status != 200) return true;
+        const PendingStreamParser::Status st =
+            page.parser.feed(reinterpret_cast<const char*>(data), len);
+        return st == PendingStreamParser::Status::kMore ||
+               st == PendingStreamParser::Status::kDone;
+    }
+
+    // PendingStreamParser::OnRecord — runs while the body is still
+    // arriving.
+    static bool on_record(const Record& r, void* user) {
+        Page& page = *static_cast<Page*>(user);
+        if (page.watch) {
+            if (r.seq <= page.self.cursor_) {
+                std::printf("[EGRESS] watch: record %s has cursor %llu <= %llu\n",
+                            r.payment_id,
+                            static_cast<unsigned long long>(r.seq),
+                            static_cast<unsigned long long>(page.self.cursor_));
+                page.bad_cursor = true;
+                return false;
             }
+            if (r.seq > page.newest) page.newest = r.seq;
+        }
+        page.self.transmit(page, r);
+        return page.parser.records() < EgressStreamPageMax;
+    }
 
-            if (tx_fn_ == nullptr ||
-                !tx_fn_(frame, sizeof(frame), tx_user_)) {
-                std::printf("[EGRESS] TX failed for %s (tx=%s); no ACK\n",
-                            r.payment_id, r.settlement_tx_hash);
-                continue;
+    // Lowers `retry` to `seq` — the oldest record the gateway should
+    // offer again. Records without a cursor (seq 0) don't take part.
+    static void note_retry(uint64_t& retry, uint64_t seq) {
+        if (seq != 0 && (retry == 0 || seq < retry)) retry = seq;
+    }
+
+    // TX one record; queue it for ACK if it went out.
+    void transmit(Page& page, const Record& r) {
+        uint8_t frame[EgressPacketCSize];
+        const char* hex    = r.packet_c_hex;
+        size_t      hexlen = 0;
+        while (hex[hexlen] != '\0' && hexlen < EgressPacketCHexMaxLen) {
+            ++hexlen;
+        }
+        if (hexlen != EgressPacketCSize * 2u) {
+            std::printf("[EGRESS] skip %s: hex len %zu != %zu\n",
+                        r.payment_id, hexlen, EgressPacketCSize * 2u);
+            return;
+        }
+        if (!hex_decode(hex, hexlen, frame, sizeof(frame))) {
+            std::printf("[EGRESS] skip %s: hex decode failed\n",
+                        r.payment_id);
+            return;
+        }
+
+        if (tx_fn_ == nullptr ||
+            !tx_fn_(frame, sizeof(frame), tx_user_)) {
+            std::printf("[EGRESS] TX failed for %s (tx=%s); no ACK\n",
+                        r.payment_id, r.settlement_tx_hash);
+            note_retry(page.retry, r.seq);
+            return;
+        }
+        Sent& s = page.sent[page.n_sent++];
+        std::memcpy(s.payment_id, r.payment_id, sizeof(s.payment_id));
+        std::memcpy(s.settlement_tx_hash, r.settlement_tx_hash, sizeof(s.settlement_tx_hash));
+        s.seq = r.seq;
+        ++page.dispatched;
+        if (page.n_sent == EgressAckBatchMax) flush(page);
+    }
+
+    // ACK everything transmitted since the last flush.
+    void flush(Page& page) {
+        if (page.n_sent == 0) return;
+        int acked = -1;
+        if (batch_ack_) acked = ack_batch(page.sent, page.n_sent, page.retry);
+        if (acked < 0) acked = ack_each(page.sent, page.n_sent, page.retry);
+        page.done  += acked;
+        page.n_sent = 0;
+    }
+
+    // One POST for every transmitted record. Returns how many count as
+    // done, or -1 if the gateway has no batch route (fall back to
+    // per-record ACKs). Per-record semantics match ack_each().
+    int ack_batch(const Sent* sent, size_t n, uint64_t& retry) {
+        AckItem items[EgressAckBatchMax] = {};
+        int     results[EgressAckBatchMax];
+        for (size_t i = 0; i < n; ++i) {
+            items[i].payment_id         = sent[i].payment_id;
+            items[i].settlement_tx_hash = sent[i].settlement_tx_hash;
+        }
+
+        int code = 0;
+        if (!client_.ack_dispatched_batch(items, n, results, code)) {
+            std::printf("[EGRESS] batch ACK transport failed for %zu records — retry next tick\n",
+                        n);
+            for (size_t i = 0; i < n; ++i) note_retry(retry, sent[i].seq);
+            return 0;
+        }
+        if (code == 404 || code == 405) {
+            std::printf("[EGRESS] gateway has no batch ACK route (%d); using per-record ACKs\n",
+                        code);
+            batch_ack_ = false;
+            return -1;
+        }
+        if (code != 200) {
+            std::printf("[EGRESS] batch ACK %d for %zu records; dropping locally\n",
+                        code, n);
+            return static_cast<int>(n); // gateway is authoritative; we're done
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (results[i] != 200) {
+                std::printf("[EGRESS] ACK %d for %s; dropping locally\n",
+                            results[i], sent[i].payment_id);
             }
+        }
+        return static_cast<int>(n);
+    }
 
+    // One POST per record — gateways without /ack/batch.
+    int ack_each(const Sent* sent, size_t n, uint64_t& retry) {
+        int dispatched_and_acked = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const Sent& r = sent[i];
             int ack_code = 0;
             const bool ack_ok = client_.ack_dispatched(
                 r.payment_id, r.settlement_tx_hash, ack_code);
             if (!ack_ok) {
                 std::printf("[EGRESS] ACK transport failed for %s — retry next tick\n",
                             r.payment_id);
+                note_retry(retry, r.seq);
                 continue;
             }
             if (ack_code != 200) {
@@ -150,13 +360,12 @@ public:
         return dispatched_and_acked;
     }
 
-private:
-    // Response buffer size — 10 records × ~500 B each + headroom.
-    static constexpr size_t RESPONSE_BUF_SIZE = 8192;
-
     Client&  client_;
     LoraTxFn tx_fn_;
     void*    tx_user_;
+    uint64_t cursor_;    // watch(): receipts up to here have been handled
+    bool     batch_ack_;
+    bool     stalled_;
 };
 
 } // namespace egress
@@ -6,8 +6,8 @@
  * Status:    Authenticated Clean Room Spec
  * File:      egress_poll_client.h
  * Desc:      VOID-138 HTTP poll client. Raw-socket GET/POST against the
- *            gateway's /api/v1/egress/pending + /api/v1/egress/ack
- *            endpoints (VOID-135b contract, pinned by the 27 Go tests
+ *            gateway's /api/v1/egress/pending (+ /watch) and
+ *            /api/v1/egress/ack (+ /ack/batch) endpoints (VOID-135b contract, pinned by the 27 Go tests
  *            in PR #17).
  * Compliant: NSA Clean C++ / SEI CERT
  * -------------------------------------------------------------------------*/
@@ -18,17 +18,34 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "egress_json.h"
+#include "http_pool.h"
+
 namespace egress {
 
+// Most records one POST /api/v1/egress/ack/batch carries. The
+// orchestrator flushes a batch each time this many records have gone
+// out, so a long page is ACKed while it is still streaming in; the
+// gateway enforces its own, larger, limit.
+constexpr size_t EgressAckBatchMax = 16;
+
+// Longest a GET /api/v1/egress/watch is asked to stay open. The pool
+// gives up on a silent connection after kRecvTimeoutMs, so the gateway
+// must answer (records or an empty array) comfortably before that; the
+// caller simply re-issues on the warm connection.
+constexpr uint32_t EgressWatchMaxWaitMs = 4000;
+static_assert(EgressWatchMaxWaitMs + 1000 <= http_pool::ConnectionPool::kRecvTimeoutMs,
+              "long-poll must return before the pool's receive timeout");
+
 // EgressPollClient is the bouncer's half of the VOID-135 egress
 // channel. One instance per gateway target; stateless, safe to
 // re-use across many polls.
 //
-// Each call opens a fresh TCP connection, sends an HTTP/1.1 request
-// with Connection: close, reads the response into a caller-provided
-// buffer, and closes. No keep-alive state; matches the existing
-// GatewayClient pattern in gateway_client.cpp so the two clients can
-// share the same networking model.
+// Requests go over an http_pool::ConnectionPool: keep-alive HTTP/1.1
+// connections reused across polls and ACKs, reconnected transparently
+// if the gateway dropped them. main() hands the same pool to
+// GatewayClient so ingest, poll and ACK share warm connections; the
+// (host, port) constructor keeps a private pool.
 //
 // Transport failures (connect refused, send error, timeout) return
 // false and leave the out-params untouched. HTTP-level failures
@@ -41,23 +58,41 @@ namespace egress {
 class EgressPollClient {
 public:
     EgressPollClient(const char* host, uint16_t port);
+    explicit EgressPollClient(http_pool::ConnectionPool& shared);
 
-    // GET /api/v1/egress/pending. Writes the raw response body into
-    // `body` (no NUL termination; caller reads `body_len` bytes). If
-    // the advertised Content-Length exceeds `body_cap`, returns false
-    // WITHOUT writing to `body` — the bouncer must not silently
-    // truncate the dispatch queue.
+    EgressPollClient(const EgressPollClient&)            = delete;
+    EgressPollClient& operator=(const EgressPollClient&) = delete;
+
+    // GET /api/v1/egress/pending?limit=EgressStreamPageMax. The
+    // response body is handed to `sink` as it arrives (see
+    // http_pool::ConnectionPool::round_trip_stream) — typically straight
+    // into a PendingStreamParser — so there is no size limit and no
+    // body buffer. `status_code` is set before the first sink call;
+    // the sink sees error bodies too and should check it.
     //
     // Returns:
     //   true  — HTTP round-trip completed; `status_code` set to the
     //           numeric status (200 on success, 503 if gateway store
     //           isn't wired, etc.)
-    //   false — transport failure (connect refused, read error,
-    //           body larger than buffer)
-    bool fetch_pending(uint8_t* body,
-                       size_t   body_cap,
-                       size_t&  body_len,
-                       int&     status_code);
+    //   false — transport failure (connect refused, read error), or
+    //           the sink returned false
+    bool fetch_pending(http_pool::BodySink sink,
+                       void*               user,
+                       int&                status_code);
+
+    // GET /api/v1/egress/watch?after=<after>&wait_ms=<wait_ms>&limit=..
+    // Long-poll form of fetch_pending: the gateway answers as soon as a
+    // pending receipt with a cursor above `after` exists, or with an
+    // empty array once `wait_ms` (clamped to EgressWatchMaxWaitMs)
+    // passes. Records carry their cursor in Record::seq, oldest first.
+    //
+    // Same return contract as fetch_pending. A 404 means the gateway
+    // predates the route — fall back to fetch_pending on an interval.
+    bool watch_pending(uint64_t            after,
+                       uint32_t            wait_ms,
+                       http_pool::BodySink sink,
+                       void*               user,
+                       int&                status_code);
 
     // POST /api/v1/egress/ack with body
     //   {"payment_id":"<payment_id>","settlement_tx_hash":"<tx>"}
@@ -77,9 +112,31 @@ public:
                         const char* settlement_tx_hash,
                         int&        status_code);
 
+    // POST /api/v1/egress/ack/batch with body
+    //   [{"payment_id":"..","settlement_tx_hash":".."},...]
+    //
+    // One round trip for up to EgressAckBatchMax records; same trust
+    // assumption on the strings as ack_dispatched(). On a 200 the
+    // gateway answers {"results":[...]} with one status per item, in
+    // order, using the single-ACK codes (200, 400, 404, 500); those
+    // are written to `results[0..n)`.
+    //
+    // Returns:
+    //   true  — HTTP round-trip completed; `status_code` set. `results`
+    //           is only filled when it is 200. 404/405 mean the gateway
+    //           predates the batch route.
+    //   false — transport failure, n out of range, or a 200 whose
+    //           results array doesn't have exactly `n` entries
+    bool ack_dispatched_batch(const AckItem* items,
+                              size_t         n,
+                              int*           results,
+                              int&           status_code);
+
+    http_pool::Stats pool_stats() const { return pool_.stats(); }
+
 private:
-    const char* host_;
-    uint16_t    port_;
+    http_pool::ConnectionPool  own_pool_; // unused when constructed on a shared pool
+    http_pool::ConnectionPool& pool_;
 };
 
 } // namespace egress
@@ -0,0 +1,181 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      frame_spool.h
+ * Desc:      Crash-safe, append-only, memory-mapped spool of accepted
+ *            frames awaiting gateway delivery.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * On disk (one directory):
+ *
+ *   spool-<base_seq:016x>.seg   fixed-size segments, preallocated and
+ *                               mmap'd; records appended back to back
+ *   spool.ack                   delivery watermark, two CRC'd slots
+ *                               written alternately
+ *
+ * Segment:  [SegmentHeader, padded to 64] [record]...
+ * Record:   [RecordHeader 24 B][frame][pad to 8]
+ *
+ * Host byte order: the spool is local state, never shipped.
+ *
+ * Every record carries its sequence number and a CRC over header and
+ * frame, so recovery scans each segment until the first record that
+ * doesn't check out — a torn tail from a crash mid-append is simply
+ * where the log ends. Sequence numbers start at 1 and are contiguous.
+ *
+ * Threading: one producer (append) and one consumer (everything
+ * else). append() never syncs; the consumer makes appended records
+ * durable in groups with sync(), so the ingest path never waits on
+ * the disk. The segment table is shared under a mutex that the
+ * producer takes only when it rolls to a new segment.
+ *
+ * A segment is deleted once every record in it is at or below the
+ * committed watermark and it is not the one being appended to.
+ * -------------------------------------------------------------------------*/
+
+#ifndef FRAME_SPOOL_H
+#define FRAME_SPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace spool {
+
+constexpr size_t kSegmentBytes     = 1u << 20; // 1 MiB ≈ 4.7k PacketBs
+constexpr size_t kMaxSegments      = 64;       // spool cap: 64 MiB
+constexpr size_t kSegmentHeaderLen = 64;
+constexpr size_t kRecordHeaderLen  = 24;
+constexpr size_t kMaxRecord        = 1024;     // largest frame accepted
+constexpr size_t kPathMax          = 256;
+constexpr size_t kDirMax           = kPathMax - 32; // room for the file name
+
+// One spooled frame. `data` points into the mapping and stays valid
+// until the consumer's next commit().
+struct Record {
+    uint64_t       seq;
+    uint32_t       tag;
+    uint16_t       len;
+    const uint8_t* data;
+};
+
+struct Stats {
+    uint64_t appended;        // records written this run
+    uint64_t append_failures; // oversize, spool full or I/O error
+    uint64_t syncs;           // group msyncs that flushed something
+    uint64_t synced_records;  // records made durable by those syncs
+    uint64_t recovered;       // unacked records found by open()
+    uint64_t compacted;       // segments deleted after delivery
+    uint64_t acked;           // committed watermark
+    uint64_t head;            // next sequence number to be assigned
+    size_t   segments;        // live segment files
+};
+
+class FrameSpool {
+public:
+    FrameSpool();
+    ~FrameSpool();
+
+    FrameSpool(const FrameSpool&)            = delete;
+    FrameSpool& operator=(const FrameSpool&) = delete;
+
+    // Creates `dir` if needed, then recovers: loads the watermark,
+    // maps every segment, finds the end of the log and deletes
+    // segments that are fully delivered. The read cursor starts at the
+    // first unacked record.
+    bool open(const char* dir);
+    // Syncs and commits, then unmaps everything.
+    void close();
+    bool is_open() const { return _open; }
+
+    // --- Producer ---
+
+    // Appends one frame. Returns its sequence number, or 0 if it was
+    // not spooled (oversize, spool full, disk error). Never syncs.
+    uint64_t append(const uint8_t* frame, size_t len, uint32_t tag);
+
+    // --- Consumer ---
+
+    // Next unread record in sequence order; false when caught up or
+    // the next record's sequence number is not below `below`.
+    bool next(Record& out, uint64_t below = UINT64_MAX);
+    // Moves the read cursor so next() returns `seq` (clamped to the
+    // oldest retained record; at or past the head it waits for it).
+    void seek(uint64_t seq);
+    // Records appended but not yet returned by next().
+    uint64_t unread() const;
+
+    // Group commit: msyncs everything appended since the last call.
+    bool sync();
+
+    // Marks every record up to `seq` delivered (in memory).
+    void ack(uint64_t seq);
+    // Persists the watermark if it moved and deletes fully delivered
+    // segments.
+    bool commit();
+
+    uint64_t head() const { return _head.load(std::memory_order_acquire); }
+    uint64_t acked() const { return _acked; }
+    Stats    stats() const;
+
+private:
+    struct Segment {
+        uint64_t            base_seq;
+        int                 fd;
+        uint8_t*            map;
+        std::atomic<size_t> used;   // bytes of published records (+ header)
+        size_t              synced; // consumer: bytes known durable
+        bool                meta_synced;
+    };
+
+    Segment*       seg_at(size_t i) { return &_segs[(_first + i) % kMaxSegments]; }
+    Segment*       find_segment(uint64_t seq); // under _mu
+    bool           roll();                     // producer; takes _mu
+    bool           map_segment(Segment& s, uint64_t base_seq, bool create);
+    void           unmap_segment(Segment& s, bool remove_file);
+    size_t         scan_segment(Segment& s, uint64_t& next_seq) const;
+    bool           record_at(const Segment& s, size_t off, size_t limit, Record& out,
+                             size_t& rec_len) const;
+    void           segment_path(uint64_t base_seq, char* out) const;
+    bool           load_watermark();
+    bool           store_watermark(uint64_t seq);
+    void           sync_dir();
+
+    char    _dir[kDirMax];
+    bool    _open;
+    int     _ack_fd;
+    uint32_t _ack_gen;
+
+    mutable std::mutex _mu;            // guards the segment table
+    Segment            _segs[kMaxSegments];
+    size_t             _first;
+    size_t             _count;
+
+    // Producer state.
+    Segment*              _tail;       // segment being appended to
+    uint64_t              _next_seq;   // producer's next sequence number
+    std::atomic<uint64_t> _head;       // published: records < head are readable
+
+    // Consumer state.
+    uint64_t _cursor_seq;
+    uint64_t _cursor_base;             // segment the cursor is in
+    size_t   _cursor_off;
+    uint64_t _acked;                   // in-memory watermark
+    uint64_t _committed;               // on-disk watermark
+    uint64_t _synced_head;             // records < this are durable
+
+    std::atomic<uint64_t> _appended;
+    std::atomic<uint64_t> _append_failures;
+    uint64_t              _syncs;
+    uint64_t              _synced_records;
+    uint64_t              _recovered;
+    uint64_t              _compacted;
+};
+
+} // namespace spool
+
+#endif // FRAME_SPOOL_H
@@ -12,11 +12,12 @@
 #include <cstdint>
 #include <cstddef>
 #include "../../void-core/include/void_packets.h"
+#include "http_pool.h"
 
 class GatewayClient {
 private:
-    const char* _host;
-    int _port;
+    http_pool::ConnectionPool  _own_pool; // unused when constructed on a shared pool
+    http_pool::ConnectionPool& _pool;
     char _json_buffer[256]; // Static buffer for JSON payload
 
     // Formats the raw 62-byte InnerInvoice into a JSON string safely
@@ -24,12 +25,28 @@ private:
 
 public:
     GatewayClient(const char* host, int port);
+    // Shares keep-alive connections with the egress poll client.
+    explicit GatewayClient(http_pool::ConnectionPool& shared);
+
+    GatewayClient(const GatewayClient&)            = delete;
+    GatewayClient& operator=(const GatewayClient&) = delete;
 
     // POSTs the raw on-wire VOID frame to the Go gateway's
     // /api/v1/ingest endpoint as application/octet-stream. The gateway
     // hands the bytes straight to its kaitai parser; do not pre-strip
     // or JSON-encode (format_json above is a debug helper only).
+    // True only if the gateway answered 2xx.
     bool push_to_l2(const uint8_t* frame_bytes, size_t frame_len);
+
+    // POSTs an ingest_batcher.h body ({len:u16_le | frame} × frames) to
+    // /api/v1/ingest/batch. True when the HTTP round trip completed;
+    // on a 200, `results[0..frames)` holds each frame's status. A 200
+    // whose results array doesn't match `frames` is a protocol error
+    // (false).
+    bool push_batch(const uint8_t* body, size_t body_len, size_t frames,
+                    int* results, int& status_code);
+
+    http_pool::Stats pool_stats() const { return _pool.stats(); }
 };
 
 #endif // GATEWAY_CLIENT_H
\ No newline at end of file
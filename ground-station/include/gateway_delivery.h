@@ -0,0 +1,357 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      gateway_delivery.h
+ * Desc:      Dedicated gateway-delivery thread fed by a lock-free SPSC
+ *            ring and, when attached, a durable frame spool — radio
+ *            ingest never waits on HTTP or on the disk.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * The reactor thread (producer) verifies, ACKs and submit()s each
+ * accepted frame and goes back to reading. The delivery thread
+ * (consumer) owns the IngestBatcher and every gateway round trip, so a
+ * slow or down gateway backs frames up instead of stalling the serial
+ * reader.
+ *
+ * With a spool attached (frame_spool.h), submit() appends the frame
+ * there and the consumer reads the spool in sequence order. Before a
+ * pass sends anything it msyncs everything appended so far: one group
+ * sync per pass, never one per frame, and never on the ingest thread.
+ * Frames the gateway accepts or permanently rejects (4xx) advance the
+ * spool watermark; a transport failure or 5xx stops the pass, backs
+ * off and replays from the watermark. Delivery is at-least-once: after
+ * a partially failed batch, frames behind the failed one are re-sent.
+ * Frames left over at shutdown or after a crash are replayed on the
+ * next start.
+ *
+ * The ring carries frames the spool could not take (no spool, spool
+ * full, disk error). When it is full the newest frame goes to the
+ * spill hook if one is installed, otherwise it is dropped; both are
+ * counted. The producer never blocks.
+ *
+ * The consumer sleeps on a condition variable when idle. The producer
+ * touches the mutex only when the consumer is parked, so the fast path
+ * stays lock-free.
+ * -------------------------------------------------------------------------*/
+
+#ifndef GATEWAY_DELIVERY_H
+#define GATEWAY_DELIVERY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "frame_spool.h"
+#include "ingest_batcher.h"
+#include "reactor.h"
+#include "spsc_ring.h"
+
+namespace ingest {
+
+constexpr size_t   kDeliveryRingSlots  = 64;    // power of two
+constexpr size_t   kDeliveryMaxFrame   = 256;   // largest PacketB is 192
+constexpr uint32_t kDeliveryIdleWaitMs = 250;   // parked wake-up bound
+constexpr uint32_t kRetryMinMs         = 500;   // first replay delay
+constexpr uint32_t kRetryMaxMs         = 30000; // backoff ceiling
+
+struct FrameSlot {
+    uint64_t enqueued_ms;
+    uint32_t tag;
+    uint16_t len;
+    uint8_t  bytes[kDeliveryMaxFrame];
+};
+
+// Full-ring hook: called on the producer thread with the frame that did
+// not fit. Return true if it was kept.
+using SpillFn = bool (*)(const uint8_t* frame, size_t len, uint32_t tag, void* user);
+
+enum class Submit { kQueued, kSpilled, kDropped };
+
+struct DeliveryStats {
+    uint64_t submitted;   // frames offered to submit()
+    uint64_t spooled;     // ... appended to the spool
+    uint64_t delivered;   // frames handed to the batcher (replays included)
+    uint64_t retries;     // delivery failures that triggered a replay
+    uint64_t full;        // submit() found the ring full (backpressure)
+    uint64_t spilled;     // ... and the spill hook kept the frame
+    uint64_t dropped;     // lost: ring full with no spill, or oversize
+    uint64_t high_water;  // deepest ring occupancy seen
+    uint64_t max_wait_ms; // longest ring residency of a frame
+};
+
+template <typename Client>
+class GatewayDelivery {
+public:
+    // `on_result` gets every per-frame verdict on the delivery thread,
+    // replays included; `tag` is what was passed to submit().
+    GatewayDelivery(Client& client, const BatchPolicy& policy, ResultFn on_result, void* user,
+                    SpillFn spill = nullptr, void* spill_user = nullptr)
+        : batcher_(client, policy, &GatewayDelivery::on_batch_result, this),
+          on_result_(on_result), user_(user), spill_(spill), spill_user_(spill_user),
+          spool_(nullptr), inflight_next_(0), failed_(false), retry_at_ms_(0),
+          backoff_ms_(kRetryMinMs), running_(false), stop_(false), parked_(false),
+          submitted_(0), spooled_(0), delivered_(0), retries_(0), full_(0), spilled_(0),
+          dropped_(0), high_water_(0), max_wait_ms_(0) {}
+
+    ~GatewayDelivery() { stop(); }
+
+    GatewayDelivery(const GatewayDelivery&)            = delete;
+    GatewayDelivery& operator=(const GatewayDelivery&) = delete;
+
+    // Configuration — before start() only.
+    void set_policy(const BatchPolicy& policy) { batcher_.set_policy(policy); }
+    // `s` must be open and outlive stop(). Unacked frames already in it
+    // are replayed first.
+    void attach_spool(spool::FrameSpool* s) { spool_ = s; }
+
+    void start() {
+        if (running_) return;
+        stop_.store(false);
+        running_ = true;
+        worker_  = std::thread([this]() { run(); });
+    }
+
+    // Delivers what it can, flushes the batcher and joins. With a spool
+    // and an unreachable gateway it does not wait: the frames stay
+    // spooled for the next start. Call from the producer thread once it
+    // has stopped submitting.
+    void stop() {
+        if (!running_) return;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stop_.store(true);
+        }
+        cv_.notify_one();
+        worker_.join();
+        running_ = false;
+    }
+
+    // Producer side. Never blocks, never syncs.
+    Submit submit(const uint8_t* frame, size_t len, uint32_t tag) {
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        if (frame == nullptr || len == 0) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return Submit::kDropped;
+        }
+        if (spool_ != nullptr && spool_->append(frame, len, tag) != 0) {
+            spooled_.fetch_add(1, std::memory_order_relaxed);
+            wake();
+            return Submit::kQueued;
+        }
+        if (len > kDeliveryMaxFrame) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return Submit::kDropped;
+        }
+        FrameSlot* slot = ring_.claim();
+        if (slot == nullptr) {
+            full_.fetch_add(1, std::memory_order_relaxed);
+            if (spill_ != nullptr && spill_(frame, len, tag, spill_user_)) {
+                spilled_.fetch_add(1, std::memory_order_relaxed);
+                return Submit::kSpilled;
+            }
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return Submit::kDropped;
+        }
+        slot->enqueued_ms = reactor::now_ms();
+        slot->tag         = tag;
+        slot->len         = static_cast<uint16_t>(len);
+        std::memcpy(slot->bytes, frame, len);
+        ring_.publish();
+
+        const uint64_t depth = ring_.size();
+        if (depth > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(depth, std::memory_order_relaxed); // single writer
+        }
+        wake();
+        return Submit::kQueued;
+    }
+
+    size_t queued() const { return ring_.size(); }
+    bool   running() const { return running_; }
+    // Batcher counters; read after stop().
+    BatchStats batch_stats() const { return batcher_.stats(); }
+
+    DeliveryStats stats() const {
+        DeliveryStats s;
+        s.submitted   = submitted_.load(std::memory_order_relaxed);
+        s.spooled     = spooled_.load(std::memory_order_relaxed);
+        s.delivered   = delivered_.load(std::memory_order_relaxed);
+        s.retries     = retries_.load(std::memory_order_relaxed);
+        s.full        = full_.load(std::memory_order_relaxed);
+        s.spilled     = spilled_.load(std::memory_order_relaxed);
+        s.dropped     = dropped_.load(std::memory_order_relaxed);
+        s.high_water  = high_water_.load(std::memory_order_relaxed);
+        s.max_wait_ms = max_wait_ms_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    // Batcher tags index this table; a batch never holds more than
+    // kBatchMaxFrames, so slots are not reused while in flight.
+    static constexpr size_t kInflightSlots = 2 * kBatchMaxFrames;
+    struct Inflight {
+        uint64_t seq; // spool sequence number, 0 for ring frames
+        uint32_t tag;
+    };
+
+    // Pairs with the fence in park(): either the consumer sees the new
+    // frame before sleeping, or we see it parked and wake it.
+    void wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mu_);
+            cv_.notify_one();
+        }
+    }
+
+    void run() {
+        if (spool_ != nullptr) spool_->seek(spool_->acked() + 1);
+        for (;;) {
+            drain_ring();
+            if (spool_ != nullptr) pump_spool();
+            batcher_.poll(reactor::now_ms());
+            if (spool_ != nullptr) spool_->commit();
+            if (stop_.load() && ring_.empty() &&
+                (spool_ == nullptr || failed_ || spool_->unread() == 0)) {
+                break;
+            }
+            park();
+        }
+        batcher_.flush();
+        if (spool_ != nullptr) spool_->commit();
+    }
+
+    uint32_t track(uint64_t seq, uint32_t tag) {
+        const uint32_t idx = inflight_next_;
+        inflight_next_ = static_cast<uint32_t>((inflight_next_ + 1) % kInflightSlots);
+        inflight_[idx] = {seq, tag};
+        delivered_.fetch_add(1, std::memory_order_relaxed);
+        return idx;
+    }
+
+    // Ring → batcher. A batcher flush (HTTP) may run inside add(); the
+    // producer keeps filling the ring meanwhile.
+    void drain_ring() {
+        while (FrameSlot* slot = ring_.front()) {
+            const uint64_t now  = reactor::now_ms();
+            const uint64_t wait = now - slot->enqueued_ms;
+            if (wait > max_wait_ms_.load(std::memory_order_relaxed)) {
+                max_wait_ms_.store(wait, std::memory_order_relaxed);
+            }
+            batcher_.add(slot->bytes, slot->len, track(0, slot->tag), now);
+            ring_.release();
+        }
+    }
+
+    // Spool → batcher, in sequence order, durable records only.
+    void pump_spool() {
+        const uint64_t appended = spool_->head();
+        spool_->sync(); // the group commit; a failed sync still delivers
+
+        const uint64_t now = reactor::now_ms();
+        if (failed_) {
+            if (now < retry_at_ms_ || batcher_.pending() > 0) return;
+            failed_ = false;
+            spool_->seek(spool_->acked() + 1);
+        }
+        spool::Record r;
+        while (!failed_ && spool_->next(r, appended)) {
+            batcher_.add(r.data, r.len, track(r.seq, r.tag), now);
+        }
+    }
+
+    static bool transient(int status) { return status == 0 || status == 429 || status >= 500; }
+
+    static void on_batch_result(uint32_t idx, int status, void* self) {
+        static_cast<GatewayDelivery*>(self)->settle(idx, status);
+    }
+
+    void settle(uint32_t idx, int status) {
+        const Inflight e = inflight_[idx % kInflightSlots];
+        if (on_result_ != nullptr) on_result_(e.tag, status, user_);
+        if (e.seq == 0 || spool_ == nullptr || failed_) return;
+        if (transient(status)) {
+            // Everything from e.seq on is replayed after the backoff.
+            failed_      = true;
+            retry_at_ms_ = reactor::now_ms() + backoff_ms_;
+            backoff_ms_  = (backoff_ms_ >= kRetryMaxMs / 2) ? kRetryMaxMs : backoff_ms_ * 2;
+            retries_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        spool_->ack(e.seq);
+        backoff_ms_ = kRetryMinMs;
+    }
+
+    bool has_work() {
+        return !ring_.empty() || (spool_ != nullptr && !failed_ && spool_->unread() > 0);
+    }
+
+    // Sleeps until a frame arrives, the batch deadline or retry time
+    // passes, or stop().
+    void park() {
+        const uint64_t now     = reactor::now_ms();
+        uint64_t       wait_ms = kDeliveryIdleWaitMs;
+        uint64_t       due     = 0;
+        if (batcher_.deadline(due)) {
+            wait_ms = (due > now) ? due - now : 0;
+        }
+        if (failed_ && batcher_.pending() == 0) {
+            const uint64_t retry_in = (retry_at_ms_ > now) ? retry_at_ms_ - now : 0;
+            if (retry_in < wait_ms) wait_ms = retry_in;
+        }
+        if (wait_ms == 0) return;
+
+        std::unique_lock<std::mutex> lock(mu_);
+        parked_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!has_work() && !stop_.load()) {
+            cv_.wait_for(lock, std::chrono::milliseconds(wait_ms));
+        }
+        parked_.store(false, std::memory_order_relaxed);
+    }
+
+    IngestBatcher<Client> batcher_;
+    ResultFn              on_result_;
+    void*                 user_;
+    SpillFn               spill_;
+    void*                 spill_user_;
+    spool::FrameSpool*    spool_;
+
+    SpscRing<FrameSlot, kDeliveryRingSlots> ring_;
+
+    // Delivery-thread state.
+    Inflight inflight_[kInflightSlots];
+    uint32_t inflight_next_;
+    bool     failed_;      // a spooled frame failed; replay pending
+    uint64_t retry_at_ms_;
+    uint32_t backoff_ms_;
+
+    std::thread             worker_;
+    bool                    running_; // producer-thread only
+    std::atomic<bool>       stop_;
+    std::atomic<bool>       parked_;
+    std::mutex              mu_;
+    std::condition_variable cv_;
+
+    std::atomic<uint64_t> submitted_;
+    std::atomic<uint64_t> spooled_;
+    std::atomic<uint64_t> delivered_;
+    std::atomic<uint64_t> retries_;
+    std::atomic<uint64_t> full_;
+    std::atomic<uint64_t> spilled_;
+    std::atomic<uint64_t> dropped_;
+    std::atomic<uint64_t> high_water_;
+    std::atomic<uint64_t> max_wait_ms_;
+};
+
+} // namespace ingest
+
+#endif // GATEWAY_DELIVERY_H
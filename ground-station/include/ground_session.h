@@ -0,0 +1,391 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      ground_session.h
+ * Desc:      Per-satellite ground sessions (State Machine Spec §5):
+ *            VACANT → HANDSHAKE_PENDING → ACTIVE → CLOSING, plus the
+ *            BLACKLISTED cooldown, in a preallocated table keyed by
+ *            sat_id.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * The spec sizes the table at MAX_CONCURRENT_SESSIONS = 8 and scans it.
+ * With TinyGS-style fan-in many satellites are in view at once, so the
+ * slots here are an open-addressing hash on sat_id: a lookup is one or
+ * two 32-byte slots (two to a cache line), not a walk over every
+ * session. A slot returning to VACANT is deleted by backward shift, so
+ * there are no tombstones and probe chains stay short for the life of
+ * the process.
+ *
+ * Transitions come from a const [state][event] table (§9.3); anything
+ * the spec does not define is a reject that keeps the current state.
+ * Timeouts are deadlines stored in the slot and applied when the sat is
+ * next seen. For sats that have gone quiet, attach() a timing wheel:
+ * each session then keeps one wheel timer on its current deadline, so
+ * a quiet table costs nothing and an expiry is O(1). Without a wheel,
+ * or when it runs out of timers, expire() sweeps the slots instead.
+ * -------------------------------------------------------------------------*/
+
+#ifndef GROUND_SESSION_H
+#define GROUND_SESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "timing_wheel.h"
+
+namespace ground_session {
+
+enum class State : uint8_t {
+    kVacant           = 0x00,
+    kHandshakePending = 0x01,
+    kActive           = 0x02,
+    kClosing          = 0x03,
+    kBlacklisted      = 0xFE,
+};
+
+enum class Event : uint8_t {
+    kHandshakeInit = 0, // Packet H (Init) with a valid signature
+    kPacketB,           // PacketB that passed the Bouncer
+    kPacketBReplay,     // PacketB the Bouncer rejected as a replay
+    kPacketD,           // verified delivery receipt
+    kSigFail,           // Ed25519 verify failed for this sat_id
+    kViolation,         // other policy breach (e.g. asset not whitelisted)
+    kAckQueueEmpty,     // CLOSING: nothing left to uplink
+    kCount,
+};
+
+// What the caller should do with the packet that raised the event.
+enum class Action : uint8_t {
+    kReject = 0,    // not valid in this state: drop and log
+    kDrop,          // blacklisted: drop silently
+    kRespond,       // new handshake: send Packet H (Resp)
+    kRespondAgain,  // handshake retry: resend the response
+    kOpen,          // session established by this PacketB: settle + ACK
+    kSettle,        // PacketB in an active session: settle + ACK
+    kReceipt,       // PacketD accepted: close the escrow
+    kCountReplay,   // replay discarded and counted
+    kBlacklist,     // this event put the sat on the blacklist
+    kWipe,          // session over, slot freed
+    kExhausted,     // no slot left for a new session (SLOT_EXHAUSTION)
+};
+
+struct Policy {
+    uint32_t handshake_ms;      // HANDSHAKE_PENDING → VACANT
+    uint32_t session_ttl_ms;    // ACTIVE → CLOSING after this long without a valid packet
+    uint32_t closing_ms;        // CLOSING → VACANT
+    uint32_t cooldown_ms;       // BLACKLISTED → VACANT
+    uint8_t  replay_limit;      // replays per session before BLACKLISTED
+    bool     require_handshake; // false: a valid PacketB opens a session directly
+};
+
+// Spec §5.1 / §5.5 timings. The TTL counts from the last valid packet,
+// so a session lasts one contact window (AOS to LOS) however long that is.
+constexpr Policy kDefaultPolicy = {30000u, 600000u, 10000u, 300000u, 5u, true};
+
+// One session slot. 32 bytes: two per cache line.
+struct Session {
+    uint32_t sat_id;
+    State    state;
+    uint8_t  replays;      // replay attempts this session
+    uint16_t pad;
+    uint64_t deadline_ms;  // when the current state times out
+    uint64_t opened_ms;    // slot allocation time
+    uint32_t packets;      // PacketB/PacketD accepted this session
+    uint32_t timer;        // timing_wheel::Handle on deadline_ms, when attached
+};
+static_assert(sizeof(Session) == 32, "Session slot must stay half a cache line");
+
+// Dense 0..4 row index for a state (kBlacklisted is 0xFE on the wire).
+inline size_t state_index(State s) {
+    switch (s) {
+        case State::kVacant:           return 0;
+        case State::kHandshakePending: return 1;
+        case State::kActive:           return 2;
+        case State::kClosing:          return 3;
+        case State::kBlacklisted:      return 4;
+    }
+    return 0;
+}
+constexpr size_t kStateCount = 5;
+
+struct Transition {
+    State  next;
+    Action action;
+};
+
+// Spec transition for `event` in `state`. Pure; a table lookup.
+Transition step(State state, Event event, const Policy& policy);
+
+// Where `state` goes when its deadline passes.
+State timeout(State state);
+
+// Deadline length for a session entering `state`; 0 for kVacant.
+uint32_t state_timeout_ms(State state, const Policy& policy);
+
+struct Result {
+    State  from;
+    State  to;
+    Action action;
+};
+
+struct Stats {
+    size_t   capacity;     // most sessions the table will hold
+    size_t   occupied;     // non-VACANT slots
+    size_t   peak;         // high-water mark of `occupied`
+    size_t   handshake_pending;
+    size_t   active;
+    size_t   closing;
+    size_t   blacklisted;
+    uint64_t exhausted;    // new sessions refused for lack of a slot
+    uint64_t dropped;      // packets silently dropped from blacklisted sats
+    uint64_t blacklistings;
+};
+
+// N slots, at most 3/4 of them occupied so every probe ends on a free
+// slot within a few steps. Not thread-safe: the reactor thread owns it.
+template <size_t N>
+class SessionTable {
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "SessionTable capacity must be a power of two");
+
+public:
+    static constexpr size_t kSlots       = N;
+    static constexpr size_t kMaxSessions = N / 4 * 3;
+
+    explicit SessionTable(const Policy& policy = kDefaultPolicy)
+        : policy_(policy), wheel_(nullptr) {
+        clear();
+    }
+
+    SessionTable(const SessionTable&)            = delete;
+    SessionTable& operator=(const SessionTable&) = delete;
+
+    void clear() {
+        if (wheel_ != nullptr) {
+            for (size_t i = 0; i < N; ++i) wheel_->cancel(slots_[i].timer);
+        }
+        std::memset(slots_, 0, sizeof(slots_));
+        std::memset(&stats_, 0, sizeof(stats_));
+        std::memset(by_state_, 0, sizeof(by_state_));
+        stats_.capacity = kMaxSessions;
+        cursor_ = 0;
+    }
+
+    // Drives timeouts from `wheel` (nullptr detaches): every session
+    // deadline is mirrored into a wheel timer tagged with its sat_id.
+    // The wheel must share on_event()'s clock and outlive the table.
+    void attach(timing_wheel::Wheel* wheel) {
+        for (size_t i = 0; i < N; ++i) {
+            Session& s = slots_[i];
+            if (wheel_ != nullptr) wheel_->cancel(s.timer);
+            s.timer = timing_wheel::kNoTimer;
+            if (wheel != nullptr && s.state != State::kVacant) {
+                s.timer = wheel->arm(s.deadline_ms, on_timer, this, s.sat_id);
+            }
+        }
+        wheel_ = wheel;
+    }
+
+    const Policy& policy() const { return policy_; }
+    Stats stats() const {
+        Stats st             = stats_;
+        st.handshake_pending = by_state_[state_index(State::kHandshakePending)];
+        st.active            = by_state_[state_index(State::kActive)];
+        st.closing           = by_state_[state_index(State::kClosing)];
+        st.blacklisted       = by_state_[state_index(State::kBlacklisted)];
+        return st;
+    }
+
+    // Feeds one event for `sat_id`, first applying any timeout that has
+    // fallen due. O(1) expected.
+    Result on_event(uint32_t sat_id, Event event, uint64_t now_ms) {
+        size_t i = probe(sat_id);
+        if (slots_[i].state != State::kVacant) i = settle_timeouts(i, now_ms);
+
+        Session& s = slots_[i];
+        const State from = s.state;
+        const Transition t = step(from, event, policy_);
+        if (t.action == Action::kDrop) ++stats_.dropped;
+        if (t.next == State::kVacant) {
+            if (from != State::kVacant) {
+                remove(i);
+                return {from, State::kVacant, Action::kWipe};
+            }
+            return {from, from, t.action};
+        }
+
+        if (from == State::kVacant) {
+            if (stats_.occupied >= kMaxSessions) {
+                ++stats_.exhausted;
+                return {from, from, Action::kExhausted};
+            }
+            s.sat_id    = sat_id;
+            s.opened_ms = now_ms;
+            ++stats_.occupied;
+            if (stats_.occupied > stats_.peak) stats_.peak = stats_.occupied;
+        }
+
+        State  next   = t.next;
+        Action action = t.action;
+        if (action == Action::kCountReplay && ++s.replays >= policy_.replay_limit) {
+            next   = State::kBlacklisted;
+            action = Action::kBlacklist;
+        }
+        const bool valid = action == Action::kOpen || action == Action::kSettle ||
+                           action == Action::kReceipt;
+        if (valid) ++s.packets;
+        // A valid packet keeps an ACTIVE session alive; otherwise the
+        // deadline only moves when the state changes.
+        if (next != from || (valid && next == State::kActive)) enter(s, next, now_ms);
+        return {from, next, action};
+    }
+
+    // False when `sat_id` is blacklisted and still cooling down; the
+    // packet is counted as dropped. Lets the caller skip the Bouncer.
+    bool admit(uint32_t sat_id, uint64_t now_ms) {
+        size_t i = probe(sat_id);
+        if (slots_[i].state == State::kVacant) return true;
+        i = settle_timeouts(i, now_ms);
+        if (slots_[i].state != State::kBlacklisted) return true;
+        ++stats_.dropped;
+        return false;
+    }
+
+    // Current state of `sat_id` as of `now_ms` (pending timeouts
+    // applied virtually; nothing is modified).
+    State state(uint32_t sat_id, uint64_t now_ms) const {
+        const Session& s = slots_[probe(sat_id)];
+        State st = s.state;
+        uint64_t deadline = s.deadline_ms;
+        while (st != State::kVacant && now_ms >= deadline) {
+            const State next = timeout(st);
+            deadline += state_timeout_ms(next, policy_);
+            st = next;
+        }
+        return st;
+    }
+
+    const Session* find(uint32_t sat_id) const {
+        const Session& s = slots_[probe(sat_id)];
+        return s.state == State::kVacant ? nullptr : &s;
+    }
+
+    // Applies due timeouts to up to `budget` slots, continuing where
+    // the previous call stopped, so sessions of sats that went quiet
+    // are closed and freed without each needing a timer. Returns the
+    // number of slots freed.
+    size_t expire(uint64_t now_ms, size_t budget) {
+        size_t freed = 0;
+        for (size_t n = 0; n < budget && n < N; ++n) {
+            const size_t   i   = cursor_;
+            const Session& s   = slots_[i];
+            const uint32_t sat = s.sat_id;
+            if (s.state != State::kVacant && now_ms >= s.deadline_ms) {
+                settle_timeouts(i, now_ms);
+                if (s.state == State::kVacant || s.sat_id != sat) {
+                    ++freed;
+                    // The backward shift may have moved another session
+                    // into this slot; look at it again.
+                    if (s.state != State::kVacant) continue;
+                }
+            }
+            cursor_ = (cursor_ + 1) & (N - 1);
+        }
+        return freed;
+    }
+
+private:
+    static constexpr unsigned log2(size_t n) { return n <= 1 ? 0 : 1 + log2(n / 2); }
+
+    static size_t home(uint32_t sat_id) {
+        // Fibonacci hashing: consecutive sat_ids land far apart.
+        return static_cast<size_t>(
+            (static_cast<uint64_t>(sat_id) * 0x9E3779B97F4A7C15ull) >> (64 - log2(N)));
+    }
+
+    // Slot holding `sat_id`, or the free slot where it would go.
+    size_t probe(uint32_t sat_id) const {
+        size_t i = home(sat_id);
+        while (slots_[i].state != State::kVacant && slots_[i].sat_id != sat_id) {
+            i = (i + 1) & (N - 1);
+        }
+        return i;
+    }
+
+    void enter(Session& s, State next, uint64_t now_ms) {
+        if (next != s.state) {
+            if (s.state != State::kVacant) --by_state_[state_index(s.state)];
+            ++by_state_[state_index(next)];
+            if (next == State::kBlacklisted) ++stats_.blacklistings;
+        }
+        s.state       = next;
+        s.deadline_ms = now_ms + state_timeout_ms(next, policy_);
+        if (wheel_ != nullptr) {
+            s.timer = wheel_->rearm(s.timer, s.deadline_ms, on_timer, this, s.sat_id);
+        }
+    }
+
+    // Wheel expiry for one sat: runs whatever has fallen due (the slot
+    // may have moved or already been settled by traffic).
+    static void on_timer(void* ctx, uint32_t sat_id) {
+        SessionTable* t = static_cast<SessionTable*>(ctx);
+        const size_t i = t->probe(sat_id);
+        if (t->slots_[i].state != State::kVacant) t->settle_timeouts(i, t->wheel_->now_ms());
+    }
+
+    // Runs the timeouts of slot i that are due by `now_ms`, each from
+    // the deadline it fell on. Returns the probe slot for the same sat
+    // (the slot is freed when the session reaches VACANT).
+    size_t settle_timeouts(size_t i, uint64_t now_ms) {
+        Session& s = slots_[i];
+        while (s.state != State::kVacant && now_ms >= s.deadline_ms) {
+            const State next = timeout(s.state);
+            if (next == State::kVacant) {
+                const uint32_t sat_id = s.sat_id;
+                remove(i);
+                return probe(sat_id);
+            }
+            enter(s, next, s.deadline_ms);
+        }
+        return i;
+    }
+
+    // Frees slot i and shifts later members of its probe chain back so
+    // lookups never need tombstones.
+    void remove(size_t i) {
+        if (wheel_ != nullptr) wheel_->cancel(slots_[i].timer);
+        --by_state_[state_index(slots_[i].state)];
+        --stats_.occupied;
+        size_t j = i;
+        for (;;) {
+            j = (j + 1) & (N - 1);
+            if (slots_[j].state == State::kVacant) break;
+            const size_t k = home(slots_[j].sat_id);
+            // Move j into the hole unless its home lies cyclically in (i, j].
+            const bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+            if (!stays) {
+                slots_[i] = slots_[j];
+                i = j;
+            }
+        }
+        std::memset(&slots_[i], 0, sizeof(slots_[i]));
+    }
+
+    Policy               policy_;
+    timing_wheel::Wheel* wheel_;
+    Session              slots_[N];
+    Stats                stats_;
+    size_t               by_state_[kStateCount];
+    size_t               cursor_;
+};
+
+// Short log labels ("active", "blacklist", …).
+const char* state_name(State s);
+const char* action_name(Action a);
+
+} // namespace ground_session
+
+#endif // GROUND_SESSION_H
@@ -0,0 +1,177 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      handshake_responder.h
+ * Desc:      Ground side of the Packet H exchange (Handshake-spec.md §2
+ *            Phase 2) with X25519 keypairs generated ahead of the pass.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * respond() takes a Packet H (Init) from a sat and:
+ *
+ *   1. checks the frame and, with a clock set, its timestamp liveness;
+ *   2. verifies the sat's Ed25519 signature over header + body;
+ *   3. takes a ground ephemeral keypair from the KeyPool;
+ *   4. derives the session key exactly as the sat's
+ *      processHandshakeResponse() does (X25519, then BLAKE2b);
+ *   5. installs it in the SessionStore under the requested TTL, unless
+ *      the sat's session is still live and was negotiated by an Init
+ *      at least as new (a replayed Init never replaces a live key);
+ *   6. writes Packet H (Resp): ground ephemeral key, TTL and timestamp
+ *      echoed, signed by the ground Identity.
+ *
+ * The KeyPool is an SPSC ring of keypairs. A refill thread, scheduled
+ * SCHED_IDLE where the OS has it, tops the ring up whenever it drops
+ * below half, so the keygen happens on a core that has nothing better to
+ * do and a handshake during a pass costs one scalar multiplication plus
+ * one signature. An empty pool falls back to an inline keygen; the miss
+ * is counted.
+ *
+ * One thread calls respond() (the ring's consumer). The store may be
+ * shared with the Bouncer on other threads.
+ * -------------------------------------------------------------------------*/
+
+#ifndef HANDSHAKE_RESPONDER_H
+#define HANDSHAKE_RESPONDER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "frame_dispatch.h"
+#include "security_context.h"
+#include "spsc_ring.h"
+
+namespace handshake_responder {
+
+constexpr size_t   kPoolSlots        = 64;   // power of two
+constexpr size_t   kRefillBelow      = kPoolSlots / 2;
+constexpr uint32_t kRefillIdleWaitMs = 250;  // parked wake-up bound
+
+// |ground clock - timestamp| allowed when a clock is set (spec §2
+// Phase 2 liveness).
+constexpr uint64_t kLivenessMs = 60000;
+
+// Packet H (Resp) is a downlink to Sat B, addressed like the ACK
+// (ack_builder.cpp).
+constexpr uint16_t kResponseApid = 101;
+
+// Largest Packet H of either tier.
+constexpr size_t kMaxPacketH = sizeof(snlp::PacketH_t);
+static_assert(sizeof(ccsds::PacketH_t) <= kMaxPacketH, "SNLP Packet H must be the larger");
+
+struct Keypair {
+    uint8_t pub[security_context::kPubKeySize];
+    uint8_t priv[security_context::kPubKeySize];
+};
+
+struct PoolStats {
+    uint64_t generated; // keypairs made by the refill thread or fill()
+    uint64_t taken;     // handed out from the ring
+    uint64_t misses;    // ring empty: generated inline on the caller
+};
+
+class KeyPool {
+public:
+    KeyPool();
+    ~KeyPool();
+
+    KeyPool(const KeyPool&)            = delete;
+    KeyPool& operator=(const KeyPool&) = delete;
+
+    // Runs the refill thread until stop(). sodium_init() first.
+    void start();
+    void stop();
+
+    // Fills the ring on the calling thread. Only while stopped.
+    void fill();
+
+    // Consumer side: a fresh keypair, from the ring when it has one.
+    // The caller wipes `out.priv` once it is used.
+    void take(Keypair& out);
+
+    size_t    available() const { return ring_.size(); }
+    PoolStats stats() const;
+
+private:
+    void run();
+    bool top_up();  // true if the ring is full
+    void wake();
+
+    SpscRing<Keypair, kPoolSlots> ring_;
+
+    std::thread             worker_;
+    bool                    running_;
+    std::atomic<bool>       stop_;
+    std::atomic<bool>       parked_;
+    std::mutex              mu_;
+    std::condition_variable cv_;
+
+    std::atomic<uint64_t> generated_;
+    std::atomic<uint64_t> taken_;
+    std::atomic<uint64_t> misses_;
+};
+
+enum class Verdict : uint8_t {
+    kResponded = 0,  // session installed, Packet H (Resp) written
+    kBadSize,        // not a Packet H of either tier, or output too small
+    kBadHeader,      // header does not parse as Packet H
+    kStale,          // timestamp outside kLivenessMs of the clock
+    kBadSignature,   // sat's Ed25519 signature does not verify
+    kBadKey,         // X25519 with the sat's ephemeral key failed
+    kStoreFull,      // no session slot left for the sat
+    kReplay,         // live session from an Init with a timestamp >= this one
+    kNoIdentity,     // ground Identity not initialised
+};
+
+const char* verdict_name(Verdict v);
+
+struct Stats {
+    uint64_t responded;
+    uint64_t rejected;
+};
+
+// Wall-clock source in Unix ms, the Packet H timestamp base.
+using Clock = uint64_t (*)();
+
+class Responder {
+public:
+    // All three must outlive the Responder; `id` must be initialised.
+    Responder(const security_context::Identity& id, security_context::SessionStore& store,
+              KeyPool& pool);
+
+    // Liveness check on the init timestamp; nullptr (default) skips it
+    // for flat-sat boards that stamp millis().
+    void set_clock(Clock clock) { clock_ = clock; }
+
+    // Answers the Packet H (Init) in init[0..len) from `sat_id`, whose
+    // registered identity key is `sat_pub`. The session TTL counts from
+    // `now_ms` on the store's clock. On kResponded, resp[0..*resp_len)
+    // holds Packet H (Resp) in the tier of the init.
+    Verdict respond(const uint8_t* init, size_t len, uint32_t sat_id,
+                    const uint8_t sat_pub[security_context::kPubKeySize], uint64_t now_ms,
+                    uint8_t* resp, size_t resp_cap, size_t* resp_len);
+
+    Stats stats() const { return stats_; }
+
+private:
+    template <frame_dispatch::Tier T>
+    Verdict respond_as(const uint8_t* init, size_t len, uint32_t sat_id,
+                       const uint8_t* sat_pub, uint64_t now_ms,
+                       uint8_t* resp, size_t resp_cap, size_t* resp_len);
+
+    const security_context::Identity& id_;
+    security_context::SessionStore&   store_;
+    KeyPool&                          pool_;
+    Clock                             clock_;
+    Stats                             stats_;
+};
+
+} // namespace handshake_responder
+
+#endif // HANDSHAKE_RESPONDER_H
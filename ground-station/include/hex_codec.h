@@ -0,0 +1,49 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      hex_codec.h
+ * Desc:      Shared ASCII-hex encoder / strict decoder for the serial
+ *            and egress paths. SIMD kernels (SSE2, AVX2 when the CPU
+ *            has it, NEON on AArch64) with a scalar tail.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Kernel choice: SSE2 is the x86-64 baseline and NEON the AArch64 one,
+ * so both are picked at compile time. AVX2 is picked once at run time
+ * (GCC/Clang on x86-64) so the binary still runs on pre-Haswell hosts.
+ * Every kernel produces byte-identical results to the scalar reference.
+ * -------------------------------------------------------------------------*/
+
+#ifndef HEX_CODEC_H
+#define HEX_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hex_codec {
+
+// Writes 2 * `len` lower-case hex chars (no NUL). Returns the number
+// of chars written, or 0 if `out_cap` is too small or a pointer is
+// NULL (len 0 also returns 0).
+size_t encode(const uint8_t* in, size_t len, char* out, size_t out_cap);
+
+// Decodes `hex_len` hex chars (either case) into `hex_len / 2` bytes.
+// Returns false — fail-closed — on odd length, any non-hex char,
+// insufficient `out_cap` or a NULL pointer; `out` is then unspecified.
+bool decode(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap);
+
+// Portable byte-at-a-time reference versions with the same contracts.
+// The SIMD kernels finish their tails with these; exposed for the
+// equivalence tests and the micro-benchmarks.
+size_t encode_scalar(const uint8_t* in, size_t len, char* out, size_t out_cap);
+bool   decode_scalar(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap);
+
+// Name of the kernel encode()/decode() use on this host: "avx2",
+// "sse2", "neon" or "scalar".
+const char* backend();
+
+} // namespace hex_codec
+
+#endif // HEX_CODEC_H
@@ -0,0 +1,110 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      http1_response.h
+ * Desc:      Resumable HTTP/1.1 response parser for the gateway
+ *            connection pool: status line, headers and body
+ *            (Content-Length, chunked or close-delimited) are parsed as
+ *            the bytes come off the socket.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#ifndef HTTP1_RESPONSE_H
+#define HTTP1_RESPONSE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace http1 {
+
+// Receives body bytes, in pieces of any size. Return false to abandon
+// the response.
+using BodySink = bool (*)(const uint8_t* data, size_t len, void* user);
+
+// One response per instance (reset() to reuse). Bytes are fed in
+// whatever pieces recv() returns; nothing is buffered but the current
+// header line, so body bytes reach the sink straight from the caller's
+// buffer — de-chunked, never copied. Because the parser knows exactly
+// where the response ends, the connection can stay open for the next
+// request; bytes after the end are left unconsumed.
+//
+// Interim 1xx responses are skipped. Only the headers that frame the
+// message (Content-Length, Transfer-Encoding, Connection) are looked at.
+class ResponseParser {
+public:
+    static constexpr size_t kMaxLine    = 512;       // one status / header line
+    static constexpr size_t kMaxHeaders = 16 * 1024; // whole header block
+
+    enum class Result : uint8_t {
+        kMore,    // feed more
+        kHeaders, // header block complete: status() is valid, feed the rest
+        kDone,    // response complete
+        kFail,    // malformed, over a limit, or the sink returned false
+    };
+
+    ResponseParser() { reset(); }
+
+    void reset();
+
+    // Parses up to `len` bytes, handing body bytes to `sink`. `*used` is
+    // how many were consumed: all of them on kMore, fewer when it stops
+    // at the end of the header block (kHeaders) or of the response
+    // (kDone). Once kDone or kFail, further feeds return the same.
+    Result feed(const uint8_t* data, size_t len, BodySink sink, void* user, size_t* used);
+
+    // The peer closed the connection: kDone if that ends the body
+    // (no Content-Length and not chunked), kFail otherwise.
+    Result finish();
+
+    bool headers_done() const { return state_ > State::kHeaderLine; }
+    int  status() const { return status_; }
+    // The connection can carry another request once this one is done.
+    bool keep_alive() const { return framed_ && !close_; }
+
+private:
+    enum class State : uint8_t {
+        kStatusLine,
+        kHeaderLine,
+        kLengthBody, // Content-Length: left_ bytes still due
+        kCloseBody,  // everything up to EOF
+        kChunkSize,
+        kChunkExt,
+        kChunkSizeLF,
+        kChunkData,
+        kChunkDataCR,
+        kChunkDataLF,
+        kTrailer,
+        kTrailerLF,
+        kDone,
+        kFail,
+    };
+
+    bool end_line(); // a complete status / header line is in line_
+    bool status_line();
+    bool header_line();
+    bool end_headers();
+    Result fail() {
+        state_ = State::kFail;
+        return Result::kFail;
+    }
+
+    State    state_;
+    int      status_;
+    bool     http11_;
+    bool     chunked_;
+    bool     has_length_;
+    bool     close_;
+    bool     framed_;
+    size_t   left_;        // body or chunk bytes still due; chunk size while parsing it
+    size_t   digits_;      // chunk-size digits seen
+    size_t   header_bytes_;
+    size_t   line_len_;    // > kMaxLine once the line overflowed
+    char     line_[kMaxLine];
+};
+
+} // namespace http1
+
+#endif // HTTP1_RESPONSE_H
@@ -0,0 +1,141 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      http_pool.h
+ * Desc:      Fixed-size pool of keep-alive HTTP/1.1 connections to the
+ *            Go gateway, shared by GatewayClient (ingest) and
+ *            EgressPollClient (pending / ack).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#ifndef HTTP_POOL_H
+#define HTTP_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "http1_response.h"
+
+namespace http_pool {
+
+// Connection-reuse counters. A snapshot; values only grow.
+struct Stats {
+    uint64_t requests;      // round_trip() calls that reached the wire
+    uint64_t connects;      // fresh TCP connections opened
+    uint64_t reuses;        // requests served on an already-open connection
+    uint64_t stale_retries; // reused connection found dead, request re-sent on a new one
+    uint64_t failures;      // transport failures reported to the caller
+};
+
+// Receives a response body as it arrives, in pieces of any size.
+// Return false to abandon the response; the connection is then closed.
+using BodySink = http1::BodySink;
+
+// Each request checks out an idle connection (or opens one in a free
+// slot), performs one request/response exchange and checks it back in
+// if the server allows keep-alive. Responses are parsed as they arrive
+// by http1::ResponseParser; Content-Length and chunked framing tell it
+// where each one ends, so the stream stays in sync. Anything else is
+// read to EOF and the connection is not reused.
+//
+// A reused connection the gateway has since closed is detected (EOF
+// before the first response byte, or a failed send) and the request is
+// re-sent once on a fresh connection — callers never see the stale
+// socket. Thread-safe: slot checkout is under a mutex, the network I/O
+// is not. When every slot is busy the request runs on a one-off
+// connection instead of waiting.
+//
+// No heap and no response buffer: the slots are a fixed array, and
+// body bytes are received straight into the caller's buffer
+// (round_trip) or handed to its sink (round_trip_stream).
+class ConnectionPool {
+public:
+    static constexpr size_t   kMaxConns      = 4;
+    static constexpr uint32_t kIdleMaxMs     = 30000;     // close idlers older than this
+    static constexpr uint32_t kRecvTimeoutMs = 5000;      // per recv() on a live connection
+
+    ConnectionPool(const char* host, uint16_t port);
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&)            = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    // Sends `head` (request line + headers, CRLFCRLF included) followed
+    // by `body`, then reads one response. The response body is
+    // received straight into `out` (no NUL termination).
+    //
+    // Returns:
+    //   true  — round-trip completed; `status_code` and `out_len` set
+    //           (any HTTP status, 4xx/5xx included)
+    //   false — transport failure, malformed response, or a body larger
+    //           than `out_cap` (never silently truncated)
+    bool round_trip(const char*    head,
+                    size_t         head_len,
+                    const uint8_t* body,
+                    size_t         body_len,
+                    uint8_t*       out,
+                    size_t         out_cap,
+                    size_t&        out_len,
+                    int&           status_code);
+
+    // Same exchange, but the body is handed to `sink` piece by piece
+    // as it comes off the socket instead of being assembled: no size
+    // limit, and the caller can act on the start of a long body while
+    // the rest is in flight. Chunked bodies are de-chunked on the way.
+    // `status_code` is set before the first sink call.
+    //
+    // Returns:
+    //   true  — the whole response was read and handed over
+    //   false — transport failure, malformed response, or the sink
+    //           returned false
+    bool round_trip_stream(const char*    head,
+                           size_t         head_len,
+                           const uint8_t* body,
+                           size_t         body_len,
+                           BodySink       sink,
+                           void*          user,
+                           int&           status_code);
+
+    // Closes every idle connection (busy ones close on check-in).
+    void close_idle();
+
+    Stats       stats() const;
+    const char* host() const { return _host; }
+    uint16_t    port() const { return _port; }
+
+private:
+    struct Slot {
+        int      fd;
+        bool     busy;
+        uint64_t last_used_ms;
+    };
+
+    // Returns a slot index (fd may be -1 = connect needed), or -1 when
+    // every slot is busy. `*reused` is true for a kept-alive fd.
+    int  acquire(bool* reused);
+    template <typename ExchangeFn>
+    bool with_connection(ExchangeFn exchange_fn);
+    void release(int slot, int fd, bool keep);
+    int  connect_new();
+
+    const char* _host;
+    uint16_t    _port;
+
+    mutable std::mutex _mu;
+    Slot               _slots[kMaxConns];
+
+    std::atomic<uint64_t> _requests;
+    std::atomic<uint64_t> _connects;
+    std::atomic<uint64_t> _reuses;
+    std::atomic<uint64_t> _stale_retries;
+    std::atomic<uint64_t> _failures;
+};
+
+} // namespace http_pool
+
+#endif // HTTP_POOL_H
@@ -0,0 +1,205 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      ingest_batcher.h
+ * Desc:      Coalesces bouncer-accepted frames into one POST to the
+ *            gateway's /api/v1/ingest/batch route.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Batch body (Content-Type: application/x-void-frames):
+ *
+ *   { len:u16_le | frame[len] } × N
+ *
+ * Response: 200 {"results":[<status>, ...]} — one HTTP-style status per
+ * frame, in order (200 accepted, 400 rejected, ...). Any other status
+ * applies to the whole batch.
+ *
+ * Design: template-based static dispatch like EgressOrchestrator — the
+ * gateway client is a template parameter so tests inject a duck-typed
+ * mock. Frames are appended straight into the wire-format body, so a
+ * flush is one round trip with no re-copy. No heap.
+ * -------------------------------------------------------------------------*/
+
+#ifndef INGEST_BATCHER_H
+#define INGEST_BATCHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ingest {
+
+constexpr size_t kBatchMaxFrames = 32;
+constexpr size_t kBatchMaxBytes  = 8192; // body incl. length prefixes
+constexpr size_t kFrameLenPrefix = 2;
+
+// Flush triggers; whichever is hit first. max_delay_ms == 0 sends
+// every frame as soon as it is added (a batch of one).
+struct BatchPolicy {
+    size_t   max_frames;   // <= kBatchMaxFrames
+    size_t   max_bytes;    // <= kBatchMaxBytes
+    uint32_t max_delay_ms; // oldest queued frame waits at most this long (+ poll cadence)
+};
+
+constexpr BatchPolicy kDefaultBatchPolicy = {kBatchMaxFrames, kBatchMaxBytes, 20};
+
+// Per-frame outcome. `status` is the gateway's per-frame HTTP-style
+// code, or 0 when the frame never got a verdict (transport failure).
+// `tag` is whatever the caller passed to add() — main() uses sat_id.
+using ResultFn = void (*)(uint32_t tag, int status, void* user);
+
+struct BatchStats {
+    uint64_t requests;  // batch POSTs sent
+    uint64_t frames;    // frames handed to the gateway (batched or not)
+    uint64_t fallbacks; // frames sent one-by-one after the route 404'd
+};
+
+// Template parameter `Client` must expose (duck-typed):
+//
+//   bool push_batch(const uint8_t* body, size_t len, size_t frames,
+//                   int* results, int& status_code);
+//   bool push_to_l2(const uint8_t* frame, size_t len);
+//
+// push_batch fills `results[0..frames)` when it returns true with a
+// 200. Production plugs in GatewayClient.
+template <typename Client>
+class IngestBatcher {
+public:
+    IngestBatcher(Client& client, const BatchPolicy& policy, ResultFn on_result, void* user)
+        : client_(client), policy_(clamp(policy)), on_result_(on_result), user_(user),
+          body_len_(0), count_(0), oldest_ms_(0), batch_route_(true), stats_{0, 0, 0} {}
+
+    // Queues one frame. Flushes first if it would not fit, and right
+    // after if it filled the batch. Returns false (nothing queued) for
+    // a frame that can never fit a batch.
+    bool add(const uint8_t* frame, size_t len, uint32_t tag, uint64_t now_ms) {
+        if (frame == nullptr || len == 0 || len > 0xFFFFu ||
+            kFrameLenPrefix + len > policy_.max_bytes) {
+            return false;
+        }
+        if (body_len_ + kFrameLenPrefix + len > policy_.max_bytes) flush();
+
+        if (count_ == 0) oldest_ms_ = now_ms;
+        body_[body_len_]     = static_cast<uint8_t>(len & 0xFFu);
+        body_[body_len_ + 1] = static_cast<uint8_t>(len >> 8);
+        std::memcpy(body_ + body_len_ + kFrameLenPrefix, frame, len);
+        body_len_ += kFrameLenPrefix + len;
+        tags_[count_++] = tag;
+
+        if (count_ >= policy_.max_frames || body_len_ >= policy_.max_bytes ||
+            policy_.max_delay_ms == 0) {
+            flush();
+        }
+        return true;
+    }
+
+    // Replaces the flush triggers; anything queued goes out first.
+    void set_policy(const BatchPolicy& policy) {
+        flush();
+        policy_ = clamp(policy);
+    }
+
+    // Deadline check — call from a timer. Flushes once the oldest
+    // queued frame has waited max_delay_ms.
+    void poll(uint64_t now_ms) {
+        if (count_ > 0 && now_ms - oldest_ms_ >= policy_.max_delay_ms) flush();
+    }
+
+    // When poll() will next flush, for callers that sleep until then.
+    // False when nothing is queued.
+    bool deadline(uint64_t& at_ms) const {
+        if (count_ == 0) return false;
+        at_ms = oldest_ms_ + policy_.max_delay_ms;
+        return true;
+    }
+
+    // Sends everything queued. Returns the number of frames the gateway
+    // accepted (2xx), or -1 if the batch request itself failed.
+    int flush() {
+        if (count_ == 0) return 0;
+        const size_t n = count_;
+        count_ = 0;
+        const size_t len = body_len_;
+        body_len_ = 0;
+        stats_.frames += n;
+
+        if (batch_route_) {
+            int results[kBatchMaxFrames];
+            int status = 0;
+            ++stats_.requests;
+            if (!client_.push_batch(body_, len, n, results, status)) {
+                report_all(n, 0);
+                return -1;
+            }
+            if (status == 200) {
+                int accepted = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    if (results[i] >= 200 && results[i] < 300) ++accepted;
+                    if (on_result_ != nullptr) on_result_(tags_[i], results[i], user_);
+                }
+                return accepted;
+            }
+            if (status != 404 && status != 405) {
+                report_all(n, status);
+                return -1;
+            }
+            // Gateway predates the batch route: stay on single-frame
+            // ingest from now on.
+            batch_route_ = false;
+        }
+        return send_singly(len, n);
+    }
+
+    size_t     pending() const { return count_; }
+    bool       batching() const { return batch_route_; }
+    BatchStats stats() const { return stats_; }
+
+private:
+    static BatchPolicy clamp(BatchPolicy p) {
+        if (p.max_frames == 0 || p.max_frames > kBatchMaxFrames) p.max_frames = kBatchMaxFrames;
+        if (p.max_bytes == 0 || p.max_bytes > kBatchMaxBytes) p.max_bytes = kBatchMaxBytes;
+        return p;
+    }
+
+    void report_all(size_t n, int status) {
+        if (on_result_ == nullptr) return;
+        for (size_t i = 0; i < n; ++i) on_result_(tags_[i], status, user_);
+    }
+
+    // Walks the already-built body and pushes each frame on its own.
+    int send_singly(size_t len, size_t n) {
+        int accepted = 0;
+        size_t off = 0;
+        for (size_t i = 0; i < n && off + kFrameLenPrefix <= len; ++i) {
+            const size_t flen = static_cast<size_t>(body_[off]) |
+                                (static_cast<size_t>(body_[off + 1]) << 8);
+            off += kFrameLenPrefix;
+            ++stats_.fallbacks;
+            const bool ok = client_.push_to_l2(body_ + off, flen);
+            if (ok) ++accepted;
+            if (on_result_ != nullptr) on_result_(tags_[i], ok ? 200 : 0, user_);
+            off += flen;
+        }
+        return accepted;
+    }
+
+    Client&     client_;
+    BatchPolicy policy_;
+    ResultFn    on_result_;
+    void*       user_;
+
+    uint8_t  body_[kBatchMaxBytes];
+    size_t   body_len_;
+    uint32_t tags_[kBatchMaxFrames];
+    size_t   count_;
+    uint64_t oldest_ms_;
+    bool     batch_route_;
+    BatchStats stats_;
+};
+
+} // namespace ingest
+
+#endif // INGEST_BATCHER_H
@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      line_framer.h
+ * Desc:      '\n'/'\r' line framer for the serial and stdin reactor
+ *            sources. Complete lines are sliced out of the caller's
+ *            read buffer in place; only a line split across two reads
+ *            is copied into the carry buffer.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#ifndef LINE_FRAMER_H
+#define LINE_FRAMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace line_framer {
+
+// Index of the first '\n' or '\r' in data[0, len), or `len` if there is
+// none. SSE2 / NEON 16 bytes per step with a scalar tail.
+size_t find_eol(const uint8_t* data, size_t len);
+
+// Same contract, one byte per step. For the tests and benchmarks.
+size_t find_eol_scalar(const uint8_t* data, size_t len);
+
+// Lines longer than N - 1 chars are truncated to N - 1; empty lines
+// (CRLF, blank) are skipped.
+template <size_t N>
+class LineFramer {
+    static_assert(N >= 2, "LineFramer needs room for one char + NUL");
+
+public:
+    LineFramer() : len_(0) {}
+
+    // Drops a partially received line (framing change, reconnect).
+    void reset() { len_ = 0; }
+
+    // Calls on_line(char* line, size_t line_len) for each complete line
+    // in `data`; line[line_len] is '\0'. A line that lies wholly inside
+    // `data` is handed out in place — its terminator byte is overwritten
+    // with the NUL — so `data` is modified and the pointer is only valid
+    // during the call. A trailing partial line is kept for the next feed.
+    //
+    // on_line returns false to stop early (the caller wants to switch
+    // framing or flush). Returns the bytes consumed: `len`, or one past
+    // the terminator of the line that stopped the walk.
+    template <typename OnLine>
+    size_t feed(uint8_t* data, size_t len, OnLine on_line) {
+        size_t pos = 0;
+        while (pos < len) {
+            const size_t rem = len - pos;
+            const size_t k   = find_eol(data + pos, rem);
+            if (k == rem) {
+                carry(data + pos, rem);
+                return len;
+            }
+            char*  line;
+            size_t line_len;
+            if (len_ > 0) {
+                carry(data + pos, k);
+                buf_[len_] = '\0';
+                line       = buf_;
+                line_len   = len_;
+                len_       = 0;
+            } else {
+                line     = reinterpret_cast<char*>(data + pos);
+                line_len = k < N - 1 ? k : N - 1;
+                line[line_len] = '\0';
+            }
+            pos += k + 1;
+            if (line_len > 0 && !on_line(line, line_len)) return pos;
+        }
+        return len;
+    }
+
+private:
+    void carry(const uint8_t* p, size_t n) {
+        const size_t room = N - 1 - len_;
+        if (n > room) n = room;
+        std::memcpy(buf_ + len_, p, n);
+        len_ += n;
+    }
+
+    char   buf_[N];
+    size_t len_;
+};
+
+} // namespace line_framer
+
+#endif // LINE_FRAMER_H
@@ -0,0 +1,114 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      reactor.h
+ * Desc:      Single-threaded readiness reactor for the bouncer main loop.
+ *            epoll on Linux, poll() on other POSIX hosts. Fixed-capacity
+ *            fd + timer tables (no heap).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reactor {
+
+// Called when `fd` is readable (or has hung up — the callback's read
+// then sees EOF/error). Runs on the thread that called run_once().
+using ReadyFn = void (*)(int fd, void* user);
+
+// Called when a periodic timer or an armed deadline is due.
+using TimerFn = void (*)(void* user);
+
+// Deadline time for "not armed".
+constexpr uint64_t kNoDeadline = UINT64_MAX;
+
+// The bouncer blocks in run_once() until serial bytes arrive, stdin has
+// a command, or the next timer is due — no fixed-interval sleep, so an
+// idle station stays asleep and a PacketB is handled as soon as its last
+// byte lands.
+//
+// Sources that report hang-up/error are dropped after their callback
+// runs once (callbacks should drain until EAGAIN), so an unplugged
+// radio can't spin the loop.
+//
+// Not thread-safe: register sources and call run_once() from one thread.
+class Reactor {
+public:
+    static constexpr size_t kMaxSources = 8;
+    static constexpr size_t kMaxTimers  = 4;
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Creates the OS poller. False if unavailable (e.g. Windows, or
+    // epoll_create1 failed); timers still work in that case.
+    bool open();
+    void close();
+
+    // Watches `fd` for readability. False if the table is full, the fd
+    // is already watched, or the OS refuses it (regular files and
+    // /dev/null are not pollable by epoll).
+    bool add_fd(int fd, ReadyFn fn, void* user);
+    bool remove_fd(int fd);
+    bool watching(int fd) const;
+
+    // Fires `fn` every `period_ms` (first fire one period from now).
+    // A callback that overruns skips missed periods instead of bursting.
+    bool add_timer(uint32_t period_ms, TimerFn fn, void* user);
+
+    // One-shot deadline sharing the timer table. Registered disarmed;
+    // returns its id, or -1 if the table is full. set_deadline() arms it
+    // for now_ms() time `due_ms` (a past time fires on the next
+    // run_once), moves it, or with kNoDeadline disarms it. It fires once
+    // and is disarmed before `fn` runs, so `fn` may arm it again. A
+    // disarmed deadline never bounds the wait.
+    int      add_deadline(TimerFn fn, void* user);
+    bool     set_deadline(int id, uint64_t due_ms);
+    uint64_t deadline(int id) const;
+
+    // Waits for at most `max_wait_ms` (negative = until something is
+    // due), then runs every ready fd callback and every due timer.
+    // Returns the number of callbacks run, or -1 on a poller error.
+    int run_once(int max_wait_ms);
+
+private:
+    struct Source {
+        int     fd;
+        ReadyFn fn;
+        void*   user;
+        bool    used;
+    };
+    struct Timer {
+        uint32_t period_ms; // 0: one-shot deadline
+        uint64_t due_ms;
+        TimerFn  fn;
+        void*    user;
+        bool     used;
+    };
+
+    Source* find_source(int fd);
+    int     wait_timeout(int max_wait_ms, uint64_t now) const;
+    int     fire_due_timers(uint64_t now);
+
+    Source _sources[kMaxSources];
+    Timer  _timers[kMaxTimers];
+    int    _epoll_fd; // Linux only; -1 elsewhere
+    bool   _open;
+};
+
+// Monotonic milliseconds (steady_clock) — the reactor's timer base.
+uint64_t now_ms();
+
+}  // namespace reactor
+
+#endif // REACTOR_H
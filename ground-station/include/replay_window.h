@@ -0,0 +1,177 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      replay_window.h
+ * Desc:      Per-satellite PacketB replay tracker for the Bouncer: the
+ *            newest accepted epoch_ts plus a short sliding window of
+ *            older ones, in a fixed open-addressing table keyed by
+ *            sat_id.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * epoch_ts is the PacketB nonce source (nonce = sat_id || epoch_ts), so
+ * each one may be accepted once per satellite. A frame newer than the
+ * newest accepted one is always fresh. An older one is still let
+ * through if it is at most kWindowMs behind and its epoch has not been
+ * seen — LoRa reorders retransmits — but only while the window has a
+ * record to remember it by; when the oldest record is evicted, the
+ * window's horizon moves up past it so an evicted epoch can never be
+ * accepted again.
+ *
+ * epoch_ts is in milliseconds and frames are seconds apart, so an
+ * IPsec-style bitmap (one bit per sequence number) would cover a few
+ * dozen ms. The window is instead kRecent (offset, CRC) records; the
+ * CRC is the frame's global_crc, which lets a byte-identical copy of an
+ * accepted frame (the satellite re-sending because it missed our ACK)
+ * be told apart from a different frame re-using the epoch. Each record
+ * also counts the retransmits it has let through: past kMaxRetransmits a
+ * copy is a replay too, so a captured frame cannot be re-fed forever
+ * when no clock bounds its age.
+ *
+ * check() is const and runs before the Ed25519 verify, so a replay
+ * costs a hash probe and never a curve operation. commit() is for
+ * verified frames only — a forged frame must not be able to advance a
+ * satellite's window or spend its retransmits. No heap: a Tracker<65536>
+ * is 3.5 MiB of slots.
+ * -------------------------------------------------------------------------*/
+
+#ifndef REPLAY_WINDOW_H
+#define REPLAY_WINDOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace replay_window {
+
+// How far behind a satellite's newest accepted epoch_ts a frame may
+// arrive and still be accepted (VOID State Machine Spec: 60 s).
+constexpr uint32_t kWindowMs = 60000;
+
+// Older epochs remembered per satellite besides the newest.
+constexpr size_t kRecent = 4;
+
+// Byte-identical copies of one accepted frame let through after the
+// first: enough for a satellite re-sending over a few lost ACKs.
+constexpr uint8_t kMaxRetransmits = 3;
+
+enum class Check : uint8_t {
+    kFresh = 0,  // never accepted: verify, then commit()
+    kRetransmit, // byte-identical to an accepted frame (same epoch, same CRC)
+    kReplay,     // epoch used by another frame, behind the window, or resent too often
+    kFull,       // satellite not tracked yet and the table is at its load limit
+};
+
+// Replay state of one satellite. 48 bytes.
+struct Window {
+    uint64_t newest;          // newest accepted epoch_ts
+    uint32_t newest_crc;
+    uint16_t horizon;         // epochs this many ms (or more) behind newest are replays
+    uint8_t  newest_resent;   // retransmits of newest accepted so far
+    uint8_t  pad;
+    uint32_t crc[kRecent];
+    uint16_t back[kRecent];   // record i is epoch newest - back[i]; kNoRecord = unused
+    uint8_t  resent[kRecent]; // retransmits of record i accepted so far
+};
+
+constexpr uint16_t kNoRecord = 0xFFFFu;
+static_assert(kWindowMs < kNoRecord, "window offsets must fit a uint16_t");
+
+// A window holding only `epoch`.
+void start(Window& w, uint64_t epoch, uint32_t crc);
+
+// Classifies a frame against the satellite's window; never kFull.
+Check check(const Window& w, uint64_t epoch, uint32_t crc);
+
+// Records an accepted frame: a kFresh one uses its epoch up, a
+// kRetransmit one spends one of its record's retransmits. Only valid
+// when check() returned one of those two.
+void commit(Window& w, uint64_t epoch, uint32_t crc);
+
+// Fixed-capacity table of windows keyed by (sat_id, link). `link` is
+// the caller's namespace for sat_ids — the Bouncer passes the frame
+// tier, so a dual-front-end station keeps separate windows for a
+// satellite's LoRa and S-band traffic. Linear probing over a
+// power-of-two slot array; inserts stop at 3/4 load so every probe
+// ends on a free slot within a few steps. Entries are never removed
+// individually; clear() forgets everything.
+//
+// Not thread-safe: the Bouncer calls it from the reactor thread only.
+template <size_t N>
+class Tracker {
+    static_assert(N >= 4 && (N & (N - 1)) == 0, "Tracker capacity must be a power of two");
+
+public:
+    static constexpr size_t kSlots   = N;
+    static constexpr size_t kMaxSats = N / 4 * 3;
+
+    Tracker() { clear(); }
+
+    Tracker(const Tracker&)            = delete;
+    Tracker& operator=(const Tracker&) = delete;
+
+    void clear() {
+        std::memset(slots_, 0, sizeof(slots_));
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+
+    Check check(uint32_t sat_id, uint8_t link, uint64_t epoch, uint32_t crc) const {
+        const Slot& s = slots_[probe(sat_id, link)];
+        if (s.used == 0) return size_ < kMaxSats ? Check::kFresh : Check::kFull;
+        return replay_window::check(s.window, epoch, crc);
+    }
+
+    // Records a verified frame that check() found kFresh or
+    // kRetransmit. Returns false only when a new satellite does not fit.
+    bool commit(uint32_t sat_id, uint8_t link, uint64_t epoch, uint32_t crc) {
+        Slot& s = slots_[probe(sat_id, link)];
+        if (s.used != 0) {
+            replay_window::commit(s.window, epoch, crc);
+            return true;
+        }
+        if (size_ >= kMaxSats) return false;
+        s.sat_id = sat_id;
+        s.link   = link;
+        s.used   = 1;
+        start(s.window, epoch, crc);
+        ++size_;
+        return true;
+    }
+
+private:
+    struct Slot {
+        uint32_t sat_id;
+        uint8_t  link;
+        uint8_t  used;
+        uint16_t pad;
+        Window   window;
+    };
+
+    static constexpr unsigned log2(size_t n) { return n <= 1 ? 0 : 1 + log2(n / 2); }
+
+    // Index of the slot holding (sat_id, link), or of the free slot
+    // where it would go.
+    size_t probe(uint32_t sat_id, uint8_t link) const {
+        // Fibonacci hashing: sat_ids are often sequential, so take the
+        // high bits of the product rather than the low ones.
+        const uint32_t key = sat_id ^ (static_cast<uint32_t>(link) * 0x85EBCA6Bu);
+        size_t i = static_cast<size_t>(
+            (static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> (64 - log2(N)));
+        while (slots_[i].used != 0 &&
+               (slots_[i].sat_id != sat_id || slots_[i].link != link)) {
+            i = (i + 1) & (N - 1);
+        }
+        return i;
+    }
+
+    Slot   slots_[N];
+    size_t size_;
+};
+
+} // namespace replay_window
+
+#endif // REPLAY_WINDOW_H
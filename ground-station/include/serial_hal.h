@@ -15,17 +15,60 @@
 #include <cstdint>
 #include <cstddef>
 
-// Initialize the serial port (e.g., "COM3" or "/dev/tty.usbmodem14101")
-bool serial_open(const char* port_name, uint32_t baud_rate);
+// One USB-serial radio (Heltec board). Instance-based so a single
+// ground-station process can drive several receivers; each instance
+// owns its own OS handle. No heap — embed instances statically.
+class SerialPort {
+public:
+    SerialPort();
+    ~SerialPort();
 
-// Read bytes directly into a pre-allocated static buffer (No Heap)
-// Returns the number of bytes read, or -1 on error.
-int serial_read_bytes(uint8_t* buffer, size_t max_bytes);
+    SerialPort(const SerialPort&) = delete;
+    SerialPort& operator=(const SerialPort&) = delete;
 
-// Safely release the hardware lock
-void serial_close();
+    // Initialize the serial port (e.g., "COM3" or "/dev/tty.usbmodem14101")
+    // at 8N1, raw, non-blocking. Returns false if the port can't be
+    // opened or `baud_rate` isn't a supported line rate. `port_name`
+    // must outlive the instance (argv / string literal).
+    bool open(const char* port_name, uint32_t baud_rate);
 
-// Write bytes out to the hardware
-int serial_write_bytes(const uint8_t* buffer, size_t len);
+    // Read bytes directly into a pre-allocated static buffer (No Heap)
+    // Returns the number of bytes read (0 if none pending), or -1 on error.
+    int read(uint8_t* buffer, size_t max_bytes);
 
-#endif
\ No newline at end of file
+    // Write bytes out to the hardware. Non-blocking: returns how many
+    // were taken (possibly fewer than `len`, 0 when the OS buffer is
+    // full), or -1 on error.
+    int write(const uint8_t* buffer, size_t len);
+
+    // Writes all `len` bytes, waiting up to `timeout_ms` in total for
+    // the port to drain when the OS buffer fills. False on error or
+    // timeout; some prefix of the buffer may then have gone out.
+    bool write_all(const uint8_t* buffer, size_t len, uint32_t timeout_ms);
+
+    // Safely release the hardware lock
+    void close();
+
+    bool        is_open() const;
+    const char* name() const { return _name; }
+    uint32_t    baud() const { return _baud; }
+
+    // OS descriptor behind the open port, for readiness polling (reactor.h).
+    // Returns -1 if the port is closed or the platform has no pollable fd
+    // (Windows HANDLE) — callers then fall back to timed reads.
+    int fd() const;
+
+    // True if `baud_rate` maps to a line rate this platform can set.
+    static bool supports_baud(uint32_t baud_rate);
+
+private:
+    const char* _name;
+    uint32_t    _baud;
+#ifdef _WIN32
+    void*       _handle; // HANDLE, kept opaque so <windows.h> stays out of headers
+#else
+    int         _fd;
+#endif
+};
+
+#endif
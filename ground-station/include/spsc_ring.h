@@ -0,0 +1,113 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      spsc_ring.h
+ * Desc:      Bounded lock-free single-producer / single-consumer ring of
+ *            fixed-size slots.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * One thread may call the producer half (claim/publish, try_push), one
+ * other thread the consumer half (front/release, try_pop). Each side
+ * owns one index and only reads the other's; a release-store publishes
+ * a slot and the matching acquire-load sees its contents, so no locks
+ * or CAS loops are needed. Each side also caches the other's index and
+ * re-reads the shared atomic only when the cache says full/empty,
+ * keeping the cache line ping-pong off the fast path.
+ *
+ * Slots are written in place (claim → fill → publish) so a 200-byte
+ * frame is copied once, not twice. No heap.
+ * -------------------------------------------------------------------------*/
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+// Destructive-interference size; C++14 has no std:: constant for it.
+#define VOID_CACHE_LINE 64
+
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr size_t kCapacity = N;
+
+    SpscRing() : _head(0), _tail_cache(0), _tail(0), _head_cache(0) {}
+
+    SpscRing(const SpscRing&)            = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // --- Producer side ---
+
+    // Next free slot to fill, or nullptr when full. The slot is not
+    // visible to the consumer until publish().
+    T* claim() {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail_cache == N) {
+            _tail_cache = _tail.load(std::memory_order_acquire);
+            if (head - _tail_cache == N) return nullptr;
+        }
+        return &_slots[head & (N - 1)];
+    }
+
+    // Hands the slot returned by the last claim() to the consumer.
+    void publish() {
+        _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool try_push(const T& v) {
+        T* slot = claim();
+        if (slot == nullptr) return false;
+        *slot = v;
+        publish();
+        return true;
+    }
+
+    // --- Consumer side ---
+
+    // Oldest published slot, or nullptr when empty. Stays valid until
+    // release().
+    T* front() {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head_cache) {
+            _head_cache = _head.load(std::memory_order_acquire);
+            if (tail == _head_cache) return nullptr;
+        }
+        return &_slots[tail & (N - 1)];
+    }
+
+    // Returns the slot from the last front() to the producer.
+    void release() {
+        _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool try_pop(T& out) {
+        T* slot = front();
+        if (slot == nullptr) return false;
+        out = *slot;
+        release();
+        return true;
+    }
+
+    // --- Either side (approximate while the other side is running) ---
+
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+private:
+    // Producer-owned line, consumer-owned line, then the slots.
+    alignas(VOID_CACHE_LINE) std::atomic<size_t> _head;
+    size_t                                       _tail_cache;
+    alignas(VOID_CACHE_LINE) std::atomic<size_t> _tail;
+    size_t                                       _head_cache;
+    alignas(VOID_CACHE_LINE) T                   _slots[N];
+};
+
+#endif // SPSC_RING_H
@@ -13,6 +13,10 @@
 
 #include <cstring>
 
+#include "crc32_ieee.h"
+#include "frame_dispatch.h"
+#include "void_packets_snlp.h"
+
 namespace ack_builder {
 namespace {
 
@@ -21,6 +25,7 @@ namespace {
 // (isSnlp=true, isCmd=true) and apid=apidSatB (101).
 constexpr uint32_t kSnlpSyncWord   = 0x1D01A5A5u; // VOID-113
 constexpr uint16_t kApidSatB       = 101u;         // ACK goes downlink to Sat B
+constexpr uint16_t kApidSatA       = 100u;         // tunnel is addressed to Sat A
 constexpr uint16_t kSeqFlags       = 0xC000u;      // Hardcoded per generator
 constexpr uint16_t kSnlpAckBodyLen = 122u;         // 136 total - 14 header
 
@@ -45,6 +50,11 @@ void WriteU32LE(uint8_t* dst, size_t& off, uint32_t v) {
     dst[off++] = static_cast<uint8_t>((v >> 16) & 0xFFu);
     dst[off++] = static_cast<uint8_t>((v >> 24) & 0xFFu);
 }
+void WriteU64LE(uint8_t* dst, size_t& off, uint64_t v) {
+    for (unsigned i = 0; i < 8; ++i) {
+        dst[off++] = static_cast<uint8_t>((v >> (8u * i)) & 0xFFu);
+    }
+}
 void WriteU16BE(uint8_t* dst, size_t& off, uint16_t v) {
     dst[off++] = static_cast<uint8_t>((v >> 8) & 0xFFu);
     dst[off++] = static_cast<uint8_t>(v & 0xFFu);
@@ -56,23 +66,6 @@ void WriteU32BE(uint8_t* dst, size_t& off, uint32_t v) {
     dst[off++] = static_cast<uint8_t>(v & 0xFFu);
 }
 
-// Table-free IEEE-802.3 CRC-32, byte-identical to Go's
-// hash/crc32.ChecksumIEEE. Kept inline here so the bouncer doesn't
-// pull void-core/src into its production link set for a 14-line
-// helper.
-uint32_t Crc32Ieee(const uint8_t* data, size_t len) {
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < len; ++i) {
-        crc ^= data[i];
-        for (int b = 0; b < 8; ++b) {
-            const uint32_t mask = static_cast<uint32_t>(
-                -static_cast<int32_t>(crc & 1u));
-            crc = (crc >> 1) ^ (0xEDB88320u & mask);
-        }
-    }
-    return ~crc;
-}
-
 }  // namespace
 
 bool build(const AckInputs& in, uint8_t* out, size_t out_cap) {
@@ -104,10 +97,36 @@ bool build(const AckInputs& in, uint8_t* out, size_t out_cap) {
     out[off++] = 0u;                                              // 131 _pad_c hi
 
     // --- CRC32 over everything written so far (header + body-ex-CRC) ---
-    const uint32_t crc = Crc32Ieee(out, off);
+    const uint32_t crc = crc32_ieee::compute(out, off);
     WriteU32LE(out, off, crc);                                    // 132-135
 
     return off == kPacketAckSize;
 }
 
+bool build_tunnel(const TunnelInputs& in, const security_context::Identity& signer,
+                  uint8_t* out, size_t out_cap) {
+    using Tunnel = snlp::TunnelData_t;
+    static_assert(sizeof(Tunnel) == kEncTunnelSize, "enc_tunnel carries one TunnelData_t");
+    if (out == nullptr || out_cap < kEncTunnelSize || !signer.ready()) return false;
+
+    std::memset(out, 0, kEncTunnelSize);
+    // --- 14-byte SNLP header, APID = Sat A ---
+    if (!frame_dispatch::Codec<frame_dispatch::Tier::kSnlp>::write_header(
+            out, out_cap, kApidSatA, true, 0u, kEncTunnelSize)) {
+        return false;
+    }
+    size_t off = offsetof(Tunnel, block_nonce);                   // 14-15 _pad_a
+    WriteU64LE(out, off, in.block_nonce);                         // 16-23
+    WriteU16LE(out, off, in.cmd_code);                            // 24-25
+    WriteU16LE(out, off, in.ttl);                                 // 26-27
+
+    // --- ground_sig over header..ttl, then the inner CRC ---
+    if (!signer.sign(out, offsetof(Tunnel, ground_sig), out + off)) return false;  // 28-91
+    off = offsetof(Tunnel, crc32);
+    const uint32_t crc = crc32_ieee::compute(out, off);
+    WriteU32LE(out, off, crc);                                    // 92-95
+
+    return off == kEncTunnelSize;
+}
+
 }  // namespace ack_builder
@@ -0,0 +1,208 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      ack_signer.cpp
+ * Desc:      PacketAck signing worker pool (see ack_signer.h).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "ack_signer.h"
+
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace ack_signer {
+
+bool build_signed(const Job& job, const security_context::Identity& id,
+                  uint8_t out[ack_builder::kPacketAckSize]) {
+    ack_builder::AckInputs ack = job.ack;
+    if (!ack_builder::build_tunnel(job.tunnel, id, ack.enc_tunnel, sizeof(ack.enc_tunnel))) {
+        return false;
+    }
+    return ack_builder::build(ack, out, ack_builder::kPacketAckSize);
+}
+
+SignerPool::SignerPool(const security_context::Identity& id)
+    : id_(id), count_(0), next_(0), running_(false), stop_(false), signaled_(false),
+      notify_rd_(-1), notify_wr_(-1), submitted_(0), full_(0), signed_(0), failed_(0),
+      drained_(0) {
+    for (Worker& w : workers_) w.parked.store(false);
+}
+
+SignerPool::~SignerPool() {
+    stop();
+#ifndef _WIN32
+    if (notify_rd_ >= 0) ::close(notify_rd_);
+    if (notify_wr_ >= 0) ::close(notify_wr_);
+#endif
+}
+
+bool SignerPool::start(size_t workers) {
+    if (running_) return false;
+#ifndef _WIN32
+    if (notify_rd_ < 0) {
+        int fds[2];
+        if (::pipe(fds) != 0) return false;
+        for (int fd : fds) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        notify_rd_ = fds[0];
+        notify_wr_ = fds[1];
+    }
+#endif
+    count_ = (workers == 0) ? 1 : (workers > kMaxWorkers ? kMaxWorkers : workers);
+    next_  = 0;
+    stop_.store(false);
+    running_ = true;
+    for (size_t i = 0; i < count_; ++i) {
+        Worker& w = workers_[i];
+        w.thread  = std::thread([this, &w, i]() { run(w, i + 1); });
+    }
+    return true;
+}
+
+void SignerPool::stop() {
+    if (!running_) return;
+    stop_.store(true);
+    for (size_t i = 0; i < count_; ++i) {
+        Worker& w = workers_[i];
+        {
+            std::lock_guard<std::mutex> lock(w.mu);
+        }
+        w.cv.notify_one();
+    }
+    for (size_t i = 0; i < count_; ++i) workers_[i].thread.join();
+    running_ = false;
+}
+
+bool SignerPool::submit(const Job& job) {
+    if (!running_) return false;
+    for (size_t n = 0; n < count_; ++n) {
+        Worker& w = workers_[next_];
+        next_     = (next_ + 1 == count_) ? 0 : next_ + 1;
+        Job* slot = w.jobs.claim();
+        if (slot == nullptr) continue;
+        *slot = job;
+        w.jobs.publish();
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        wake(w);
+        return true;
+    }
+    full_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+size_t SignerPool::drain(DoneFn fn, void* user) {
+    // Clear first: a frame published after this is either seen below or
+    // re-signals the pipe.
+    signaled_.store(false);
+#ifndef _WIN32
+    if (notify_rd_ >= 0) {
+        uint8_t sink[64];
+        while (::read(notify_rd_, sink, sizeof(sink)) > 0) {}
+    }
+#endif
+    size_t n = 0;
+    for (size_t i = 0; i < count_; ++i) {
+        Worker& w = workers_[i];
+        const bool was_full = w.done.size() == kQueueSlots;
+        Done* d;
+        while ((d = w.done.front()) != nullptr) {
+            if (fn != nullptr) fn(*d, user);
+            w.done.release();
+            ++n;
+        }
+        if (was_full) wake(w);  // it may be parked on a full ring
+    }
+    drained_.fetch_add(n, std::memory_order_relaxed);
+    return n;
+}
+
+Stats SignerPool::stats() const {
+    Stats s;
+    s.submitted = submitted_.load(std::memory_order_relaxed);
+    s.full      = full_.load(std::memory_order_relaxed);
+    s.signed_   = signed_.load(std::memory_order_relaxed);
+    s.failed    = failed_.load(std::memory_order_relaxed);
+    s.drained   = drained_.load(std::memory_order_relaxed);
+    return s;
+}
+
+// Pairs with the fence in run(): either the worker sees the new job
+// before sleeping, or we see it parked and wake it.
+void SignerPool::wake(Worker& w) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (w.parked.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(w.mu);
+        w.cv.notify_one();
+    }
+}
+
+// One pipe byte per batch of completions the consumer has not yet
+// drained.
+void SignerPool::notify() {
+    if (signaled_.exchange(true)) return;
+#ifndef _WIN32
+    if (notify_wr_ >= 0) {
+        // A full pipe already reads as ready: nothing to do on EAGAIN.
+        const uint8_t one     = 1;
+        const ssize_t written = ::write(notify_wr_, &one, 1);
+        (void)written;
+    }
+#endif
+}
+
+void SignerPool::run(Worker& w, size_t core) {
+#ifdef __linux__
+    // A core of its own when there are enough; ingest keeps core 0.
+    const unsigned cores = std::thread::hardware_concurrency();
+    if (cores > 1) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core % cores, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void)core;
+#endif
+    for (;;) {
+        Job*  job = w.jobs.front();
+        Done* out = (job != nullptr) ? w.done.claim() : nullptr;
+        if (out != nullptr) {
+            const bool ok = build_signed(*job, id_, out->frame);
+            out->tag = job->tag;
+            out->ok  = ok;
+            w.jobs.release();
+            w.done.publish();
+            signed_.fetch_add(1, std::memory_order_relaxed);
+            if (!ok) failed_.fetch_add(1, std::memory_order_relaxed);
+            notify();
+            continue;
+        }
+        if (stop_.load()) return;
+
+        std::unique_lock<std::mutex> lock(w.mu);
+        w.parked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        job = w.jobs.front();
+        if ((job == nullptr || w.done.claim() == nullptr) && !stop_.load()) {
+            w.cv.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs));
+        }
+        w.parked.store(false, std::memory_order_relaxed);
+    }
+}
+
+} // namespace ack_signer
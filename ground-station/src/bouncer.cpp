@@ -10,50 +10,274 @@
  * -------------------------------------------------------------------------*/
 
 #include "bouncer.h"
+#include <sodium.h>
 #include <cstdio>
 #include <cstring>
 
-Bouncer::Bouncer() {
-    // Zero session key on construction
-    for (size_t i = 0; i < sizeof(_session_key); ++i) {
-        _session_key[i] = 0;
-    }
+#include "crc32_ieee.h"
+#include "frame_dispatch.h"
+
+namespace {
+
+// Little-endian u32 load by explicit shifts — no misaligned struct read.
+uint32_t LoadLE32(const uint8_t* p) {
+    return  static_cast<uint32_t>(p[0])
+         | (static_cast<uint32_t>(p[1]) <<  8)
+         | (static_cast<uint32_t>(p[2]) << 16)
+         | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t LoadLE64(const uint8_t* p) {
+    return static_cast<uint64_t>(LoadLE32(p)) | (static_cast<uint64_t>(LoadLE32(p + 4)) << 32);
+}
+
+using frame_dispatch::Tier;
+using frame_dispatch::TierTraits;
+
+// Offset of enc_payload for whichever tier the frame belongs to.
+size_t EncPayloadOffset(const uint8_t* buf, size_t len) {
+    return (frame_dispatch::detect_tier(buf, len) == Tier::kSnlp)
+               ? offsetof(TierTraits<Tier::kSnlp>::PacketB, enc_payload)
+               : offsetof(TierTraits<Tier::kCcsds>::PacketB, enc_payload);
 }
 
-bool Bouncer::validate_signature(const uint8_t* data, size_t data_len, const uint8_t* signature, size_t sig_len) const {
-    // TODO: Implement Ed25519/PUF signature validation (no heap)
-    (void)data; (void)data_len; (void)signature; (void)sig_len;
+constexpr size_t kEncPayloadSize = sizeof(TierTraits<Tier::kSnlp>::PacketB::enc_payload);
+static_assert(sizeof(TierTraits<Tier::kSnlp>::PacketB::enc_payload) ==
+              sizeof(TierTraits<Tier::kCcsds>::PacketB::enc_payload),
+              "enc_payload must match across tiers");
+
+// Where a PacketB keeps what the decrypt needs.
+struct PayloadRef {
+    Tier     tier;
+    uint32_t sat_id;
+    uint64_t epoch;
+    size_t   enc_offset;
+};
+
+template <Tier T>
+bool PayloadRefAs(const uint8_t* buf, size_t len, PayloadRef* ref) {
+    using PacketB = typename TierTraits<T>::PacketB;
+    if (len < sizeof(PacketB)) return false;
+    *ref = {T, LoadLE32(buf + offsetof(PacketB, sat_id)),
+            LoadLE64(buf + offsetof(PacketB, epoch_ts)), offsetof(PacketB, enc_payload)};
     return true;
 }
 
-bool Bouncer::decrypt_payload(const uint8_t* enc, size_t enc_len, uint8_t* out, size_t out_len) const {
-    // TODO: Implement ChaCha20 decryption (no heap)
-    if (enc_len > out_len) return false;
-    for (size_t i = 0; i < enc_len; ++i) {
-        out[i] = enc[i]; // Demo: copy only
+bool FindPayload(const uint8_t* buf, size_t len, PayloadRef* ref) {
+    if (buf == nullptr) return false;
+    return (frame_dispatch::detect_tier(buf, len) == Tier::kSnlp)
+               ? PayloadRefAs<Tier::kSnlp>(buf, len, ref)
+               : PayloadRefAs<Tier::kCcsds>(buf, len, ref);
+}
+
+}  // namespace
+
+Bouncer::Bouncer() : _sessions(nullptr), _session_clock(nullptr), _clock(nullptr) {
+    clear_sat_keys();
+}
+
+bool Bouncer::register_sat_key(uint32_t sat_id, const uint8_t* pubkey, size_t len) {
+    if (pubkey == nullptr || len != kPubKeySize) return false;
+    SatKey* slot = nullptr;
+    for (size_t i = 0; i < kMaxRegisteredSats; ++i) {
+        if (_keys[i].used && _keys[i].sat_id == sat_id) { slot = &_keys[i]; break; }
+        if (!_keys[i].used && slot == nullptr) slot = &_keys[i];
     }
+    if (slot == nullptr) return false; // registry full
+    slot->sat_id = sat_id;
+    std::memcpy(slot->pub, pubkey, kPubKeySize);
+    slot->used = true;
     return true;
 }
 
-bool Bouncer::process_packet(const uint8_t* buf, size_t len, uint8_t* out, size_t out_max) const {
-    // Example: Check for PacketB_t
-    if (!validate_packet_size<PacketB_t>(buf, len)) {
-        std::puts("[BOUNCER] Invalid packet size for PacketB_t.");
-        return false;
+void Bouncer::clear_sat_keys() {
+    std::memset(_keys, 0, sizeof(_keys));
+}
+
+const uint8_t* Bouncer::find_sat_key(uint32_t sat_id) const {
+    for (size_t i = 0; i < kMaxRegisteredSats; ++i) {
+        if (_keys[i].used && _keys[i].sat_id == sat_id) return _keys[i].pub;
+    }
+    return nullptr;
+}
+
+bool Bouncer::validate_signature(uint32_t sat_id,
+                                 const uint8_t* data, size_t data_len,
+                                 const uint8_t* signature, size_t sig_len) const {
+    if (data == nullptr || signature == nullptr) return false;
+    if (sig_len != crypto_sign_BYTES) return false;
+    const uint8_t* pub = find_sat_key(sat_id);
+    if (pub == nullptr) return false;
+    return crypto_sign_verify_detached(signature, data, data_len, pub) == 0;
+}
+
+BouncerVerdict Bouncer::decrypt_payload(Tier tier, uint32_t sat_id, uint64_t epoch_ts,
+                                        const uint8_t* enc, size_t enc_len,
+                                        uint8_t* out, size_t out_len) const {
+    if (enc == nullptr || out == nullptr || out_len < enc_len) {
+        return BouncerVerdict::kOutputTooSmall;
+    }
+    if (tier == Tier::kSnlp || _sessions == nullptr) {
+        if (out != enc) std::memmove(out, enc, enc_len);
+        return BouncerVerdict::kAccepted;
+    }
+    return _sessions->crypt(sat_id, epoch_ts, enc, enc_len, out, _session_clock())
+               ? BouncerVerdict::kAccepted
+               : BouncerVerdict::kNoSession;
+}
+
+BouncerVerdict Bouncer::decrypt_in_place(uint8_t* buf, size_t len) const {
+    PayloadRef ref;
+    if (!FindPayload(buf, len, &ref)) return BouncerVerdict::kBadSize;
+    uint8_t* enc = buf + ref.enc_offset;
+    return decrypt_payload(ref.tier, ref.sat_id, ref.epoch, enc, kEncPayloadSize,
+                           enc, kEncPayloadSize);
+}
+
+size_t Bouncer::decrypt_batch(const BouncerMutableFrame* frames, size_t count,
+                              BouncerVerdict* verdicts) const {
+    if (frames == nullptr || verdicts == nullptr || count > kMaxBatch) return 0;
+
+    // libsodium has no multi-nonce ChaCha20 entry point, so what batches
+    // is everything around the stream: each sat's key is found, its TTL
+    // checked and its shard locked once for all of its frames, and every
+    // payload is XORed in place through libsodium's own block loop.
+    PayloadRef ref[kMaxBatch];
+    bool       pending[kMaxBatch];
+    for (size_t i = 0; i < count; ++i) {
+        pending[i] = false;
+        if (verdicts[i] != BouncerVerdict::kAccepted) continue;
+        if (!FindPayload(frames[i].buf, frames[i].len, &ref[i])) {
+            verdicts[i] = BouncerVerdict::kBadSize;
+            continue;
+        }
+        if (ref[i].tier == Tier::kSnlp || _sessions == nullptr) continue;  // plaintext
+        // The same buffer listed twice is decrypted once, not XORed back.
+        pending[i] = true;
+        for (size_t j = 0; j < i; ++j) {
+            if (pending[j] && frames[j].buf == frames[i].buf) pending[i] = false;
+        }
     }
-    
-    // Cast only occurs after length validation
-    const PacketB_t* pkt = reinterpret_cast<const PacketB_t*>(buf);
 
-    // 1. Signature Validation
-    if (!validate_signature(buf, len - sizeof(pkt->signature) - sizeof(pkt->global_crc), pkt->signature, sizeof(pkt->signature))) {
-        std::puts("[BOUNCER] Signature validation failed.");
+    const uint64_t now = (_sessions != nullptr) ? _session_clock() : 0;
+    security_context::SessionStore::CryptJob jobs[kMaxBatch];
+    size_t                                   owner[kMaxBatch];
+    for (size_t i = 0; i < count; ++i) {
+        if (!pending[i]) continue;
+        const uint32_t sat = ref[i].sat_id;
+        size_t n = 0;
+        for (size_t j = i; j < count; ++j) {
+            if (!pending[j] || ref[j].sat_id != sat) continue;
+            jobs[n]  = {ref[j].epoch, frames[j].buf + ref[j].enc_offset, kEncPayloadSize};
+            owner[n] = j;
+            ++n;
+            pending[j] = false;
+        }
+        if (!_sessions->crypt_many(sat, jobs, n, now)) {
+            for (size_t k = 0; k < n; ++k) verdicts[owner[k]] = BouncerVerdict::kNoSession;
+        }
+    }
+    // Repeats of a buffer share its verdict.
+    size_t accepted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (verdicts[i] == BouncerVerdict::kAccepted) {
+            for (size_t j = 0; j < i; ++j) {
+                if (frames[j].buf == frames[i].buf) {
+                    verdicts[i] = verdicts[j];
+                    break;
+                }
+            }
+        }
+        if (verdicts[i] == BouncerVerdict::kAccepted) ++accepted;
+    }
+    return accepted;
+}
+
+template <Tier T>
+BouncerVerdict Bouncer::check_frame_as(const uint8_t* buf, size_t len, Admission* adm) const {
+    using PacketB = typename TierTraits<T>::PacketB;
+    // VOID-111 signature scope: header + body up to the signature field.
+    constexpr size_t kSigScope = offsetof(PacketB, signature);
+    constexpr size_t kCrcScope = offsetof(PacketB, global_crc);
+
+    if (!validate_packet_size<PacketB>(buf, len)) {
+        return BouncerVerdict::kBadSize;
+    }
+    if (!frame_dispatch::Codec<T>::template view<PacketB>(buf, len)) {
+        return BouncerVerdict::kBadHeader;
+    }
+
+    // CRC first: a few hundred cycles vs ~50 µs for the Ed25519 verify.
+    const uint32_t crc = LoadLE32(buf + kCrcScope);
+    if (crc32_ieee::compute(buf, kCrcScope) != crc) {
+        return BouncerVerdict::kBadCrc;
+    }
+
+    const uint32_t sat_id = LoadLE32(buf + offsetof(PacketB, sat_id));
+    if (find_sat_key(sat_id) == nullptr) {
+        return BouncerVerdict::kUnknownSat;
+    }
+
+    // Freshness and replay are table lookups, so a replayed frame is
+    // dropped here and never costs a verify.
+    const uint64_t epoch = LoadLE64(buf + offsetof(PacketB, epoch_ts));
+    if (_clock != nullptr) {
+        const uint64_t now = _clock();
+        if ((now > epoch ? now - epoch : epoch - now) > kFreshnessMs) {
+            return BouncerVerdict::kStale;
+        }
+    }
+    const uint8_t tier = static_cast<uint8_t>(T);
+    const replay_window::Check seen = _replay.check(sat_id, tier, epoch, crc);
+    if (seen == replay_window::Check::kReplay) return BouncerVerdict::kReplay;
+    if (seen == replay_window::Check::kFull) return BouncerVerdict::kReplayTableFull;
+
+    if (!validate_signature(sat_id, buf, kSigScope,
+                            buf + offsetof(PacketB, signature),
+                            crypto_sign_BYTES)) {
+        return BouncerVerdict::kBadSignature;
+    }
+    *adm = {sat_id, tier, epoch, crc};
+    return BouncerVerdict::kAccepted;
+}
+
+BouncerVerdict Bouncer::check_frame(const uint8_t* buf, size_t len, Admission* adm) const {
+    if (buf == nullptr) return BouncerVerdict::kBadSize;
+    return (frame_dispatch::detect_tier(buf, len) == Tier::kSnlp)
+               ? check_frame_as<Tier::kSnlp>(buf, len, adm)
+               : check_frame_as<Tier::kCcsds>(buf, len, adm);
+}
+
+BouncerVerdict Bouncer::admit(const Admission& adm) {
+    return _replay.commit(adm.sat_id, adm.tier, adm.epoch, adm.crc)
+               ? BouncerVerdict::kAccepted
+               : BouncerVerdict::kReplayTableFull;
+}
+
+BouncerVerdict Bouncer::admit_copy(const Admission& adm) {
+    const replay_window::Check seen = _replay.check(adm.sat_id, adm.tier, adm.epoch, adm.crc);
+    return (seen == replay_window::Check::kRetransmit) ? admit(adm) : BouncerVerdict::kReplay;
+}
+
+bool Bouncer::process_packet(const uint8_t* buf, size_t len, uint8_t* out, size_t out_max) {
+    // 1. Structure, CRC, replay window and Ed25519 signature against the
+    //    registered key; an accepted epoch_ts is used up from here on.
+    Admission adm = {};
+    BouncerVerdict v = check_frame(buf, len, &adm);
+    if (v == BouncerVerdict::kAccepted) v = admit(adm);
+    if (v != BouncerVerdict::kAccepted) {
+        std::printf("[BOUNCER] PacketB rejected: %s.\n", bouncer_verdict_name(v));
         return false;
     }
 
-    // 2. Decrypt Payload
-    if (!decrypt_payload(pkt->enc_payload, sizeof(pkt->enc_payload), out, out_max)) {
-        std::puts("[BOUNCER] Payload decryption failed.");
+    // Payload is read only after length + CRC + signature validation
+    const uint8_t* enc = buf + EncPayloadOffset(buf, len);
+
+    // 2. Decrypt Payload (ChaCha20 under the sat's session key for CCSDS)
+    v = decrypt_payload(static_cast<Tier>(adm.tier), adm.sat_id, adm.epoch,
+                        enc, kEncPayloadSize, out, out_max);
+    if (v != BouncerVerdict::kAccepted) {
+        std::printf("[BOUNCER] PacketB rejected: %s.\n", bouncer_verdict_name(v));
         return false;
     }
 
@@ -63,12 +287,59 @@ bool Bouncer::process_packet(const uint8_t* buf, size_t len, uint8_t* out, size_
     return true;
 }
 
-void Bouncer::set_session_key(const uint8_t* key, size_t len) {
-    if (len > sizeof(_session_key)) len = sizeof(_session_key);
-    for (size_t i = 0; i < len; ++i) _session_key[i] = key[i];
-    for (size_t i = len; i < sizeof(_session_key); ++i) _session_key[i] = 0;
+size_t Bouncer::process_batch(const BouncerFrame* frames, size_t count,
+                              BouncerVerdict* verdicts) {
+    if (frames == nullptr || verdicts == nullptr || count > kMaxBatch) return 0;
+
+    // libsodium exposes no multi-scalar multiplication, so a randomised
+    // batch equation built from its public point API costs MORE than N
+    // vartime double-scalar verifies. The batch win here is therefore
+    // (a) structural/CRC/registry/replay rejects before any curve math and
+    // (b) one verify per distinct frame: a burst of LoRa retransmits of
+    // the same payment is verified once. Each copy still spends one of
+    // its epoch's retransmits, so a burst cannot slip past the cap.
+    // Per-frame verdicts keep one forged frame from failing its
+    // neighbours.
+    Admission adms[kMaxBatch] = {};
+    size_t    accepted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const BouncerFrame& f = frames[i];
+
+        bool reused = false;
+        if (f.buf != nullptr) {
+            for (size_t j = 0; j < i; ++j) {
+                if (frames[j].buf != nullptr && frames[j].len == f.len &&
+                    std::memcmp(frames[j].buf, f.buf, f.len) == 0) {
+                    verdicts[i] = verdicts[j];
+                    adms[i]     = adms[j];
+                    if (verdicts[i] == BouncerVerdict::kAccepted) verdicts[i] = admit_copy(adms[i]);
+                    reused = true;
+                    break;
+                }
+            }
+        }
+        if (!reused) {
+            verdicts[i] = check_frame(f.buf, f.len, &adms[i]);
+            if (verdicts[i] == BouncerVerdict::kAccepted) verdicts[i] = admit(adms[i]);
+        }
+        if (verdicts[i] == BouncerVerdict::kAccepted) ++accepted;
+    }
+    return accepted;
 }
 
-void Bouncer::clear_session_key() {
-    for (size_t i = 0; i < sizeof(_session_key); ++i) _session_key[i] = 0;
-}
\ No newline at end of file
+const char* bouncer_verdict_name(BouncerVerdict v) {
+    switch (v) {
+        case BouncerVerdict::kAccepted:        return "accepted";
+        case BouncerVerdict::kBadSize:         return "bad-size";
+        case BouncerVerdict::kBadHeader:       return "bad-header";
+        case BouncerVerdict::kBadCrc:          return "bad-crc";
+        case BouncerVerdict::kUnknownSat:      return "unknown-sat";
+        case BouncerVerdict::kStale:           return "stale";
+        case BouncerVerdict::kReplay:          return "replay";
+        case BouncerVerdict::kReplayTableFull: return "replay-table-full";
+        case BouncerVerdict::kBadSignature:    return "bad-signature";
+        case BouncerVerdict::kOutputTooSmall:  return "output-too-small";
+        case BouncerVerdict::kNoSession:       return "no-session";
+    }
+    return "unknown";
+}
@@ -10,203 +10,543 @@
  *            (bare JSON array of records) and extracts the three fields
  *            the bouncer needs: payment_id, settlement_tx_hash,
  *            packet_c_hex. Other fields are parsed over and discarded.
+ *            Also reads the per-record status array of the batch
+ *            endpoints (ingest/batch, egress/ack/batch).
  * Compliant: NSA Clean C++ / SEI CERT
  * -------------------------------------------------------------------------
  * Design notes:
- *  - Linear walk, no heap allocations, no std::string.
+ *  - One pass, no heap allocations, no std::string. The body is read
+ *    in 64-byte blocks; each block is classified with SIMD (SSE2 /
+ *    NEON, scalar elsewhere) into bitmasks of quotes, backslashes and
+ *    structural chars ({ } [ ] : ,). Escaped quotes are removed and a
+ *    prefix-XOR of the remaining quotes masks out everything inside
+ *    strings, so the parser below only ever sees real structure: it
+ *    steps from one set bit to the next and never re-walks a record.
+ *  - Push-driven: PendingStreamParser takes the body in pieces of any
+ *    size (a partial block is padded) and carries the in-string and
+ *    escape bits, the key, and the value being copied across them.
+ *    parse_pending_response() is a one-feed wrapper.
+ *  - Keys are matched at the top level of each record only; values of
+ *    other keys (nested objects included) are stepped over.
  *  - Bounded copy into caller-provided Record buckets; any string
  *    exceeding its bucket length rejects the WHOLE response (fail-closed).
  *  - Escape handling is minimal (pass-through after \\). The gateway
  *    fields we care about are decimal digits / hex / "0x…" — Go's
  *    encoding/json never escapes them. A future change that introduces
  *    quoted chars in these fields needs a parser rev.
- *  - Nested object detection uses a brace-depth counter so a
- *    gracefully-formed but verbose record (e.g. with a nested sub-
- *    object in a future schema) still terminates on the correct }.
  * -------------------------------------------------------------------------*/
 
 #include "egress_json.h"
 
 #include <cstring>
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define EGRESS_JSON_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define EGRESS_JSON_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace egress {
 namespace {
 
-// Skip JSON whitespace (spaces, tabs, newlines, CR). Returns new pos.
-size_t skip_ws(const char* body, size_t pos, size_t end) {
-    while (pos < end) {
-        const char c = body[pos];
-        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
-        ++pos;
-    }
-    return pos;
-}
-
-// Extract a JSON string value. `pos` MUST point at the opening `"`.
-// Copies the body into `out` (bounded by out_max-1 + a trailing NUL).
-// Advances `pos` past the closing quote on success.
-// Returns true on success, false on overflow / unterminated literal.
-bool extract_string(const char* body, size_t& pos, size_t end,
-                    char* out, size_t out_max) {
-    if (out_max == 0) return false;
-    if (pos >= end || body[pos] != '"') return false;
-    ++pos; // skip opening quote
-    size_t written = 0;
-    while (pos < end) {
-        char c = body[pos];
-        if (c == '"') {
-            // Closing quote — terminate output.
-            if (written >= out_max) return false;
-            out[written] = '\0';
-            ++pos;
-            return true;
-        }
-        // Pass-through after backslash (handles \\" in arbitrary JSON,
-        // though the gateway's fields never emit escapes).
-        if (c == '\\' && pos + 1 < end) {
-            ++pos;
-            c = body[pos];
-        }
-        if (written + 1 >= out_max) return false; // overflow (leave room for NUL)
-        out[written] = c;
-        ++written;
-        ++pos;
-    }
-    return false; // unterminated string
-}
-
-// Locate `"<key>"` inside [start, end), step past the colon, and extract
-// the JSON string value into `out`. Scans linearly; O(end-start) per key.
-bool find_and_extract_key(const char* body, size_t start, size_t end,
-                          const char* key_literal,
-                          char* out, size_t out_max) {
-    const size_t key_len = std::strlen(key_literal);
-    size_t pos = start;
-    while (pos < end) {
-        // Advance to the next `"` — might be a key quote or a value quote.
-        while (pos < end && body[pos] != '"') ++pos;
-        if (pos >= end) return false;
-
-        // Check that a full "<key>" fits in the remaining window.
-        if (pos + 1 + key_len + 1 > end) return false;
-
-        if (body[pos + 1 + key_len] == '"' &&
-            std::memcmp(&body[pos + 1], key_literal, key_len) == 0) {
-            // Matched "<key>". Step past the closing quote of the key,
-            // skip ws, expect ':', skip ws, then extract the value.
-            pos += 1 + key_len + 1;
-            pos = skip_ws(body, pos, end);
-            if (pos >= end || body[pos] != ':') return false;
-            ++pos;
-            pos = skip_ws(body, pos, end);
-            return extract_string(body, pos, end, out, out_max);
-        }
-
-        // False positive (different key or value string) — step past
-        // the current quote and keep scanning. Because the quote we
-        // matched might be the OPEN quote of a value (which could
-        // itself contain a `:` that would confuse naive parsers),
-        // advance to the matching closing quote first.
-        ++pos;
-        while (pos < end) {
-            const char c = body[pos];
-            if (c == '\\' && pos + 1 < end) { pos += 2; continue; }
-            if (c == '"') { ++pos; break; }
-            ++pos;
-        }
-    }
-    return false;
-}
-
-// Find the index one past the matching `}` for an object opening at
-// `pos` (which MUST be `{`). Handles quoted strings and escapes so a
-// `}` inside a string doesn't fool the brace counter. Returns
-// body_len on unmatched / unterminated input.
-size_t find_object_end(const char* body, size_t pos, size_t end) {
-    if (pos >= end || body[pos] != '{') return end;
-    int depth = 0;
-    bool in_string = false;
-    while (pos < end) {
-        const char c = body[pos];
-        if (in_string) {
-            if (c == '\\' && pos + 1 < end) { pos += 2; continue; }
-            if (c == '"') in_string = false;
-            ++pos;
-            continue;
-        }
-        if (c == '"')       { in_string = true; ++pos; continue; }
-        else if (c == '{')  { ++depth; }
-        else if (c == '}')  { --depth; if (depth == 0) { return pos + 1; } }
-        ++pos;
-    }
-    return end; // unmatched
+constexpr size_t kBlock = 64;
+
+// One bit per byte of a 64-byte block, bit i = byte i.
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t structural; // { } [ ] : ,
+};
+
+#if defined(EGRESS_JSON_SSE2)
+
+BlockMasks classify(const uint8_t* p) {
+    BlockMasks m = {0, 0, 0};
+    for (unsigned k = 0; k < 4; ++k) {
+        const __m128i v      = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16u * k));
+        const __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20)); // '[' → '{', ']' → '}'
+        const __m128i s = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                         _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')),
+                         _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+        const unsigned shift = 16u * k;
+        m.quote |= static_cast<uint64_t>(
+                       _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))))
+                   << shift;
+        m.backslash |= static_cast<uint64_t>(
+                           _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))
+                       << shift;
+        m.structural |= static_cast<uint64_t>(_mm_movemask_epi8(s)) << shift;
+    }
+    return m;
+}
+
+#elif defined(EGRESS_JSON_NEON)
+
+// NEON has no movemask: weight each lane by its bit and add pairwise.
+uint64_t to_bitmask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) {
+    static const uint8_t kWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                         1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t w = vld1q_u8(kWeights);
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, w), vandq_u8(m1, w));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, w), vandq_u8(m3, w));
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+BlockMasks classify(const uint8_t* p) {
+    uint8x16_t q[4], b[4], s[4];
+    for (unsigned k = 0; k < 4; ++k) {
+        const uint8x16_t v      = vld1q_u8(p + 16u * k);
+        const uint8x16_t folded = vorrq_u8(v, vdupq_n_u8(0x20));
+        q[k] = vceqq_u8(v, vdupq_n_u8('"'));
+        b[k] = vceqq_u8(v, vdupq_n_u8('\\'));
+        s[k] = vorrq_u8(vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')),
+                                 vceqq_u8(folded, vdupq_n_u8('}'))),
+                        vorrq_u8(vceqq_u8(v, vdupq_n_u8(':')),
+                                 vceqq_u8(v, vdupq_n_u8(','))));
+    }
+    BlockMasks m;
+    m.quote      = to_bitmask(q[0], q[1], q[2], q[3]);
+    m.backslash  = to_bitmask(b[0], b[1], b[2], b[3]);
+    m.structural = to_bitmask(s[0], s[1], s[2], s[3]);
+    return m;
+}
+
+#else
+
+BlockMasks classify(const uint8_t* p) {
+    BlockMasks m = {0, 0, 0};
+    for (unsigned i = 0; i < kBlock; ++i) {
+        const uint64_t bit = uint64_t{1} << i;
+        switch (p[i]) {
+        case '"':  m.quote |= bit; break;
+        case '\\': m.backslash |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',':
+            m.structural |= bit;
+            break;
+        default: break;
+        }
+    }
+    return m;
+}
+
+#endif
+
+// Bit i set ⇔ an odd number of bits at or below i are set in `x`. On
+// the quote mask this marks every byte from an opening quote up to
+// (not including) its closing quote.
+uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Bytes escaped by a backslash in a block of `n` valid bytes. Rare (the
+// gateway never escapes the fields we read), so a bit loop rather than
+// the branch-free trick. A backslash in the last byte escapes the first
+// byte of the next block (or feed) via `carry`.
+uint64_t escaped_bits(uint64_t backslash, uint64_t& carry, size_t n) {
+    const uint64_t last = uint64_t{1} << (n - 1u);
+    uint64_t escaped = carry;
+    carry = 0;
+    while (backslash != 0) {
+        const uint64_t bit = backslash & (~backslash + 1u);
+        backslash ^= bit;
+        if ((escaped & bit) != 0) continue; // "\\\\": the second one is literal
+        if (bit == last) {
+            carry = 1;
+        } else {
+            escaped |= bit << 1;
+        }
+    }
+    return escaped;
+}
+
+bool is_ws(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+bool only_ws(const char* s, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (!is_ws(s[i])) return false;
+    }
+    return true;
+}
+
+// Keys we extract from each record. kOther covers everything else.
+enum class Field : uint8_t { kOther, kPaymentId, kTxHash, kPacketCHex, kSeq };
+
+Field match_key(const char* key, size_t len) {
+    switch (len) {
+    case 3:  return std::memcmp(key, "seq", 3) == 0 ? Field::kSeq : Field::kOther;
+    case 10: return std::memcmp(key, "payment_id", 10) == 0 ? Field::kPaymentId : Field::kOther;
+    case 12: return std::memcmp(key, "packet_c_hex", 12) == 0 ? Field::kPacketCHex : Field::kOther;
+    case 18:
+        return std::memcmp(key, "settlement_tx_hash", 18) == 0 ? Field::kTxHash : Field::kOther;
+    default: return Field::kOther;
+    }
+}
+
+uint8_t field_bit(Field f) { return static_cast<uint8_t>(1u << static_cast<unsigned>(f)); }
+
+constexpr uint8_t kRequiredFields = (1u << static_cast<unsigned>(Field::kPaymentId)) |
+                                    (1u << static_cast<unsigned>(Field::kTxHash)) |
+                                    (1u << static_cast<unsigned>(Field::kPacketCHex));
+
+// parse_pending_response()'s sink: copy into the caller's array and
+// stop once it is full.
+struct Collector {
+    Record* out;
+    size_t  cap;
+    size_t  count;
+};
+
+bool collect(const Record& rec, void* user) {
+    Collector* c = static_cast<Collector*>(user);
+    c->out[c->count++] = rec;
+    return c->count < c->cap;
 }
 
 } // anonymous namespace
 
-int parse_pending_response(const char* body,
-                           size_t      body_len,
-                           Record*     out,
-                           size_t      max_records) {
-    if (!body || body_len == 0 || !out || max_records == 0) return -1;
+PendingStreamParser::PendingStreamParser(OnRecord on_record, void* user)
+    : on_record_(on_record), user_(user), status_(Status::kMore), state_(State::kArrayOpen),
+      records_(0), in_string_(0), escape_carry_(0), found_(0), field_(0), depth_(0),
+      key_len_(0), out_(nullptr), out_cap_(0), out_len_(0), escape_(false),
+      scalar_seen_(false), scalar_bad_(false), scalar_done_(false) {
+    rec_.payment_id[0]         = '\0';
+    rec_.settlement_tx_hash[0] = '\0';
+    rec_.packet_c_hex[0]       = '\0';
+    rec_.seq                   = 0;
+}
 
-    size_t pos = skip_ws(body, 0, body_len);
-    if (pos >= body_len || body[pos] != '[') return -1;
-    ++pos;
-    pos = skip_ws(body, pos, body_len);
+PendingStreamParser::Status PendingStreamParser::feed(const char* data, size_t len) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t base = 0; status_ == Status::kMore && base < len; base += kBlock) {
+        const size_t n = len - base < kBlock ? len - base : kBlock;
+        BlockMasks m;
+        if (n == kBlock) {
+            m = classify(bytes + base);
+        } else {
+            uint8_t tail[kBlock];
+            std::memset(tail, ' ', sizeof(tail));
+            std::memcpy(tail, bytes + base, n);
+            m = classify(tail);
+        }
+        const uint64_t quotes = m.quote & ~escaped_bits(m.backslash, escape_carry_, n);
+        const uint64_t inside = prefix_xor(quotes) ^ (uint64_t{0} - in_string_);
+        in_string_ = (inside >> (n - 1u)) & 1u;
+        uint64_t bits = (m.structural & ~inside) | quotes; // padding is ' ': no bits past n
 
-    // Empty array — 0 records, valid response.
-    if (pos < body_len && body[pos] == ']') return 0;
+        const char* block = data + base;
+        size_t      prev  = 0;
+        while (bits != 0) {
+            const size_t pos = static_cast<size_t>(__builtin_ctzll(bits));
+            bits &= bits - 1u;
+            if (!on_structural(block[pos], block + prev, pos - prev)) return status_;
+            prev = pos + 1;
+        }
+        absorb(block + prev, n - prev);
+    }
+    return status_;
+}
 
-    size_t count = 0;
-    while (pos < body_len) {
-        pos = skip_ws(body, pos, body_len);
-        if (pos >= body_len || body[pos] != '{') return -1;
+// Bytes between two structural chars, possibly split over blocks and
+// feeds: key text, string value text, a scalar, or whitespace.
+void PendingStreamParser::absorb(const char* s, size_t n) {
+    if (n == 0) return;
+    switch (state_) {
+    case State::kKeyClose:
+        if (key_len_ + n > kKeyMax) {
+            key_len_ = kKeyMax + 1; // matches no key
+        } else {
+            std::memcpy(key_ + key_len_, s, n);
+            key_len_ += n;
+        }
+        return;
+
+    case State::kStringClose:
+        if (out_ == nullptr) return;
+        if (!escape_ && std::memchr(s, '\\', n) == nullptr) {
+            if (out_len_ + n >= out_cap_) return fail();
+            std::memcpy(out_ + out_len_, s, n);
+            out_len_ += n;
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (!escape_ && s[i] == '\\') { // drop the backslash, keep what it escapes
+                escape_ = true;
+                continue;
+            }
+            escape_ = false;
+            if (out_len_ + 1 >= out_cap_) return fail();
+            out_[out_len_++] = s[i];
+        }
+        return;
+
+    case State::kNested:
+        return;
 
-        const size_t obj_start = pos;
-        const size_t obj_end   = find_object_end(body, pos, body_len);
-        if (obj_end >= body_len && (obj_end == body_len && body[body_len - 1] != '}')) {
-            return -1;
+    case State::kValue: {
+        // Scalar (number / true / null) up to the next ',' or '}'.
+        if (static_cast<Field>(field_) != Field::kSeq) {
+            if (!scalar_seen_) scalar_seen_ = !only_ws(s, n);
+            return;
+        }
+        uint64_t seq  = rec_.seq;
+        bool     seen = scalar_seen_;
+        bool     bad  = scalar_bad_;
+        bool     done = scalar_done_;
+        for (size_t i = 0; i < n; ++i) {
+            const char c = s[i];
+            if (is_ws(c)) {
+                done = seen;
+                continue;
+            }
+            seen = true;
+            const uint64_t d = static_cast<uint64_t>(c - '0');
+            if (done || c < '0' || c > '9' || seq > (UINT64_MAX - d) / 10u) {
+                bad = true;
+                continue;
+            }
+            seq = seq * 10u + d;
         }
-        if (obj_end == body_len) return -1;
+        rec_.seq     = seq;
+        scalar_seen_ = seen;
+        scalar_bad_  = bad;
+        scalar_done_ = done;
+        return;
+    }
 
-        Record& r = out[count];
-        // Zero each bucket's first byte so partial-extract still leaves
-        // a valid C string.
-        r.payment_id[0]         = '\0';
-        r.settlement_tx_hash[0] = '\0';
-        r.packet_c_hex[0]       = '\0';
+    default:
+        // Between tokens only whitespace may precede the next
+        // structural char.
+        if (!only_ws(s, n)) fail();
+        return;
+    }
+}
 
-        if (!find_and_extract_key(body, obj_start, obj_end, "payment_id",
-                                  r.payment_id, EgressPaymentIdMaxLen))
-            return -1;
-        if (!find_and_extract_key(body, obj_start, obj_end, "settlement_tx_hash",
-                                  r.settlement_tx_hash, EgressTxHashMaxLen))
-            return -1;
-        if (!find_and_extract_key(body, obj_start, obj_end, "packet_c_hex",
-                                  r.packet_c_hex, EgressPacketCHexMaxLen))
-            return -1;
+// A scalar value ended at ',' or '}'; `seq` is the only one we keep.
+bool PendingStreamParser::end_scalar() {
+    const Field f = static_cast<Field>(field_);
+    if (f == Field::kSeq) {
+        if (!scalar_seen_ || scalar_bad_) return false;
+        found_ |= field_bit(f);
+    } else if (f != Field::kOther || !scalar_seen_) {
+        return false;
+    }
+    state_ = State::kAfterValue;
+    return true;
+}
 
-        ++count;
-        pos = obj_end;
+bool PendingStreamParser::end_record() {
+    if ((found_ & kRequiredFields) != kRequiredFields) return false;
+    ++records_;
+    if (on_record_ != nullptr && !on_record_(rec_, user_)) status_ = Status::kStopped;
+    state_ = State::kAfterRecord;
+    return true;
+}
 
-        // Cap reached — stop even if more records remain.
-        if (count >= max_records) {
-            return static_cast<int>(count);
+// `gap` is what lies between the previous structural char and `c`
+// within this block. Returns false once parsing ends (error, stop or
+// the closing ']').
+bool PendingStreamParser::on_structural(char c, const char* gap, size_t gap_len) {
+    const char* key     = gap; // the whole key is in this block: match it in place
+    size_t      key_len = gap_len;
+    if (state_ != State::kKeyClose || key_len_ != 0) {
+        absorb(gap, gap_len);
+        if (status_ != Status::kMore) return false;
+        key     = key_;
+        key_len = key_len_;
+    }
+
+    if (state_ == State::kValue && (c == ',' || c == '}')) {
+        // The scalar ends here; the switch then treats `c` as the
+        // char after the value.
+        if (!end_scalar()) {
+            fail();
+            return false;
         }
+    } else if (state_ == State::kValue && scalar_seen_) {
+        fail(); // e.g. `12"x"`
+        return false;
+    }
 
-        pos = skip_ws(body, pos, body_len);
-        if (pos >= body_len) return -1;
-        if (body[pos] == ',') {
-            ++pos;
-            continue;
+    bool ok = true;
+    switch (state_) {
+    case State::kArrayOpen:
+        ok     = c == '[';
+        state_ = State::kFirstRecord;
+        break;
+
+    case State::kFirstRecord:
+    case State::kRecord:
+        if (c == ']' && state_ == State::kFirstRecord) {
+            status_ = Status::kDone;
+            break;
         }
-        if (body[pos] == ']') {
-            return static_cast<int>(count);
+        ok = c == '{';
+        rec_.payment_id[0]         = '\0';
+        rec_.settlement_tx_hash[0] = '\0';
+        rec_.packet_c_hex[0]       = '\0';
+        rec_.seq                   = 0;
+        found_ = 0;
+        state_ = State::kFirstKey;
+        break;
+
+    case State::kFirstKey:
+    case State::kKey:
+        ok       = c == '"'; // includes "{}", which lacks the required fields
+        key_len_ = 0;
+        state_   = State::kKeyClose;
+        break;
+
+    case State::kKeyClose: {
+        ok = c == '"';
+        Field f = match_key(key, key_len); // an overlong key_len_ matches nothing
+        if ((found_ & field_bit(f)) != 0) f = Field::kOther; // first one wins
+        field_ = static_cast<uint8_t>(f);
+        state_ = State::kColon;
+        break;
+    }
+
+    case State::kColon:
+        ok           = c == ':';
+        scalar_seen_ = false;
+        scalar_bad_  = false;
+        scalar_done_ = false;
+        state_       = State::kValue;
+        break;
+
+    case State::kValue: // a ',' / '}' here was handled above
+        if (c == '"') {
+            switch (static_cast<Field>(field_)) {
+            case Field::kPaymentId:
+                out_     = rec_.payment_id;
+                out_cap_ = EgressPaymentIdMaxLen;
+                break;
+            case Field::kTxHash:
+                out_     = rec_.settlement_tx_hash;
+                out_cap_ = EgressTxHashMaxLen;
+                break;
+            case Field::kPacketCHex:
+                out_     = rec_.packet_c_hex;
+                out_cap_ = EgressPacketCHexMaxLen;
+                break;
+            case Field::kSeq: // a quoted cursor is malformed
+                ok = false;
+                break;
+            case Field::kOther:
+                out_ = nullptr;
+                break;
+            }
+            out_len_ = 0;
+            escape_  = false;
+            state_   = State::kStringClose;
+        } else if (c == '{' || c == '[') {
+            ok     = static_cast<Field>(field_) == Field::kOther;
+            depth_ = 1;
+            state_ = State::kNested;
+        } else {
+            ok = false;
         }
-        return -1;
+        break;
+
+    case State::kStringClose:
+        ok = c == '"';
+        if (out_ != nullptr) out_[out_len_] = '\0';
+        found_ |= field_bit(static_cast<Field>(field_));
+        state_ = State::kAfterValue;
+        break;
+
+    case State::kNested:
+        if (c == '{' || c == '[') {
+            ++depth_;
+        } else if ((c == '}' || c == ']') && --depth_ == 0) {
+            state_ = State::kAfterValue;
+        }
+        break;
+
+    case State::kAfterValue:
+        if (c == ',') {
+            state_ = State::kKey;
+        } else {
+            ok = c == '}' && end_record();
+        }
+        break;
+
+    case State::kAfterRecord:
+        if (c == ',') {
+            state_ = State::kRecord;
+        } else {
+            ok      = c == ']';
+            status_ = Status::kDone;
+        }
+        break;
+    }
+    if (!ok) {
+        fail();
+        return false;
+    }
+    return status_ == Status::kMore;
+}
+
+int parse_pending_response(const char* body,
+                           size_t      body_len,
+                           Record*     out,
+                           size_t      max_records) {
+    if (!body || body_len == 0 || !out || max_records == 0) return -1;
+
+    Collector           c = {out, max_records, 0};
+    PendingStreamParser parser(&collect, &c);
+    switch (parser.feed(body, body_len)) {
+    case PendingStreamParser::Status::kDone:
+    case PendingStreamParser::Status::kStopped: // cap reached — more records may remain
+        return static_cast<int>(c.count);
+    case PendingStreamParser::Status::kMore:    // ran out mid-array (includes an unterminated string)
+    case PendingStreamParser::Status::kError:
+        break;
     }
     return -1;
 }
 
+int parse_batch_results(const char* json, size_t len, int* out, size_t cap) {
+    static const char kKey[] = "\"results\"";
+    const size_t klen = sizeof(kKey) - 1;
+    size_t i = 0;
+    while (i + klen <= len && std::memcmp(json + i, kKey, klen) != 0) ++i;
+    if (i + klen > len) return -1;
+    i += klen;
+    while (i < len && (json[i] == ' ' || json[i] == ':')) ++i;
+    if (i >= len || json[i] != '[') return -1;
+    ++i;
+
+    size_t n = 0;
+    for (;;) {
+        while (i < len && json[i] == ' ') ++i;
+        if (i < len && json[i] == ']') return static_cast<int>(n);
+        if (n == cap) return -1;
+        int v = 0;
+        size_t digits = 0;
+        while (i < len && json[i] >= '0' && json[i] <= '9' && digits < 4) {
+            v = v * 10 + (json[i] - '0');
+            ++i;
+            ++digits;
+        }
+        if (digits == 0) return -1;
+        out[n++] = v;
+        while (i < len && json[i] == ' ') ++i;
+        if (i < len && json[i] == ',') { ++i; continue; }
+        if (i < len && json[i] == ']') return static_cast<int>(n);
+        return -1;
+    }
+}
+
 } // namespace egress
@@ -5,8 +5,9 @@
  * License:   Apache 2.0
  * Status:    Authenticated Clean Room Spec
  * File:      egress_poll_client.cpp
- * Desc:      Raw-socket HTTP/1.1 client for the VOID-138 bouncer
- *            egress path. Talks to the gateway's VOID-135b endpoints.
+ * Desc:      HTTP/1.1 client for the VOID-138 bouncer egress path.
+ *            Talks to the gateway's VOID-135b endpoints over the
+ *            shared keep-alive connection pool.
  * Compliant: NSA Clean C++ / SEI CERT
  * -------------------------------------------------------------------------*/
 
@@ -15,263 +16,65 @@
 #include <cstdio>
 #include <cstring>
 
-// Cross-platform socket headers — same split the existing
-// gateway_client.cpp uses.
-#ifdef _WIN32
-    #include <winsock2.h>
-    #include <ws2tcpip.h>
-    #pragma comment(lib, "ws2_32.lib")
-#else
-    #include <sys/socket.h>
-    #include <arpa/inet.h>
-    #include <unistd.h>
-#endif
-
 namespace egress {
 namespace {
 
 // Request header buffer. 512 B is ample for our two fixed request
-// shapes: a GET with no body (~180 B) and a POST with a small JSON
-// body (~320 B).
+// shapes: a GET with no body (~150 B) and a POST with a small JSON
+// body (~300 B).
 constexpr size_t REQ_BUF_SIZE  = 512;
 
-// Temp buffer for a single recv() call on the response stream.
-// 2 KiB covers headers + a modest body slice per read; we loop until
-// the socket closes or the body_cap is reached.
-constexpr size_t RECV_CHUNK    = 2048;
-
-// HTTP response size guard — if the total bytes received from a
-// single response exceed this, we bail to avoid a pathological
-// gateway feeding the bouncer unbounded data. 64 KiB is 10x the
-// largest legitimate /pending response (10 records × ~500 B each).
-constexpr size_t RESP_CAP      = 64 * 1024;
-
-// Connect a blocking TCP socket to host:port. Returns the fd or -1.
-// Caller closes.
-int connect_to(const char* host, uint16_t port) {
-#ifdef _WIN32
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return -1;
-#endif
-    int fd = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
-    if (fd < 0) return -1;
-
-    sockaddr_in addr;
-    std::memset(&addr, 0, sizeof(addr));
-    addr.sin_family = AF_INET;
-    addr.sin_port   = htons(port);
-    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
-#ifdef _WIN32
-        closesocket(fd);
-#else
-        ::close(fd);
-#endif
-        return -1;
-    }
-
-    if (::connect(fd,
-                  reinterpret_cast<sockaddr*>(&addr),
-                  sizeof(addr)) < 0) {
-#ifdef _WIN32
-        closesocket(fd);
-#else
-        ::close(fd);
-#endif
-        return -1;
-    }
-    return fd;
-}
-
-void close_fd(int fd) {
-#ifdef _WIN32
-    closesocket(fd);
-#else
-    ::close(fd);
-#endif
-}
-
-// Bounded strtoi for Content-Length / status-code lines. Reads decimal
-// digits up to `max_chars`, stops at first non-digit, stores into
-// `out`. Returns bytes consumed; -1 if no digits read.
-int parse_decimal(const char* s, size_t max_chars, size_t& out) {
-    size_t v = 0;
-    size_t i = 0;
-    while (i < max_chars && s[i] >= '0' && s[i] <= '9') {
-        v = v * 10u + static_cast<size_t>(s[i] - '0');
-        ++i;
-    }
-    if (i == 0) return -1;
-    out = v;
-    return static_cast<int>(i);
-}
-
-// Parse "HTTP/1.1 <code> <reason>\r\n" — returns the numeric code.
-// Returns -1 on malformed input.
-int parse_status_line(const char* buf, size_t len) {
-    // Accept HTTP/1.0 and HTTP/1.1.
-    const char* prefix10 = "HTTP/1.0 ";
-    const char* prefix11 = "HTTP/1.1 ";
-    if (len < 12) return -1;
-    if (std::memcmp(buf, prefix10, 9) != 0 &&
-        std::memcmp(buf, prefix11, 9) != 0) {
-        return -1;
-    }
-    size_t code = 0;
-    int consumed = parse_decimal(&buf[9], len - 9, code);
-    if (consumed <= 0) return -1;
-    return static_cast<int>(code);
-}
-
-// Find the end of the HTTP header block (CRLFCRLF). Returns offset
-// one past the terminator, or 0 if not found.
-size_t find_header_end(const uint8_t* buf, size_t len) {
-    for (size_t i = 0; i + 3 < len; ++i) {
-        if (buf[i]   == '\r' && buf[i+1] == '\n' &&
-            buf[i+2] == '\r' && buf[i+3] == '\n') {
-            return i + 4;
-        }
-    }
-    return 0;
-}
-
-// Scan the headers for "Content-Length: <n>". Returns true + sets
-// `len` on match; false if the header isn't present (we'll read
-// until EOF in that case).
-bool parse_content_length(const uint8_t* hdr, size_t hdr_len, size_t& len) {
-    const char* needle = "Content-Length:";
-    const size_t nlen  = std::strlen(needle);
-    for (size_t i = 0; i + nlen < hdr_len; ++i) {
-        bool match = true;
-        for (size_t j = 0; j < nlen; ++j) {
-            const char c = static_cast<char>(hdr[i + j]);
-            const char n = needle[j];
-            // Case-insensitive compare for the ASCII letters; header
-            // names are case-insensitive per RFC 7230.
-            char cl = c, nl = n;
-            if (cl >= 'A' && cl <= 'Z') cl = static_cast<char>(cl - 'A' + 'a');
-            if (nl >= 'A' && nl <= 'Z') nl = static_cast<char>(nl - 'A' + 'a');
-            if (cl != nl) { match = false; break; }
-        }
-        if (!match) continue;
-        size_t p = i + nlen;
-        while (p < hdr_len && (hdr[p] == ' ' || hdr[p] == '\t')) ++p;
-        size_t n = 0;
-        int c = parse_decimal(reinterpret_cast<const char*>(&hdr[p]),
-                              hdr_len - p, n);
-        if (c <= 0) return false;
-        len = n;
-        return true;
-    }
-    return false;
-}
-
-// Send a whole buffer, looping past short writes.
-bool send_all(int fd, const char* buf, size_t len) {
-    size_t off = 0;
-    while (off < len) {
-        ssize_t w = ::send(fd, buf + off, len - off, 0);
-        if (w <= 0) return false;
-        off += static_cast<size_t>(w);
-    }
-    return true;
-}
-
-// Read the whole response into `resp` (capped at RESP_CAP). Returns
-// the number of bytes read, or SIZE_MAX on error / overflow.
-size_t read_full_response(int fd, uint8_t* resp, size_t resp_cap) {
-    size_t total = 0;
-    while (total < resp_cap) {
-        uint8_t chunk[RECV_CHUNK];
-        ssize_t r = ::recv(fd, reinterpret_cast<char*>(chunk),
-                           sizeof(chunk), 0);
-        if (r < 0) return static_cast<size_t>(-1); // transport error
-        if (r == 0) break;                         // peer closed
-        if (total + static_cast<size_t>(r) > resp_cap) {
-            return static_cast<size_t>(-1);        // too big
-        }
-        std::memcpy(&resp[total], chunk, static_cast<size_t>(r));
-        total += static_cast<size_t>(r);
-    }
-    return total;
-}
+// Batch ACK body: per item ~45 B of JSON punctuation/keys plus the two
+// bounded fields (Record buckets, 96 + 80) — 16 items fit in 4 KiB.
+constexpr size_t ACK_BATCH_BODY_SIZE =
+    EgressAckBatchMax * (EgressPaymentIdMaxLen + EgressTxHashMaxLen + 48);
 
-// Shared HTTP round-trip engine. Sends `req` on a fresh socket, reads
-// the response, parses status + body. Writes the body into `body` (up
-// to `body_cap`) on success.
-//
-// If body size exceeds body_cap, returns false (no silent truncation).
-bool do_round_trip(const char* host,
-                   uint16_t    port,
-                   const char* req,
-                   size_t      req_len,
-                   uint8_t*    body,
-                   size_t      body_cap,
-                   size_t&     body_len,
-                   int&        status_code) {
-    int fd = connect_to(host, port);
-    if (fd < 0) return false;
+} // anonymous namespace
 
-    if (!send_all(fd, req, req_len)) {
-        close_fd(fd);
-        return false;
-    }
+// ---------------------------------------------------------------------------
 
-    uint8_t resp[RESP_CAP];
-    const size_t n = read_full_response(fd, resp, sizeof(resp));
-    close_fd(fd);
-    if (n == static_cast<size_t>(-1)) return false;
-    if (n < 12) return false; // too short for "HTTP/1.1 xxx"
+EgressPollClient::EgressPollClient(const char* host, uint16_t port)
+    : own_pool_(host, port), pool_(own_pool_) {}
 
-    // Parse status.
-    status_code = parse_status_line(
-        reinterpret_cast<const char*>(resp), n);
-    if (status_code < 0) return false;
+EgressPollClient::EgressPollClient(http_pool::ConnectionPool& shared)
+    : own_pool_(shared.host(), shared.port()), pool_(shared) {}
 
-    // Find header terminator.
-    const size_t body_off = find_header_end(resp, n);
-    if (body_off == 0) return false;
-    const size_t body_bytes = n - body_off;
+bool EgressPollClient::fetch_pending(http_pool::BodySink sink,
+                                     void*               user,
+                                     int&                status_code) {
+    if (sink == nullptr) return false;
 
-    // Check Content-Length if present — if it disagrees with the
-    // bytes actually received, bail.
-    size_t advertised = 0;
-    if (parse_content_length(resp, body_off, advertised)) {
-        if (advertised != body_bytes) return false;
-    }
+    char req[REQ_BUF_SIZE];
+    const int n = std::snprintf(req, sizeof(req),
+        "GET /api/v1/egress/pending?limit=%zu HTTP/1.1\r\n"
+        "Host: %s:%u\r\n"
+        "Accept: application/json\r\n\r\n",
+        EgressStreamPageMax, pool_.host(), static_cast<unsigned>(pool_.port()));
+    if (n < 0 || static_cast<size_t>(n) >= sizeof(req)) return false;
 
-    if (body_bytes > body_cap) return false; // no silent truncation
-    if (body != nullptr && body_bytes > 0) {
-        std::memcpy(body, &resp[body_off], body_bytes);
-    }
-    body_len = body_bytes;
-    return true;
+    return pool_.round_trip_stream(req, static_cast<size_t>(n), nullptr, 0,
+                                   sink, user, status_code);
 }
 
-} // anonymous namespace
-
-// ---------------------------------------------------------------------------
-
-EgressPollClient::EgressPollClient(const char* host, uint16_t port)
-    : host_(host), port_(port) {}
-
-bool EgressPollClient::fetch_pending(uint8_t* body,
-                                     size_t   body_cap,
-                                     size_t&  body_len,
-                                     int&     status_code) {
-    if (body == nullptr || body_cap == 0) return false;
+bool EgressPollClient::watch_pending(uint64_t            after,
+                                     uint32_t            wait_ms,
+                                     http_pool::BodySink sink,
+                                     void*               user,
+                                     int&                status_code) {
+    if (sink == nullptr) return false;
+    if (wait_ms > EgressWatchMaxWaitMs) wait_ms = EgressWatchMaxWaitMs;
 
     char req[REQ_BUF_SIZE];
     const int n = std::snprintf(req, sizeof(req),
-        "GET /api/v1/egress/pending HTTP/1.1\r\n"
+        "GET /api/v1/egress/watch?after=%llu&wait_ms=%u&limit=%zu HTTP/1.1\r\n"
         "Host: %s:%u\r\n"
-        "Accept: application/json\r\n"
-        "Connection: close\r\n\r\n",
-        host_, static_cast<unsigned>(port_));
+        "Accept: application/json\r\n\r\n",
+        static_cast<unsigned long long>(after), static_cast<unsigned>(wait_ms),
+        EgressStreamPageMax, pool_.host(), static_cast<unsigned>(pool_.port()));
     if (n < 0 || static_cast<size_t>(n) >= sizeof(req)) return false;
 
-    return do_round_trip(host_, port_,
-                         req, static_cast<size_t>(n),
-                         body, body_cap, body_len, status_code);
+    return pool_.round_trip_stream(req, static_cast<size_t>(n), nullptr, 0,
+                                   sink, user, status_code);
 }
 
 bool EgressPollClient::ack_dispatched(const char* payment_id,
@@ -291,18 +94,64 @@ bool EgressPollClient::ack_dispatched(const char* payment_id,
         "POST /api/v1/egress/ack HTTP/1.1\r\n"
         "Host: %s:%u\r\n"
         "Content-Type: application/json\r\n"
-        "Content-Length: %d\r\n"
-        "Connection: close\r\n\r\n"
+        "Content-Length: %d\r\n\r\n"
         "%s",
-        host_, static_cast<unsigned>(port_), jn, json);
+        pool_.host(), static_cast<unsigned>(pool_.port()), jn, json);
     if (n < 0 || static_cast<size_t>(n) >= sizeof(req)) return false;
 
     uint8_t sink[1024];
     size_t  sink_len = 0;
-    return do_round_trip(host_, port_,
-                         req, static_cast<size_t>(n),
-                         sink, sizeof(sink),
-                         sink_len, status_code);
+    return pool_.round_trip(req, static_cast<size_t>(n), nullptr, 0,
+                            sink, sizeof(sink), sink_len, status_code);
+}
+
+bool EgressPollClient::ack_dispatched_batch(const AckItem* items,
+                                            size_t         n,
+                                            int*           results,
+                                            int&           status_code) {
+    if (items == nullptr || results == nullptr || n == 0 || n > EgressAckBatchMax) {
+        return false;
+    }
+
+    char   json[ACK_BATCH_BODY_SIZE];
+    size_t jn = 0;
+    json[jn++] = '[';
+    for (size_t i = 0; i < n; ++i) {
+        if (items[i].payment_id == nullptr || items[i].settlement_tx_hash == nullptr) {
+            return false;
+        }
+        const int w = std::snprintf(json + jn, sizeof(json) - jn,
+            "%s{\"payment_id\":\"%s\",\"settlement_tx_hash\":\"%s\"}",
+            i == 0 ? "" : ",", items[i].payment_id, items[i].settlement_tx_hash);
+        if (w < 0 || static_cast<size_t>(w) >= sizeof(json) - jn) return false;
+        jn += static_cast<size_t>(w);
+    }
+    if (jn + 1 >= sizeof(json)) return false;
+    json[jn++] = ']';
+
+    char req[REQ_BUF_SIZE];
+    const int hn = std::snprintf(req, sizeof(req),
+        "POST /api/v1/egress/ack/batch HTTP/1.1\r\n"
+        "Host: %s:%u\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: %zu\r\n\r\n",
+        pool_.host(), static_cast<unsigned>(pool_.port()), jn);
+    if (hn < 0 || static_cast<size_t>(hn) >= sizeof(req)) return false;
+
+    uint8_t resp[1024];
+    size_t  resp_len = 0;
+    int     status   = 0;
+    if (!pool_.round_trip(req, static_cast<size_t>(hn),
+                          reinterpret_cast<const uint8_t*>(json), jn,
+                          resp, sizeof(resp), resp_len, status)) {
+        return false;
+    }
+    status_code = status;
+    if (status != 200) return true;
+
+    const int got = parse_batch_results(reinterpret_cast<const char*>(resp), resp_len,
+                                        results, n);
+    return got == static_cast<int>(n);
 }
 
-} // namespace egress
\ No newline at end of file
+} // namespace egress
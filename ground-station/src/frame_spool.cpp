@@ -0,0 +1,554 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      frame_spool.cpp
+ * Desc:      Memory-mapped frame spool: append, recovery, group sync,
+ *            watermark, compaction. POSIX only; on Windows open() fails
+ *            and the station runs without a spool.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "frame_spool.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "crc32_ieee.h"
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <dirent.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace spool {
+namespace {
+
+constexpr uint32_t kSegmentMagic = 0x4C505356u; // "VSPL"
+constexpr uint32_t kRecordMagic  = 0x31524656u; // "VFR1"
+constexpr uint16_t kVersion      = 1;
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_len;
+    uint64_t base_seq;
+    uint32_t reserved;
+    uint32_t crc; // over the bytes before it
+};
+
+struct RecordHeader {
+    uint32_t magic;
+    uint16_t len;
+    uint16_t flags;
+    uint32_t tag;
+    uint32_t crc; // over this header (crc = 0) then the frame
+    uint64_t seq;
+};
+
+struct AckSlot {
+    uint64_t seq;
+    uint32_t gen;
+    uint32_t crc; // over seq + gen
+};
+
+static_assert(sizeof(SegmentHeader) <= kSegmentHeaderLen, "segment header overflows its slot");
+static_assert(sizeof(RecordHeader) == kRecordHeaderLen, "record header must be 24 bytes");
+static_assert(sizeof(AckSlot) == 16, "ack slot must be 16 bytes");
+static_assert(kRecordHeaderLen + kMaxRecord + kSegmentHeaderLen <= kSegmentBytes,
+              "largest record must fit an empty segment");
+
+size_t align8(size_t n) { return (n + 7u) & ~static_cast<size_t>(7u); }
+
+uint32_t record_crc(RecordHeader h, const uint8_t* frame) {
+    h.crc = 0;
+    uint8_t raw[sizeof(RecordHeader)];
+    std::memcpy(raw, &h, sizeof(raw));
+    return crc32_ieee::update(crc32_ieee::compute(raw, sizeof(raw)), frame, h.len);
+}
+
+uint32_t segment_crc(const SegmentHeader& h) {
+    uint8_t raw[sizeof(SegmentHeader)];
+    std::memcpy(raw, &h, sizeof(raw));
+    return crc32_ieee::compute(raw, offsetof(SegmentHeader, crc));
+}
+
+uint32_t ack_crc(const AckSlot& a) {
+    uint8_t raw[sizeof(AckSlot)];
+    std::memcpy(raw, &a, sizeof(raw));
+    return crc32_ieee::compute(raw, offsetof(AckSlot, crc));
+}
+
+// "spool-<16 hex>.seg" → base sequence number.
+bool parse_segment_name(const char* name, uint64_t& base) {
+    if (std::strncmp(name, "spool-", 6) != 0 || std::strlen(name) != 26 ||
+        std::strcmp(name + 22, ".seg") != 0) {
+        return false;
+    }
+    char* end = nullptr;
+    const unsigned long long v = std::strtoull(name + 6, &end, 16);
+    if (end != name + 22 || v == 0) return false;
+    base = static_cast<uint64_t>(v);
+    return true;
+}
+
+} // namespace
+
+FrameSpool::FrameSpool()
+    : _open(false), _ack_fd(-1), _ack_gen(0), _first(0), _count(0), _tail(nullptr),
+      _next_seq(1), _head(1), _cursor_seq(1), _cursor_base(0), _cursor_off(0), _acked(0),
+      _committed(0), _synced_head(1), _appended(0), _append_failures(0), _syncs(0),
+      _synced_records(0), _recovered(0), _compacted(0) {
+    _dir[0] = '\0';
+    for (Segment& s : _segs) {
+        s.base_seq    = 0;
+        s.fd          = -1;
+        s.map         = nullptr;
+        s.used.store(0);
+        s.synced      = 0;
+        s.meta_synced = true;
+    }
+}
+
+FrameSpool::~FrameSpool() { close(); }
+
+bool FrameSpool::open(const char* dir) {
+#ifdef _WIN32
+    (void)dir;
+    return false;
+#else
+    if (_open) return true;
+    const size_t dlen = (dir != nullptr) ? std::strlen(dir) : 0;
+    if (dlen == 0 || dlen >= kDirMax) return false;
+    std::memcpy(_dir, dir, dlen + 1);
+    if (::mkdir(_dir, 0700) != 0 && errno != EEXIST) return false;
+    if (!load_watermark()) return false;
+
+    uint64_t bases[kMaxSegments];
+    size_t   nbases = 0;
+    DIR* d = ::opendir(_dir);
+    if (d == nullptr) return false;
+    while (const dirent* e = ::readdir(d)) {
+        uint64_t base = 0;
+        if (nbases < kMaxSegments && parse_segment_name(e->d_name, base)) bases[nbases++] = base;
+    }
+    ::closedir(d);
+    for (size_t i = 1; i < nbases; ++i) { // insertion sort, ≤ 64 entries
+        const uint64_t v = bases[i];
+        size_t j = i;
+        for (; j > 0 && bases[j - 1] > v; --j) bases[j] = bases[j - 1];
+        bases[j] = v;
+    }
+
+    // Map and scan in order. A segment that fails to map (bad header,
+    // wrong size) is skipped; its records are lost, the rest are not.
+    _first = 0;
+    _count = 0;
+    uint64_t next = 0;
+    for (size_t i = 0; i < nbases; ++i) {
+        Segment& s = _segs[_count];
+        if (!map_segment(s, bases[i], false)) continue;
+        uint64_t seq = bases[i];
+        s.used.store(scan_segment(s, seq));
+        s.synced = s.used.load();
+        next = seq;
+        ++_count;
+    }
+
+    if (_count > 0 && _acked + 1 < seg_at(0)->base_seq) {
+        _acked = seg_at(0)->base_seq - 1; // older records are gone
+    }
+    _tail = (_count > 0) ? seg_at(_count - 1) : nullptr;
+    if (next < _acked + 1) {
+        // The watermark is ahead of the log: start a fresh segment so
+        // sequence numbers stay contiguous within each one.
+        next  = _acked + 1;
+        _tail = nullptr;
+    }
+    _next_seq    = next;
+    _synced_head = next;
+    _head.store(next, std::memory_order_release);
+    _recovered   = next - (_acked + 1);
+    _open        = true;
+
+    seek(_acked + 1);
+    commit(); // drops segments a previous run delivered but didn't compact
+    return true;
+#endif
+}
+
+void FrameSpool::close() {
+    if (!_open) return;
+    sync();
+    commit();
+    std::lock_guard<std::mutex> lock(_mu);
+    for (size_t i = 0; i < _count; ++i) unmap_segment(*seg_at(i), false);
+    _count = 0;
+    _tail  = nullptr;
+#ifndef _WIN32
+    if (_ack_fd >= 0) ::close(_ack_fd);
+#endif
+    _ack_fd = -1;
+    _open   = false;
+}
+
+// --- Producer ---
+
+uint64_t FrameSpool::append(const uint8_t* frame, size_t len, uint32_t tag) {
+    if (!_open || frame == nullptr || len == 0 || len > kMaxRecord) {
+        _append_failures.fetch_add(1, std::memory_order_relaxed);
+        return 0;
+    }
+    const size_t rec_len = align8(kRecordHeaderLen + len);
+    if (_tail == nullptr || _tail->used.load(std::memory_order_relaxed) + rec_len > kSegmentBytes) {
+        if (!roll()) {
+            _append_failures.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        }
+    }
+
+    Segment*     s   = _tail;
+    const size_t off = s->used.load(std::memory_order_relaxed);
+    RecordHeader h   = {kRecordMagic, static_cast<uint16_t>(len), 0, tag, 0, _next_seq};
+    h.crc = record_crc(h, frame);
+    std::memcpy(s->map + off + kRecordHeaderLen, frame, len);
+    std::memcpy(s->map + off, &h, sizeof(h));
+    s->used.store(off + rec_len, std::memory_order_release);
+
+    const uint64_t seq = _next_seq++;
+    _head.store(_next_seq, std::memory_order_release);
+    _appended.fetch_add(1, std::memory_order_relaxed);
+    return seq;
+}
+
+bool FrameSpool::roll() {
+    std::lock_guard<std::mutex> lock(_mu);
+    if (_count == kMaxSegments) return false; // spool full
+    Segment* s = seg_at(_count);
+    if (!map_segment(*s, _next_seq, true)) return false;
+    ++_count;
+    _tail = s;
+    return true;
+}
+
+// --- Consumer ---
+
+FrameSpool::Segment* FrameSpool::find_segment(uint64_t seq) {
+    for (size_t i = _count; i > 0; --i) {
+        Segment* s = seg_at(i - 1);
+        if (s->base_seq <= seq) return s;
+    }
+    return (_count > 0) ? seg_at(0) : nullptr;
+}
+
+bool FrameSpool::next(Record& out, uint64_t below) {
+    if (!_open || _cursor_seq >= head() || _cursor_seq >= below) return false;
+    std::lock_guard<std::mutex> lock(_mu);
+
+    // Locate the cursor's segment; it may have been compacted away
+    // or never positioned (after seek()).
+    size_t idx = _count;
+    if (_cursor_off != 0) {
+        for (size_t i = 0; i < _count; ++i) {
+            if (seg_at(i)->base_seq == _cursor_base) idx = i;
+        }
+    }
+    if (idx == _count) {
+        Segment* s = find_segment(_cursor_seq);
+        if (s == nullptr) return false;
+        for (size_t i = 0; i < _count; ++i) {
+            if (seg_at(i) == s) idx = i;
+        }
+        if (s->base_seq > _cursor_seq) _cursor_seq = s->base_seq; // clamp to oldest kept
+        _cursor_off = kSegmentHeaderLen;
+    }
+
+    for (;;) {
+        Segment*     s    = seg_at(idx);
+        const size_t used = s->used.load(std::memory_order_acquire);
+        size_t       rec_len = 0;
+        if (_cursor_off < used && record_at(*s, _cursor_off, used, out, rec_len)) {
+            _cursor_off += rec_len;
+            if (out.seq < _cursor_seq) continue; // scanning up to a seek target
+            _cursor_base = s->base_seq;
+            _cursor_seq  = out.seq + 1;
+            return true;
+        }
+        // End of this segment (or damage): continue in the next one.
+        if (idx + 1 == _count) return false;
+        ++idx;
+        if (seg_at(idx)->base_seq > _cursor_seq) _cursor_seq = seg_at(idx)->base_seq;
+        _cursor_base = seg_at(idx)->base_seq;
+        _cursor_off  = kSegmentHeaderLen;
+    }
+}
+
+void FrameSpool::seek(uint64_t seq) {
+    _cursor_seq = (seq == 0) ? 1 : seq;
+    _cursor_off = 0; // re-located by next()
+}
+
+uint64_t FrameSpool::unread() const {
+    const uint64_t h = head();
+    return (h > _cursor_seq) ? h - _cursor_seq : 0;
+}
+
+bool FrameSpool::sync() {
+    if (!_open) return false;
+    const uint64_t head_now = head(); // records below it are fully written
+    bool ok       = true;
+    bool new_file = false;
+    {
+        std::lock_guard<std::mutex> lock(_mu);
+        for (size_t i = 0; i < _count; ++i) {
+            Segment*     s    = seg_at(i);
+            const size_t used = s->used.load(std::memory_order_acquire);
+#ifndef _WIN32
+            if (used > s->synced) {
+                const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+                const size_t from = s->synced - (s->synced % page);
+                if (::msync(s->map + from, used - from, MS_SYNC) == 0) {
+                    s->synced = used;
+                } else {
+                    ok = false;
+                }
+            }
+            if (!s->meta_synced) {
+                // First sync of a new segment: its allocation too.
+                if (::fsync(s->fd) == 0) {
+                    s->meta_synced = true;
+                    new_file       = true;
+                } else {
+                    ok = false;
+                }
+            }
+#else
+            (void)used;
+#endif
+        }
+    }
+    if (new_file) sync_dir();
+    if (ok && head_now > _synced_head) {
+        ++_syncs;
+        _synced_records += head_now - _synced_head;
+        _synced_head = head_now;
+    }
+    return ok;
+}
+
+void FrameSpool::ack(uint64_t seq) {
+    if (seq > _acked && seq < head()) _acked = seq;
+}
+
+bool FrameSpool::commit() {
+    if (!_open) return false;
+    bool ok = true;
+    if (_acked != _committed) {
+        if (store_watermark(_acked)) {
+            _committed = _acked;
+        } else {
+            ok = false;
+        }
+    }
+    // Only what the on-disk watermark covers may go.
+    std::lock_guard<std::mutex> lock(_mu);
+    while (_count > 1 && seg_at(1)->base_seq <= _committed + 1) {
+        unmap_segment(*seg_at(0), true);
+        _first = (_first + 1) % kMaxSegments;
+        --_count;
+        ++_compacted;
+    }
+    return ok;
+}
+
+Stats FrameSpool::stats() const {
+    Stats s;
+    s.appended        = _appended.load(std::memory_order_relaxed);
+    s.append_failures = _append_failures.load(std::memory_order_relaxed);
+    s.syncs           = _syncs;
+    s.synced_records  = _synced_records;
+    s.recovered       = _recovered;
+    s.compacted       = _compacted;
+    s.acked           = _committed;
+    s.head            = head();
+    std::lock_guard<std::mutex> lock(_mu);
+    s.segments        = _count;
+    return s;
+}
+
+// --- Segment files ---
+
+size_t FrameSpool::scan_segment(Segment& s, uint64_t& next_seq) const {
+    size_t off = kSegmentHeaderLen;
+    Record r;
+    size_t rec_len = 0;
+    while (record_at(s, off, kSegmentBytes, r, rec_len) && r.seq == next_seq) {
+        off += rec_len;
+        ++next_seq;
+    }
+    return off;
+}
+
+bool FrameSpool::record_at(const Segment& s, size_t off, size_t limit, Record& out,
+                           size_t& rec_len) const {
+    if (off + kRecordHeaderLen > limit) return false;
+    RecordHeader h;
+    std::memcpy(&h, s.map + off, sizeof(h));
+    if (h.magic != kRecordMagic || h.len == 0 || h.len > kMaxRecord) return false;
+    rec_len = align8(kRecordHeaderLen + h.len);
+    if (off + rec_len > limit) return false;
+    const uint8_t* data = s.map + off + kRecordHeaderLen;
+    if (record_crc(h, data) != h.crc) return false;
+    out.seq  = h.seq;
+    out.tag  = h.tag;
+    out.len  = h.len;
+    out.data = data;
+    return true;
+}
+
+void FrameSpool::segment_path(uint64_t base_seq, char* out) const {
+    std::snprintf(out, kPathMax, "%s/spool-%016llx.seg", _dir,
+                  static_cast<unsigned long long>(base_seq));
+}
+
+bool FrameSpool::map_segment(Segment& s, uint64_t base_seq, bool create) {
+#ifdef _WIN32
+    (void)s;
+    (void)base_seq;
+    (void)create;
+    return false;
+#else
+    char path[kPathMax];
+    segment_path(base_seq, path);
+    const int fd = ::open(path, O_RDWR | O_CLOEXEC | (create ? (O_CREAT | O_EXCL) : 0), 0600);
+    if (fd < 0) return false;
+
+    if (create) {
+        // Preallocate so a full disk fails here, not as SIGBUS on a
+        // later store into the mapping.
+        if (::posix_fallocate(fd, 0, static_cast<off_t>(kSegmentBytes)) != 0) {
+            ::close(fd);
+            ::unlink(path);
+            return false;
+        }
+    } else {
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size != static_cast<off_t>(kSegmentBytes)) {
+            ::close(fd);
+            return false;
+        }
+    }
+
+    void* m = ::mmap(nullptr, kSegmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (m == MAP_FAILED) {
+        ::close(fd);
+        if (create) ::unlink(path);
+        return false;
+    }
+    s.map = static_cast<uint8_t*>(m);
+    s.fd  = fd;
+
+    SegmentHeader h;
+    if (create) {
+        h = {kSegmentMagic, kVersion, static_cast<uint16_t>(kSegmentHeaderLen), base_seq, 0, 0};
+        h.crc = segment_crc(h);
+        std::memcpy(s.map, &h, sizeof(h));
+    } else {
+        std::memcpy(&h, s.map, sizeof(h));
+        if (h.magic != kSegmentMagic || h.version != kVersion || h.base_seq != base_seq ||
+            h.crc != segment_crc(h)) {
+            unmap_segment(s, false);
+            return false;
+        }
+    }
+    s.base_seq    = base_seq;
+    s.used.store(kSegmentHeaderLen, std::memory_order_release);
+    s.synced      = 0;
+    s.meta_synced = !create;
+    return true;
+#endif
+}
+
+void FrameSpool::unmap_segment(Segment& s, bool remove_file) {
+#ifndef _WIN32
+    if (s.map != nullptr) ::munmap(s.map, kSegmentBytes);
+    if (s.fd >= 0) ::close(s.fd);
+    if (remove_file) {
+        char path[kPathMax];
+        segment_path(s.base_seq, path);
+        ::unlink(path);
+    }
+#else
+    (void)remove_file;
+#endif
+    s.map = nullptr;
+    s.fd  = -1;
+    s.used.store(0);
+}
+
+// --- Watermark ---
+
+bool FrameSpool::load_watermark() {
+#ifdef _WIN32
+    return false;
+#else
+    char path[kPathMax];
+    std::snprintf(path, sizeof(path), "%s/spool.ack", _dir);
+    _ack_fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (_ack_fd < 0) return false;
+
+    AckSlot slots[2];
+    std::memset(slots, 0, sizeof(slots));
+    if (::pread(_ack_fd, slots, sizeof(slots), 0) < 0) return false;
+    _acked   = 0;
+    _ack_gen = 0;
+    for (const AckSlot& a : slots) {
+        // A torn write leaves the other slot intact.
+        if (a.gen != 0 && a.crc == ack_crc(a) && a.gen > _ack_gen) {
+            _ack_gen = a.gen;
+            _acked   = a.seq;
+        }
+    }
+    _committed = _acked;
+    return true;
+#endif
+}
+
+bool FrameSpool::store_watermark(uint64_t seq) {
+#ifdef _WIN32
+    (void)seq;
+    return false;
+#else
+    AckSlot a = {seq, _ack_gen + 1, 0};
+    a.crc = ack_crc(a);
+    const off_t at = static_cast<off_t>((a.gen & 1u) * sizeof(AckSlot));
+    if (::pwrite(_ack_fd, &a, sizeof(a), at) != static_cast<ssize_t>(sizeof(a))) return false;
+#ifdef __linux__
+    if (::fdatasync(_ack_fd) != 0) return false;
+#else
+    if (::fsync(_ack_fd) != 0) return false;
+#endif
+    _ack_gen = a.gen;
+    return true;
+#endif
+}
+
+void FrameSpool::sync_dir() {
+#ifndef _WIN32
+    const int fd = ::open(_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#endif
+}
+
+} // namespace spool
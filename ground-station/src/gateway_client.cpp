@@ -10,21 +10,17 @@
  * -------------------------------------------------------------------------*/
 
 #include "../include/gateway_client.h"
+#include "../include/egress_json.h"
 #include <cstdio>
 #include <cstring>
 
-// Cross-Platform Socket Headers
-#ifdef _WIN32
-    #include <winsock2.h>
-    #include <ws2tcpip.h>
-    #pragma comment(lib, "ws2_32.lib") // Tell MSVC to link Winsock
-#else
-    #include <sys/socket.h>
-    #include <arpa/inet.h>
-    #include <unistd.h>
-#endif
+GatewayClient::GatewayClient(const char* host, int port)
+    : _own_pool(host, static_cast<uint16_t>(port)), _pool(_own_pool) {
+    std::memset(_json_buffer, 0, sizeof(_json_buffer));
+}
 
-GatewayClient::GatewayClient(const char* host, int port) : _host(host), _port(port) {
+GatewayClient::GatewayClient(http_pool::ConnectionPool& shared)
+    : _own_pool(shared.host(), shared.port()), _pool(shared) {
     std::memset(_json_buffer, 0, sizeof(_json_buffer));
 }
 
@@ -65,64 +61,64 @@ bool GatewayClient::push_to_l2(const uint8_t* frame_bytes, size_t frame_len) {
         return false;
     }
 
-#ifdef _WIN32
-    WSADATA wsaData;
-    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
-#endif
-
-    // 1. Create Socket
-    int sock = socket(AF_INET, SOCK_STREAM, 0);
-    if (sock < 0) return false;
-
-    // 2. Setup Address
-    struct sockaddr_in server_addr;
-    std::memset(&server_addr, 0, sizeof(server_addr));
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(static_cast<uint16_t>(_port));
-    inet_pton(AF_INET, _host, &server_addr.sin_addr);
-
-    // 3. Connect
-    if (connect(sock, reinterpret_cast<struct sockaddr*>(&server_addr), sizeof(server_addr)) < 0) {
-        std::puts("[ERROR] Could not connect to Go Gateway.");
-#ifdef _WIN32
-        closesocket(sock); WSACleanup();
-#else
-        close(sock);
-#endif
-        return false;
-    }
-
-    // 4. Build HTTP headers only. The body is raw binary (frame may
-    // contain 0x00 bytes), so we send headers and body separately —
-    // we cannot use strlen-bounded snprintf on the body.
+    // Build HTTP headers only. The body is raw binary (frame may
+    // contain 0x00 bytes), so it is handed to the pool separately —
+    // we cannot use strlen-bounded snprintf on the body. HTTP/1.1
+    // defaults to keep-alive; the pool reuses the connection.
     char headers[512] = {0};
     const int written = std::snprintf(headers, sizeof(headers),
         "POST /api/v1/ingest HTTP/1.1\r\n"
-        "Host: %s:%d\r\n"
+        "Host: %s:%u\r\n"
         "Content-Type: application/octet-stream\r\n"
-        "Content-Length: %zu\r\n"
-        "Connection: close\r\n\r\n",
-        _host, _port, frame_len);
+        "Content-Length: %zu\r\n\r\n",
+        _pool.host(), static_cast<unsigned>(_pool.port()), frame_len);
     if (written < 0 || static_cast<size_t>(written) >= sizeof(headers)) {
         std::puts("[ERROR] HTTP header buffer overflow.");
-#ifdef _WIN32
-        closesocket(sock); WSACleanup();
-#else
-        close(sock);
-#endif
         return false;
     }
 
-    // 5. Send headers, then body. Two TCP writes — the kernel coalesces.
-    send(sock, headers, static_cast<size_t>(written), 0);
-    send(sock, reinterpret_cast<const char*>(frame_bytes), frame_len, 0);
+    // The response must be read to keep the kept-alive stream in step;
+    // its JSON body is not needed here.
+    uint8_t sink[1024];
+    size_t  sink_len = 0;
+    int     status   = 0;
+    if (!_pool.round_trip(headers, static_cast<size_t>(written), frame_bytes, frame_len,
+                          sink, sizeof(sink), sink_len, status)) {
+        std::puts("[ERROR] Could not connect to Go Gateway.");
+        return false;
+    }
+    if (status < 200 || status >= 300) {
+        std::printf("[ERROR] Go Gateway rejected frame (HTTP %d).\n", status);
+        return false;
+    }
+    return true;
+}
 
-    // 6. Cleanup
-#ifdef _WIN32
-    closesocket(sock); WSACleanup();
-#else
-    close(sock);
-#endif
+bool GatewayClient::push_batch(const uint8_t* body, size_t body_len, size_t frames,
+                               int* results, int& status_code) {
+    if (body == nullptr || body_len == 0 || frames == 0 || results == nullptr) return false;
 
-    return true;
-}
\ No newline at end of file
+    char headers[512] = {0};
+    const int written = std::snprintf(headers, sizeof(headers),
+        "POST /api/v1/ingest/batch HTTP/1.1\r\n"
+        "Host: %s:%u\r\n"
+        "Content-Type: application/x-void-frames\r\n"
+        "Content-Length: %zu\r\n\r\n",
+        _pool.host(), static_cast<unsigned>(_pool.port()), body_len);
+    if (written < 0 || static_cast<size_t>(written) >= sizeof(headers)) return false;
+
+    // ~6 B per result ("200,") plus the JSON envelope.
+    uint8_t resp[1024];
+    size_t  resp_len = 0;
+    int     status   = 0;
+    if (!_pool.round_trip(headers, static_cast<size_t>(written), body, body_len,
+                          resp, sizeof(resp), resp_len, status)) {
+        return false;
+    }
+    status_code = status;
+    if (status != 200) return true;
+
+    const int n = egress::parse_batch_results(reinterpret_cast<const char*>(resp), resp_len,
+                                              results, frames);
+    return n == static_cast<int>(frames);
+}
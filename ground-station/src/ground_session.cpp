@@ -0,0 +1,110 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      ground_session.cpp
+ * Desc:      Ground session transition table (State Machine Spec §5.2).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "ground_session.h"
+
+namespace ground_session {
+namespace {
+
+constexpr size_t kEvents = static_cast<size_t>(Event::kCount);
+
+constexpr State V  = State::kVacant;
+constexpr State HP = State::kHandshakePending;
+constexpr State AC = State::kActive;
+constexpr State CL = State::kClosing;
+constexpr State BL = State::kBlacklisted;
+
+// [state][event] in Event order: HandshakeInit, PacketB, PacketBReplay,
+// PacketD, SigFail, Violation, AckQueueEmpty. Pairs the spec leaves
+// undefined are a reject that stays put (§9.3).
+constexpr Transition kTable[kStateCount][kEvents] = {
+    // VACANT: only a handshake allocates a slot.
+    {{HP, Action::kRespond},      {V,  Action::kReject},      {V,  Action::kReject},
+     {V,  Action::kReject},       {V,  Action::kReject},      {V,  Action::kReject},
+     {V,  Action::kReject}},
+    // HANDSHAKE_PENDING: the first valid PacketB confirms the session.
+    {{HP, Action::kRespondAgain}, {AC, Action::kOpen},        {HP, Action::kCountReplay},
+     {HP, Action::kReject},       {BL, Action::kBlacklist},   {BL, Action::kBlacklist},
+     {HP, Action::kReject}},
+    // ACTIVE: settlement.
+    {{AC, Action::kReject},       {AC, Action::kSettle},      {AC, Action::kCountReplay},
+     {AC, Action::kReceipt},      {BL, Action::kBlacklist},   {BL, Action::kBlacklist},
+     {AC, Action::kReject}},
+    // CLOSING: late receipts only.
+    {{CL, Action::kReject},       {CL, Action::kReject},      {CL, Action::kReject},
+     {CL, Action::kReceipt},      {CL, Action::kReject},      {CL, Action::kReject},
+     {V,  Action::kWipe}},
+    // BLACKLISTED: everything dropped until the cooldown ends.
+    {{BL, Action::kDrop},         {BL, Action::kDrop},        {BL, Action::kDrop},
+     {BL, Action::kDrop},         {BL, Action::kDrop},        {BL, Action::kDrop},
+     {BL, Action::kDrop}},
+};
+
+// Where each state goes when its deadline passes.
+constexpr State kTimeouts[kStateCount] = {V, V, CL, V, V};
+
+} // anonymous namespace
+
+Transition step(State state, Event event, const Policy& policy) {
+    const size_t e = static_cast<size_t>(event);
+    if (e >= kEvents) return {state, Action::kReject};
+    // Plaintext SNLP has no handshake: the first verified PacketB is
+    // the session's proof of identity.
+    if (state == State::kVacant && event == Event::kPacketB && !policy.require_handshake) {
+        return {State::kActive, Action::kOpen};
+    }
+    return kTable[state_index(state)][e];
+}
+
+State timeout(State state) {
+    return kTimeouts[state_index(state)];
+}
+
+uint32_t state_timeout_ms(State state, const Policy& policy) {
+    switch (state) {
+        case State::kVacant:           return 0;
+        case State::kHandshakePending: return policy.handshake_ms;
+        case State::kActive:           return policy.session_ttl_ms;
+        case State::kClosing:          return policy.closing_ms;
+        case State::kBlacklisted:      return policy.cooldown_ms;
+    }
+    return 0;
+}
+
+const char* state_name(State s) {
+    switch (s) {
+        case State::kVacant:           return "vacant";
+        case State::kHandshakePending: return "handshake-pending";
+        case State::kActive:           return "active";
+        case State::kClosing:          return "closing";
+        case State::kBlacklisted:      return "blacklisted";
+    }
+    return "unknown";
+}
+
+const char* action_name(Action a) {
+    switch (a) {
+        case Action::kReject:       return "reject";
+        case Action::kDrop:         return "drop";
+        case Action::kRespond:      return "respond";
+        case Action::kRespondAgain: return "respond-again";
+        case Action::kOpen:         return "open";
+        case Action::kSettle:       return "settle";
+        case Action::kReceipt:      return "receipt";
+        case Action::kCountReplay:  return "count-replay";
+        case Action::kBlacklist:    return "blacklist";
+        case Action::kWipe:         return "wipe";
+        case Action::kExhausted:    return "exhausted";
+    }
+    return "unknown";
+}
+
+} // namespace ground_session
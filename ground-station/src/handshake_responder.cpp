@@ -0,0 +1,225 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      handshake_responder.cpp
+ * Desc:      Packet H responder and keypair pool (see handshake_responder.h).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "handshake_responder.h"
+
+#include <sodium.h>
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace handshake_responder {
+
+using frame_dispatch::Tier;
+using frame_dispatch::TierTraits;
+using security_context::kPubKeySize;
+using security_context::kSessionKeySize;
+
+// ---------------------------------------------------------------------------
+// KeyPool
+// ---------------------------------------------------------------------------
+KeyPool::KeyPool()
+    : running_(false), stop_(false), parked_(false), generated_(0), taken_(0), misses_(0) {}
+
+KeyPool::~KeyPool() {
+    stop();
+    // take() wipes what it hands out; wipe what nobody took.
+    Keypair* slot;
+    while ((slot = ring_.front()) != nullptr) {
+        sodium_memzero(slot->priv, sizeof(slot->priv));
+        ring_.release();
+    }
+}
+
+void KeyPool::start() {
+    if (running_) return;
+    stop_.store(false);
+    running_ = true;
+    worker_  = std::thread([this]() { run(); });
+}
+
+void KeyPool::stop() {
+    if (!running_) return;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_.store(true);
+    }
+    cv_.notify_one();
+    worker_.join();
+    running_ = false;
+}
+
+void KeyPool::fill() {
+    if (!running_) top_up();
+}
+
+bool KeyPool::top_up() {
+    Keypair* slot;
+    while ((slot = ring_.claim()) != nullptr) {
+        crypto_box_keypair(slot->pub, slot->priv);
+        ring_.publish();
+        generated_.fetch_add(1, std::memory_order_relaxed);
+        if (stop_.load(std::memory_order_relaxed)) return false;
+    }
+    return true;
+}
+
+void KeyPool::take(Keypair& out) {
+    Keypair* slot = ring_.front();
+    if (slot == nullptr) {
+        crypto_box_keypair(out.pub, out.priv);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        wake();
+        return;
+    }
+    std::memcpy(&out, slot, sizeof(out));
+    sodium_memzero(slot->priv, sizeof(slot->priv));
+    ring_.release();
+    taken_.fetch_add(1, std::memory_order_relaxed);
+    if (ring_.size() < kRefillBelow) wake();
+}
+
+PoolStats KeyPool::stats() const {
+    PoolStats s;
+    s.generated = generated_.load(std::memory_order_relaxed);
+    s.taken     = taken_.load(std::memory_order_relaxed);
+    s.misses    = misses_.load(std::memory_order_relaxed);
+    return s;
+}
+
+// Pairs with the fence in run(): either the refill thread sees the ring
+// below the mark before sleeping, or we see it parked and wake it.
+void KeyPool::wake() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(mu_);
+        cv_.notify_one();
+    }
+}
+
+void KeyPool::run() {
+#ifdef __linux__
+    // Keygen only ever runs when no other thread wants the core.
+    sched_param idle = {};
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &idle);
+#endif
+    while (!stop_.load()) {
+        top_up();
+        std::unique_lock<std::mutex> lock(mu_);
+        parked_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ring_.size() >= kRefillBelow && !stop_.load()) {
+            cv_.wait_for(lock, std::chrono::milliseconds(kRefillIdleWaitMs));
+        }
+        parked_.store(false, std::memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Responder
+// ---------------------------------------------------------------------------
+Responder::Responder(const security_context::Identity& id, security_context::SessionStore& store,
+                     KeyPool& pool)
+    : id_(id), store_(store), pool_(pool), clock_(nullptr), stats_() {}
+
+Verdict Responder::respond(const uint8_t* init, size_t len, uint32_t sat_id,
+                           const uint8_t sat_pub[kPubKeySize], uint64_t now_ms,
+                           uint8_t* resp, size_t resp_cap, size_t* resp_len) {
+    Verdict v = Verdict::kBadSize;
+    if (init != nullptr && sat_pub != nullptr && resp != nullptr && resp_len != nullptr) {
+        v = (frame_dispatch::detect_tier(init, len) == Tier::kSnlp)
+                ? respond_as<Tier::kSnlp>(init, len, sat_id, sat_pub, now_ms, resp, resp_cap, resp_len)
+                : respond_as<Tier::kCcsds>(init, len, sat_id, sat_pub, now_ms, resp, resp_cap, resp_len);
+    }
+    if (v == Verdict::kResponded) {
+        ++stats_.responded;
+    } else {
+        ++stats_.rejected;
+    }
+    return v;
+}
+
+template <Tier T>
+Verdict Responder::respond_as(const uint8_t* init, size_t len, uint32_t sat_id,
+                              const uint8_t* sat_pub, uint64_t now_ms,
+                              uint8_t* resp, size_t resp_cap, size_t* resp_len) {
+    using PacketH = typename TierTraits<T>::PacketH;
+    // Signature scope: header + body up to the signature field, as the
+    // sat's begin_handshake() signs it.
+    constexpr size_t kSigScope = offsetof(PacketH, signature);
+
+    if (!id_.ready()) return Verdict::kNoIdentity;
+    if (len != sizeof(PacketH) || resp_cap < sizeof(PacketH)) return Verdict::kBadSize;
+    if (!frame_dispatch::Codec<T>::template view<PacketH>(init, len)) return Verdict::kBadHeader;
+
+    PacketH in;
+    std::memcpy(&in, init, sizeof(in));
+    if (clock_ != nullptr) {
+        const uint64_t now = clock_();
+        const uint64_t ts  = in.timestamp;
+        if ((now > ts ? now - ts : ts - now) > kLivenessMs) return Verdict::kStale;
+    }
+    if (crypto_sign_verify_detached(in.signature, init, kSigScope, sat_pub) != 0) {
+        return Verdict::kBadSignature;
+    }
+
+    // The only keygen-dependent step; everything below is one X25519
+    // and one Ed25519 sign.
+    Keypair kp;
+    pool_.take(kp);
+    uint8_t key[kSessionKeySize];
+    const bool shared = crypto_scalarmult(key, kp.priv, in.eph_pub_key) == 0;
+    sodium_memzero(kp.priv, sizeof(kp.priv));
+    if (!shared) {
+        sodium_memzero(key, sizeof(key));
+        return Verdict::kBadKey;
+    }
+    crypto_generichash(key, kSessionKeySize, key, kSessionKeySize, nullptr, 0);
+    const security_context::SessionStore::Install installed =
+        store_.install_handshake(sat_id, key, in.session_ttl, now_ms, in.timestamp);
+    sodium_memzero(key, sizeof(key));
+    if (installed == security_context::SessionStore::Install::kFull) return Verdict::kStoreFull;
+    if (installed == security_context::SessionStore::Install::kNotNewer) return Verdict::kReplay;
+
+    PacketH out;
+    std::memset(&out, 0, sizeof(out));
+    frame_dispatch::Codec<T>::write_header(reinterpret_cast<uint8_t*>(&out.header),
+                                           sizeof(out.header), kResponseApid, true, 0u,
+                                           sizeof(PacketH));
+    out.session_ttl = in.session_ttl;
+    out.timestamp   = in.timestamp;
+    std::memcpy(out.eph_pub_key, kp.pub, kPubKeySize);
+    id_.sign(reinterpret_cast<const uint8_t*>(&out), kSigScope, out.signature);
+    std::memcpy(resp, &out, sizeof(out));
+    *resp_len = sizeof(out);
+    return Verdict::kResponded;
+}
+
+const char* verdict_name(Verdict v) {
+    switch (v) {
+        case Verdict::kResponded:    return "responded";
+        case Verdict::kBadSize:      return "bad-size";
+        case Verdict::kBadHeader:    return "bad-header";
+        case Verdict::kStale:        return "stale";
+        case Verdict::kBadSignature: return "bad-signature";
+        case Verdict::kBadKey:       return "bad-key";
+        case Verdict::kStoreFull:    return "store-full";
+        case Verdict::kReplay:       return "replay";
+        case Verdict::kNoIdentity:   return "no-identity";
+    }
+    return "unknown";
+}
+
+} // namespace handshake_responder
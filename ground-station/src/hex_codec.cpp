@@ -0,0 +1,294 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      hex_codec.cpp
+ * Desc:      Hex encode / strict decode kernels: scalar, SSE2, AVX2,
+ *            NEON.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Decode, per vector of chars:
+ *   digit = '0' <= c <= '9'            value c - '0'
+ *   alpha = 'a' <= (c | 0x20) <= 'f'   value (c | 0x20) - 'a' + 10
+ * Any lane in neither class fails the whole call. Bytes >= 0x80 are
+ * negative as int8 and so fall outside both signed-compare windows.
+ * Pairs of nibbles are then merged (hi << 4 | lo) and narrowed.
+ *
+ * Encode: split into hi/lo nibbles, add '0' (+39 for 10..15 → 'a'..'f'),
+ * interleave hi/lo.
+ * -------------------------------------------------------------------------*/
+
+#include "hex_codec.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define HEX_CODEC_SSE2 1
+#include <emmintrin.h>
+#if defined(__x86_64__) && defined(__GNUC__)
+#define HEX_CODEC_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define HEX_CODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace hex_codec {
+namespace {
+
+constexpr char kDigits[] = "0123456789abcdef";
+
+int nibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool args_ok_decode(const char* hex, size_t hex_len, const uint8_t* out, size_t out_cap) {
+    return hex != nullptr && out != nullptr && (hex_len & 1u) == 0u && hex_len / 2u <= out_cap;
+}
+
+bool args_ok_encode(const uint8_t* in, size_t len, const char* out, size_t out_cap) {
+    return in != nullptr && out != nullptr && len != 0 && len <= out_cap / 2u;
+}
+
+#if defined(HEX_CODEC_SSE2)
+
+// 16 chars → 16 nibble values; non-hex lanes are flagged in `bad`.
+inline __m128i nibbles_sse2(__m128i v, __m128i& bad) {
+    const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), v));
+    const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+    bad = _mm_or_si128(bad, _mm_andnot_si128(_mm_or_si128(digit, alpha), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(_mm_sub_epi8(v, _mm_set1_epi8('0')), digit),
+                        _mm_and_si128(_mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)), alpha));
+}
+
+// Nibble bytes n0 n1 n2 n3 … as 16-bit lanes → (n0 << 4 | n1) per lane.
+inline __m128i merge_pairs_sse2(__m128i n) {
+    const __m128i hi = _mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0x00FF)), 4);
+    return _mm_or_si128(hi, _mm_srli_epi16(n, 8));
+}
+
+inline __m128i to_ascii_sse2(__m128i n) {
+    const __m128i over9 = _mm_cmpgt_epi8(n, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(n, _mm_set1_epi8('0')),
+                        _mm_and_si128(over9, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+bool decode_sse2(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap) {
+    if (!args_ok_decode(hex, hex_len, out, out_cap)) return false;
+    size_t i = 0;
+    for (; i + 32u <= hex_len; i += 32u) {
+        __m128i bad = _mm_setzero_si128();
+        const __m128i a = nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i)), bad);
+        const __m128i b = nibbles_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i + 16u)), bad);
+        if (_mm_movemask_epi8(bad) != 0) return false;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2u),
+                         _mm_packus_epi16(merge_pairs_sse2(a), merge_pairs_sse2(b)));
+    }
+    return decode_scalar(hex + i, hex_len - i, out + i / 2u, out_cap - i / 2u);
+}
+
+size_t encode_sse2(const uint8_t* in, size_t len, char* out, size_t out_cap) {
+    if (!args_ok_encode(in, len, out, out_cap)) return 0;
+    size_t i = 0;
+    for (; i + 16u <= len; i += 16u) {
+        const __m128i b  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i lo = to_ascii_sse2(_mm_and_si128(b, _mm_set1_epi8(0x0F)));
+        const __m128i hi = to_ascii_sse2(_mm_and_si128(_mm_srli_epi16(b, 4), _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2u), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2u + 16u), _mm_unpackhi_epi8(hi, lo));
+    }
+    if (i < len) encode_scalar(in + i, len - i, out + i * 2u, out_cap - i * 2u);
+    return len * 2u;
+}
+
+#endif // HEX_CODEC_SSE2
+
+#if defined(HEX_CODEC_AVX2)
+
+#define HEX_CODEC_AVX2_FN __attribute__((target("avx2")))
+
+HEX_CODEC_AVX2_FN inline __m256i nibbles_avx2(__m256i v, __m256i& bad) {
+    const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+    const __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+    bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(digit, alpha),
+                                                   _mm256_set1_epi8(-1)));
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_sub_epi8(v, _mm256_set1_epi8('0')), digit),
+        _mm256_and_si256(_mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)), alpha));
+}
+
+HEX_CODEC_AVX2_FN inline __m256i merge_pairs_avx2(__m256i n) {
+    const __m256i hi = _mm256_slli_epi16(_mm256_and_si256(n, _mm256_set1_epi16(0x00FF)), 4);
+    return _mm256_or_si256(hi, _mm256_srli_epi16(n, 8));
+}
+
+HEX_CODEC_AVX2_FN inline __m256i to_ascii_avx2(__m256i n) {
+    const __m256i over9 = _mm256_cmpgt_epi8(n, _mm256_set1_epi8(9));
+    return _mm256_add_epi8(_mm256_add_epi8(n, _mm256_set1_epi8('0')),
+                           _mm256_and_si256(over9, _mm256_set1_epi8('a' - '0' - 10)));
+}
+
+HEX_CODEC_AVX2_FN bool decode_avx2(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap) {
+    if (!args_ok_decode(hex, hex_len, out, out_cap)) return false;
+    size_t i = 0;
+    for (; i + 64u <= hex_len; i += 64u) {
+        __m256i bad = _mm256_setzero_si256();
+        const __m256i a = nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i)), bad);
+        const __m256i b = nibbles_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i + 32u)), bad);
+        if (_mm256_movemask_epi8(bad) != 0) return false;
+        // packus works per 128-bit lane: reorder quadwords 0,2,1,3.
+        const __m256i packed = _mm256_packus_epi16(merge_pairs_avx2(a), merge_pairs_avx2(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2u),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    // The tail runs legacy-SSE code: clear the upper halves first or
+    // every SSE instruction there pays the AVX transition penalty.
+    _mm256_zeroupper();
+    return decode_sse2(hex + i, hex_len - i, out + i / 2u, out_cap - i / 2u);
+}
+
+HEX_CODEC_AVX2_FN size_t encode_avx2(const uint8_t* in, size_t len, char* out, size_t out_cap) {
+    if (!args_ok_encode(in, len, out, out_cap)) return 0;
+    size_t i = 0;
+    for (; i + 32u <= len; i += 32u) {
+        const __m256i b  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i lo = to_ascii_avx2(_mm256_and_si256(b, _mm256_set1_epi8(0x0F)));
+        const __m256i hi = to_ascii_avx2(
+            _mm256_and_si256(_mm256_srli_epi16(b, 4), _mm256_set1_epi8(0x0F)));
+        // unpack works per 128-bit lane: stitch bytes 0-15 then 16-31.
+        const __m256i first  = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2u),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2u + 32u),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    _mm256_zeroupper(); // see decode_avx2()
+    if (i < len) encode_sse2(in + i, len - i, out + i * 2u, out_cap - i * 2u);
+    return len * 2u;
+}
+
+#undef HEX_CODEC_AVX2_FN
+
+#endif // HEX_CODEC_AVX2
+
+#if defined(HEX_CODEC_NEON)
+
+inline uint8x16_t nibbles_neon(uint8x16_t v, uint8x16_t& bad) {
+    const uint8x16_t dv    = vsubq_u8(v, vdupq_n_u8('0'));
+    const uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+    const uint8x16_t av    = vsubq_u8(lower, vdupq_n_u8('a'));
+    const uint8x16_t digit = vcleq_u8(dv, vdupq_n_u8(9));
+    const uint8x16_t alpha = vcleq_u8(av, vdupq_n_u8(5));
+    bad = vorrq_u8(bad, vmvnq_u8(vorrq_u8(digit, alpha)));
+    return vbslq_u8(digit, dv, vaddq_u8(av, vdupq_n_u8(10)));
+}
+
+inline uint8x16_t to_ascii_neon(uint8x16_t n) {
+    return vaddq_u8(n, vbslq_u8(vcgtq_u8(n, vdupq_n_u8(9)),
+                                vdupq_n_u8('a' - 10), vdupq_n_u8('0')));
+}
+
+bool decode_neon(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap) {
+    if (!args_ok_decode(hex, hex_len, out, out_cap)) return false;
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(hex);
+    size_t i = 0;
+    for (; i + 32u <= hex_len; i += 32u) {
+        const uint8x16x2_t pair = vld2q_u8(src + i); // even chars / odd chars
+        uint8x16_t bad = vdupq_n_u8(0);
+        const uint8x16_t hi = nibbles_neon(pair.val[0], bad);
+        const uint8x16_t lo = nibbles_neon(pair.val[1], bad);
+        if (vmaxvq_u8(bad) != 0) return false;
+        vst1q_u8(out + i / 2u, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    return decode_scalar(hex + i, hex_len - i, out + i / 2u, out_cap - i / 2u);
+}
+
+size_t encode_neon(const uint8_t* in, size_t len, char* out, size_t out_cap) {
+    if (!args_ok_encode(in, len, out, out_cap)) return 0;
+    uint8_t* dst = reinterpret_cast<uint8_t*>(out);
+    size_t i = 0;
+    for (; i + 16u <= len; i += 16u) {
+        const uint8x16_t b = vld1q_u8(in + i);
+        uint8x16x2_t chars;
+        chars.val[0] = to_ascii_neon(vshrq_n_u8(b, 4));
+        chars.val[1] = to_ascii_neon(vandq_u8(b, vdupq_n_u8(0x0F)));
+        vst2q_u8(dst + i * 2u, chars); // interleaves hi, lo
+    }
+    if (i < len) encode_scalar(in + i, len - i, out + i * 2u, out_cap - i * 2u);
+    return len * 2u;
+}
+
+#endif // HEX_CODEC_NEON
+
+using DecodeFn = bool (*)(const char*, size_t, uint8_t*, size_t);
+using EncodeFn = size_t (*)(const uint8_t*, size_t, char*, size_t);
+
+struct Kernels {
+    DecodeFn    decode;
+    EncodeFn    encode;
+    const char* name;
+};
+
+Kernels pick_kernels() {
+#if defined(HEX_CODEC_AVX2)
+    if (__builtin_cpu_supports("avx2")) return {decode_avx2, encode_avx2, "avx2"};
+#endif
+#if defined(HEX_CODEC_SSE2)
+    return {decode_sse2, encode_sse2, "sse2"};
+#elif defined(HEX_CODEC_NEON)
+    return {decode_neon, encode_neon, "neon"};
+#else
+    return {decode_scalar, encode_scalar, "scalar"};
+#endif
+}
+
+const Kernels& kernels() {
+    static const Kernels k = pick_kernels();
+    return k;
+}
+
+} // anonymous namespace
+
+size_t encode_scalar(const uint8_t* in, size_t len, char* out, size_t out_cap) {
+    if (!args_ok_encode(in, len, out, out_cap)) return 0;
+    for (size_t i = 0; i < len; ++i) {
+        out[i * 2u]      = kDigits[(in[i] >> 4) & 0x0Fu];
+        out[i * 2u + 1u] = kDigits[in[i] & 0x0Fu];
+    }
+    return len * 2u;
+}
+
+bool decode_scalar(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap) {
+    if (!args_ok_decode(hex, hex_len, out, out_cap)) return false;
+    const size_t need = hex_len / 2u;
+    for (size_t i = 0; i < need; ++i) {
+        const int hi = nibble(hex[i * 2u]);
+        const int lo = nibble(hex[i * 2u + 1u]);
+        if (hi < 0 || lo < 0) return false;
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+size_t encode(const uint8_t* in, size_t len, char* out, size_t out_cap) {
+    return kernels().encode(in, len, out, out_cap);
+}
+
+bool decode(const char* hex, size_t hex_len, uint8_t* out, size_t out_cap) {
+    return kernels().decode(hex, hex_len, out, out_cap);
+}
+
+const char* backend() { return kernels().name; }
+
+} // namespace hex_codec
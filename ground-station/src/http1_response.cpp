@@ -0,0 +1,294 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      http1_response.cpp
+ * Desc:      Byte-at-a-time HTTP/1.1 response state machine; body bytes
+ *            are passed through in runs.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "http1_response.h"
+
+#include <cstring>
+
+namespace http1 {
+namespace {
+
+char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// `s` (length `len`) equals lower-case `name`, ignoring case.
+bool name_is(const char* s, size_t len, const char* name) {
+    if (std::strlen(name) != len) return false;
+    for (size_t i = 0; i < len; ++i) {
+        if (lower(s[i]) != name[i]) return false;
+    }
+    return true;
+}
+
+// Case-insensitive search for lower-case `needle` inside [s, s+len).
+bool contains_token(const char* s, size_t len, const char* needle) {
+    const size_t nlen = std::strlen(needle);
+    for (size_t i = 0; i + nlen <= len; ++i) {
+        size_t j = 0;
+        while (j < nlen && lower(s[i + j]) == needle[j]) ++j;
+        if (j == nlen) return true;
+    }
+    return false;
+}
+
+// Unsigned decimal, the whole span; false on anything else or overflow.
+bool parse_size(const char* s, size_t len, size_t* out) {
+    if (len == 0) return false;
+    size_t v = 0;
+    for (size_t i = 0; i < len; ++i) {
+        if (s[i] < '0' || s[i] > '9') return false;
+        const size_t d = static_cast<size_t>(s[i] - '0');
+        if (v > (SIZE_MAX - d) / 10u) return false;
+        v = v * 10u + d;
+    }
+    *out = v;
+    return true;
+}
+
+int hex_digit(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // anonymous namespace
+
+void ResponseParser::reset() {
+    state_        = State::kStatusLine;
+    status_       = -1;
+    http11_       = false;
+    chunked_      = false;
+    has_length_   = false;
+    close_        = true;
+    framed_       = false;
+    left_         = 0;
+    digits_       = 0;
+    header_bytes_ = 0;
+    line_len_     = 0;
+}
+
+// "HTTP/1.x <3 digits>[ reason]"
+bool ResponseParser::status_line() {
+    if (line_len_ < 12 || line_len_ > kMaxLine) return false;
+    if (std::memcmp(line_, "HTTP/1.1 ", 9) == 0) {
+        http11_ = true;
+    } else if (std::memcmp(line_, "HTTP/1.0 ", 9) == 0) {
+        http11_ = false;
+    } else {
+        return false;
+    }
+    int code = 0;
+    for (size_t i = 9; i < 12; ++i) {
+        if (line_[i] < '0' || line_[i] > '9') return false;
+        code = code * 10 + (line_[i] - '0');
+    }
+    if (line_len_ > 12 && line_[12] != ' ') return false;
+    status_     = code;
+    close_      = !http11_;
+    chunked_    = false;
+    has_length_ = false;
+    left_       = 0;
+    state_      = State::kHeaderLine;
+    return true;
+}
+
+bool ResponseParser::header_line() {
+    if (line_len_ == 0) return end_headers();
+
+    const bool   overflow = line_len_ > kMaxLine;
+    const size_t len      = overflow ? kMaxLine : line_len_;
+    const char*  colon    = static_cast<const char*>(std::memchr(line_, ':', len));
+    if (colon == nullptr) return overflow; // an overlong line we can't read is skipped
+
+    const size_t name_len = static_cast<size_t>(colon - line_);
+    const char*  value    = colon + 1;
+    size_t       vlen     = len - name_len - 1;
+    while (vlen > 0 && (*value == ' ' || *value == '\t')) {
+        ++value;
+        --vlen;
+    }
+    while (vlen > 0 && (value[vlen - 1] == ' ' || value[vlen - 1] == '\t')) --vlen;
+
+    if (name_is(line_, name_len, "content-length")) {
+        size_t n = 0;
+        if (overflow || !parse_size(value, vlen, &n)) return false;
+        if (has_length_ && n != left_) return false; // conflicting lengths
+        has_length_ = true;
+        left_       = n;
+    } else if (name_is(line_, name_len, "transfer-encoding")) {
+        if (overflow) return false;
+        if (contains_token(value, vlen, "chunked")) chunked_ = true;
+    } else if (name_is(line_, name_len, "connection")) {
+        if (overflow) return false;
+        if (contains_token(value, vlen, "close")) close_ = true;
+        if (contains_token(value, vlen, "keep-alive")) close_ = false;
+    }
+    return true;
+}
+
+bool ResponseParser::end_headers() {
+    if (status_ >= 100 && status_ < 200) {
+        state_ = State::kStatusLine; // interim response; the real one follows
+        return true;
+    }
+    framed_ = true;
+    if (chunked_) {
+        left_   = 0;
+        digits_ = 0;
+        state_  = State::kChunkSize;
+    } else if (has_length_) {
+        state_ = (left_ == 0) ? State::kDone : State::kLengthBody;
+    } else if (status_ == 204 || status_ == 304) {
+        state_ = State::kDone;
+    } else {
+        framed_ = false; // the body runs to EOF
+        state_  = State::kCloseBody;
+    }
+    return true;
+}
+
+bool ResponseParser::end_line() {
+    // Strip the CR of CRLF (a bare LF is tolerated).
+    if (line_len_ > 0 && line_len_ <= kMaxLine && line_[line_len_ - 1] == '\r') --line_len_;
+    const bool ok = (state_ == State::kStatusLine) ? status_line() : header_line();
+    line_len_ = 0;
+    return ok;
+}
+
+ResponseParser::Result ResponseParser::feed(const uint8_t* data, size_t len, BodySink sink, void* user,
+                            size_t* used) {
+    *used = 0;
+    if (state_ == State::kDone) return Result::kDone;
+    if (state_ == State::kFail) return Result::kFail;
+
+    size_t i = 0;
+    while (i < len) {
+        // Body bytes: hand over the longest run available.
+        if (state_ == State::kLengthBody || state_ == State::kChunkData ||
+            state_ == State::kCloseBody) {
+            size_t n = len - i;
+            if (state_ != State::kCloseBody && n > left_) n = left_;
+            if (!sink(data + i, n, user)) {
+                *used = i;
+                return fail();
+            }
+            i += n;
+            if (state_ == State::kCloseBody) continue;
+            left_ -= n;
+            if (left_ != 0) continue;
+            if (state_ == State::kChunkData) {
+                state_ = State::kChunkDataCR;
+                continue;
+            }
+            state_ = State::kDone;
+            *used  = i;
+            return Result::kDone;
+        }
+
+        const uint8_t c = data[i++];
+        switch (state_) {
+        case State::kStatusLine:
+        case State::kHeaderLine:
+            if (++header_bytes_ > kMaxHeaders) {
+                *used = i;
+                return fail();
+            }
+            if (c != '\n') {
+                if (line_len_ < kMaxLine) line_[line_len_] = static_cast<char>(c);
+                ++line_len_;
+                break;
+            }
+            if (!end_line()) {
+                *used = i;
+                return fail();
+            }
+            if (headers_done()) {
+                *used = i;
+                return Result::kHeaders;
+            }
+            break;
+
+        case State::kChunkSize: {
+            const int d = hex_digit(c);
+            if (d >= 0) {
+                if (left_ > (SIZE_MAX >> 4)) return fail();
+                left_ = left_ * 16u + static_cast<size_t>(d);
+                ++digits_;
+            } else if (digits_ == 0) {
+                return fail();
+            } else if (c == '\r') {
+                state_ = State::kChunkSizeLF;
+            } else if (c == ';' || c == ' ' || c == '\t') {
+                state_ = State::kChunkExt;
+            } else {
+                return fail();
+            }
+            break;
+        }
+        case State::kChunkExt:
+            if (c == '\r') state_ = State::kChunkSizeLF;
+            break;
+        case State::kChunkSizeLF:
+            if (c != '\n') return fail();
+            state_    = (left_ == 0) ? State::kTrailer : State::kChunkData;
+            line_len_ = 0;
+            break;
+        case State::kChunkDataCR:
+            if (c != '\r') return fail();
+            state_ = State::kChunkDataLF;
+            break;
+        case State::kChunkDataLF:
+            if (c != '\n') return fail();
+            state_  = State::kChunkSize;
+            digits_ = 0;
+            break;
+        case State::kTrailer:
+            if (++header_bytes_ > kMaxHeaders) return fail();
+            if (c == '\r') {
+                state_ = State::kTrailerLF;
+            } else {
+                ++line_len_;
+            }
+            break;
+        case State::kTrailerLF:
+            if (c != '\n') return fail();
+            if (line_len_ == 0) { // the empty line ends the message
+                state_ = State::kDone;
+                *used  = i;
+                return Result::kDone;
+            }
+            line_len_ = 0;
+            state_    = State::kTrailer;
+            break;
+        case State::kLengthBody:
+        case State::kCloseBody:
+        case State::kChunkData:
+        case State::kDone:
+        case State::kFail:
+            break; // handled above
+        }
+    }
+    *used = i;
+    return Result::kMore;
+}
+
+ResponseParser::Result ResponseParser::finish() {
+    if (state_ == State::kCloseBody || state_ == State::kDone) {
+        state_ = State::kDone;
+        return Result::kDone;
+    }
+    return fail();
+}
+
+} // namespace http1
@@ -0,0 +1,386 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      http_pool.cpp
+ * Desc:      Keep-alive HTTP/1.1 connection pool for the gateway clients.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "http_pool.h"
+
+#include <cstring>
+
+#include "http1_response.h"
+#include "reactor.h" // now_ms()
+
+// Cross-platform socket headers — same split gateway_client.cpp uses.
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+
+namespace http_pool {
+namespace {
+
+// Requests whose head + body fit here go out in one send(): with
+// TCP_NODELAY a split write would cost an extra segment per request.
+constexpr size_t kCoalesceCap = 2048;
+
+// One recv() slice.
+constexpr size_t kRecvChunk = 4096;
+
+void close_fd(int fd) {
+#ifdef _WIN32
+    closesocket(fd);
+#else
+    ::close(fd);
+#endif
+}
+
+// True when the last socket error means the peer dropped the
+// connection (as opposed to a timeout).
+bool peer_reset() {
+#ifdef _WIN32
+    const int e = WSAGetLastError();
+    return e == WSAECONNRESET || e == WSAECONNABORTED;
+#else
+    return errno == ECONNRESET || errno == EPIPE;
+#endif
+}
+
+bool send_all(int fd, const char* buf, size_t len) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL; // a dead keep-alive peer must not SIGPIPE us
+#else
+    const int flags = 0;
+#endif
+    size_t off = 0;
+    while (off < len) {
+#ifdef _WIN32
+        const int w = ::send(fd, buf + off, static_cast<int>(len - off), flags);
+#else
+        const ssize_t w = ::send(fd, buf + off, len - off, flags);
+#endif
+        if (w <= 0) return false;
+        off += static_cast<size_t>(w);
+    }
+    return true;
+}
+
+// The gateway closed an idle keep-alive connection if it is readable
+// before we've sent anything (EOF or stray bytes either way).
+bool idle_conn_dead(int fd) {
+#ifdef _WIN32
+    (void)fd;
+    return false; // stale-retry path covers it
+#else
+    struct pollfd p;
+    p.fd      = fd;
+    p.events  = POLLIN;
+    p.revents = 0;
+    return ::poll(&p, 1, 0) != 0;
+#endif
+}
+
+enum class Exchange { kOk, kStale, kFail };
+
+bool send_request(int fd, const char* head, size_t head_len,
+                  const uint8_t* body, size_t body_len) {
+    if (head_len + body_len <= kCoalesceCap) {
+        char req[kCoalesceCap];
+        std::memcpy(req, head, head_len);
+        if (body_len > 0) std::memcpy(req + head_len, body, body_len);
+        return send_all(fd, req, head_len + body_len);
+    }
+    return send_all(fd, head, head_len) &&
+           (body_len == 0 || send_all(fd, reinterpret_cast<const char*>(body), body_len));
+}
+
+long recv_some(int fd, uint8_t* buf, size_t len) {
+#ifdef _WIN32
+    return ::recv(fd, reinterpret_cast<char*>(buf), static_cast<int>(len), 0);
+#else
+    return static_cast<long>(::recv(fd, buf, len, 0));
+#endif
+}
+
+// round_trip()'s sink: the body is assembled in the caller's buffer.
+// recv() writes there directly once the headers are in, so a
+// Content-Length body lands in place and chunked data only moves down
+// over its size lines.
+struct Assembly {
+    uint8_t* out;
+    size_t   cap;
+    size_t   len;
+};
+
+bool assemble(const uint8_t* data, size_t n, void* user) {
+    Assembly* a = static_cast<Assembly*>(user);
+    if (n > a->cap - a->len) return false; // no silent truncation
+    uint8_t* dst = a->out + a->len;
+    if (dst != data) std::memmove(dst, data, n);
+    a->len += n;
+    return true;
+}
+
+// One request/response on `fd`: body bytes go to `sink`. With `direct`
+// set (and `sink` == assemble) recv() targets its free space. kStale:
+// the (reused) connection was already dead and nothing was received —
+// safe to re-send. `*keep` says whether the connection can serve
+// another request.
+Exchange exchange(int fd, bool reused,
+                  const char* head, size_t head_len,
+                  const uint8_t* body, size_t body_len,
+                  BodySink sink, void* user, Assembly* direct,
+                  int& status_code, bool* keep) {
+    *keep = false;
+    if (!send_request(fd, head, head_len, body, body_len)) {
+        return reused ? Exchange::kStale : Exchange::kFail;
+    }
+
+    using Parsed = http1::ResponseParser::Result;
+    http1::ResponseParser parser;
+    uint8_t               scratch[kRecvChunk];
+    bool                  received = false;
+    for (;;) {
+        uint8_t* dst  = scratch;
+        size_t   room = sizeof(scratch);
+        if (direct != nullptr && parser.headers_done() && direct->len < direct->cap) {
+            dst  = direct->out + direct->len;
+            room = direct->cap - direct->len;
+        }
+        const long r = recv_some(fd, dst, room);
+        if (r <= 0) {
+            if (!received && reused && (r == 0 || peer_reset())) return Exchange::kStale;
+            // EOF is only a valid end for a close-delimited body.
+            if (r < 0 || parser.finish() != Parsed::kDone) {
+                return Exchange::kFail;
+            }
+            return Exchange::kOk;
+        }
+        received = true;
+
+        const uint8_t* p = dst;
+        size_t         n = static_cast<size_t>(r);
+        for (;;) {
+            size_t used = 0;
+            const Parsed res = parser.feed(p, n, sink, user, &used);
+            p += used;
+            n -= used;
+            if (res == Parsed::kHeaders) {
+                status_code = parser.status();
+                continue; // the rest of this read, possibly nothing
+            }
+            if (res == Parsed::kFail) return Exchange::kFail;
+            if (res == Parsed::kDone) {
+                // Bytes past the response mean the stream is out of step.
+                *keep = parser.keep_alive() && n == 0;
+                return Exchange::kOk;
+            }
+            break; // kMore
+        }
+    }
+}
+
+} // anonymous namespace
+
+ConnectionPool::ConnectionPool(const char* host, uint16_t port)
+    : _host(host), _port(port), _slots{},
+      _requests(0), _connects(0), _reuses(0), _stale_retries(0), _failures(0) {
+    for (Slot& s : _slots) s = {-1, false, 0};
+}
+
+ConnectionPool::~ConnectionPool() {
+    std::lock_guard<std::mutex> lock(_mu);
+    for (Slot& s : _slots) {
+        if (s.fd >= 0) close_fd(s.fd);
+        s.fd = -1;
+    }
+}
+
+void ConnectionPool::close_idle() {
+    std::lock_guard<std::mutex> lock(_mu);
+    for (Slot& s : _slots) {
+        if (!s.busy && s.fd >= 0) {
+            close_fd(s.fd);
+            s.fd = -1;
+        }
+    }
+}
+
+Stats ConnectionPool::stats() const {
+    Stats s;
+    s.requests      = _requests.load();
+    s.connects      = _connects.load();
+    s.reuses        = _reuses.load();
+    s.stale_retries = _stale_retries.load();
+    s.failures      = _failures.load();
+    return s;
+}
+
+int ConnectionPool::connect_new() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return -1;
+#endif
+    const int fd = static_cast<int>(socket(AF_INET, SOCK_STREAM, 0));
+    if (fd < 0) return -1;
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port   = htons(_port);
+    if (inet_pton(AF_INET, _host, &addr.sin_addr) != 1 ||
+        ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close_fd(fd);
+        return -1;
+    }
+
+    // Small request/response exchanges: no Nagle delay, and a bound on
+    // how long a half-dead keep-alive peer can stall the caller.
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&one), sizeof(one));
+#ifdef _WIN32
+    DWORD tv = kRecvTimeoutMs;
+#else
+    struct timeval tv;
+    tv.tv_sec  = kRecvTimeoutMs / 1000;
+    tv.tv_usec = static_cast<suseconds_t>((kRecvTimeoutMs % 1000) * 1000);
+#endif
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&tv), sizeof(tv));
+
+    _connects.fetch_add(1);
+    return fd;
+}
+
+int ConnectionPool::acquire(bool* reused) {
+    std::lock_guard<std::mutex> lock(_mu);
+    const uint64_t now = reactor::now_ms();
+    int empty = -1;
+    for (size_t i = 0; i < kMaxConns; ++i) {
+        Slot& s = _slots[i];
+        if (s.busy) continue;
+        if (s.fd >= 0 && now - s.last_used_ms > kIdleMaxMs) {
+            close_fd(s.fd);
+            s.fd = -1;
+        }
+        if (s.fd >= 0) {
+            s.busy  = true;
+            *reused = true;
+            return static_cast<int>(i);
+        }
+        if (empty < 0) empty = static_cast<int>(i);
+    }
+    if (empty >= 0) {
+        _slots[empty].busy = true;
+        *reused = false;
+    }
+    return empty;
+}
+
+void ConnectionPool::release(int slot, int fd, bool keep) {
+    if (slot < 0) {
+        if (fd >= 0) close_fd(fd);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mu);
+    Slot& s = _slots[slot];
+    if (!keep && fd >= 0) {
+        close_fd(fd);
+        fd = -1;
+    }
+    s.fd           = fd;
+    s.busy         = false;
+    s.last_used_ms = reactor::now_ms();
+}
+
+// Runs `exchange(fd, reused, &keep)` on a pooled connection, re-sending
+// once on a fresh one if a reused socket turns out to be stale.
+template <typename ExchangeFn>
+bool ConnectionPool::with_connection(ExchangeFn exchange_fn) {
+    bool reused = false;
+    const int slot = acquire(&reused);
+    int fd = (slot >= 0) ? _slots[slot].fd : -1;
+
+    if (reused && idle_conn_dead(fd)) {
+        close_fd(fd);
+        fd     = -1;
+        reused = false;
+    }
+
+    // At most two attempts: the second only after a stale reused socket.
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (fd < 0) {
+            fd     = connect_new();
+            reused = false;
+            if (fd < 0) break;
+        }
+        _requests.fetch_add(1);
+        if (reused) _reuses.fetch_add(1);
+
+        bool keep = false;
+        const Exchange ex = exchange_fn(fd, reused, &keep);
+        if (ex == Exchange::kOk) {
+            release(slot, fd, keep);
+            return true;
+        }
+        close_fd(fd);
+        fd = -1;
+        if (ex != Exchange::kStale) break;
+        _stale_retries.fetch_add(1);
+    }
+
+    release(slot, -1, false);
+    _failures.fetch_add(1);
+    return false;
+}
+
+bool ConnectionPool::round_trip(const char*    head,
+                                size_t         head_len,
+                                const uint8_t* body,
+                                size_t         body_len,
+                                uint8_t*       out,
+                                size_t         out_cap,
+                                size_t&        out_len,
+                                int&           status_code) {
+    if (head == nullptr || head_len == 0 || (body == nullptr && body_len != 0)) return false;
+    Assembly assembly = {out, out == nullptr ? 0 : out_cap, 0};
+    const bool ok = with_connection([&](int fd, bool reused, bool* keep) {
+        assembly.len = 0; // a stale retry starts over
+        return exchange(fd, reused, head, head_len, body, body_len,
+                        &assemble, &assembly, &assembly, status_code, keep);
+    });
+    if (ok) out_len = assembly.len;
+    return ok;
+}
+
+bool ConnectionPool::round_trip_stream(const char*    head,
+                                       size_t         head_len,
+                                       const uint8_t* body,
+                                       size_t         body_len,
+                                       BodySink       sink,
+                                       void*          user,
+                                       int&           status_code) {
+    if (head == nullptr || head_len == 0 || (body == nullptr && body_len != 0) ||
+        sink == nullptr) {
+        return false;
+    }
+    return with_connection([&](int fd, bool reused, bool* keep) {
+        return exchange(fd, reused, head, head_len, body, body_len,
+                        sink, user, nullptr, status_code, keep);
+    });
+}
+
+} // namespace http_pool
@@ -0,0 +1,57 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      line_framer.cpp
+ * Desc:      Vectorised end-of-line search for LineFramer.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Serial lines are ~240 chars (a PACKET_B hex line), so 16-byte steps
+ * already leave the search far below the per-line routing cost; there is
+ * no AVX2 variant.
+ * -------------------------------------------------------------------------*/
+
+#include "line_framer.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define LINE_FRAMER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define LINE_FRAMER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace line_framer {
+
+size_t find_eol_scalar(const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        if (data[i] == '\n' || data[i] == '\r') return i;
+    }
+    return len;
+}
+
+size_t find_eol(const uint8_t* data, size_t len) {
+    size_t i = 0;
+#if defined(LINE_FRAMER_SSE2)
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; i + 16u <= len; i += 16u) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const int mask  = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, nl),
+                                                         _mm_cmpeq_epi8(v, cr)));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+    }
+#elif defined(LINE_FRAMER_NEON)
+    const uint8x16_t nl = vdupq_n_u8('\n');
+    const uint8x16_t cr = vdupq_n_u8('\r');
+    for (; i + 16u <= len; i += 16u) {
+        const uint8x16_t v = vld1q_u8(data + i);
+        if (vmaxvq_u8(vorrq_u8(vceqq_u8(v, nl), vceqq_u8(v, cr))) != 0) break;
+    }
+#endif
+    return i + find_eol_scalar(data + i, len - i);
+}
+
+} // namespace line_framer
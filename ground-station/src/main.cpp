@@ -13,108 +13,370 @@
 #include <cstring>
 #include <cstdlib>
 #include <cstdint>
+#include <chrono>
 #include <thread>
 #include <atomic>
-#include <chrono>
+#include <mutex>
+
+#include <sodium.h>
 
 #include "serial_hal.h"
 #include "bouncer.h"
 #include "gateway_client.h"
+#include "ingest_batcher.h"
+#include "frame_spool.h"
+#include "gateway_delivery.h"
 #include "egress_poll_client.h"
 #include "egress_orchestrator.h"
 #include "ack_builder.h"
+#include "ack_signer.h"
+#include "ground_session.h"
+#include "handshake_responder.h"
+#include "timing_wheel.h"
+#include "hex_codec.h"
+#include "crc32_ieee.h"
+#include "frame_dispatch.h"
+#include "reactor.h"
+#include "serial_frame.h"
+#include "line_framer.h"
+#include "spsc_ring.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 // --- Global State ---
 // Stack-allocated modules (No Heap) as per .cursorrules
 std::atomic<bool> is_running{true};
 Bouncer edge_firewall;
-GatewayClient go_gateway("127.0.0.1", 8080);
+
+// Flat-sat Sat B identity: Ed25519 public key derived from the
+// deterministic test seed (generate_packets.go detSeedHex). Matches the
+// gateway registry MockDB entry for the same key.
+static constexpr uint32_t kFlatSatId = 0xCAFEBABEu;
+static const uint8_t kFlatSatPubKey[Bouncer::kPubKeySize] = {
+    0x48, 0x22, 0xf9, 0x7b, 0xc9, 0xe8, 0x74, 0x6a,
+    0xcc, 0x9b, 0x24, 0x01, 0xe2, 0x1d, 0xb1, 0xaf,
+    0xba, 0x02, 0x12, 0x65, 0x7a, 0xd4, 0xae, 0x8e,
+    0xe9, 0xfd, 0x16, 0x96, 0x4d, 0xd2, 0x7d, 0x97,
+};
+// Per-satellite ground sessions (State Machine Spec §5). Sized for a
+// TinyGS-scale network in view at once: 3072 sessions, 128 KiB.
+// Plaintext SNLP needs no handshake, so a verified PacketB may still
+// open the session itself.
+static constexpr size_t   kGroundSessionSlots = 4096;
+static constexpr uint32_t kSessionTickMs      = 100;
+static ground_session::Policy plaintext_session_policy() {
+    ground_session::Policy p = ground_session::kDefaultPolicy;
+    p.require_handshake = false;
+    return p;
+}
+static ground_session::SessionTable<kGroundSessionSlots> ground_sessions(plaintext_session_policy());
+// One wheel timer per session deadline (handshake, TTL, CLOSING,
+// blacklist cooldown), kSessionTickMs resolution. The reactor wakes for
+// it only at next_wake_ms(): an idle station with no session deadline
+// sleeps. As many timers as slots, so every session always gets one.
+static timing_wheel::TimerPool<kGroundSessionSlots> session_timers(reactor::now_ms, kSessionTickMs);
+static int session_deadline = -1; // reactor one-shot id
+
+// Ground authority identity, per-sat ChaCha20 session keys, and the
+// Packet H responder that installs them (Handshake-spec.md §2) with
+// ephemeral keypairs made ahead of time on an idle core.
+static security_context::Identity     ground_identity;
+static security_context::SessionStore session_keys;
+static handshake_responder::KeyPool   handshake_keys;
+static handshake_responder::Responder handshake(ground_identity, session_keys, handshake_keys);
+// Builds and signs PacketAck tunnels (TunnelData ground_sig) on worker
+// cores; finished frames come back through its completion rings.
+static ack_signer::SignerPool         ack_signers(ground_identity);
+static constexpr uint16_t             kAckTunnelTtlS = 60;
+static constexpr uint32_t             kAckDrainMs    = 5; // when the notify fd can't be polled
+
+// Feeds one event into the sat's ground session and logs the changes
+// worth an operator's attention.
+static ground_session::Result note_session_event(uint32_t sat_id, ground_session::Event ev,
+                                                 uint64_t now) {
+    const ground_session::Result r = ground_sessions.on_event(sat_id, ev, now);
+    if (r.action == ground_session::Action::kBlacklist) {
+        session_keys.erase(sat_id);
+        std::printf("[SESSION] ⛔ Sat 0x%08X blacklisted for %u s.\n",
+                    static_cast<unsigned>(sat_id),
+                    static_cast<unsigned>(ground_sessions.policy().cooldown_ms / 1000));
+    } else if (r.action == ground_session::Action::kOpen) {
+        std::printf("[SESSION] Sat 0x%08X session open.\n", static_cast<unsigned>(sat_id));
+    } else if (r.action == ground_session::Action::kExhausted) {
+        std::printf("[SESSION] ⚠️  SLOT_EXHAUSTION: no session slot for sat 0x%08X.\n",
+                    static_cast<unsigned>(sat_id));
+    }
+    return r;
+}
+
+// Points the reactor's one-shot at the wheel's next wake-up. Runs
+// before every wait, so a session that armed an earlier timer in a
+// callback is covered, and after each poll().
+static void arm_session_deadline(reactor::Reactor* loop) {
+    const uint64_t due = session_timers.next_wake_ms();
+    if (loop->deadline(session_deadline) != due) loop->set_deadline(session_deadline, due);
+}
+
+static void on_session_deadline(void* user) {
+    session_timers.poll();
+    arm_session_deadline(static_cast<reactor::Reactor*>(user));
+}
+
+static void print_session_stats() {
+    const ground_session::Stats st = ground_sessions.stats();
+    std::printf("[SESSION] %zu/%zu slots in use (peak %zu): %zu handshake, %zu active, "
+                "%zu closing, %zu blacklisted; %llu refused, %llu dropped, %llu blacklistings.\n",
+                st.occupied, st.capacity, st.peak, st.handshake_pending, st.active,
+                st.closing, st.blacklisted, static_cast<unsigned long long>(st.exhausted),
+                static_cast<unsigned long long>(st.dropped),
+                static_cast<unsigned long long>(st.blacklistings));
+    const timing_wheel::Stats ts = session_timers.stats();
+    std::printf("[SESSION] %zu timers armed (peak %zu); %llu fired, %llu refused.\n",
+                ts.armed, ts.peak, static_cast<unsigned long long>(ts.fired),
+                static_cast<unsigned long long>(ts.exhausted));
+    const handshake_responder::Stats hs = handshake.stats();
+    const handshake_responder::PoolStats ps = handshake_keys.stats();
+    std::printf("[HANDSHAKE] %llu answered, %llu refused; %zu session key(s); %zu/%zu "
+                "keypairs ready, %llu taken, %llu made inline.\n",
+                static_cast<unsigned long long>(hs.responded),
+                static_cast<unsigned long long>(hs.rejected), session_keys.size(),
+                handshake_keys.available(), handshake_responder::kPoolSlots,
+                static_cast<unsigned long long>(ps.taken),
+                static_cast<unsigned long long>(ps.misses));
+}
+
+// Keep-alive connections to the Go gateway, shared by ingest pushes
+// and the egress poll/ACK client below.
+http_pool::ConnectionPool gateway_pool("127.0.0.1", 8080);
+GatewayClient go_gateway(gateway_pool);
+
+// Per-frame verdicts for batched ingest; `sat_id` is the add() tag.
+static void on_ingest_result(uint32_t sat_id, int status, void* /*user*/) {
+    if (status >= 200 && status < 300) {
+        std::printf("[GATEWAY] ✅ Live hardware payload (sat 0x%08X) delivered to Gateway.\n",
+                    static_cast<unsigned>(sat_id));
+    } else if (status == 0) {
+        std::printf("[GATEWAY] ❌ Failed to reach Go Gateway (sat 0x%08X).\n",
+                    static_cast<unsigned>(sat_id));
+    } else {
+        std::printf("[GATEWAY] ❌ Gateway rejected frame from sat 0x%08X (HTTP %d).\n",
+                    static_cast<unsigned>(sat_id), status);
+    }
+}
+
+// Every accepted PacketB is spooled to disk before delivery and stays
+// there until the gateway has taken it. Directory from VOID_SPOOL_DIR.
+spool::FrameSpool frame_spool;
+
+// Hands accepted frames from the reactor thread to the gateway-delivery
+// thread, which batches them so a burst during a pass reaches the
+// gateway as one /api/v1/ingest/batch request (policy from
+// VOID_INGEST_BATCH_MS in main()). HTTP latency never stalls serial
+// ingest; without a spool a full ring drops the newest frame.
+ingest::GatewayDelivery<GatewayClient> gateway_delivery(go_gateway, ingest::kDefaultBatchPolicy,
+                                                        on_ingest_result, nullptr);
+
+// --- Radio front-ends ---
+// One entry per USB-serial receiver named on the command line
+// (different frequencies / antennas). Port 0 is the primary: CLI
+// commands and egress PacketC uplinks go out on it; PacketAcks go back
+// out on whichever port heard the PacketB.
+static constexpr size_t   kMaxRadioPorts  = 4;
+static constexpr uint32_t kDefaultBaud    = 115200;
+
+// Every link boots as ASCII hex lines; after the board answers our
+// serial_frame::kOfferLine it switches to binary COBS frames.
+enum class LinkMode : uint8_t { kHex, kCobs };
+
+struct RadioPort {
+    SerialPort            serial;
+    line_framer::LineFramer<512> line;
+    serial_frame::Decoder cobs;
+    LinkMode              mode;
+    uint8_t               offers;        // framing offers sent so far
+    uint64_t              next_offer_ms; // earliest re-offer
+    uint8_t               index;
+    bool                  polled; // fd registered with the reactor
+    bool                  lost;   // read error / hang-up; no longer drained
+};
+static RadioPort radio_ports[kMaxRadioPorts];
+static size_t    radio_port_count = 0;
+
+// Offers are repeated (rate-limited) while a hex-mode port keeps
+// talking, so a board that reboots or is flashed later still upgrades.
+// Old firmware just sees a few unknown command lines.
+static constexpr uint8_t  kMaxFramingOffers   = 5;
+static constexpr uint64_t kFramingReofferMs   = 1000;
+static bool               framing_negotiation = true; // VOID_SERIAL_FRAMING=hex disables
+
+// Egress TX runs on its own thread in watch mode: serial writes and the
+// link-mode switches they depend on are serialised so two frames never
+// interleave on the wire. The reactor thread is the only mode writer.
+static std::mutex radio_tx_mu;
+
+// A whole frame or nothing usable: a write the board's USB buffer can't
+// take within this long is reported as failed, so the caller's inline
+// or retry path runs instead of the frame being cut short silently.
+static constexpr uint32_t kSerialWriteTimeoutMs = 250;
+
+static bool radio_write(size_t port, const uint8_t* data, size_t len) {
+    if (port >= radio_port_count) return false;
+    return radio_ports[port].serial.write_all(data, len, kSerialWriteTimeoutMs);
+}
+
+// Sends a text command ("H", "ACK_BUY", ...) in the port's link mode.
+static bool radio_send_line(size_t port, const char* text) {
+    if (port >= radio_port_count) return false;
+    const size_t len = std::strlen(text);
+    std::lock_guard<std::mutex> lock(radio_tx_mu);
+    if (radio_ports[port].mode == LinkMode::kCobs) {
+        uint8_t wire[serial_frame::kMaxEncoded];
+        const size_t n = serial_frame::encode(serial_frame::Type::kLine,
+                                              reinterpret_cast<const uint8_t*>(text), len,
+                                              wire, sizeof(wire));
+        return n > 0 && radio_write(port, wire, n);
+    }
+    char line[serial_frame::kMaxPayload + 2];
+    if (len + 1 >= sizeof(line)) return false;
+    std::memcpy(line, text, len);
+    line[len] = '\n';
+    return radio_write(port, reinterpret_cast<const uint8_t*>(line), len + 1);
+}
+
+// Hands a VOID frame to the board for LoRa TX: a Type::kTxFrame on a
+// COBS link, "<tag><hex>\n" (tag e.g. "PACKET_C_TX:") on an ASCII one.
+static bool radio_send_frame(size_t port, const char* tag, const uint8_t* data, size_t len) {
+    if (port >= radio_port_count || len > VOID_MAX_PACKET_SIZE) return false;
+    std::lock_guard<std::mutex> lock(radio_tx_mu);
+    if (radio_ports[port].mode == LinkMode::kCobs) {
+        uint8_t wire[serial_frame::kMaxEncoded];
+        const size_t n = serial_frame::encode(serial_frame::Type::kTxFrame, data, len,
+                                              wire, sizeof(wire));
+        return n > 0 && radio_write(port, wire, n);
+    }
+    static constexpr size_t kMaxTagLen = 24;
+    const size_t tag_len = std::strlen(tag);
+    if (tag_len > kMaxTagLen) return false;
+    char line[kMaxTagLen + VOID_MAX_PACKET_SIZE * 2 + 1];
+    std::memcpy(line, tag, tag_len);
+    const size_t line_len = tag_len + hex_codec::encode(data, len, line + tag_len,
+                                                        sizeof(line) - tag_len);
+    line[line_len] = '\n';
+    return radio_write(port, reinterpret_cast<const uint8_t*>(line), line_len + 1);
+}
+
+static void offer_framing(RadioPort* rp) {
+    if (!framing_negotiation || rp->mode != LinkMode::kHex) return;
+    if (rp->offers >= kMaxFramingOffers) return;
+    const uint64_t now = reactor::now_ms();
+    if (rp->offers > 0 && now < rp->next_offer_ms) return;
+    ++rp->offers;
+    rp->next_offer_ms = now + kFramingReofferMs;
+    // The leading newline ends any half COBS frame a board still on
+    // binary holds from a previous station; ASCII boards skip the blank
+    // line.
+    char line[sizeof(serial_frame::kOfferLine) + 1];
+    line[0] = '\n';
+    std::memcpy(line + 1, serial_frame::kOfferLine, sizeof(serial_frame::kOfferLine));
+    radio_send_line(rp->index, line);
+}
+
+// Serial read cadence when the port has no pollable fd (Windows) —
+// the pre-reactor 10 ms loop interval.
+static constexpr uint32_t kSerialFallbackPollMs = 10;
+
+// Upper bound on one reactor wait so a shutdown requested from the
+// fallback CLI thread is noticed promptly.
+static constexpr int kLoopWakeMs = 500;
 
 // VOID-138: egress poll client pointed at the same gateway as
-// `go_gateway`. Constructed with the same host/port so a local-Anvil
-// flat-sat invocation "just works" without env-var fiddling. Tuneable
-// via VOID_GATEWAY_HOST / VOID_GATEWAY_PORT at runtime below.
-egress::EgressPollClient egress_client("127.0.0.1", 8080);
+// `go_gateway`, over the same connection pool, so a local-Anvil
+// flat-sat invocation "just works" without env-var fiddling.
+egress::EgressPollClient egress_client(gateway_pool);
 
 // VOID-138: LoRa TX callback. For flat-sat, the bouncer hands the
 // 112-byte PacketC frame to the satellite firmware over USB-serial
-// using a PACKET_C_TX:<hex>\n command line — the firmware's LoRa
-// radio driver does the actual RF TX. Returns true iff the serial
+// (PACKET_C_TX:<hex>\n, or a kTxFrame on a COBS link) — the firmware's
+// LoRa radio driver does the actual RF TX. Returns true iff the serial
 // write succeeded (which is the bouncer's completion signal; the
 // firmware-side LoRa TX may still fail independently, and that's a
 // future ticket's concern).
 static bool lora_tx_via_serial(const uint8_t* data, size_t len, void* /*user*/) {
-    // Re-encode the decoded PacketC back into ASCII hex so the firmware
-    // receives the same line format it already handles for other packet
-    // types (INVOICE:, PACKET_B:, etc.).
-    // The orchestrator decoded to bytes so the production path stays
-    // agnostic of transport; re-encoding here owns the serial-line
-    // convention used by the existing firmware.
-    static constexpr size_t kPrefixLen = 13; // "PACKET_C_TX:"
-    static constexpr size_t kMaxHex    = egress::EgressPacketCSize * 2;
-    static constexpr size_t kLineCap   = kPrefixLen + kMaxHex + 2; // +\n +\0
-    char line[kLineCap];
-    std::snprintf(line, sizeof(line), "PACKET_C_TX:");
-    static const char kDigits[] = "0123456789abcdef";
-    for (size_t i = 0; i < len && i < egress::EgressPacketCSize; ++i) {
-        line[kPrefixLen + i * 2]     = kDigits[(data[i] >> 4) & 0x0Fu];
-        line[kPrefixLen + i * 2 + 1] = kDigits[data[i] & 0x0Fu];
-    }
-    const size_t line_len = kPrefixLen + len * 2u;
-    line[line_len]     = '\n';
-    line[line_len + 1] = '\0';
-
-    const int n = serial_write_bytes(reinterpret_cast<const uint8_t*>(line),
-                                     line_len + 1);
-    return n >= 0;
+    if (len > egress::EgressPacketCSize) return false;
+    return radio_send_frame(0, "PACKET_C_TX:", data, len);
 }
 
 // VOID-134: emit a 136-byte SNLP PacketAck frame as "PACKET_ACK_TX:<hex>\n"
-// so the firmware-side Heltec LoRa-transmits it back down to Sat B.
+// (or a kTxFrame) so the firmware-side Heltec LoRa-transmits it back
+// down to Sat B.
 // Mirrors the VOID-138 PACKET_C_TX: serial-line convention. Returns
 // true iff the serial write succeeded; radio-side TX failure is a
 // separate concern (no retry in alpha per the spec).
-static bool lora_tx_ack_via_serial(const uint8_t* data, size_t len) {
-    static constexpr char   kPrefix[]  = "PACKET_ACK_TX:";
-    static constexpr size_t kPrefixLen = sizeof(kPrefix) - 1;
-    static constexpr size_t kMaxHex    = ack_builder::kPacketAckSize * 2;
-    static constexpr size_t kLineCap   = kPrefixLen + kMaxHex + 2; // +\n +\0
-
+static bool lora_tx_ack_via_serial(size_t port, const uint8_t* data, size_t len) {
     if (len != ack_builder::kPacketAckSize) return false;
+    return radio_send_frame(port, "PACKET_ACK_TX:", data, len);
+}
 
-    char line[kLineCap];
-    std::memcpy(line, kPrefix, kPrefixLen);
-    static const char kDigits[] = "0123456789abcdef";
-    for (size_t i = 0; i < len; ++i) {
-        line[kPrefixLen + i * 2]     = kDigits[(data[i] >> 4) & 0x0Fu];
-        line[kPrefixLen + i * 2 + 1] = kDigits[data[i] & 0x0Fu];
+// VOID-134: PacketB.sat_id is a little-endian uint32 (SNLP offset 112,
+// CCSDS offset 104). Pulling it by explicit byte-shift avoids any
+// misaligned-pointer cast and is endian-safe.
+template <typename PacketB>
+static uint32_t extract_packet_b_sat_id(const uint8_t* pkt) {
+    const uint8_t* p = pkt + offsetof(PacketB, sat_id);
+    return  static_cast<uint32_t>(p[0])
+         | (static_cast<uint32_t>(p[1]) <<  8)
+         | (static_cast<uint32_t>(p[2]) << 16)
+         | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// PacketB.epoch_ts (LE u64) in the frame's own tier: the tunnel's
+// replay nonce until L2 block heights reach the station.
+static uint64_t extract_packet_b_epoch(const uint8_t* pkt, size_t len) {
+    const size_t off = (frame_dispatch::detect_tier(pkt, len) == frame_dispatch::Tier::kSnlp)
+                           ? offsetof(snlp::PacketB_t, epoch_ts)
+                           : offsetof(ccsds::PacketB_t, epoch_ts);
+    uint64_t v = 0;
+    for (size_t i = 0; i < sizeof(v); ++i) v |= static_cast<uint64_t>(pkt[off + i]) << (8u * i);
+    return v;
+}
+
+// Sends one signed PacketAck back out the port its PacketB came in on.
+static void send_signed_ack(const ack_signer::Done& done, void* /*user*/) {
+    if (done.ok && lora_tx_ack_via_serial(done.tag, done.frame, sizeof(done.frame))) {
+        std::puts("[ACK] ✅ PacketAck emitted over LoRa downlink.");
+    } else {
+        std::puts("[ACK] ⚠️  PacketAck emit failed (non-fatal).");
     }
-    const size_t line_len = kPrefixLen + len * 2u;
-    line[line_len]     = '\n';
-    line[line_len + 1] = '\0';
+}
 
-    const int n = serial_write_bytes(reinterpret_cast<const uint8_t*>(line),
-                                     line_len + 1);
-    return n >= 0;
+static void on_ack_signed(int /*fd*/, void* /*user*/) {
+    ack_signers.drain(send_signed_ack, nullptr);
 }
 
-// VOID-134: PacketB.sat_id lives at SNLP offset 112 as a little-endian
-// uint32 (see void_packets_snlp.h::PacketB_t). Pulling it by explicit
-// byte-shift avoids any misaligned-pointer cast and is endian-safe.
-static uint32_t extract_packet_b_sat_id_snlp(const uint8_t* pkt) {
-    return  static_cast<uint32_t>(pkt[112])
-         | (static_cast<uint32_t>(pkt[113]) <<  8)
-         | (static_cast<uint32_t>(pkt[114]) << 16)
-         | (static_cast<uint32_t>(pkt[115]) << 24);
+static void on_ack_drain_timer(void* /*user*/) {
+    ack_signers.drain(send_signed_ack, nullptr);
 }
 
-// --- Helper: Hex to Binary (No Heap) ---
-void hex_to_bin(const char* hex, uint8_t* bin_out, size_t max_len) {
-    size_t len = std::strlen(hex);
-    for (size_t i = 0; i < len && (i / 2) < max_len; i += 2) {
-        char byte_str[3] = {hex[i], hex[i+1], '\0'};
-        bin_out[i/2] = static_cast<uint8_t>(std::strtol(byte_str, nullptr, 16));
+// VOID_ACK_SIGNERS=<n>: signing workers (default: one per core but
+// the ingest core).
+static size_t ack_signer_count() {
+    if (const char* v = std::getenv("VOID_ACK_SIGNERS")) {
+        char* endp = nullptr;
+        const unsigned long n = std::strtoul(v, &endp, 10);
+        if (endp != v && *endp == '\0' && n >= 1ul && n <= ack_signer::kMaxWorkers) {
+            return static_cast<size_t>(n);
+        }
     }
+    const unsigned cores = std::thread::hardware_concurrency();
+    return (cores > 1) ? cores - 1 : 1;
+}
+
+// Unix time in ms, the PacketB epoch_ts base.
+static uint64_t wall_clock_ms() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
 }
 
 // --- Test Command: Simulate Radio Packet ---
@@ -122,7 +384,9 @@ static void test_ack() {
     std::puts("\n[INFO] Simulating incoming PacketB_t from LoRa Radio...");
 
     PacketB_t mock_radio_rx = {};
-    mock_radio_rx.header.apid_lo = 0x08; // Dummy Header
+    frame_dispatch::Codec<frame_dispatch::Tier::kSnlp>::write_header(
+        reinterpret_cast<uint8_t*>(&mock_radio_rx.header), sizeof(mock_radio_rx.header),
+        101u, false, 0u, sizeof(PacketB_t));
     
     // Inject mock data into the encrypted payload space (62 bytes)
     uint64_t ts = 1708722000;
@@ -134,11 +398,27 @@ static void test_ack() {
     std::memcpy(mock_radio_rx.enc_payload + 44, &sat, 4);
     std::memcpy(mock_radio_rx.enc_payload + 48, &amt, 8);
     std::memcpy(mock_radio_rx.enc_payload + 56, &ast, 2);
+    mock_radio_rx.sat_id = sat;
+    // A fresh epoch each run, or the replay window rejects the repeat.
+    mock_radio_rx.epoch_ts = wall_clock_ms();
+
+    // The bouncer now verifies Ed25519 for real: sign the mock with a
+    // throwaway identity registered under the mock sat_id, then seal
+    // the CRC so the frame clears every firewall stage.
+    uint8_t demo_pub[crypto_sign_PUBLICKEYBYTES];
+    uint8_t demo_priv[crypto_sign_SECRETKEYBYTES];
+    crypto_sign_keypair(demo_pub, demo_priv);
+    edge_firewall.register_sat_key(sat, demo_pub, sizeof(demo_pub));
+    uint8_t* raw = reinterpret_cast<uint8_t*>(&mock_radio_rx);
+    crypto_sign_detached(mock_radio_rx.signature, nullptr, raw,
+                         offsetof(PacketB_t, signature), demo_priv);
+    sodium_memzero(demo_priv, sizeof(demo_priv));
+    mock_radio_rx.global_crc = crc32_ieee::compute(raw, offsetof(PacketB_t, global_crc));
 
     uint8_t sanitized_out[62] = {0};
 
     // 1. Pass it through the firewall
-    if (edge_firewall.process_packet(reinterpret_cast<const uint8_t*>(&mock_radio_rx), sizeof(PacketB_t), sanitized_out, sizeof(sanitized_out))) {
+    if (edge_firewall.process_packet(raw, sizeof(PacketB_t), sanitized_out, sizeof(sanitized_out))) {
         std::puts("[BOUNCER] ✅ Firewall passed. Bridging to Web3 Gateway...");
         
         // 2. Send via TCP to Go Server
@@ -152,23 +432,68 @@ static void test_ack() {
     }
 }
 
-// VOID-138: egress poll thread. Drains pending receipts from the Go
-// gateway every `interval_ms` and dispatches each PacketC via LoRa
-// (through the serial HAL). Exits cleanly on `is_running = false`.
+// Post-firewall handling for one verified PacketB: ACK on the downlink,
+// then push the live frame to the Go Gateway.
+static void handle_accepted_packet_b(const uint8_t* packet_bin, size_t len, uint32_t sat_id,
+                                     size_t port) {
+    std::puts("[BOUNCER] ✅ Signature Valid. Decryption Success.");
+
+    // VOID-134: emit PacketAck on the downlink independently
+    // of gateway delivery. Per Acknowledgement-spec, the ACK
+    // confirms reception — gateway/L2 settlement is a later
+    // phase and failing to reach L2 must not suppress it.
+    // Fire-and-forget, no retry (alpha).
+    ack_signer::Job job = {};
+    job.tag                = static_cast<uint32_t>(port);
+    job.ack.target_tx_id   = sat_id;
+    job.ack.status         = ack_builder::kAckStatusVerified;
+    job.ack.azimuth        = 180;        // flat-sat fixed pointing
+    job.ack.elevation      = 45;
+    job.ack.frequency_hz   = 437200000u; // 437.2 MHz ISM
+    job.ack.duration_ms    = 5000u;
+    job.tunnel.block_nonce = extract_packet_b_epoch(packet_bin, len);
+    job.tunnel.cmd_code    = ack_builder::kTunnelCmdUnlock;
+    job.tunnel.ttl         = kAckTunnelTtlS;
+
+    // The ground_sig is signed on a worker and the frame sent from
+    // on_ack_signed(); with every queue full it is signed here.
+    if (!ack_signers.submit(job)) {
+        ack_signer::Done done;
+        done.tag = job.tag;
+        done.ok  = ack_signer::build_signed(job, ground_identity, done.frame);
+        send_signed_ack(done, nullptr);
+    }
+
+    // Hand the LIVE hardware packet to the delivery thread; the verdict
+    // arrives via on_ingest_result when its batch is flushed.
+    if (gateway_delivery.submit(packet_bin, len, sat_id) == ingest::Submit::kDropped) {
+        std::printf("[GATEWAY] ⚠️  Delivery queue full; frame from sat 0x%08X dropped.\n",
+                    static_cast<unsigned>(sat_id));
+    }
+}
+
+// VOID-138: egress. Drains pending receipts from the Go gateway and
+// dispatches each PacketC via LoRa (through the serial HAL). By default
+// a dedicated thread long-polls GET /egress/watch with a receipt cursor,
+// so a new receipt goes out within milliseconds of being written; with
+// VOID_EGRESS_MODE=poll (or a gateway without /watch) it is an interval
+// tick instead — a reactor timer on the main thread.
 //
 // Env tuning:
-//   VOID_EGRESS_POLL_MS   — poll interval (default 1000 ms)
-//   VOID_EGRESS_DISABLED  — set to "1" to skip the thread entirely
+//   VOID_EGRESS_MODE      — "watch" (default) or "poll"
+//   VOID_EGRESS_POLL_MS   — poll interval, and the back-off after a
+//                           failed long-poll (default 1000 ms)
+//   VOID_EGRESS_DISABLED  — set to "1" to skip egress entirely
 //
 // Non-fatal errors are logged and the loop continues — the gateway's
 // PENDING state is authoritative, so a transient failure here just
 // means the record stays PENDING and gets re-offered next tick.
-void egress_poll_listener() {
+using EgressOrchestrator = egress::EgressOrchestrator<egress::EgressPollClient>;
+
+// Returns the configured poll interval, or 0 if egress is disabled.
+static unsigned egress_poll_interval_ms() {
     const char* disabled = std::getenv("VOID_EGRESS_DISABLED");
-    if (disabled != nullptr && std::strcmp(disabled, "1") == 0) {
-        std::puts("[EGRESS] VOID_EGRESS_DISABLED=1 — poll thread not started.");
-        return;
-    }
+    if (disabled != nullptr && std::strcmp(disabled, "1") == 0) return 0;
 
     // Interval: parse env var if set, else default 1000 ms.
     unsigned interval_ms = 1000;
@@ -179,167 +504,689 @@ void egress_poll_listener() {
             interval_ms = static_cast<unsigned>(v);
         }
     }
+    return interval_ms;
+}
+
+// VOID_INGEST_BATCH_MS: how long an accepted frame may wait for others
+// to share its ingest request (default 20 ms; 0 = send each at once).
+static uint32_t ingest_batch_delay_ms() {
+    if (const char* v = std::getenv("VOID_INGEST_BATCH_MS")) {
+        char* endp = nullptr;
+        const unsigned long ms = std::strtoul(v, &endp, 10);
+        if (endp != v && *endp == '\0' && ms <= 1000ul) return static_cast<uint32_t>(ms);
+    }
+    return ingest::kDefaultBatchPolicy.max_delay_ms;
+}
 
-    egress::EgressOrchestrator<egress::EgressPollClient> orch(
-        egress_client, lora_tx_via_serial, nullptr);
-    std::printf("[EGRESS] 🔁 Polling gateway for pending receipts every %u ms.\n",
-                interval_ms);
+// VOID_CHECK_FRESHNESS=1: reject PacketBs whose epoch_ts is more than
+// Bouncer::kFreshnessMs off this host's clock. Needs GPS-disciplined
+// epochs on the satellite, so it stays off for flat-sat stubs.
+static bool check_freshness() {
+    const char* v = std::getenv("VOID_CHECK_FRESHNESS");
+    return v != nullptr && std::strcmp(v, "1") == 0;
+}
+
+// VOID_GROUND_SEED: 64 hex chars, the ground authority's Ed25519 seed.
+// Without it the station signs Packet H (Resp) with a key made fresh
+// at start-up, which sats holding the real authority key will refuse.
+static bool init_ground_identity() {
+    uint8_t seed[security_context::kSeedSize];
+    const char* v = std::getenv("VOID_GROUND_SEED");
+    if (v == nullptr) {
+        randombytes_buf(seed, sizeof(seed));
+    } else if (std::strlen(v) != 2 * sizeof(seed) ||
+               !hex_codec::decode(v, 2 * sizeof(seed), seed, sizeof(seed))) {
+        std::puts("[ERROR] VOID_GROUND_SEED must be 64 hex characters.");
+        return false;
+    }
+    const bool ok = ground_identity.init_from_seed(seed);
+    sodium_memzero(seed, sizeof(seed));
+    if (!ok) return false;
+    char pub[2 * security_context::kPubKeySize + 1];
+    pub[hex_codec::encode(ground_identity.public_key(), security_context::kPubKeySize, pub,
+                          sizeof(pub) - 1)] = '\0';
+    std::printf("[HANDSHAKE] Ground authority key %s%s.\n", pub,
+                (v == nullptr) ? " (ephemeral: set VOID_GROUND_SEED)" : "");
+    return true;
+}
+
+// VOID_SPOOL_DIR: where accepted frames are spooled (default
+// "void-spool" under the working directory; "off" disables spooling).
+static const char* spool_dir() {
+    const char* v = std::getenv("VOID_SPOOL_DIR");
+    if (v == nullptr || *v == '\0') return "void-spool";
+    if (std::strcmp(v, "off") == 0) return nullptr;
+    return v;
+}
+
+static void on_egress_tick(void* user) {
+    EgressOrchestrator* orch = static_cast<EgressOrchestrator*>(user);
+    const int dispatched = orch->tick();
+    if (dispatched > 0) {
+        std::printf("[EGRESS] ✅ Dispatched %d receipt(s) this tick.\n",
+                    dispatched);
+    }
+    // dispatched < 0: transport or parse error — retried next tick.
+    // Common during startup before the gateway has its HTTP listener up.
+}
 
+static bool egress_watch_mode() {
+    const char* v = std::getenv("VOID_EGRESS_MODE");
+    return v == nullptr || std::strcmp(v, "poll") != 0;
+}
+
+// Sleeps up to `ms`, waking early on shutdown.
+static void egress_backoff(unsigned ms) {
+    for (unsigned slept = 0; slept < ms && is_running; slept += 50) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+}
+
+// Egress thread body in watch mode. A held long-poll would stall serial
+// ingest on the reactor thread, hence the thread. Backs off one poll
+// interval after an error or a failed TX/ACK (the gateway would answer
+// the retry at once); falls back to interval ticks if there is no
+// /watch route.
+static void egress_watch_loop(EgressOrchestrator* orch, unsigned interval_ms) {
     while (is_running) {
-        const int dispatched = orch.tick();
+        const int dispatched = orch->watch(egress::EgressWatchMaxWaitMs);
+        if (dispatched == egress::EgressWatchUnsupported) {
+            std::printf("[EGRESS] Gateway has no /egress/watch — polling every %u ms "
+                        "instead.\n", interval_ms);
+            break;
+        }
         if (dispatched > 0) {
-            std::printf("[EGRESS] ✅ Dispatched %d receipt(s) this tick.\n",
-                        dispatched);
-        } else if (dispatched < 0) {
-            // Transport or parse error — wait out the tick and retry.
-            // Common during startup before the gateway has its HTTP
-            // listener up.
+            std::printf("[EGRESS] ✅ Dispatched %d receipt(s) (cursor %llu).\n",
+                        dispatched, static_cast<unsigned long long>(orch->cursor()));
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+        if (dispatched < 0 || orch->watch_stalled()) egress_backoff(interval_ms);
+    }
+    while (is_running) {
+        on_egress_tick(orch);
+        egress_backoff(interval_ms);
     }
-    std::puts("[EGRESS] Shutting down poll thread.");
 }
 
-// --- Background CLI Thread ---
+// --- CLI ---
+static void handle_cli_command(const char* input) {
+    if (std::strcmp(input, "h") == 0) {
+        std::puts("[CLI] Triggering Handshake via USB...");
+        radio_send_line(0, "H");
+    }
+    else if (std::strcmp(input, "ack") == 0) {
+        std::puts("[CLI] Authorizing Buy...");
+        radio_send_line(0, "ACK_BUY");
+    }
+    else if (std::strcmp(input, "tst_ack") == 0) {
+        test_ack(); // Run our zero-heap pipeline test
+    }
+    else if (std::strcmp(input, "sessions") == 0) {
+        print_session_stats();
+    }
+    else if (std::strcmp(input, "exit") == 0) {
+        std::puts("[CLI] Shutting down...");
+        is_running = false;
+    }
+}
+
+// Fallback for hosts where stdin can't join the reactor (Windows, or
+// stdin redirected from a regular file): blocking reads on a thread.
+// Commands touch the Bouncer and session tables, which belong to the
+// reactor thread, so the reader only queues each line; the main loop
+// runs it after its next wake (at most kLoopWakeMs away).
+struct CliLine {
+    char text[32];
+};
+static SpscRing<CliLine, 4> cli_inbox;
+
 void cli_listener() {
-    char input[32] = {0};
-    std::puts("\n💻 CLI Ready. Commands: 'h', 'ack', 'tst_ack' (Test Pipeline), 'exit'");
-    
+    char input[sizeof(CliLine::text)] = {0};
     while (is_running) {
         if (std::fgets(input, sizeof(input), stdin)) {
             size_t len = std::strlen(input);
             if (len > 0 && input[len - 1] == '\n') input[len - 1] = '\0'; // Strip newline
-
-            if (std::strcmp(input, "h") == 0) {
-                std::puts("[CLI] Triggering Handshake via USB...");
-                const char* cmd = "H\n";
-                serial_write_bytes(reinterpret_cast<const uint8_t*>(cmd), std::strlen(cmd));
-            } 
-            else if (std::strcmp(input, "ack") == 0) {
-                std::puts("[CLI] Authorizing Buy...");
-                const char* cmd = "ACK_BUY\n";
-                serial_write_bytes(reinterpret_cast<const uint8_t*>(cmd), std::strlen(cmd));
-            } 
-            else if (std::strcmp(input, "tst_ack") == 0) {
-                test_ack(); // Run our zero-heap pipeline test
+            CliLine* slot = cli_inbox.claim();
+            if (slot == nullptr) {
+                std::printf("[CLI] Busy — '%s' dropped.\n", input);
+                continue;
             }
-            else if (std::strcmp(input, "exit") == 0) {
-                std::puts("[CLI] Shutting down...");
-                is_running = false;
+            std::memcpy(slot->text, input, sizeof(slot->text));
+            cli_inbox.publish();
+        }
+    }
+}
+
+// Reactor thread: runs the commands cli_listener() queued.
+static void drain_cli_inbox() {
+    const CliLine* line;
+    while ((line = cli_inbox.front()) != nullptr) {
+        handle_cli_command(line->text);
+        cli_inbox.release();
+    }
+}
+
+#ifndef _WIN32
+static line_framer::LineFramer<32> cli_line;
+
+static void on_stdin_ready(int fd, void* user) {
+    reactor::Reactor* loop = static_cast<reactor::Reactor*>(user);
+    uint8_t chunk[64];
+    const ssize_t n = ::read(fd, chunk, sizeof(chunk));
+    if (n <= 0) {
+        loop->remove_fd(fd); // EOF (Ctrl-D / closed pipe): stop watching
+        return;
+    }
+    cli_line.feed(chunk, static_cast<size_t>(n), [](char* line, size_t) {
+        handle_cli_command(line);
+        return true;
+    });
+}
+#endif
+
+// --- USB-serial RX dispatch ---
+// Hex frame lines from the firmware are routed on frame content (sync,
+// APID, packet_len, F-03 magic), not on the line prefix: the buyer
+// reports a relayed PacketC as "PACKET_D:". Handling another packet
+// type is one rx_dispatch.on<T>() line in main().
+static frame_dispatch::Dispatcher rx_dispatch;
+
+// PacketB frames completed within one serial drain are verified as a
+// batch (pass bursts + retransmits) before any ACK/gateway work. Slots
+// are sized for the larger (SNLP) frame so LoRa and S-band PacketBs
+// share one batch. Each frame is tagged with the radio port it came
+// in on so the ACK goes back out the same receiver.
+struct RxBatch {
+    uint8_t      bin[Bouncer::kMaxBatch][sizeof(snlp::PacketB_t)];
+    BouncerFrame frames[Bouncer::kMaxBatch];
+    uint32_t     sat_id[Bouncer::kMaxBatch];
+    uint8_t      port[Bouncer::kMaxBatch];
+    uint8_t      src_port; // port currently being drained
+    size_t       count;
+};
+static RxBatch rx_batch;
+
+template <typename PacketB>
+static void on_rx_packet_b(const frame_dispatch::FrameView<PacketB>& v, void* user) {
+    RxBatch* batch = static_cast<RxBatch*>(user);
+    std::printf("\n[HARDWARE] 📦 Received PACKET B from Sat B on %s. Routing to Bouncer...\n",
+                radio_ports[batch->src_port].serial.name());
+    if (batch->count >= Bouncer::kMaxBatch) {
+        std::puts("[BOUNCER] ⚠️  Batch full — PacketB dropped.");
+        return;
+    }
+    // Blacklisted sats are dropped before the Bouncer spends a verify.
+    const uint32_t sat_id = extract_packet_b_sat_id<PacketB>(v.bytes());
+    if (!ground_sessions.admit(sat_id, reactor::now_ms())) return;
+    // The line buffer is reused for the next line, so the batch keeps
+    // its own copy until process_batch() runs.
+    uint8_t* slot = batch->bin[batch->count];
+    std::memcpy(slot, v.bytes(), v.size());
+    batch->frames[batch->count] = {slot, v.size()};
+    batch->sat_id[batch->count] = sat_id;
+    batch->port[batch->count]   = batch->src_port;
+    ++batch->count;
+}
+
+static const char* rx_port_name() {
+    return radio_ports[rx_batch.src_port].serial.name();
+}
+
+static void on_rx_invoice(const frame_dispatch::FrameView<PacketA_t>& v, void* /*user*/) {
+    std::printf("\n[HARDWARE] 📄 Received Packet A (Invoice) from APID %u on %s. Awaiting 'ack' command.\n",
+                static_cast<unsigned>(v.info().apid), rx_port_name());
+}
+
+static void on_rx_receipt(const frame_dispatch::FrameView<PacketC_t>& v, void* /*user*/) {
+    std::printf("\n[HARDWARE] 🧾 Received Packet C (Receipt) relayed from APID %u on %s.\n",
+                static_cast<unsigned>(v.info().apid), rx_port_name());
+}
+
+// Packet H (Init). The frame carries no sat_id; a flat-sat link has the
+// one registered sat. The answer goes back as the line the firmware
+// parses: HANDSHAKE_ACK:<ground eph_pub hex><signature hex>. The sat
+// rebuilds the rest of Packet H (Resp) — header, its own TTL and
+// timestamp echoed — to check the signature.
+template <typename PacketH>
+static void on_rx_handshake(const frame_dispatch::FrameView<PacketH>& v, void* /*user*/) {
+    const uint8_t  port   = rx_batch.src_port;
+    const uint32_t sat_id = kFlatSatId;
+    const uint64_t now    = reactor::now_ms();
+    std::printf("\n[HARDWARE] 🤝 Received Packet H (Init) from APID %u on %s.\n",
+                static_cast<unsigned>(v.info().apid), radio_ports[port].serial.name());
+    if (!ground_sessions.admit(sat_id, now)) return;
+
+    // Only a vacant or pending session takes a handshake (§5.2); checked
+    // before respond() so a live session's key is never replaced.
+    const ground_session::State st = ground_sessions.state(sat_id, now);
+    if (st != ground_session::State::kVacant &&
+        st != ground_session::State::kHandshakePending) {
+        std::printf("[SESSION] Packet H from sat 0x%08X not accepted in state %s.\n",
+                    static_cast<unsigned>(sat_id), ground_session::state_name(st));
+        return;
+    }
+
+    uint8_t resp[handshake_responder::kMaxPacketH];
+    size_t  resp_len = 0;
+    const handshake_responder::Verdict hv = handshake.respond(
+        v.bytes(), v.size(), sat_id, kFlatSatPubKey, now, resp, sizeof(resp), &resp_len);
+    if (hv != handshake_responder::Verdict::kResponded) {
+        std::printf("[HANDSHAKE] ❌ Packet H rejected (%s).\n",
+                    handshake_responder::verdict_name(hv));
+        if (hv == handshake_responder::Verdict::kBadSignature) {
+            note_session_event(sat_id, ground_session::Event::kSigFail, now);
+        }
+        return;
+    }
+    note_session_event(sat_id, ground_session::Event::kHandshakeInit, now);
+
+    static constexpr char kTag[] = "HANDSHAKE_ACK:";
+    char line[sizeof(kTag) + 2 * (security_context::kPubKeySize + security_context::kSignatureSize)];
+    std::memcpy(line, kTag, sizeof(kTag) - 1);
+    size_t n = sizeof(kTag) - 1;
+    n += hex_codec::encode(resp + offsetof(PacketH, eph_pub_key), security_context::kPubKeySize,
+                           line + n, sizeof(line) - n);
+    n += hex_codec::encode(resp + offsetof(PacketH, signature), security_context::kSignatureSize,
+                           line + n, sizeof(line) - n);
+    line[n] = '\0';
+    if (radio_send_line(port, line)) {
+        std::printf("[HANDSHAKE] ✅ Session key installed for sat 0x%08X; response sent.\n",
+                    static_cast<unsigned>(sat_id));
+    }
+}
+
+static void on_rx_heartbeat(const frame_dispatch::FrameView<HeartbeatPacket_t>& v, void* /*user*/) {
+    std::printf("\n[HARDWARE] 💓 Heartbeat from APID %u (seq %u) on %s.\n",
+                static_cast<unsigned>(v.info().apid),
+                static_cast<unsigned>(v.info().seq_count), rx_port_name());
+}
+
+static void dispatch_rx_frame(const uint8_t* frame, size_t len) {
+    const frame_dispatch::Status st = rx_dispatch.dispatch(frame, len);
+    if (st != frame_dispatch::Status::kOk) {
+        std::printf("[HARDWARE] ⚠️  Frame dropped (%s).\n", frame_dispatch::status_name(st));
+    }
+}
+
+// Handles one "<TAG>:<hex>" line from a hex-mode port. Lines whose
+// payload is not a whole hex frame (firmware log chatter such as
+// "WARN:...") are ignored; the board's framing answer switches the
+// port to COBS.
+static void route_rx_line(RadioPort* rp, const char* line) {
+    if (std::strcmp(line, serial_frame::kAcceptLine) == 0) {
+        std::printf("[SERIAL] %s switched to COBS binary framing.\n", rp->serial.name());
+        {
+            std::lock_guard<std::mutex> lock(radio_tx_mu);
+            rp->mode = LinkMode::kCobs;
+        }
+        rp->cobs.reset();
+        return;
+    }
+    offer_framing(rp);
+
+    const char* colon = std::strchr(line, ':');
+    if (colon == nullptr) return;
+    const char* hex = colon + 1;
+    const size_t hex_len = std::strlen(hex);
+
+    uint8_t frame[VOID_MAX_PACKET_SIZE];
+    if (hex_len == 0 || !hex_codec::decode(hex, hex_len, frame, sizeof(frame))) return;
+    dispatch_rx_frame(frame, hex_len / 2);
+}
+
+// Several receivers usually hear the same PacketB. Accepted frames are
+// remembered briefly by CRC so the ACK + gateway push run once, on the
+// first port that heard it. A repeat on the SAME port is the satellite
+// retransmitting because it missed our ACK, so that one is handled again.
+struct RecentRx {
+    uint32_t crc;
+    uint64_t seen_ms;
+    uint8_t  port;
+    bool     used;
+};
+static constexpr size_t   kRecentRxSlots        = 16;
+static constexpr uint64_t kCrossPortDupWindowMs = 2000;
+static RecentRx recent_rx[kRecentRxSlots];
+static size_t   recent_rx_next = 0;
+
+// Returns true (and the first port in *first) if another port already
+// handled this frame inside the window; otherwise records it.
+static bool heard_on_other_port(const uint8_t* buf, size_t len, uint8_t port, uint8_t* first) {
+    const uint32_t crc = crc32_ieee::compute(buf, len);
+    const uint64_t now = reactor::now_ms();
+    for (const RecentRx& r : recent_rx) {
+        if (r.used && r.crc == crc && now - r.seen_ms <= kCrossPortDupWindowMs) {
+            if (r.port == port) break; // same-port retransmit: re-ACK
+            *first = r.port;
+            return true;
+        }
+    }
+    recent_rx[recent_rx_next] = {crc, now, port, true};
+    recent_rx_next = (recent_rx_next + 1) % kRecentRxSlots;
+    return false;
+}
+
+// Verifies every PacketB gathered since the last flush as one batch,
+// then ACKs + forwards the accepted ones.
+static void flush_rx_batch() {
+    if (rx_batch.count == 0) return;
+    BouncerVerdict verdicts[Bouncer::kMaxBatch];
+    edge_firewall.process_batch(rx_batch.frames, rx_batch.count, verdicts);
+    const uint64_t now = reactor::now_ms();
+    for (size_t k = 0; k < rx_batch.count; ++k) {
+        const BouncerFrame& f = rx_batch.frames[k];
+        if (verdicts[k] != BouncerVerdict::kAccepted) {
+            std::printf("[BOUNCER] ❌ Threat Detected (%s). Packet Dropped.\n",
+                        bouncer_verdict_name(verdicts[k]));
+            if (verdicts[k] == BouncerVerdict::kReplay) {
+                note_session_event(rx_batch.sat_id[k], ground_session::Event::kPacketBReplay, now);
+            } else if (verdicts[k] == BouncerVerdict::kBadSignature) {
+                note_session_event(rx_batch.sat_id[k], ground_session::Event::kSigFail, now);
             }
+            continue;
+        }
+        const ground_session::Result sr =
+            note_session_event(rx_batch.sat_id[k], ground_session::Event::kPacketB, now);
+        if (sr.action != ground_session::Action::kOpen &&
+            sr.action != ground_session::Action::kSettle) {
+            std::printf("[SESSION] PacketB from sat 0x%08X not accepted in state %s (%s).\n",
+                        static_cast<unsigned>(rx_batch.sat_id[k]),
+                        ground_session::state_name(sr.from),
+                        ground_session::action_name(sr.action));
+            continue;
+        }
+        uint8_t first = 0;
+        if (heard_on_other_port(f.buf, f.len, rx_batch.port[k], &first)) {
+            std::printf("[RX] PacketB on %s already handled via %s — duplicate suppressed.\n",
+                        radio_ports[rx_batch.port[k]].serial.name(),
+                        radio_ports[first].serial.name());
+            continue;
+        }
+        handle_accepted_packet_b(f.buf, f.len, rx_batch.sat_id[k], rx_batch.port[k]);
+    }
+    rx_batch.count = 0;
+}
+
+static void feed_cobs_byte(RadioPort* rp, uint8_t byte) {
+    switch (rp->cobs.push(byte)) {
+    case serial_frame::Decoder::Result::kFrame:
+        // kLine is firmware chatter; kTxFrame never travels upstream.
+        if (rp->cobs.type() == serial_frame::Type::kFrame) {
+            dispatch_rx_frame(rp->cobs.payload(), rp->cobs.payload_len());
+        }
+        break;
+    case serial_frame::Decoder::Result::kError:
+        std::printf("[SERIAL] ⚠️  Corrupt frame on %s dropped.\n", rp->serial.name());
+        break;
+    case serial_frame::Decoder::Result::kOverflow:
+        // No delimiter for a whole frame's worth of bytes: the board
+        // rebooted into ASCII. Fall back; its next line re-offers.
+        std::printf("[SERIAL] ⚠️  %s stopped speaking COBS — back to ASCII hex.\n",
+                    rp->serial.name());
+        {
+            std::lock_guard<std::mutex> lock(radio_tx_mu);
+            rp->mode = LinkMode::kHex;
         }
+        rp->offers = 0;
+        rp->line.reset();
+        break;
+    case serial_frame::Decoder::Result::kPending:
+        break;
     }
 }
 
+// Feeds received bytes through the port's current framing. The mode
+// can flip mid-buffer (the accept line is followed directly by COBS), so
+// the line framer stops after any line that switches it, and also when
+// the PacketB batch fills, and hands the rest on.
+static void feed_radio(RadioPort* rp, uint8_t* data, size_t len) {
+    const auto on_line = [rp](char* line, size_t) {
+        route_rx_line(rp, line);
+        return rp->mode == LinkMode::kHex && rx_batch.count < Bouncer::kMaxBatch;
+    };
+    size_t i = 0;
+    while (i < len) {
+        if (rp->mode == LinkMode::kHex) {
+            i += rp->line.feed(data + i, len - i, on_line);
+        } else {
+            feed_cobs_byte(rp, data[i++]);
+        }
+        if (rx_batch.count == Bouncer::kMaxBatch) flush_rx_batch();
+    }
+}
+
+// Drains everything the port has buffered (the fd is O_NDELAY), then
+// verifies the resulting PacketB batch once.
+static void drain_radio(RadioPort* rp) {
+    if (rp->lost) return;
+    rx_batch.src_port = rp->index;
+    uint8_t rx_buf[4096];
+    int bytes;
+    while ((bytes = rp->serial.read(rx_buf, sizeof(rx_buf))) > 0) {
+        feed_radio(rp, rx_buf, static_cast<size_t>(bytes));
+    }
+    flush_rx_batch();
+    if (bytes < 0) {
+        // Hang-up or I/O error (board unplugged). The reactor drops the
+        // fd on HUP; the other receivers keep running.
+        std::printf("[SERIAL] ⚠️  Lost %s — no longer reading it.\n", rp->serial.name());
+        rp->lost = true;
+    }
+}
+
+static void on_radio_ready(int /*fd*/, void* user) {
+    drain_radio(static_cast<RadioPort*>(user));
+}
+
+// Timed reads for ports the reactor can't watch (Windows HANDLEs).
+static void on_radio_fallback_timer(void* /*user*/) {
+    for (size_t i = 0; i < radio_port_count; ++i) {
+        if (!radio_ports[i].polled) drain_radio(&radio_ports[i]);
+    }
+}
+
+// Opens one "<device>[@<baud>]" command-line argument as the next radio
+// port. The '@' is split in place (argv is writable).
+static bool open_radio_port(char* arg) {
+    if (radio_port_count == kMaxRadioPorts) {
+        std::printf("[ERROR] Too many radio ports (max %zu); ignoring %s\n", kMaxRadioPorts, arg);
+        return false;
+    }
+    uint32_t baud = kDefaultBaud;
+    if (char* at = std::strrchr(arg, '@')) {
+        char* endp = nullptr;
+        const unsigned long v = std::strtoul(at + 1, &endp, 10);
+        if (endp == at + 1 || *endp != '\0' || !SerialPort::supports_baud(static_cast<uint32_t>(v))) {
+            std::printf("[ERROR] Unsupported baud rate in %s\n", arg);
+            return false;
+        }
+        baud = static_cast<uint32_t>(v);
+        *at = '\0';
+    }
+
+    RadioPort& rp = radio_ports[radio_port_count];
+    if (!rp.serial.open(arg, baud)) {
+        std::printf("[ERROR] Failed to connect to %s\n", arg);
+        return false;
+    }
+    rp.index  = static_cast<uint8_t>(radio_port_count);
+    rp.mode   = LinkMode::kHex;
+    rp.offers = 0;
+    std::printf("[SYSTEM] Connected to hardware on %s @ %u baud%s\n", arg,
+                static_cast<unsigned>(baud), (radio_port_count == 0) ? " (primary)" : "");
+    ++radio_port_count;
+    if (!framing_negotiation) {
+        // A board a previous station left on COBS goes back to hex lines.
+        radio_send_line(rp.index, serial_frame::kRevertLine);
+    }
+    offer_framing(&rp);
+    return true;
+}
+
 // --- Main execution ---
 int main(int argc, char* argv[]) {
     // We allow running without a COM port strictly for testing the 'tst_ack' CLI command
-    bool hardware_connected = false;
+    if (sodium_init() < 0) {
+        std::puts("[ERROR] libsodium init failed — cannot verify signatures.");
+        return 1;
+    }
+    edge_firewall.register_sat_key(kFlatSatId, kFlatSatPubKey, sizeof(kFlatSatPubKey));
+    if (check_freshness()) {
+        edge_firewall.set_clock(&wall_clock_ms);
+        handshake.set_clock(&wall_clock_ms);
+    }
+    if (!init_ground_identity()) return 1;
+    edge_firewall.set_session_store(&session_keys, reactor::now_ms);
+    handshake_keys.start();
+
+    // LoRa (SNLP) and S-band (CCSDS) PacketBs feed the same bouncer batch.
+    rx_dispatch.on<snlp::PacketB_t>(&on_rx_packet_b<snlp::PacketB_t>, &rx_batch);
+    rx_dispatch.on<ccsds::PacketB_t>(&on_rx_packet_b<ccsds::PacketB_t>, &rx_batch);
+    rx_dispatch.on<PacketA_t>(&on_rx_invoice, nullptr);
+    rx_dispatch.on<PacketC_t>(&on_rx_receipt, nullptr);
+    rx_dispatch.on<HeartbeatPacket_t>(&on_rx_heartbeat, nullptr);
+    rx_dispatch.on<snlp::PacketH_t>(&on_rx_handshake<snlp::PacketH_t>, nullptr);
+    rx_dispatch.on<ccsds::PacketH_t>(&on_rx_handshake<ccsds::PacketH_t>, nullptr);
     
-    if (argc >= 2) {
-        if (!serial_open(argv[1], 115200)) {
-            std::printf("[ERROR] Failed to connect to %s\n", argv[1]);
-        } else {
-            std::printf("[SYSTEM] Connected to hardware on %s\n", argv[1]);
-            hardware_connected = true;
-        }
-    } else {
+    if (const char* framing = std::getenv("VOID_SERIAL_FRAMING")) {
+        framing_negotiation = (std::strcmp(framing, "hex") != 0);
+    }
+
+    // ground_station <device>[@baud] [<device>[@baud] ...]
+    for (int i = 1; i < argc; ++i) {
+        open_radio_port(argv[i]);
+    }
+    if (argc < 2) {
         std::puts("[SYSTEM] Starting in TEST MODE (No COM port provided). Use 'tst_ack'.");
     }
 
-    // Spawn the CLI in the background
-    std::thread cli_thread(cli_listener);
+    // The main thread sleeps in the reactor until a radio has bytes, a
+    // CLI command arrives or the egress timer is due — no fixed polling
+    // interval. All receivers share the one loop.
+    reactor::Reactor loop;
+    const bool can_poll = loop.open();
 
-    // VOID-138: spawn the egress poll thread. Joined below on shutdown.
-    std::thread egress_thread(egress_poll_listener);
+    bool need_fallback_timer = false;
+    for (size_t i = 0; i < radio_port_count; ++i) {
+        RadioPort& rp = radio_ports[i];
+        rp.polled = can_poll && loop.add_fd(rp.serial.fd(), on_radio_ready, &rp);
+        if (!rp.polled) need_fallback_timer = true;
+    }
+    if (need_fallback_timer) {
+        // Non-pollable ports (Windows HANDLE): timed reads as before.
+        loop.add_timer(kSerialFallbackPollMs, on_radio_fallback_timer, nullptr);
+    }
+    ground_sessions.attach(&session_timers);
+    session_deadline = loop.add_deadline(on_session_deadline, &loop);
+
+    std::puts("\n💻 CLI Ready. Commands: 'h', 'ack', 'tst_ack' (Test Pipeline), 'sessions', 'exit'");
+    std::thread cli_thread;
+#ifndef _WIN32
+    const bool cli_in_loop = can_poll && loop.add_fd(STDIN_FILENO, on_stdin_ready, &loop);
+#else
+    const bool cli_in_loop = false;
+#endif
+    if (!cli_in_loop) cli_thread = std::thread(cli_listener);
 
-    // Buffers for reading USB Serial streams
-    uint8_t rx_buf[256];
-    char line_buf[512] = {0};
-    size_t line_idx = 0;
+    // VOID-138: egress long-poll thread, or poll on a reactor timer.
+    EgressOrchestrator orch(egress_client, lora_tx_via_serial, nullptr);
+    const unsigned egress_ms = egress_poll_interval_ms();
+    std::thread    egress_thread;
+    if (egress_ms == 0) {
+        std::puts("[EGRESS] VOID_EGRESS_DISABLED=1 — egress polling not started.");
+    } else if (egress_watch_mode()) {
+        egress_thread = std::thread(egress_watch_loop, &orch, egress_ms);
+        std::puts("[EGRESS] 🔁 Long-polling gateway for new receipts.");
+    } else {
+        loop.add_timer(egress_ms, on_egress_tick, &orch);
+        std::printf("[EGRESS] 🔁 Polling gateway for pending receipts every %u ms.\n",
+                    egress_ms);
+    }
 
-    // --- The Main Hardware Polling Loop ---
+    ingest::BatchPolicy batch_policy = ingest::kDefaultBatchPolicy;
+    batch_policy.max_delay_ms = ingest_batch_delay_ms();
+    gateway_delivery.set_policy(batch_policy);
+    if (const char* dir = spool_dir()) {
+        if (frame_spool.open(dir)) {
+            gateway_delivery.attach_spool(&frame_spool);
+            const spool::Stats sp = frame_spool.stats();
+            std::printf("[SPOOL] 💾 Spooling accepted frames to %s/ (%llu undelivered "
+                        "frame(s) to replay).\n",
+                        dir, static_cast<unsigned long long>(sp.recovered));
+        } else {
+            std::printf("[SPOOL] ⚠️  Cannot open spool at %s — frames are held in memory "
+                        "only.\n", dir);
+        }
+    }
+    gateway_delivery.start();
+
+    if (ack_signers.start(ack_signer_count())) {
+        if (!(can_poll && loop.add_fd(ack_signers.notify_fd(), on_ack_signed, nullptr))) {
+            loop.add_timer(kAckDrainMs, on_ack_drain_timer, nullptr);
+        }
+        std::printf("[ACK] ✍️  %zu PacketAck signing worker(s).\n", ack_signers.workers());
+    } else {
+        std::puts("[ACK] ⚠️  Signing workers unavailable — ACKs are signed inline.");
+    }
+
+    // --- The Main Event Loop ---
     while (is_running) {
-        if (hardware_connected) {
-            int bytes = serial_read_bytes(rx_buf, sizeof(rx_buf));
-            
-            for (int i = 0; i < bytes; i++) {
-                char c = static_cast<char>(rx_buf[i]);
-                if (c == '\n' || c == '\r') {
-                    if (line_idx > 0) {
-                        line_buf[line_idx] = '\0'; 
-                        
-                        if (std::strncmp(line_buf, "PACKET_B:", 9) == 0) {
-                            std::puts("\n[HARDWARE] 📦 Received PACKET B from Sat B. Routing to Bouncer...");
-                            
-                            uint8_t packet_bin[SIZE_PACKET_B]; 
-                            uint8_t cleartext_out[256];
-                            
-                            hex_to_bin(&line_buf[9], packet_bin, sizeof(packet_bin));
-                            
-                            // Let the Bouncer validate the crypto & structural limits
-                            if (edge_firewall.process_packet(packet_bin, sizeof(packet_bin), cleartext_out, sizeof(cleartext_out))) {
-                                std::puts("[BOUNCER] ✅ Signature Valid. Decryption Success.");
-
-                                // VOID-134: emit PacketAck on the downlink independently
-                                // of gateway delivery. Per Acknowledgement-spec, the ACK
-                                // confirms reception — gateway/L2 settlement is a later
-                                // phase and failing to reach L2 must not suppress it.
-                                // Fire-and-forget, no retry (alpha).
-                                ack_builder::AckInputs ack_in = {};
-                                ack_in.target_tx_id = extract_packet_b_sat_id_snlp(packet_bin);
-                                ack_in.status       = ack_builder::kAckStatusVerified;
-                                ack_in.azimuth      = 180;        // flat-sat fixed pointing
-                                ack_in.elevation    = 45;
-                                ack_in.frequency_hz = 437200000u; // 437.2 MHz ISM
-                                ack_in.duration_ms  = 5000u;
-                                // enc_tunnel left zero-filled: plaintext alpha has no
-                                // on-chain UNLOCK sig to carry (VOID-134 non-goal).
-
-                                uint8_t ack_frame[ack_builder::kPacketAckSize];
-                                if (ack_builder::build(ack_in, ack_frame, sizeof(ack_frame)) &&
-                                    lora_tx_ack_via_serial(ack_frame, sizeof(ack_frame))) {
-                                    std::puts("[ACK] ✅ PacketAck emitted over LoRa downlink.");
-                                } else {
-                                    std::puts("[ACK] ⚠️  PacketAck emit failed (non-fatal).");
-                                }
-
-                                // Push the LIVE hardware packet to the Go Gateway
-                                if (go_gateway.push_to_l2(packet_bin, sizeof(packet_bin))) {
-                                    std::puts("[GATEWAY] ✅ Live hardware payload delivered to Gateway.");
-                                } else {
-                                    std::puts("[GATEWAY] ❌ Failed to reach Go Gateway.");
-                                }
-                            } else {
-                                std::puts("[BOUNCER] ❌ Threat Detected. Packet Dropped.");
-                            }
-                        }
-
-
-                        // --- RESTORED CHUNK ---
-                        else if (std::strncmp(line_buf, "INVOICE:", 8) == 0) {
-                            std::puts("\n[HARDWARE] 📄 Received Packet A (Invoice). Awaiting 'ack' command.");
-                        }
-                        // ----------------------
-                        line_idx = 0; // Reset buffer
-                    }
-                } else if (line_idx < sizeof(line_buf) - 1) {
-                    line_buf[line_idx++] = c;
-                }
-            }
+        arm_session_deadline(&loop);
+        if (loop.run_once(cli_in_loop ? -1 : kLoopWakeMs) < 0) {
+            std::puts("[ERROR] Reactor wait failed — shutting down.");
+            is_running = false;
         }
-        
-        // Sleep for 10ms to prevent CPU pegging (100% usage)
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if (!cli_in_loop) drain_cli_inbox();
     }
 
-    // Cleanup
-    cli_thread.detach();
-    // VOID-138: egress poll thread watches `is_running` and exits
-    // promptly on shutdown. Join rather than detach so its last log
-    // line lands before main returns.
+    // Cleanup: let an open long-poll return (≤ EgressWatchMaxWaitMs)
+    // before the serial ports close, then deliver whatever is queued.
     if (egress_thread.joinable()) egress_thread.join();
-    if (hardware_connected) serial_close();
+    ack_signers.stop();
+    ack_signers.drain(send_signed_ack, nullptr); // the last ACKs out
+    gateway_delivery.stop();
+    handshake_keys.stop();
+    if (cli_thread.joinable()) cli_thread.detach(); // parked in fgets()
+    loop.close();
+    for (size_t i = 0; i < radio_port_count; ++i) {
+        // Leave the board on ASCII for the next station or a terminal.
+        if (radio_ports[i].mode == LinkMode::kCobs && !radio_ports[i].lost) {
+            radio_send_line(i, serial_frame::kRevertLine);
+        }
+        radio_ports[i].serial.close();
+    }
+    const http_pool::Stats net = gateway_pool.stats();
+    std::printf("[NET] Gateway: %llu request(s), %llu connect(s), %llu reused, "
+                "%llu stale retr%s, %llu failure(s).\n",
+                static_cast<unsigned long long>(net.requests),
+                static_cast<unsigned long long>(net.connects),
+                static_cast<unsigned long long>(net.reuses),
+                static_cast<unsigned long long>(net.stale_retries),
+                (net.stale_retries == 1) ? "y" : "ies",
+                static_cast<unsigned long long>(net.failures));
+    const ack_signer::Stats as = ack_signers.stats();
+    std::printf("[ACK] %llu PacketAck(s) signed on workers, %llu failed, %llu signed inline.\n",
+                static_cast<unsigned long long>(as.signed_),
+                static_cast<unsigned long long>(as.failed),
+                static_cast<unsigned long long>(as.full));
+    const ingest::DeliveryStats dq = gateway_delivery.stats();
+    std::printf("[NET] Delivery queue: %llu frame(s), high-water %llu/%u, "
+                "max wait %llu ms, %llu full, %llu dropped.\n",
+                static_cast<unsigned long long>(dq.delivered),
+                static_cast<unsigned long long>(dq.high_water),
+                static_cast<unsigned>(ingest::kDeliveryRingSlots),
+                static_cast<unsigned long long>(dq.max_wait_ms),
+                static_cast<unsigned long long>(dq.full),
+                static_cast<unsigned long long>(dq.dropped));
+    if (frame_spool.is_open()) {
+        const spool::Stats sp = frame_spool.stats();
+        std::printf("[SPOOL] %llu frame(s) spooled, %llu group sync(s), %llu replay(s), "
+                    "%llu left for next start.\n",
+                    static_cast<unsigned long long>(sp.appended),
+                    static_cast<unsigned long long>(sp.syncs),
+                    static_cast<unsigned long long>(dq.retries),
+                    static_cast<unsigned long long>(sp.head - 1 - sp.acked));
+        frame_spool.close();
+    }
     std::puts("[SYSTEM] Ground Station shut down securely.");
     return 0;
-}
\ No newline at end of file
+}
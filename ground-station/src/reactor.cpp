@@ -0,0 +1,236 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      reactor.cpp
+ * Desc:      epoll / poll() implementation of the bouncer reactor.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "reactor.h"
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <unistd.h>
+#elif !defined(_WIN32)
+    #include <poll.h>
+#endif
+
+namespace reactor {
+namespace {
+
+// Upper bound on a timer-only wait with nothing scheduled, so a
+// caller's run_once(-1) loop still re-checks its exit flag.
+constexpr int kIdleWaitMs = 100;
+
+}  // namespace
+
+uint64_t now_ms() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(
+        duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+Reactor::Reactor() : _epoll_fd(-1), _open(false) {
+    for (Source& s : _sources) s = {-1, nullptr, nullptr, false};
+    for (Timer& t : _timers)   t = {0u, 0u, nullptr, nullptr, false};
+}
+
+Reactor::~Reactor() {
+    close();
+}
+
+bool Reactor::open() {
+    if (_open) return true;
+#if defined(__linux__)
+    _epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll_fd < 0) return false;
+    _open = true;
+#elif !defined(_WIN32)
+    _open = true;
+#endif
+    return _open;
+}
+
+void Reactor::close() {
+#if defined(__linux__)
+    if (_epoll_fd >= 0) {
+        ::close(_epoll_fd);
+        _epoll_fd = -1;
+    }
+#endif
+    _open = false;
+    for (Source& s : _sources) s = {-1, nullptr, nullptr, false};
+}
+
+Reactor::Source* Reactor::find_source(int fd) {
+    for (Source& s : _sources) {
+        if (s.used && s.fd == fd) return &s;
+    }
+    return nullptr;
+}
+
+bool Reactor::watching(int fd) const {
+    for (const Source& s : _sources) {
+        if (s.used && s.fd == fd) return true;
+    }
+    return false;
+}
+
+bool Reactor::add_fd(int fd, ReadyFn fn, void* user) {
+    if (!_open || fd < 0 || fn == nullptr || watching(fd)) return false;
+    Source* slot = nullptr;
+    for (Source& s : _sources) {
+        if (!s.used) { slot = &s; break; }
+    }
+    if (slot == nullptr) return false;
+
+#if defined(__linux__)
+    struct epoll_event ev = {};
+    ev.events  = EPOLLIN;
+    ev.data.fd = fd;
+    if (::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) return false;
+#endif
+    *slot = {fd, fn, user, true};
+    return true;
+}
+
+bool Reactor::remove_fd(int fd) {
+    Source* s = find_source(fd);
+    if (s == nullptr) return false;
+#if defined(__linux__)
+    ::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+    *s = {-1, nullptr, nullptr, false};
+    return true;
+}
+
+bool Reactor::add_timer(uint32_t period_ms, TimerFn fn, void* user) {
+    if (period_ms == 0u || fn == nullptr) return false;
+    for (Timer& t : _timers) {
+        if (!t.used) {
+            t = {period_ms, now_ms() + period_ms, fn, user, true};
+            return true;
+        }
+    }
+    return false;
+}
+
+int Reactor::add_deadline(TimerFn fn, void* user) {
+    if (fn == nullptr) return -1;
+    for (size_t i = 0; i < kMaxTimers; ++i) {
+        if (!_timers[i].used) {
+            _timers[i] = {0u, kNoDeadline, fn, user, true};
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool Reactor::set_deadline(int id, uint64_t due_ms) {
+    if (id < 0 || static_cast<size_t>(id) >= kMaxTimers) return false;
+    Timer& t = _timers[static_cast<size_t>(id)];
+    if (!t.used || t.period_ms != 0u) return false;
+    t.due_ms = due_ms;
+    return true;
+}
+
+uint64_t Reactor::deadline(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= kMaxTimers) return kNoDeadline;
+    const Timer& t = _timers[static_cast<size_t>(id)];
+    return (t.used && t.period_ms == 0u) ? t.due_ms : kNoDeadline;
+}
+
+int Reactor::wait_timeout(int max_wait_ms, uint64_t now) const {
+    int timeout = max_wait_ms;
+    for (const Timer& t : _timers) {
+        if (!t.used || t.due_ms == kNoDeadline) continue;
+        const uint64_t left = (t.due_ms > now) ? t.due_ms - now : 0u;
+        // A periodic due time is never more than a period out; a
+        // deadline can be arbitrarily far.
+        const uint64_t cap = (t.period_ms != 0u) ? t.period_ms : static_cast<uint64_t>(INT_MAX);
+        const int left_ms = static_cast<int>((left > cap) ? cap : left);
+        if (timeout < 0 || left_ms < timeout) timeout = left_ms;
+    }
+    return timeout;
+}
+
+int Reactor::fire_due_timers(uint64_t now) {
+    int fired = 0;
+    for (Timer& t : _timers) {
+        if (!t.used || t.due_ms > now) continue;
+        if (t.period_ms == 0u) {
+            t.due_ms = kNoDeadline;
+            t.fn(t.user);
+            ++fired;
+            continue;
+        }
+        t.due_ms += t.period_ms;
+        if (t.due_ms <= now) t.due_ms = now + t.period_ms; // overran: skip, don't burst
+        t.fn(t.user);
+        ++fired;
+    }
+    return fired;
+}
+
+int Reactor::run_once(int max_wait_ms) {
+    const int timeout = wait_timeout(max_wait_ms, now_ms());
+    int ran = 0;
+
+    if (!_open) {
+        // No poller (Windows, or open() not called): timers only.
+        const int nap = (timeout < 0) ? kIdleWaitMs : timeout;
+        if (nap > 0) std::this_thread::sleep_for(std::chrono::milliseconds(nap));
+        return fire_due_timers(now_ms());
+    }
+
+#if defined(__linux__)
+    struct epoll_event events[kMaxSources];
+    const int n = ::epoll_wait(_epoll_fd, events, static_cast<int>(kMaxSources), timeout);
+    if (n < 0 && errno != EINTR) return -1;
+    for (int i = 0; i < n; ++i) {
+        const size_t k = static_cast<size_t>(i);
+        const int fd = events[k].data.fd;
+        Source* s = find_source(fd);
+        if (s == nullptr) continue; // removed by an earlier callback this round
+        s->fn(fd, s->user);
+        ++ran;
+        if ((events[k].events & (EPOLLHUP | EPOLLERR)) != 0) {
+            remove_fd(fd);
+        }
+    }
+#elif !defined(_WIN32)
+    struct pollfd pfds[kMaxSources];
+    nfds_t nfds = 0;
+    for (const Source& s : _sources) {
+        if (!s.used) continue;
+        pfds[nfds].fd      = s.fd;
+        pfds[nfds].events  = POLLIN;
+        pfds[nfds].revents = 0;
+        ++nfds;
+    }
+    const int n = ::poll(pfds, nfds, timeout);
+    if (n < 0 && errno != EINTR) return -1;
+    for (nfds_t i = 0; n > 0 && i < nfds; ++i) {
+        if (pfds[i].revents == 0) continue;
+        Source* s = find_source(pfds[i].fd);
+        if (s == nullptr) continue;
+        s->fn(pfds[i].fd, s->user);
+        ++ran;
+        if ((pfds[i].revents & (POLLHUP | POLLERR | POLLNVAL)) != 0) {
+            remove_fd(pfds[i].fd);
+        }
+    }
+#endif
+
+    return ran + fire_due_timers(now_ms());
+}
+
+}  // namespace reactor
@@ -0,0 +1,113 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      replay_window.cpp
+ * Desc:      Per-satellite sliding replay window (see replay_window.h).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "replay_window.h"
+
+namespace replay_window {
+namespace {
+
+constexpr uint64_t kHorizonMax = static_cast<uint64_t>(kWindowMs) + 1;
+
+// Remembers the epoch `back` ms behind newest, with `resent`
+// retransmits already spent. When every record is in
+// use the oldest epoch — an existing record or this one — is dropped and
+// the horizon moves up to it, so it is rejected from then on rather than
+// forgotten.
+void remember(Window& w, uint16_t back, uint32_t crc, uint8_t resent) {
+    size_t oldest = kRecent;
+    for (size_t i = 0; i < kRecent; ++i) {
+        if (w.back[i] == kNoRecord) {
+            w.back[i]   = back;
+            w.crc[i]    = crc;
+            w.resent[i] = resent;
+            return;
+        }
+        if (oldest == kRecent || w.back[i] > w.back[oldest]) oldest = i;
+    }
+    if (back >= w.back[oldest]) {
+        if (back < w.horizon) w.horizon = back;
+        return;
+    }
+    if (w.back[oldest] < w.horizon) w.horizon = w.back[oldest];
+    w.back[oldest]   = back;
+    w.crc[oldest]    = crc;
+    w.resent[oldest] = resent;
+}
+
+// A byte-identical copy is a retransmit until its record has let
+// kMaxRetransmits through; after that it is a replay like any other.
+Check resend(uint32_t crc, uint32_t record_crc, uint8_t resent) {
+    if (crc != record_crc) return Check::kReplay;
+    return resent < kMaxRetransmits ? Check::kRetransmit : Check::kReplay;
+}
+
+} // anonymous namespace
+
+void start(Window& w, uint64_t epoch, uint32_t crc) {
+    w.newest        = epoch;
+    w.newest_crc    = crc;
+    w.horizon       = static_cast<uint16_t>(kHorizonMax);
+    w.newest_resent = 0;
+    w.pad           = 0;
+    for (size_t i = 0; i < kRecent; ++i) {
+        w.back[i]   = kNoRecord;
+        w.crc[i]    = 0;
+        w.resent[i] = 0;
+    }
+}
+
+Check check(const Window& w, uint64_t epoch, uint32_t crc) {
+    if (epoch > w.newest) return Check::kFresh;
+
+    const uint64_t behind = w.newest - epoch;
+    if (behind == 0) return resend(crc, w.newest_crc, w.newest_resent);
+    if (behind >= w.horizon) return Check::kReplay;
+    for (size_t i = 0; i < kRecent; ++i) {
+        if (w.back[i] == behind) return resend(crc, w.crc[i], w.resent[i]);
+    }
+    return Check::kFresh;
+}
+
+void commit(Window& w, uint64_t epoch, uint32_t crc) {
+    if (epoch <= w.newest) {
+        const uint64_t behind = w.newest - epoch;
+        if (behind == 0) {
+            ++w.newest_resent;
+            return;
+        }
+        for (size_t i = 0; i < kRecent; ++i) {
+            if (w.back[i] != behind) continue;
+            ++w.resent[i];
+            return;
+        }
+        // Out of order but inside the horizon (check() said kFresh).
+        remember(w, static_cast<uint16_t>(behind), crc, 0);
+        return;
+    }
+
+    // The window slides forward by `d`: every record and the horizon
+    // age with it, records falling off the back are dropped, and the
+    // previous newest becomes a record of its own.
+    const uint64_t d = epoch - w.newest;
+    const uint64_t h = (d < kHorizonMax - w.horizon) ? w.horizon + d : kHorizonMax;
+    w.horizon = static_cast<uint16_t>(h);
+    for (size_t i = 0; i < kRecent; ++i) {
+        if (w.back[i] == kNoRecord) continue;
+        w.back[i] = (d < h - w.back[i]) ? static_cast<uint16_t>(w.back[i] + d) : kNoRecord;
+    }
+    if (d < h) remember(w, static_cast<uint16_t>(d), w.newest_crc, w.newest_resent);
+
+    w.newest        = epoch;
+    w.newest_crc    = crc;
+    w.newest_resent = 0;
+}
+
+} // namespace replay_window
@@ -17,126 +17,226 @@
 #ifdef _WIN32
 #include <windows.h>
 
-static HANDLE hSerial = INVALID_HANDLE_VALUE;
+SerialPort::SerialPort() : _name(nullptr), _baud(0), _handle(INVALID_HANDLE_VALUE) {}
 
-bool serial_open(const char* port_name, uint32_t baud_rate) {
-    hSerial = CreateFileA(port_name, GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
-    if (hSerial == INVALID_HANDLE_VALUE) return false;
+SerialPort::~SerialPort() {
+    close();
+}
+
+bool SerialPort::supports_baud(uint32_t baud_rate) {
+    return baud_rate > 0; // DCB.BaudRate takes the rate directly
+}
+
+bool SerialPort::open(const char* port_name, uint32_t baud_rate) {
+    if (is_open() || !supports_baud(baud_rate)) return false;
+
+    HANDLE h = CreateFileA(port_name, GENERIC_READ | GENERIC_WRITE, 0, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (h == INVALID_HANDLE_VALUE) return false;
 
     DCB dcbSerialParams = {0};
     dcbSerialParams.DCBlength = sizeof(dcbSerialParams);
-    if (!GetCommState(hSerial, &dcbSerialParams)) return false;
+    if (!GetCommState(h, &dcbSerialParams)) { CloseHandle(h); return false; }
 
     dcbSerialParams.BaudRate = baud_rate;
     dcbSerialParams.ByteSize = 8;
     dcbSerialParams.StopBits = ONESTOPBIT;
     dcbSerialParams.Parity   = NOPARITY;
 
-    if (!SetCommState(hSerial, &dcbSerialParams)) return false;
+    if (!SetCommState(h, &dcbSerialParams)) { CloseHandle(h); return false; }
 
     // Non-blocking reads
     COMMTIMEOUTS timeouts = {0};
     timeouts.ReadIntervalTimeout         = MAXDWORD;
     timeouts.ReadTotalTimeoutConstant    = 0;
     timeouts.ReadTotalTimeoutMultiplier  = 0;
-    SetCommTimeouts(hSerial, &timeouts);
+    SetCommTimeouts(h, &timeouts);
 
+    _handle = h;
+    _name   = port_name;
+    _baud   = baud_rate;
     return true;
 }
 
-int serial_read_bytes(uint8_t* buffer, size_t max_bytes) {
-    if (hSerial == INVALID_HANDLE_VALUE) return -1;
+bool SerialPort::is_open() const {
+    return _handle != INVALID_HANDLE_VALUE;
+}
+
+int SerialPort::read(uint8_t* buffer, size_t max_bytes) {
+    if (!is_open()) return -1;
     DWORD bytes_read;
-    if (ReadFile(hSerial, buffer, static_cast<DWORD>(max_bytes), &bytes_read, NULL)) {
+    if (ReadFile(static_cast<HANDLE>(_handle), buffer, static_cast<DWORD>(max_bytes), &bytes_read, NULL)) {
         return static_cast<int>(bytes_read);
     }
     return -1;
 }
 
-void serial_close() {
-    if (hSerial != INVALID_HANDLE_VALUE) {
-        CloseHandle(hSerial);
-        hSerial = INVALID_HANDLE_VALUE;
+int SerialPort::fd() const {
+    return -1; // HANDLE is not pollable alongside sockets/stdin
+}
+
+void SerialPort::close() {
+    if (is_open()) {
+        CloseHandle(static_cast<HANDLE>(_handle));
+        _handle = INVALID_HANDLE_VALUE;
     }
 }
 
-int serial_write_bytes(const uint8_t* buffer, size_t len) {
-    if (hSerial == INVALID_HANDLE_VALUE) return -1;
+int SerialPort::write(const uint8_t* buffer, size_t len) {
+    if (!is_open()) return -1;
     DWORD bytes_written;
-    if (WriteFile(hSerial, buffer, static_cast<DWORD>(len), &bytes_written, NULL)) {
+    if (WriteFile(static_cast<HANDLE>(_handle), buffer, static_cast<DWORD>(len), &bytes_written, NULL)) {
         return static_cast<int>(bytes_written);
     }
     return -1;
 }
 
+// WriteFile blocks (no write timeouts are set), so each call takes what
+// it can; a call that takes nothing is treated as a stall.
+bool SerialPort::write_all(const uint8_t* buffer, size_t len, uint32_t /*timeout_ms*/) {
+    size_t done = 0;
+    while (done < len) {
+        const int n = write(buffer + done, len - done);
+        if (n <= 0) return false;
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
 // =================================================================-------
 // MAC / LINUX (POSIX) IMPLEMENTATION
 // =================================================================-------
 #else
+#include <cerrno>
+#include <chrono>
 #include <fcntl.h>
+#include <poll.h>
 #include <termios.h>
 #include <unistd.h>
 
-static int serial_fd = -1;
+namespace {
+
+// termios wants a Bxxx constant, not the numeric rate.
+bool BaudToSpeed(uint32_t baud_rate, speed_t* out) {
+    switch (baud_rate) {
+        case 9600:   *out = B9600;   return true;
+        case 19200:  *out = B19200;  return true;
+        case 38400:  *out = B38400;  return true;
+        case 57600:  *out = B57600;  return true;
+        case 115200: *out = B115200; return true;
+#ifdef B230400
+        case 230400: *out = B230400; return true;
+#endif
+#ifdef B460800
+        case 460800: *out = B460800; return true;
+#endif
+#ifdef B921600
+        case 921600: *out = B921600; return true;
+#endif
+        default: return false;
+    }
+}
+
+}  // namespace
+
+SerialPort::SerialPort() : _name(nullptr), _baud(0), _fd(-1) {}
+
+SerialPort::~SerialPort() {
+    close();
+}
+
+bool SerialPort::supports_baud(uint32_t baud_rate) {
+    speed_t speed;
+    return BaudToSpeed(baud_rate, &speed);
+}
+
+bool SerialPort::open(const char* port_name, uint32_t baud_rate) {
+    speed_t speed;
+    if (is_open() || !BaudToSpeed(baud_rate, &speed)) return false;
 
-bool serial_open(const char* port_name, uint32_t baud_rate) {
-    (void)baud_rate; // Suppress unused warning (assuming 115200 for demo)
-    
     // Open in non-blocking read/write mode
-    serial_fd = open(port_name, O_RDWR | O_NOCTTY | O_NDELAY);
-    if (serial_fd == -1) return false;
+    const int fd = ::open(port_name, O_RDWR | O_NOCTTY | O_NDELAY | O_CLOEXEC);
+    if (fd == -1) return false;
 
     struct termios options;
-    tcgetattr(serial_fd, &options);
+    if (tcgetattr(fd, &options) != 0) { ::close(fd); return false; }
 
-    // Set Baud Rate to 115200
-    cfsetispeed(&options, B115200);
-    cfsetospeed(&options, B115200);
+    cfsetispeed(&options, speed);
+    cfsetospeed(&options, speed);
 
     // 8N1 standard configuration
     options.c_cflag |= (CLOCAL | CREAD);
-    // options.c_cflag &= ~PARENB;
-    // options.c_cflag &= ~CSTOPB;
-    // options.c_cflag &= ~CSIZE;
-    // options.c_cflag |= CS8;
-
-    // 1. Fix C_CFLAG (Control Modes)
     options.c_cflag &= ~static_cast<tcflag_t>(PARENB); // Clear parity bit
     options.c_cflag &= ~static_cast<tcflag_t>(CSTOPB); // Clear stop field
     options.c_cflag &= ~static_cast<tcflag_t>(CSIZE);  // Clear size bits
     options.c_cflag |= static_cast<tcflag_t>(CS8);    // 8-bit characters
 
+    // Raw input (no terminal echo or line buffering)
     tcflag_t local_mask = static_cast<tcflag_t>(ICANON | ECHO | ECHOE | ISIG);
     options.c_lflag &= ~local_mask;
 
     options.c_iflag &= ~static_cast<tcflag_t>(IXON | IXOFF | IXANY);
-    
-    // // Raw input (no terminal echo or line buffering)
-    // options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+    options.c_iflag &= ~static_cast<tcflag_t>(ICRNL | INLCR | IGNCR);
+
+    // Raw output: no "\n" -> "\r\n" rewriting on the way to the board
+    options.c_oflag &= ~static_cast<tcflag_t>(OPOST);
 
-    tcsetattr(serial_fd, TCSANOW, &options);
-    fcntl(serial_fd, F_SETFL, FNDELAY);
+    if (tcsetattr(fd, TCSANOW, &options) != 0) { ::close(fd); return false; }
+    fcntl(fd, F_SETFL, FNDELAY);
 
+    _fd   = fd;
+    _name = port_name;
+    _baud = baud_rate;
     return true;
 }
 
-int serial_read_bytes(uint8_t* buffer, size_t max_bytes) {
-    if (serial_fd == -1) return -1;
-    int bytes_read = static_cast<int>(read(serial_fd, buffer, max_bytes));
-    return (bytes_read > 0) ? bytes_read : 0;
+bool SerialPort::is_open() const {
+    return _fd != -1;
 }
 
-void serial_close() {
-    if (serial_fd != -1) {
-        close(serial_fd);
-        serial_fd = -1;
-    }
+int SerialPort::read(uint8_t* buffer, size_t max_bytes) {
+    if (!is_open()) return -1;
+    const ssize_t n = ::read(_fd, buffer, max_bytes);
+    if (n > 0) return static_cast<int>(n);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+    return -1; // 0 on a non-blocking tty = hang-up (board unplugged)
+}
+
+int SerialPort::fd() const {
+    return _fd;
 }
 
+void SerialPort::close() {
+    if (_fd != -1) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
 
-int serial_write_bytes(const uint8_t* buffer, size_t len) {
-    if (serial_fd == -1) return -1;
-    int bytes_written = static_cast<int>(write(serial_fd, buffer, len));
-    return (bytes_written > 0) ? bytes_written : 0;
+int SerialPort::write(const uint8_t* buffer, size_t len) {
+    if (!is_open()) return -1;
+    const ssize_t n = ::write(_fd, buffer, len);
+    if (n >= 0) return static_cast<int>(n);
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+}
+bool SerialPort::write_all(const uint8_t* buffer, size_t len, uint32_t timeout_ms) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    size_t done = 0;
+    while (done < len) {
+        const int n = write(buffer + done, len - done);
+        if (n < 0) return false;
+        done += static_cast<size_t>(n);
+        if (done == len) break;
+
+        // OS buffer full (or a short write): wait for room.
+        const long long left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   deadline - Clock::now()).count();
+        if (left <= 0) return false;
+        struct pollfd pfd = {_fd, POLLOUT, 0};
+        const int r = ::poll(&pfd, 1, static_cast<int>(left));
+        if (r < 0 && errno != EINTR) return false;
+        if (r > 0 && (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) return false;
+    }
+    return true;
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,228 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      loopback_http_server.h
+ * Desc:      Loopback HTTP/1.1 server shared by the gateway-facing test
+ *            suites: real sockets, no mocks, same wire path the bouncer
+ *            uses in production.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Binds 127.0.0.1 on a kernel-assigned port and serves each accepted
+ * connection on its own thread: requests are framed by Content-Length,
+ * handed to the test's handler, and its reply is sent verbatim. The
+ * connection stays open (keep-alive) unless the reply says to close, so
+ * one server covers one-shot, keep-alive, dropped-connection and
+ * long-poll tests. A handler may block (long-poll); whatever it waits on
+ * must be woken before stop().
+ *
+ * std::string / std::function are used ONLY in test scaffolding —
+ * production code remains no-heap / bounded-buffer.
+ * -------------------------------------------------------------------------*/
+
+#ifndef LOOPBACK_HTTP_SERVER_H
+#define LOOPBACK_HTTP_SERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace loopback_http {
+
+struct Request {
+    std::string head;  // request line + headers, without the blank line
+    std::string body;  // Content-Length bytes
+    int         conn;  // accept ordinal on this server, from 0
+    int         seq;   // request ordinal on this connection, from 0
+
+    std::string raw() const { return head + "\r\n\r\n" + body; }
+};
+
+struct Reply {
+    std::string bytes;         // sent verbatim; empty sends nothing
+    bool        close = false; // hang up after sending
+};
+
+using Handler = std::function<Reply(const Request&)>;
+
+// "HTTP/1.1 <status>" with a JSON Content-Type, Content-Length and any
+// `extra_headers` (each ending in "\r\n"), then `body`.
+inline std::string response(const char* status, const std::string& body,
+                            const char* extra_headers = "") {
+    char head[256];
+    std::snprintf(head, sizeof(head),
+                  "HTTP/1.1 %s\r\nContent-Type: application/json\r\n"
+                  "Content-Length: %zu\r\n%s\r\n",
+                  status, body.size(), extra_headers);
+    return std::string(head) + body;
+}
+
+class Server {
+public:
+    explicit Server(Handler handler) : handler_(std::move(handler)) {
+#ifdef _WIN32
+        WSADATA wsa;
+        WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+        listen_fd_ = static_cast<int>(::socket(AF_INET, SOCK_STREAM, 0));
+        int reuse = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR,
+                     reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+        sockaddr_in addr{};
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = 0; // kernel picks
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listen_fd_, 4);
+        socklen_t alen = sizeof(addr);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &alen);
+        port_     = ntohs(addr.sin_port);
+        acceptor_ = std::thread([this]() { accept_loop(); });
+    }
+
+    ~Server() { stop(); }
+
+    Server(const Server&)            = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Closes the listener (the port then refuses connections), hangs up
+    // open connections and joins every thread. Idempotent.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (stopped_) return;
+            stopped_ = true;
+            for (int fd : conns_) ::shutdown(fd, kShutBoth);
+        }
+        ::shutdown(listen_fd_, kShutBoth); // wakes accept()
+        close_fd(listen_fd_);
+        acceptor_.join();
+        for (std::thread& t : workers_) t.join();
+    }
+
+    uint16_t port() const     { return port_; }
+    int      accepts() const  { return accepts_.load(); }
+    int      requests() const { return requests_.load(); }
+
+    // The most recent request, as received.
+    Request last_request() const {
+        std::lock_guard<std::mutex> lock(mu_);
+        return last_;
+    }
+
+private:
+#ifdef _WIN32
+    static constexpr int kShutBoth = SD_BOTH;
+    static constexpr int kSendFlags = 0;
+    static void close_fd(int fd) { ::closesocket(static_cast<SOCKET>(fd)); }
+#else
+    static constexpr int kShutBoth = SHUT_RDWR;
+    static constexpr int kSendFlags = MSG_NOSIGNAL;
+    static void close_fd(int fd) { ::close(fd); }
+#endif
+
+    void accept_loop() {
+        for (int conn = 0;; ++conn) {
+            const int fd = static_cast<int>(::accept(listen_fd_, nullptr, nullptr));
+            if (fd < 0) return;
+            std::lock_guard<std::mutex> lock(mu_);
+            if (stopped_) {
+                close_fd(fd);
+                return;
+            }
+            accepts_.fetch_add(1);
+            conns_.push_back(fd);
+            workers_.emplace_back([this, fd, conn]() {
+                serve(fd, conn);
+                std::lock_guard<std::mutex> done(mu_);
+                for (size_t i = 0; i < conns_.size(); ++i) {
+                    if (conns_[i] != fd) continue;
+                    conns_.erase(conns_.begin() + static_cast<std::ptrdiff_t>(i));
+                    break;
+                }
+                close_fd(fd);
+            });
+        }
+    }
+
+    void serve(int fd, int conn) {
+        std::string buf;
+        char        chunk[4096];
+        for (int seq = 0;; ++seq) {
+            size_t head_end = buf.find("\r\n\r\n");
+            size_t need     = std::string::npos;
+            for (;;) {
+                if (head_end != std::string::npos && need == std::string::npos) {
+                    size_t       body_len = 0;
+                    const size_t cl       = buf.find("Content-Length: ");
+                    if (cl != std::string::npos && cl < head_end) {
+                        body_len = std::strtoul(buf.c_str() + cl + 16, nullptr, 10);
+                    }
+                    need = head_end + 4 + body_len;
+                }
+                if (need != std::string::npos && buf.size() >= need) break;
+                const int n = static_cast<int>(::recv(fd, chunk, sizeof(chunk), 0));
+                if (n <= 0) return;
+                buf.append(chunk, static_cast<size_t>(n));
+                if (head_end == std::string::npos) head_end = buf.find("\r\n\r\n");
+            }
+
+            Request req;
+            req.head = buf.substr(0, head_end);
+            req.body = buf.substr(head_end + 4, need - head_end - 4);
+            req.conn = conn;
+            req.seq  = seq;
+            buf.erase(0, need);
+            requests_.fetch_add(1);
+            {
+                std::lock_guard<std::mutex> lock(mu_);
+                last_ = req;
+            }
+
+            const Reply reply = handler_(req);
+            size_t sent = 0;
+            while (sent < reply.bytes.size()) {
+                const int n = static_cast<int>(::send(fd, reply.bytes.data() + sent,
+                                                      reply.bytes.size() - sent, kSendFlags));
+                if (n <= 0) return;
+                sent += static_cast<size_t>(n);
+            }
+            if (reply.close) return;
+        }
+    }
+
+    Handler                  handler_;
+    int                      listen_fd_ = -1;
+    uint16_t                 port_      = 0;
+    std::thread              acceptor_;
+    std::vector<std::thread> workers_;
+    std::vector<int>         conns_;
+    mutable std::mutex       mu_;
+    bool                     stopped_ = false;
+    Request                  last_{};
+    std::atomic<int>         accepts_{0};
+    std::atomic<int>         requests_{0};
+};
+
+}  // namespace loopback_http
+
+#endif  // LOOPBACK_HTTP_SERVER_H
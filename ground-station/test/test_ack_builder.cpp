@@ -10,12 +10,17 @@
  * -------------------------------------------------------------------------*/
 
 #include <gtest/gtest.h>
+#include <sodium.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 
 #include "ack_builder.h"
+#include "crc32_ieee.h"
+#include "frame_dispatch.h"
+#include "security_context.h"
 
 // VOID_TEST_VECTORS_DIR is defined by CMake on the test target and
 // points at `<repo>/test/vectors`.
@@ -102,3 +107,52 @@ TEST(AckBuilder, TargetTxIdIsLittleEndianAtBodyOffsetTwo) {
     EXPECT_EQ(built[14 + 2 + 2], 0x22);
     EXPECT_EQ(built[14 + 2 + 3], 0x11);
 }
+
+// The frame the bouncer puts on the downlink must route back as an ACK
+// through the shared classifier (sync, APID, packet_len, F-03 magic).
+TEST(AckBuilder, BuiltFrameClassifiesAsAck) {
+    uint8_t built[ack_builder::kPacketAckSize] = {0};
+    ASSERT_TRUE(ack_builder::build(DeterministicInputs(),
+                                   built, sizeof(built)));
+    frame_dispatch::Status st = frame_dispatch::Status::kOk;
+    const frame_dispatch::FrameView<snlp::PacketAck_t> v =
+        frame_dispatch::view_as<snlp::PacketAck_t>(built, sizeof(built), &st);
+    ASSERT_TRUE(v) << frame_dispatch::status_name(st);
+    EXPECT_TRUE(v.info().is_command);
+    EXPECT_EQ(v->target_tx_id, 0xCAFEBABEu);
+}
+
+// Acknowledgment-spec §C: ground_sig covers header..ttl, the inner CRC
+// covers everything before it, and the header routes to Sat A.
+TEST(AckBuilder, TunnelIsSignedByTheGroundAndChecksummed) {
+    security_context::Identity ground;
+    uint8_t seed[security_context::kSeedSize];
+    std::memset(seed, 0x5A, sizeof(seed));
+    ASSERT_TRUE(ground.init_from_seed(seed));
+
+    ack_builder::TunnelInputs in = {};
+    in.block_nonce = 0x0102030405060708ull;
+    in.cmd_code    = ack_builder::kTunnelCmdUnlock;
+    in.ttl         = 60;
+    uint8_t tunnel[ack_builder::kEncTunnelSize];
+    ASSERT_TRUE(ack_builder::build_tunnel(in, ground, tunnel, sizeof(tunnel)));
+
+    using Tunnel = snlp::TunnelData_t;
+    EXPECT_EQ(crypto_sign_verify_detached(tunnel + offsetof(Tunnel, ground_sig), tunnel,
+                                          offsetof(Tunnel, ground_sig), ground.public_key()),
+              0);
+    Tunnel t;
+    std::memcpy(&t, tunnel, sizeof(t));
+    const uint64_t nonce = t.block_nonce;  // packed: no reference binding
+    const uint16_t cmd   = t.cmd_code;
+    const uint32_t crc   = t.crc32;
+    EXPECT_EQ(nonce, in.block_nonce);
+    EXPECT_EQ(cmd, ack_builder::kTunnelCmdUnlock);
+    EXPECT_EQ(crc, crc32_ieee::compute(tunnel, offsetof(Tunnel, crc32)));
+    // SNLP header bytes 4-5: BE identification field, APID in the low 11 bits.
+    EXPECT_EQ(((tunnel[4] << 8) | tunnel[5]) & 0x7FF, 100);
+
+    security_context::Identity unready;
+    EXPECT_FALSE(ack_builder::build_tunnel(in, unready, tunnel, sizeof(tunnel)));
+    EXPECT_FALSE(ack_builder::build_tunnel(in, ground, tunnel, sizeof(tunnel) - 1));
+}
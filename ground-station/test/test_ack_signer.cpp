@@ -0,0 +1,180 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_ack_signer.cpp
+ * Desc:      PacketAck signing pool: every job comes back exactly once as
+ *            a valid signed frame, identical to an inline build, the
+ *            notify fd fires, and a stalled consumer backs jobs up
+ *            instead of losing them.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <sodium.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+#include "ack_builder.h"
+#include "ack_signer.h"
+#include "frame_dispatch.h"
+#include "security_context.h"
+
+using ack_signer::Done;
+using ack_signer::Job;
+using ack_signer::SignerPool;
+
+namespace {
+
+void make_identity(security_context::Identity& id) {
+    uint8_t seed[security_context::kSeedSize];
+    std::memset(seed, 0x33, sizeof(seed));
+    ASSERT_TRUE(id.init_from_seed(seed));
+}
+
+Job make_job(uint32_t tag) {
+    Job j = {};
+    j.tag                 = tag;
+    j.ack.target_tx_id    = 0xCAFE0000u + tag;
+    j.ack.status          = ack_builder::kAckStatusVerified;
+    j.ack.duration_ms     = 5000u;
+    j.tunnel.block_nonce  = 1790985600000ull + tag;
+    j.tunnel.cmd_code     = ack_builder::kTunnelCmdUnlock;
+    j.tunnel.ttl          = 60;
+    return j;
+}
+
+struct Collected {
+    std::vector<uint32_t>                 tags;
+    std::vector<std::vector<uint8_t>>     frames;
+    size_t                                bad = 0;
+};
+
+void collect(const Done& d, void* user) {
+    Collected* c = static_cast<Collected*>(user);
+    if (!d.ok) ++c->bad;
+    c->tags.push_back(d.tag);
+    c->frames.emplace_back(d.frame, d.frame + sizeof(d.frame));
+}
+
+// Drains until `want` frames are in or ~10 s pass.
+void drain_until(SignerPool& pool, Collected& c, size_t want) {
+    for (int i = 0; i < 10000 && c.tags.size() < want; ++i) {
+        if (pool.drain(&collect, &c) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+} // namespace
+
+TEST(AckSigner, EveryJobComesBackOnceAsTheInlineFrame) {
+    security_context::Identity ground;
+    make_identity(ground);
+    SignerPool pool(ground);
+    ASSERT_TRUE(pool.start(4));
+    EXPECT_EQ(pool.workers(), 4u);
+
+    constexpr uint32_t kJobs = 500;
+    Collected c;
+    uint32_t sent = 0;
+    while (sent < kJobs) {
+        if (pool.submit(make_job(sent))) {
+            ++sent;
+        } else {
+            pool.drain(&collect, &c);  // backpressure: make room
+        }
+    }
+    drain_until(pool, c, kJobs);
+    pool.stop();
+
+    ASSERT_EQ(c.tags.size(), kJobs);
+    EXPECT_EQ(c.bad, 0u);
+    std::vector<bool> seen(kJobs, false);
+    for (size_t i = 0; i < c.tags.size(); ++i) {
+        const uint32_t tag = c.tags[i];
+        ASSERT_LT(tag, kJobs);
+        EXPECT_FALSE(seen[tag]) << "tag " << tag << " twice";
+        seen[tag] = true;
+
+        // Ed25519 is deterministic: the worker's frame is byte-identical
+        // to the one the ingest thread would have built.
+        uint8_t inline_frame[ack_builder::kPacketAckSize];
+        ASSERT_TRUE(ack_signer::build_signed(make_job(tag), ground, inline_frame));
+        ASSERT_EQ(std::memcmp(c.frames[i].data(), inline_frame, sizeof(inline_frame)), 0);
+    }
+
+    // The frame routes as an ACK and its tunnel verifies.
+    const uint8_t* f = c.frames[0].data();
+    frame_dispatch::Status st = frame_dispatch::Status::kOk;
+    const frame_dispatch::FrameView<snlp::PacketAck_t> v =
+        frame_dispatch::view_as<snlp::PacketAck_t>(f, ack_builder::kPacketAckSize, &st);
+    ASSERT_TRUE(v) << frame_dispatch::status_name(st);
+    const uint8_t* tunnel = f + offsetof(snlp::PacketAck_t, enc_tunnel);
+    EXPECT_EQ(crypto_sign_verify_detached(tunnel + offsetof(snlp::TunnelData_t, ground_sig),
+                                          tunnel, offsetof(snlp::TunnelData_t, ground_sig),
+                                          ground.public_key()),
+              0);
+
+    const ack_signer::Stats s = pool.stats();
+    EXPECT_EQ(s.submitted, kJobs);
+    EXPECT_EQ(s.signed_, kJobs);
+    EXPECT_EQ(s.drained, kJobs);
+}
+
+#ifndef _WIN32
+TEST(AckSigner, NotifyFdTurnsReadableWhenAFrameIsReady) {
+    security_context::Identity ground;
+    make_identity(ground);
+    SignerPool pool(ground);
+    ASSERT_TRUE(pool.start(1));
+    ASSERT_GE(pool.notify_fd(), 0);
+
+    pollfd pfd = {pool.notify_fd(), POLLIN, 0};
+    EXPECT_EQ(::poll(&pfd, 1, 0), 0);  // nothing yet
+    ASSERT_TRUE(pool.submit(make_job(7)));
+    ASSERT_EQ(::poll(&pfd, 1, 10000), 1);
+
+    Collected c;
+    drain_until(pool, c, 1);
+    ASSERT_EQ(c.tags.size(), 1u);
+    EXPECT_EQ(c.tags[0], 7u);
+    pfd.revents = 0;
+    EXPECT_EQ(::poll(&pfd, 1, 0), 0);  // drained: quiet again
+    pool.stop();
+}
+#endif
+
+// Nobody drains: each worker fills its completion ring, then its job
+// queue, then submit() refuses. Nothing is lost; a drain lets the rest
+// through.
+TEST(AckSigner, StalledConsumerBacksJobsUpWithoutLosingThem) {
+    security_context::Identity ground;
+    make_identity(ground);
+    SignerPool pool(ground);
+    EXPECT_FALSE(pool.submit(make_job(0)));  // not running
+    ASSERT_TRUE(pool.start(2));
+
+    uint32_t sent = 0;
+    while (pool.submit(make_job(sent))) ++sent;
+    EXPECT_GE(sent, 2 * ack_signer::kQueueSlots);
+    EXPECT_LE(sent, 4 * ack_signer::kQueueSlots);
+    EXPECT_EQ(pool.stats().full, 1u);
+
+    Collected c;
+    drain_until(pool, c, sent);
+    EXPECT_EQ(c.tags.size(), sent);
+    EXPECT_EQ(c.bad, 0u);
+    pool.stop();
+    EXPECT_EQ(pool.drain(&collect, &c), 0u);
+}
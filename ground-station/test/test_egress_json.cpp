@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <string>
 
 #include "egress_json.h"
 
@@ -184,4 +185,175 @@ TEST(EgressJSON, NullOrZeroInputsRejected) {
     const char body[] = "[]";
     EXPECT_LT(egress::parse_pending_response(body, lit_len(body), nullptr, 4), 0);
     EXPECT_LT(egress::parse_pending_response(body, lit_len(body), recs, 0), 0);
-}
\ No newline at end of file
+}
+TEST(EgressJSON, WatchCursorSeqIsOptional) {
+    // /watch adds "seq"; /pending omits it (→ 0).
+    const char body[] =
+        "[{\"seq\":18446744073709551615,\"payment_id\":\"1\","
+        "\"settlement_tx_hash\":\"0xa\",\"packet_c_hex\":\"aa\"},"
+        "{\"payment_id\":\"2\",\"settlement_tx_hash\":\"0xb\","
+        "\"packet_c_hex\":\"bb\"}]";
+    egress::Record recs[4];
+    ASSERT_EQ(egress::parse_pending_response(body, lit_len(body), recs, 4), 2);
+    EXPECT_EQ(recs[0].seq, UINT64_MAX);
+    EXPECT_EQ(recs[1].seq, 0u);
+}
+
+TEST(EgressJSON, MalformedSeqRejected) {
+    const char quoted[] =
+        "[{\"seq\":\"7\",\"payment_id\":\"1\",\"settlement_tx_hash\":\"0xa\","
+        "\"packet_c_hex\":\"aa\"}]";
+    const char overflow[] =
+        "[{\"seq\":18446744073709551616,\"payment_id\":\"1\","
+        "\"settlement_tx_hash\":\"0xa\",\"packet_c_hex\":\"aa\"}]";
+    egress::Record recs[4];
+    EXPECT_LT(egress::parse_pending_response(quoted, lit_len(quoted), recs, 4), 0);
+    EXPECT_LT(egress::parse_pending_response(overflow, lit_len(overflow), recs, 4), 0);
+}
+
+TEST(EgressJSON, StructureInsideStringsAndNestedValuesIsIgnored) {
+    // Only top-level keys of a record count; brackets, colons, commas and
+    // escaped quotes inside strings are not structure.
+    const char body[] =
+        "[{\"memo\":\"}],{\\\"payment_id\\\":\\\"evil\\\"\","
+        "\"meta\":{\"payment_id\":\"nested\",\"list\":[1,{\"x\":\"]\"}]},"
+        "\"payment_id\":\"7\",\"settlement_tx_hash\":\"0xa\","
+        "\"packet_c_hex\":\"aa\",\"ok\":true}]";
+    egress::Record recs[4];
+    ASSERT_EQ(egress::parse_pending_response(body, lit_len(body), recs, 4), 1);
+    EXPECT_STREQ(recs[0].payment_id, "7");
+    EXPECT_STREQ(recs[0].settlement_tx_hash, "0xa");
+}
+
+TEST(EgressJSON, EscapesAreTrackedAcrossBlockBoundaries) {
+    // Slide an escaped quote and an escaped backslash across every
+    // offset of the 64-byte scan blocks.
+    for (size_t pad = 0; pad < 140; ++pad) {
+        const std::string body = "[{\"pad\":\"" + std::string(pad, 'x') +
+                                 "\\\"\\\\\",\"payment_id\":\"a\\\"b\","
+                                 "\"settlement_tx_hash\":\"0x\\\\\",\"packet_c_hex\":\"cc\"}]";
+        egress::Record recs[1];
+        ASSERT_EQ(egress::parse_pending_response(body.data(), body.size(), recs, 1), 1)
+            << "pad " << pad;
+        EXPECT_STREQ(recs[0].payment_id, "a\"b");
+        EXPECT_STREQ(recs[0].settlement_tx_hash, "0x\\");
+        EXPECT_STREQ(recs[0].packet_c_hex, "cc");
+    }
+}
+
+TEST(EgressJSON, LargeBacklogParsesEveryRecord) {
+    std::string body = "[";
+    for (int i = 1; i <= 300; ++i) {
+        char rec[160];
+        std::snprintf(rec, sizeof(rec),
+                      "%s{\"seq\":%d,\"sat_id\":3405691582,\"payment_id\":\"%d\","
+                      "\"settlement_tx_hash\":\"0x%x\",\"packet_c_hex\":\"%04x\"}",
+                      i == 1 ? "" : ",\n ", i, i, i, i);
+        body += rec;
+    }
+    body += "]";
+    static egress::Record recs[300];
+    ASSERT_EQ(egress::parse_pending_response(body.data(), body.size(), recs, 300), 300);
+    EXPECT_EQ(recs[0].seq, 1u);
+    EXPECT_EQ(recs[299].seq, 300u);
+    EXPECT_STREQ(recs[299].payment_id, "300");
+    EXPECT_STREQ(recs[299].settlement_tx_hash, "0x12c");
+    EXPECT_STREQ(recs[299].packet_c_hex, "012c");
+}
+
+TEST(EgressJSON, EveryTruncationRejected) {
+    const char body[] =
+        "[{\"payment_id\":\"1\",\"settlement_tx_hash\":\"0xa\",\"packet_c_hex\":\"aa\"},"
+        " {\"payment_id\":\"2\",\"meta\":{\"k\":[1,2]},\"settlement_tx_hash\":\"0xb\","
+        "\"packet_c_hex\":\"bb\"}]";
+    egress::Record recs[4];
+    ASSERT_EQ(egress::parse_pending_response(body, lit_len(body), recs, 4), 2);
+    for (size_t n = 1; n < lit_len(body); ++n) {
+        EXPECT_LT(egress::parse_pending_response(body, n, recs, 4), 0) << "len " << n;
+    }
+}
+
+namespace {
+
+// PendingStreamParser sink that keeps the last few records as strings.
+struct Seen {
+    std::string payment_id[4];
+    std::string tx_hash[4];
+    uint64_t    seq[4];
+    size_t      count;
+    size_t      stop_after; // decline the record that reaches this count
+};
+
+bool remember(const egress::Record& rec, void* user) {
+    Seen* s = static_cast<Seen*>(user);
+    if (s->count < 4) {
+        s->payment_id[s->count] = rec.payment_id;
+        s->tx_hash[s->count]    = rec.settlement_tx_hash;
+        s->seq[s->count]        = rec.seq;
+    }
+    return ++s->count != s->stop_after;
+}
+
+} // namespace
+
+TEST(EgressJSON, StreamSplitAtAnyOffsetMatchesOneShot) {
+    // Strings, escapes, nested values and the seq digits all straddle
+    // some feed boundary across the sweep.
+    const char body[] =
+        "[{\"seq\": 18446744073709551615 ,\"memo\":\"}],\\\"x\\\\\","
+        "\"payment_id\":\"a\\\"b\",\"meta\":{\"k\":[1,{\"q\":\"]\"}]},"
+        "\"settlement_tx_hash\":\"0x\\\\\",\"packet_c_hex\":\"cc\"},\n"
+        " {\"payment_id\":\"2\",\"settlement_tx_hash\":\"0xb\",\"packet_c_hex\":\"bb\","
+        "\"seq\":7}]";
+    const size_t len = lit_len(body);
+    for (size_t cut = 0; cut <= len; ++cut) {
+        Seen seen = {};
+        egress::PendingStreamParser parser(&remember, &seen);
+        parser.feed(body, cut);
+        ASSERT_EQ(parser.feed(body + cut, len - cut),
+                  egress::PendingStreamParser::Status::kDone) << "cut " << cut;
+        ASSERT_EQ(parser.records(), 2u);
+        EXPECT_EQ(seen.seq[0], UINT64_MAX);
+        EXPECT_EQ(seen.payment_id[0], "a\"b");
+        EXPECT_EQ(seen.tx_hash[0], "0x\\");
+        EXPECT_EQ(seen.payment_id[1], "2");
+        EXPECT_EQ(seen.seq[1], 7u);
+    }
+
+    Seen seen = {};
+    egress::PendingStreamParser bytewise(&remember, &seen);
+    for (size_t i = 0; i < len; ++i) bytewise.feed(body + i, 1);
+    EXPECT_EQ(bytewise.status(), egress::PendingStreamParser::Status::kDone);
+    EXPECT_EQ(seen.payment_id[0], "a\"b");
+    EXPECT_EQ(seen.tx_hash[1], "0xb");
+}
+
+TEST(EgressJSON, StreamHandsOverEachRecordAsItCloses) {
+    const char first[] =
+        "[{\"payment_id\":\"1\",\"settlement_tx_hash\":\"0xa\",\"packet_c_hex\":\"aa\"}";
+    const char rest[] =
+        ",{\"payment_id\":\"2\",\"settlement_tx_hash\":\"0xb\",\"packet_c_hex\":\"bb\"}]";
+    Seen seen = {};
+    egress::PendingStreamParser parser(&remember, &seen);
+    EXPECT_EQ(parser.feed(first, lit_len(first)), egress::PendingStreamParser::Status::kMore);
+    EXPECT_EQ(seen.count, 1u); // before the rest of the body exists
+    EXPECT_EQ(parser.feed(rest, lit_len(rest)), egress::PendingStreamParser::Status::kDone);
+    EXPECT_EQ(seen.count, 2u);
+}
+
+TEST(EgressJSON, StreamStopsWhenSinkDeclinesAndErrorsAreSticky) {
+    const char body[] =
+        "[{\"payment_id\":\"1\",\"settlement_tx_hash\":\"0xa\",\"packet_c_hex\":\"aa\"},"
+        "{\"payment_id\":\"2\",\"settlement_tx_hash\":\"0xb\",\"packet_c_hex\":\"bb\"}]";
+    Seen seen = {};
+    seen.stop_after = 1;
+    egress::PendingStreamParser stopped(&remember, &seen);
+    EXPECT_EQ(stopped.feed(body, lit_len(body)), egress::PendingStreamParser::Status::kStopped);
+    EXPECT_EQ(seen.count, 1u);
+
+    Seen bad_seen = {};
+    egress::PendingStreamParser bad(&remember, &bad_seen);
+    EXPECT_EQ(bad.feed("[{\"payment_id\":1,", 17), egress::PendingStreamParser::Status::kError);
+    EXPECT_EQ(bad.feed(body + 1, lit_len(body) - 1), egress::PendingStreamParser::Status::kError);
+    EXPECT_EQ(bad_seen.count, 0u);
+}
@@ -10,8 +10,10 @@
  * -------------------------------------------------------------------------*/
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -29,6 +31,16 @@ struct MockHttpClient {
     std::string pending_body;
     int         pending_status = 200;
     bool        pending_returns = true; // false simulates transport failure
+    // When non-empty, each fetch_pending serves (and drops) the front
+    // page instead of `pending_body`; an exhausted queue serves "[]".
+    std::deque<std::string> pending_pages;
+    bool                    paged = false;
+    int                     fetch_calls = 0;
+
+    // Canned /watch responses, served front first ("[]" once drained).
+    std::deque<std::string> watch_pages;
+    int                     watch_status = 200;
+    std::vector<uint64_t>   watch_after; // cursor sent on each call
 
     // Canned /ack response status.
     int         ack_status = 200;
@@ -40,23 +52,79 @@ struct MockHttpClient {
     };
     std::vector<AckCall> acks_received;
 
-    bool fetch_pending(uint8_t* body, size_t cap, size_t& len,
-                       int& status_code) {
+    // Canned /ack/batch behaviour. `batch_status` is the route-level
+    // status (404 = old gateway); per-record results come from
+    // `batch_results` when set, else every record gets `ack_status`.
+    int              batch_status = 200;
+    std::vector<int> batch_results;
+    int              batch_calls  = 0;
+    std::vector<size_t> batch_sizes;  // items per batch call
+    std::vector<size_t> batch_served; // body bytes served when it was made
+    int              single_calls = 0;
+
+    // Bodies reach the sink `slice` bytes at a time, the way a slow
+    // socket hands them over; `served` counts the bytes so far.
+    size_t slice  = 7;
+    size_t served = 0;
+
+    bool serve(const std::string& page, http_pool::BodySink sink, void* user) {
+        for (size_t off = 0; off < page.size(); off += slice) {
+            const size_t n = std::min(slice, page.size() - off);
+            served += n;
+            if (!sink(reinterpret_cast<const uint8_t*>(page.data()) + off, n, user)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool fetch_pending(http_pool::BodySink sink, void* user, int& status_code) {
+        ++fetch_calls;
         if (!pending_returns) return false;
         status_code = pending_status;
-        if (pending_body.size() > cap) return false;
-        std::memcpy(body, pending_body.data(), pending_body.size());
-        len = pending_body.size();
-        return true;
+        std::string page = pending_body;
+        if (paged) {
+            page = pending_pages.empty() ? "[]" : pending_pages.front();
+            if (!pending_pages.empty()) pending_pages.pop_front();
+        }
+        return serve(page, sink, user);
+    }
+
+    bool watch_pending(uint64_t after, uint32_t /*wait_ms*/, http_pool::BodySink sink,
+                       void* user, int& status_code) {
+        watch_after.push_back(after);
+        status_code = watch_status;
+        std::string page = "[]";
+        if (!watch_pages.empty()) {
+            page = watch_pages.front();
+            watch_pages.pop_front();
+        }
+        return serve(page, sink, user);
     }
 
     bool ack_dispatched(const char* pid, const char* tx,
                         int& status_code) {
+        ++single_calls;
         acks_received.push_back({pid, tx});
         if (!ack_returns) return false;
         status_code = ack_status;
         return true;
     }
+
+    bool ack_dispatched_batch(const egress::AckItem* items, size_t n,
+                              int* results, int& status_code) {
+        ++batch_calls;
+        batch_sizes.push_back(n);
+        batch_served.push_back(served);
+        if (!ack_returns) return false;
+        status_code = batch_status;
+        if (batch_status != 200) return true;
+        for (size_t i = 0; i < n; ++i) {
+            acks_received.push_back({items[i].payment_id, items[i].settlement_tx_hash});
+            results[i] = i < batch_results.size() ? batch_results[i] : ack_status;
+        }
+        return true;
+    }
 };
 
 // ---------------------------------------------------------------------------
@@ -140,6 +208,8 @@ TEST(EgressOrchestrator, BatchOfThreeDispatchesInOrder) {
     EXPECT_EQ(client.acks_received[0].payment_id, "1");
     EXPECT_EQ(client.acks_received[1].payment_id, "2");
     EXPECT_EQ(client.acks_received[2].payment_id, "3");
+    EXPECT_EQ(client.batch_calls, 1);  // one ACK round trip for the tick
+    EXPECT_EQ(client.single_calls, 0);
 }
 
 TEST(EgressOrchestrator, TransportFailureOnFetchReturnsNegative) {
@@ -214,4 +284,204 @@ TEST(EgressOrchestrator, TxFailureMeansNoAck) {
     EXPECT_EQ(orch.tick(), 0);
     EXPECT_EQ(cap.frames.size(), 1u);
     EXPECT_EQ(client.acks_received.size(), 0u);
-}
\ No newline at end of file
+}
+
+namespace {
+
+std::string ThreeRecordBody() {
+    std::string hex(224, '0');
+    return "["
+             "{\"payment_id\":\"1\",\"settlement_tx_hash\":\"0xA\","
+              "\"packet_c_hex\":\"" + hex + "\"},"
+             "{\"payment_id\":\"2\",\"settlement_tx_hash\":\"0xB\","
+              "\"packet_c_hex\":\"" + hex + "\"},"
+             "{\"payment_id\":\"3\",\"settlement_tx_hash\":\"0xC\","
+              "\"packet_c_hex\":\"" + hex + "\"}"
+           "]";
+}
+
+}  // namespace
+
+TEST(EgressOrchestrator, BatchAckPerRecordFailuresAreDroppedLocally) {
+    MockHttpClient client;
+    client.pending_body  = ThreeRecordBody();
+    client.batch_results = {200, 404, 200}; // "2" unknown to the gateway
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    // Same contract as single ACKs: the gateway is authoritative.
+    EXPECT_EQ(orch.tick(), 3);
+    EXPECT_EQ(client.batch_calls, 1);
+    EXPECT_EQ(client.single_calls, 0);
+    EXPECT_TRUE(orch.batch_ack_enabled());
+}
+
+TEST(EgressOrchestrator, BatchAckTransportFailureCountsNothing) {
+    MockHttpClient client;
+    client.pending_body = ThreeRecordBody();
+    client.ack_returns  = false;
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.tick(), 0);
+    EXPECT_EQ(cap.frames.size(), 3u);
+    EXPECT_EQ(client.batch_calls, 1);
+    EXPECT_EQ(client.single_calls, 0); // retried next tick, not per record
+}
+
+TEST(EgressOrchestrator, MissingBatchRouteFallsBackToSingleAcks) {
+    MockHttpClient client;
+    client.pending_body = ThreeRecordBody();
+    client.batch_status = 404; // gateway without /ack/batch
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.tick(), 3);
+    EXPECT_EQ(client.batch_calls, 1);
+    EXPECT_EQ(client.single_calls, 3);
+    ASSERT_EQ(client.acks_received.size(), 3u);
+    EXPECT_EQ(client.acks_received[2].payment_id, "3");
+    EXPECT_FALSE(orch.batch_ack_enabled());
+
+    // The fallback sticks: no more batch attempts on later ticks.
+    EXPECT_EQ(orch.tick(), 3);
+    EXPECT_EQ(client.batch_calls, 1);
+    EXPECT_EQ(client.single_calls, 6);
+}
+
+namespace {
+
+// JSON array of records with consecutive ids / cursors starting at
+// `first`. `with_seq` adds the /watch cursor field.
+std::string Page(int first, int count, bool with_seq) {
+    const std::string hex(224, '0');
+    std::string out = "[";
+    for (int i = first; i < first + count; ++i) {
+        if (i != first) out += ",";
+        out += "{";
+        if (with_seq) out += "\"seq\":" + std::to_string(i) + ",";
+        out += "\"payment_id\":\"" + std::to_string(i) + "\","
+               "\"settlement_tx_hash\":\"0x" + std::to_string(i) + "\","
+               "\"packet_c_hex\":\"" + hex + "\"}";
+    }
+    return out + "]";
+}
+
+}  // namespace
+
+TEST(EgressOrchestrator, FullPagesDrainWithinOneTick) {
+    MockHttpClient client;
+    client.paged         = true;
+    client.pending_pages = {Page(1, 10, false), Page(11, 10, false), Page(21, 3, false)};
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    // 23 records behind the gateway's page cap of 10: one tick, three
+    // GETs, no interval wait between pages.
+    EXPECT_EQ(orch.tick(), 23);
+    EXPECT_EQ(client.fetch_calls, 3);
+    EXPECT_EQ(cap.frames.size(), 23u);
+}
+
+TEST(EgressOrchestrator, DrainStopsWhenAPageIsNotFullyAcked) {
+    MockHttpClient client;
+    client.paged         = true;
+    client.pending_pages = {Page(1, 10, false), Page(11, 10, false)};
+    TxCapture cap;
+    cap.next_returns = false; // nothing goes out — the same page would come back
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.tick(), 0);
+    EXPECT_EQ(client.fetch_calls, 1);
+}
+
+TEST(EgressOrchestrator, WatchAdvancesCursorPastHandledRecords) {
+    MockHttpClient client;
+    client.watch_pages = {Page(1, 3, true), Page(4, 1, true)};
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.watch(1000), 3);
+    EXPECT_EQ(orch.cursor(), 3u);
+    EXPECT_EQ(orch.watch(1000), 1);
+    EXPECT_EQ(orch.watch(1000), 0); // long-poll timed out empty
+    ASSERT_EQ(client.watch_after.size(), 3u);
+    EXPECT_EQ(client.watch_after[0], 0u);
+    EXPECT_EQ(client.watch_after[1], 3u);
+    EXPECT_EQ(client.watch_after[2], 4u);
+    EXPECT_FALSE(orch.watch_stalled());
+    EXPECT_EQ(client.acks_received.size(), 4u);
+}
+
+TEST(EgressOrchestrator, WatchRewindsCursorToFailedRecord) {
+    MockHttpClient client;
+    client.watch_pages = {Page(5, 3, true)};
+    TxCapture cap;
+    cap.next_returns = false; // LoRa TX fails for the whole page
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.watch(1000), 0);
+    EXPECT_EQ(orch.cursor(), 4u); // the gateway re-offers seq 5 onwards
+    EXPECT_TRUE(orch.watch_stalled());
+}
+
+TEST(EgressOrchestrator, WatchReportsMissingRouteAndBadCursor) {
+    MockHttpClient client;
+    client.watch_status = 404;
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+    EXPECT_EQ(orch.watch(1000), egress::EgressWatchUnsupported);
+
+    // A page without cursors is not a /watch answer.
+    client.watch_status = 200;
+    client.watch_pages  = {Page(1, 1, false)};
+    EXPECT_EQ(orch.watch(1000), -1);
+    EXPECT_EQ(cap.frames.size(), 0u);
+}
+
+TEST(EgressOrchestrator, LongPageIsDispatchedWhileItStreams) {
+    // A post-outage backlog in one response: records go out and are
+    // ACKed EgressAckBatchMax at a time before the body has finished.
+    MockHttpClient client;
+    client.paged         = true;
+    client.pending_pages = {Page(1, 40, false)};
+    const size_t body_len = client.pending_pages.front().size();
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.tick(), 40);
+    EXPECT_EQ(client.fetch_calls, 1); // 40 < 256 and != 10: no second round
+    ASSERT_EQ(client.batch_sizes.size(), 3u);
+    EXPECT_EQ(client.batch_sizes[0], egress::EgressAckBatchMax);
+    EXPECT_EQ(client.batch_sizes[1], egress::EgressAckBatchMax);
+    EXPECT_EQ(client.batch_sizes[2], 8u);
+    EXPECT_LT(client.batch_served[0], body_len / 2);
+    EXPECT_EQ(client.batch_served[2], body_len);
+    EXPECT_EQ(client.acks_received.back().payment_id, "40");
+}
+
+TEST(EgressOrchestrator, StreamPageCapEndsTheRoundAndDrainsOn) {
+    // A gateway that ignores `limit` is cut off at EgressStreamPageMax
+    // records; the rest arrives on the next GET of the same tick.
+    MockHttpClient client;
+    client.paged         = true;
+    client.pending_pages = {Page(1, 300, false), Page(257, 44, false)};
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.tick(), 300);
+    EXPECT_EQ(client.fetch_calls, 2);
+    EXPECT_EQ(client.acks_received.size(), 300u);
+}
+
+TEST(EgressOrchestrator, RecordsBeforeAMidPageErrorAreStillAcked) {
+    MockHttpClient client;
+    const std::string good = Page(1, 2, false);
+    client.pending_body = good.substr(0, good.size() - 1) + ",{\"payment_id\":1}]";
+    TxCapture cap;
+    egress::EgressOrchestrator<MockHttpClient> orch(client, capture_tx, &cap);
+
+    EXPECT_EQ(orch.tick(), 2);
+    EXPECT_EQ(cap.frames.size(), 2u);
+    EXPECT_EQ(client.acks_received.size(), 2u);
+}
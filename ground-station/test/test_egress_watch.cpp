@@ -0,0 +1,208 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_egress_watch.cpp
+ * Desc:      Long-poll egress end to end: EgressOrchestrator +
+ *            EgressPollClient against a local stand-in for the
+ *            gateway's /egress/watch + /egress/ack/batch routes.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include "egress_orchestrator.h"
+#include "egress_poll_client.h"
+#include "loopback_http_server.h"
+
+namespace {
+
+// Stand-in gateway: keeps receipts in memory with a cursor each, holds
+// GET /watch open until a pending receipt past `after` exists (or
+// wait_ms passes), and marks receipts dispatched on POST /ack/batch.
+// Runs on the shared loopback server: a thread per connection,
+// keep-alive, Content-Length framing only.
+class StandInGateway {
+public:
+    StandInGateway()
+        : srv_([this](const loopback_http::Request& req) { return route(req); }) {}
+
+    ~StandInGateway() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stopping_ = true;
+        }
+        cv_.notify_all(); // release held long-polls before the sockets go
+        srv_.stop();
+    }
+
+    uint16_t port() const { return srv_.port(); }
+
+    // Writes `n` new receipts (what the receipt processor does after a
+    // settlement) and wakes any held long-poll.
+    void publish(int n) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            for (int i = 0; i < n; ++i) {
+                receipts_.push_back({receipts_.size() + 1, false});
+            }
+        }
+        cv_.notify_all();
+    }
+
+    int    watch_requests() const { return watch_requests_.load(); }
+    size_t served() const { return served_.load(); }
+    size_t dispatched() const {
+        std::lock_guard<std::mutex> lock(mu_);
+        size_t n = 0;
+        for (const Receipt& r : receipts_) n += r.dispatched;
+        return n;
+    }
+
+private:
+    struct Receipt {
+        uint64_t seq;
+        bool     dispatched;
+    };
+
+    loopback_http::Reply route(const loopback_http::Request& req) {
+        std::string out;
+        if (req.head.compare(0, 26, "GET /api/v1/egress/watch?a") == 0) {
+            out = watch(req.head);
+        } else if (req.head.compare(0, 34, "POST /api/v1/egress/ack/batch HTTP") == 0) {
+            out = ack_batch(req.body);
+        }
+        if (out.empty()) return {loopback_http::response("404 Not Found", "{}"), false};
+        return {loopback_http::response("200 OK", out), false};
+    }
+
+    std::string watch(const std::string& head) {
+        ++watch_requests_;
+        const uint64_t after   = std::strtoull(head.c_str() + head.find("after=") + 6, nullptr, 10);
+        const long     wait_ms = std::strtol(head.c_str() + head.find("wait_ms=") + 8, nullptr, 10);
+
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait_for(lock, std::chrono::milliseconds(wait_ms),
+                     [&]() { return stopping_ || first_pending(after) < receipts_.size(); });
+        std::string out = "[";
+        size_t      n   = 0;
+        for (size_t i = first_pending(after); i < receipts_.size() && n < 10; ++i) {
+            const Receipt& r = receipts_[i];
+            if (r.dispatched) continue;
+            const std::string id = std::to_string(r.seq);
+            if (n++ != 0) out += ",";
+            out += "{\"seq\":" + id + ",\"payment_id\":\"" + id +
+                   "\",\"settlement_tx_hash\":\"0x" + id + "\",\"packet_c_hex\":\"" +
+                   std::string(224, '0') + "\"}";
+        }
+        served_ += n;
+        return out + "]";
+    }
+
+    // Index of the first undispatched receipt with seq > after.
+    size_t first_pending(uint64_t after) const {
+        for (size_t i = static_cast<size_t>(after); i < receipts_.size(); ++i) {
+            if (!receipts_[i].dispatched) return i;
+        }
+        return receipts_.size();
+    }
+
+    std::string ack_batch(const std::string& body) {
+        std::lock_guard<std::mutex> lock(mu_);
+        std::string out = "{\"results\":[";
+        size_t      pos = 0;
+        size_t      n   = 0;
+        while ((pos = body.find("\"payment_id\":\"", pos)) != std::string::npos) {
+            pos += 14;
+            const uint64_t seq = std::strtoull(body.c_str() + pos, nullptr, 10);
+            const bool     ok  = seq >= 1 && seq <= receipts_.size();
+            if (ok) receipts_[seq - 1].dispatched = true;
+            out += (n++ != 0 ? "," : "");
+            out += ok ? "200" : "404";
+        }
+        return out + "]}";
+    }
+
+    mutable std::mutex       mu_;
+    std::condition_variable  cv_;
+    std::vector<Receipt>     receipts_;
+    bool                     stopping_ = false;
+    std::atomic<int>         watch_requests_{0};
+    std::atomic<size_t>      served_{0};
+    loopback_http::Server    srv_; // last: its handlers use the members above
+};
+
+struct TxLog {
+    std::atomic<size_t>                   frames{0};
+    std::chrono::steady_clock::time_point last;
+};
+
+bool record_tx(const uint8_t*, size_t, void* user) {
+    TxLog* log = static_cast<TxLog*>(user);
+    log->last  = std::chrono::steady_clock::now();
+    ++log->frames;
+    return true;
+}
+
+using Orchestrator = egress::EgressOrchestrator<egress::EgressPollClient>;
+
+}  // namespace
+
+TEST(EgressWatch, NewReceiptArrivesWhileLongPollIsHeld) {
+    StandInGateway gw;
+    egress::EgressPollClient client("127.0.0.1", gw.port());
+    TxLog        tx;
+    Orchestrator orch(client, record_tx, &tx);
+
+    std::atomic<int> dispatched{-1};
+    std::thread      poller([&]() { dispatched = orch.watch(egress::EgressWatchMaxWaitMs); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100)); // request is parked
+    const auto written = std::chrono::steady_clock::now();
+    gw.publish(1);
+    poller.join();
+
+    EXPECT_EQ(dispatched.load(), 1);
+    ASSERT_EQ(tx.frames.load(), 1u);
+    // Far below the 1 s poll interval this replaces (and the 4 s hold).
+    EXPECT_LT(tx.last - written, std::chrono::milliseconds(500));
+    EXPECT_EQ(gw.watch_requests(), 1);
+    EXPECT_EQ(gw.dispatched(), 1u);
+    EXPECT_EQ(orch.cursor(), 1u);
+}
+
+TEST(EgressWatch, BacklogDrainsBackToBackWithoutResends) {
+    StandInGateway gw;
+    gw.publish(25);
+    egress::EgressPollClient client("127.0.0.1", gw.port());
+    TxLog        tx;
+    Orchestrator orch(client, record_tx, &tx);
+
+    int total = 0;
+    for (int i = 0; i < 3; ++i) total += orch.watch(egress::EgressWatchMaxWaitMs);
+    EXPECT_EQ(total, 25);
+    EXPECT_EQ(gw.watch_requests(), 3); // 10 + 10 + 5, none of them waited
+    EXPECT_EQ(gw.served(), 25u);       // nothing offered twice
+    EXPECT_EQ(gw.dispatched(), 25u);
+    EXPECT_EQ(orch.cursor(), 25u);
+
+    // Caught up: the next round is an empty long-poll, not a re-send.
+    gw.publish(1);
+    EXPECT_EQ(orch.watch(egress::EgressWatchMaxWaitMs), 1);
+    EXPECT_EQ(gw.served(), 26u);
+    EXPECT_EQ(client.pool_stats().connects, 1u); // one warm connection throughout
+}
+
+#endif  // !_WIN32
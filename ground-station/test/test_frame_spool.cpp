@@ -0,0 +1,280 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_frame_spool.cpp
+ * Desc:      Frame spool: ordered read-back, recovery after reopen and
+ *            after a torn append, watermark + compaction, and replay
+ *            through the delivery thread when the gateway comes back.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "frame_spool.h"
+#include "gateway_delivery.h"
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <unistd.h>
+
+namespace {
+
+// Fresh spool directory per test, removed afterwards.
+class TempDir {
+public:
+    TempDir() {
+        char tmpl[] = "/tmp/void-spool-test-XXXXXX";
+        path_ = ::mkdtemp(tmpl);
+    }
+    ~TempDir() {
+        for (const std::string& f : files()) ::unlink((path_ + "/" + f).c_str());
+        ::rmdir(path_.c_str());
+    }
+    const char* path() const { return path_.c_str(); }
+
+    std::vector<std::string> files() const {
+        std::vector<std::string> out;
+        if (DIR* d = ::opendir(path_.c_str())) {
+            while (const dirent* e = ::readdir(d)) {
+                if (e->d_name[0] != '.') out.push_back(e->d_name);
+            }
+            ::closedir(d);
+        }
+        return out;
+    }
+    size_t segments() const {
+        size_t n = 0;
+        for (const std::string& f : files()) n += (f.find(".seg") != std::string::npos);
+        return n;
+    }
+
+private:
+    std::string path_;
+};
+
+constexpr size_t kFrameLen = 192; // PacketB
+constexpr size_t kRecLen   = 216; // align8(24 + 192)
+
+void MakeFrame(uint8_t (&frame)[kFrameLen], uint32_t id) {
+    std::memset(frame, 0x1D, sizeof(frame));
+    std::memcpy(frame, &id, sizeof(id));
+}
+
+uint32_t FrameId(const uint8_t* data) {
+    uint32_t id = 0;
+    std::memcpy(&id, data, sizeof(id));
+    return id;
+}
+
+void AppendN(spool::FrameSpool& s, uint32_t first, uint32_t n) {
+    uint8_t frame[kFrameLen];
+    for (uint32_t i = first; i < first + n; ++i) {
+        MakeFrame(frame, i);
+        ASSERT_EQ(s.append(frame, sizeof(frame), i), static_cast<uint64_t>(i));
+    }
+}
+
+// Duck-typed gateway that can be "down" (transport failure) and
+// records the frame ids it accepted, in order.
+struct FlakyGateway {
+    std::atomic<bool>     down{false};
+    std::atomic<int>      attempts{0};
+    std::mutex            mu;
+    std::vector<uint32_t> accepted;
+
+    bool push_batch(const uint8_t* body, size_t len, size_t frames, int* results, int& status) {
+        attempts.fetch_add(1);
+        if (down.load()) return false;
+        std::lock_guard<std::mutex> lock(mu);
+        size_t off = 0;
+        for (size_t i = 0; i < frames && off + 2 <= len; ++i) {
+            const size_t flen = body[off] | (static_cast<size_t>(body[off + 1]) << 8);
+            accepted.push_back(FrameId(body + off + 2));
+            results[i] = 200;
+            off += 2 + flen;
+        }
+        status = 200;
+        return true;
+    }
+    bool push_to_l2(const uint8_t*, size_t) { return true; }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mu);
+        return accepted.size();
+    }
+};
+
+using Delivery = ingest::GatewayDelivery<FlakyGateway>;
+
+bool WaitFor(const std::function<bool()>& cond, int ms) {
+    for (int i = 0; i < ms / 5; ++i) {
+        if (cond()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return cond();
+}
+
+}  // namespace
+
+TEST(FrameSpool, ReadsBackInOrderAndRecoversAfterReopen) {
+    TempDir dir;
+    {
+        spool::FrameSpool s;
+        ASSERT_TRUE(s.open(dir.path()));
+        AppendN(s, 1, 100);
+        spool::Record r;
+        for (uint32_t i = 1; i <= 100; ++i) {
+            ASSERT_TRUE(s.next(r));
+            EXPECT_EQ(r.seq, i);
+            EXPECT_EQ(r.tag, i);
+            ASSERT_EQ(r.len, kFrameLen);
+            EXPECT_EQ(FrameId(r.data), i);
+        }
+        EXPECT_FALSE(s.next(r));
+        ASSERT_TRUE(s.sync());
+        EXPECT_EQ(s.stats().syncs, 1u);           // one group sync for 100 frames
+        EXPECT_EQ(s.stats().synced_records, 100u);
+    }
+    spool::FrameSpool s;
+    ASSERT_TRUE(s.open(dir.path()));
+    EXPECT_EQ(s.stats().recovered, 100u); // nothing was acked
+    spool::Record r;
+    ASSERT_TRUE(s.next(r));
+    EXPECT_EQ(r.seq, 1u);
+    EXPECT_EQ(s.unread(), 99u);
+}
+
+TEST(FrameSpool, TornAppendEndsTheLogAndIsOverwritten) {
+    TempDir dir;
+    {
+        spool::FrameSpool s;
+        ASSERT_TRUE(s.open(dir.path()));
+        AppendN(s, 1, 10);
+    }
+    // Damage the 10th record's payload as a crash mid-append would.
+    const std::string seg = std::string(dir.path()) + "/spool-0000000000000001.seg";
+    FILE* f = std::fopen(seg.c_str(), "r+b");
+    ASSERT_NE(f, nullptr);
+    std::fseek(f, static_cast<long>(spool::kSegmentHeaderLen + 9 * kRecLen + 24 + 100), SEEK_SET);
+    std::fputc(0x00, f);
+    std::fclose(f);
+
+    spool::FrameSpool s;
+    ASSERT_TRUE(s.open(dir.path()));
+    EXPECT_EQ(s.stats().recovered, 9u);
+    EXPECT_EQ(s.head(), 10u);
+    AppendN(s, 10, 1); // reuses seq 10 over the torn record
+    s.close();
+
+    ASSERT_TRUE(s.open(dir.path()));
+    EXPECT_EQ(s.stats().recovered, 10u);
+}
+
+TEST(FrameSpool, WatermarkSurvivesRestartAndCompactsDeliveredSegments) {
+    TempDir dir;
+    const uint32_t per_seg = static_cast<uint32_t>(
+        (spool::kSegmentBytes - spool::kSegmentHeaderLen) / kRecLen);
+    const uint32_t total = 2 * per_seg + 100; // three segments
+    {
+        spool::FrameSpool s;
+        ASSERT_TRUE(s.open(dir.path()));
+        AppendN(s, 1, total);
+        EXPECT_EQ(dir.segments(), 3u);
+        s.ack(per_seg + 10); // all of segment 1, part of segment 2
+        ASSERT_TRUE(s.commit());
+        EXPECT_EQ(dir.segments(), 2u);
+        EXPECT_EQ(s.stats().compacted, 1u);
+    }
+    spool::FrameSpool s;
+    ASSERT_TRUE(s.open(dir.path()));
+    EXPECT_EQ(s.acked(), per_seg + 10u);
+    EXPECT_EQ(s.stats().recovered, total - per_seg - 10u);
+    spool::Record r;
+    ASSERT_TRUE(s.next(r));
+    EXPECT_EQ(r.seq, per_seg + 11u);
+
+    s.ack(total);
+    ASSERT_TRUE(s.commit());
+    EXPECT_EQ(dir.segments(), 1u); // the tail segment is kept for appends
+}
+
+TEST(FrameSpool, DeliveryReplaysInOrderOnceGatewayReturns) {
+    TempDir dir;
+    spool::FrameSpool s;
+    ASSERT_TRUE(s.open(dir.path()));
+    FlakyGateway gw;
+    gw.down = true;
+    Delivery delivery(gw, {8, ingest::kBatchMaxBytes, 5}, nullptr, nullptr);
+    delivery.attach_spool(&s);
+    delivery.start();
+
+    uint8_t frame[kFrameLen];
+    for (uint32_t i = 1; i <= 40; ++i) {
+        MakeFrame(frame, i);
+        ASSERT_EQ(delivery.submit(frame, sizeof(frame), i), ingest::Submit::kQueued);
+    }
+    ASSERT_TRUE(WaitFor([&]() { return gw.attempts.load() > 0; }, 2000));
+    gw.down = false;
+    ASSERT_TRUE(WaitFor([&]() { return gw.count() >= 40; }, 5000));
+    delivery.stop();
+
+    // Nothing was lost and the gateway saw the frames in order.
+    ASSERT_EQ(gw.accepted.size(), 40u);
+    for (uint32_t i = 0; i < 40; ++i) EXPECT_EQ(gw.accepted[i], i + 1);
+    const ingest::DeliveryStats d = delivery.stats();
+    EXPECT_EQ(d.spooled, 40u);
+    EXPECT_GE(d.retries, 1u);
+    EXPECT_EQ(s.acked(), 40u);
+    EXPECT_LT(s.stats().syncs, 40u); // grouped, not per frame
+}
+
+TEST(FrameSpool, UndeliveredFramesAreReplayedOnNextStart) {
+    TempDir dir;
+    {
+        spool::FrameSpool s;
+        ASSERT_TRUE(s.open(dir.path()));
+        FlakyGateway down;
+        down.down = true;
+        Delivery delivery(down, {8, ingest::kBatchMaxBytes, 0}, nullptr, nullptr);
+        delivery.attach_spool(&s);
+        delivery.start();
+        uint8_t frame[kFrameLen];
+        for (uint32_t i = 1; i <= 12; ++i) {
+            MakeFrame(frame, i);
+            delivery.submit(frame, sizeof(frame), i);
+        }
+        ASSERT_TRUE(WaitFor([&]() { return down.attempts.load() > 0; }, 2000));
+        delivery.stop(); // gives up quickly; frames stay spooled
+        EXPECT_EQ(s.acked(), 0u);
+    }
+
+    spool::FrameSpool s;
+    ASSERT_TRUE(s.open(dir.path()));
+    EXPECT_EQ(s.stats().recovered, 12u);
+    FlakyGateway up;
+    Delivery delivery(up, {8, ingest::kBatchMaxBytes, 0}, nullptr, nullptr);
+    delivery.attach_spool(&s);
+    delivery.start();
+    ASSERT_TRUE(WaitFor([&]() { return up.count() >= 12; }, 2000));
+    delivery.stop();
+    ASSERT_EQ(up.accepted.size(), 12u);
+    EXPECT_EQ(up.accepted.front(), 1u);
+    EXPECT_EQ(up.accepted.back(), 12u);
+    EXPECT_EQ(s.acked(), 12u);
+}
+
+#endif  // !_WIN32
@@ -0,0 +1,213 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_gateway_delivery.cpp
+ * Desc:      SPSC ring ordering under two threads, and the delivery
+ *            thread: submit() stays fast while the gateway stalls,
+ *            full-ring drop / spill accounting, drain on stop().
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gateway_delivery.h"
+#include "ingest_batcher.h"
+#include "spsc_ring.h"
+
+namespace {
+
+// Duck-typed gateway whose round trips block until released, standing
+// in for a slow or unreachable Go gateway.
+struct StallingGateway {
+    std::atomic<bool>     stalled{false};
+    std::atomic<int>      batches{0};
+    std::mutex            mu;
+    std::vector<uint32_t> seen; // first payload word of each frame, in order
+
+    bool push_batch(const uint8_t* body, size_t len, size_t frames, int* results, int& status) {
+        while (stalled.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        batches.fetch_add(1);
+        size_t off = 0;
+        std::lock_guard<std::mutex> lock(mu);
+        for (size_t i = 0; i < frames && off + 2 <= len; ++i) {
+            const size_t flen = body[off] | (static_cast<size_t>(body[off + 1]) << 8);
+            uint32_t id = 0;
+            std::memcpy(&id, body + off + 2, sizeof(id));
+            seen.push_back(id);
+            results[i] = 200;
+            off += 2 + flen;
+        }
+        status = 200;
+        return true;
+    }
+    bool push_to_l2(const uint8_t*, size_t) { return true; }
+};
+
+using Delivery = ingest::GatewayDelivery<StallingGateway>;
+
+void MakeFrame(uint8_t (&frame)[192], uint32_t id) {
+    std::memset(frame, 0x1D, sizeof(frame));
+    std::memcpy(frame, &id, sizeof(id));
+}
+
+struct Spill {
+    int  calls = 0;
+    bool keep  = true;
+    static bool fn(const uint8_t*, size_t, uint32_t, void* user) {
+        Spill* s = static_cast<Spill*>(user);
+        ++s->calls;
+        return s->keep;
+    }
+};
+
+}  // namespace
+
+TEST(SpscRing, FillsToCapacityThenRefuses) {
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push(i));
+    EXPECT_FALSE(ring.try_push(99));
+    EXPECT_EQ(ring.size(), 4u);
+
+    int v = -1;
+    ASSERT_TRUE(ring.try_pop(v));
+    EXPECT_EQ(v, 0);
+    EXPECT_TRUE(ring.try_push(4)); // freed slot is reusable
+    for (int want = 1; want <= 4; ++want) {
+        ASSERT_TRUE(ring.try_pop(v));
+        EXPECT_EQ(v, want);
+    }
+    EXPECT_FALSE(ring.try_pop(v));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRing, TwoThreadsSeeEveryItemInOrder) {
+    constexpr uint32_t kItems = 50000;
+    SpscRing<uint32_t, 64> ring;
+    std::thread producer([&ring]() {
+        for (uint32_t i = 0; i < kItems;) {
+            if (ring.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expect = 0;
+    while (expect < kItems) {
+        uint32_t v = 0;
+        if (!ring.try_pop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(v, expect);
+        ++expect;
+    }
+    producer.join();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(GatewayDelivery, SubmitDoesNotWaitForStalledGateway) {
+    StallingGateway gw;
+    Delivery delivery(gw, {1, ingest::kBatchMaxBytes, 0}, nullptr, nullptr);
+    delivery.start();
+
+    gw.stalled = true;
+    uint8_t frame[192];
+    const auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < 32; ++i) {
+        MakeFrame(frame, i);
+        ASSERT_EQ(delivery.submit(frame, sizeof(frame), i), ingest::Submit::kQueued);
+    }
+    const auto took = std::chrono::steady_clock::now() - t0;
+    EXPECT_LT(took, std::chrono::milliseconds(50)); // the gateway is still blocked
+    EXPECT_EQ(gw.batches.load(), 0);
+
+    gw.stalled = false;
+    delivery.stop();
+    const ingest::DeliveryStats s = delivery.stats();
+    EXPECT_EQ(s.delivered, 32u);
+    EXPECT_EQ(s.dropped, 0u);
+    EXPECT_GE(s.high_water, 2u);
+    ASSERT_EQ(gw.seen.size(), 32u);
+    for (uint32_t i = 0; i < 32; ++i) EXPECT_EQ(gw.seen[i], i);
+}
+
+TEST(GatewayDelivery, FullRingDropsNewestAndCounts) {
+    StallingGateway gw;
+    Delivery delivery(gw, {1, ingest::kBatchMaxBytes, 0}, nullptr, nullptr);
+    delivery.start();
+
+    gw.stalled = true;
+    uint8_t frame[192];
+    int queued = 0, dropped = 0;
+    for (uint32_t i = 0; i < ingest::kDeliveryRingSlots + 16; ++i) {
+        MakeFrame(frame, i);
+        const ingest::Submit r = delivery.submit(frame, sizeof(frame), i);
+        if (r == ingest::Submit::kQueued) ++queued;
+        if (r == ingest::Submit::kDropped) ++dropped;
+    }
+    // The consumer may already hold one frame inside the stalled flush.
+    EXPECT_GE(queued, static_cast<int>(ingest::kDeliveryRingSlots));
+    EXPECT_LE(queued, static_cast<int>(ingest::kDeliveryRingSlots) + 1);
+    EXPECT_EQ(queued + dropped, static_cast<int>(ingest::kDeliveryRingSlots) + 16);
+
+    gw.stalled = false;
+    delivery.stop();
+    const ingest::DeliveryStats s = delivery.stats();
+    EXPECT_EQ(s.delivered, static_cast<uint64_t>(queued));
+    EXPECT_EQ(s.dropped, static_cast<uint64_t>(dropped));
+    EXPECT_EQ(s.full, static_cast<uint64_t>(dropped));
+    EXPECT_EQ(s.high_water, ingest::kDeliveryRingSlots);
+    // Drop-newest: what got through is the oldest run, in order.
+    for (size_t i = 0; i < gw.seen.size(); ++i) EXPECT_EQ(gw.seen[i], i);
+}
+
+TEST(GatewayDelivery, FullRingHandsFrameToSpillHook) {
+    StallingGateway gw;
+    Spill    spill;
+    Delivery delivery(gw, {1, ingest::kBatchMaxBytes, 0}, nullptr, nullptr, &Spill::fn, &spill);
+    // Not started: nothing drains, so the ring fills deterministically.
+    uint8_t frame[192];
+    for (uint32_t i = 0; i < ingest::kDeliveryRingSlots; ++i) {
+        MakeFrame(frame, i);
+        ASSERT_EQ(delivery.submit(frame, sizeof(frame), i), ingest::Submit::kQueued);
+    }
+    EXPECT_EQ(delivery.submit(frame, sizeof(frame), 0), ingest::Submit::kSpilled);
+    spill.keep = false;
+    EXPECT_EQ(delivery.submit(frame, sizeof(frame), 0), ingest::Submit::kDropped);
+    EXPECT_EQ(spill.calls, 2);
+
+    const ingest::DeliveryStats s = delivery.stats();
+    EXPECT_EQ(s.full, 2u);
+    EXPECT_EQ(s.spilled, 1u);
+    EXPECT_EQ(s.dropped, 1u);
+}
+
+TEST(GatewayDelivery, DeadlineFlushRunsOnDeliveryThread) {
+    StallingGateway gw;
+    Delivery delivery(gw, {ingest::kBatchMaxFrames, ingest::kBatchMaxBytes, 20}, nullptr, nullptr);
+    delivery.start();
+
+    uint8_t frame[192];
+    for (uint32_t i = 0; i < 3; ++i) {
+        MakeFrame(frame, i);
+        delivery.submit(frame, sizeof(frame), i);
+    }
+    // No one calls poll(): the delivery thread wakes for the deadline.
+    for (int i = 0; i < 200 && gw.batches.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(gw.batches.load(), 1);
+    EXPECT_EQ(gw.seen.size(), 3u);
+    delivery.stop();
+}
@@ -0,0 +1,250 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_ground_session.cpp
+ * Desc:      Ground session table: spec §5.2 transitions, timeouts,
+ *            replay/signature blacklisting with cooldown, slot
+ *            exhaustion, and hash-table churn at thousands of sessions.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "ground_session.h"
+#include "timing_wheel.h"
+
+using ground_session::Action;
+using ground_session::Event;
+using ground_session::Policy;
+using ground_session::SessionTable;
+using ground_session::State;
+
+namespace {
+
+constexpr uint32_t kSat = 0xCAFEBABEu;
+
+uint64_t g_clock = 0;
+uint64_t test_clock() { return g_clock; }
+
+Policy plaintext_policy() {
+    Policy p = ground_session::kDefaultPolicy;
+    p.require_handshake = false;
+    return p;
+}
+
+} // namespace
+
+TEST(GroundSession, HandshakeThenPacketBOpensTheSession) {
+    static SessionTable<64> t;
+    t.clear();
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketB, 0).action, Action::kReject);
+    EXPECT_EQ(t.find(kSat), nullptr);
+
+    ground_session::Result r = t.on_event(kSat, Event::kHandshakeInit, 1000);
+    EXPECT_EQ(r.to, State::kHandshakePending);
+    EXPECT_EQ(r.action, Action::kRespond);
+    EXPECT_EQ(t.on_event(kSat, Event::kHandshakeInit, 2000).action, Action::kRespondAgain);
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketD, 2500).action, Action::kReject);
+
+    r = t.on_event(kSat, Event::kPacketB, 3000);
+    EXPECT_EQ(r.from, State::kHandshakePending);
+    EXPECT_EQ(r.to, State::kActive);
+    EXPECT_EQ(r.action, Action::kOpen);
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketB, 4000).action, Action::kSettle);
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketD, 5000).action, Action::kReceipt);
+
+    const ground_session::Session* s = t.find(kSat);
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->packets, 3u);
+    EXPECT_EQ(s->opened_ms, 1000u);
+    EXPECT_EQ(t.stats().active, 1u);
+    EXPECT_EQ(t.stats().occupied, 1u);
+}
+
+TEST(GroundSession, PlaintextPolicyOpensOnTheFirstPacketB) {
+    static SessionTable<64> t(plaintext_policy());
+    t.clear();
+    const ground_session::Result r = t.on_event(kSat, Event::kPacketB, 0);
+    EXPECT_EQ(r.to, State::kActive);
+    EXPECT_EQ(r.action, Action::kOpen);
+}
+
+TEST(GroundSession, UnconfirmedHandshakeTimesOut) {
+    static SessionTable<64> t;
+    t.clear();
+    t.on_event(kSat, Event::kHandshakeInit, 0);
+    EXPECT_EQ(t.state(kSat, 29999), State::kHandshakePending);
+    EXPECT_EQ(t.state(kSat, 30000), State::kVacant);
+
+    // The next PacketB finds no session.
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketB, 30000).action, Action::kReject);
+    EXPECT_EQ(t.find(kSat), nullptr);
+    EXPECT_EQ(t.stats().occupied, 0u);
+}
+
+TEST(GroundSession, IdleSessionClosesAcceptsLateReceiptsThenWipes) {
+    static SessionTable<64> t(plaintext_policy());
+    t.clear();
+    const uint32_t ttl = t.policy().session_ttl_ms;
+    t.on_event(kSat, Event::kPacketB, 0);
+    t.on_event(kSat, Event::kPacketB, ttl - 1); // traffic keeps it open
+    EXPECT_EQ(t.state(kSat, 2 * ttl - 2), State::kActive);
+    EXPECT_EQ(t.state(kSat, 2 * ttl - 1), State::kClosing);
+
+    const uint64_t closing = 2 * ttl - 1;
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketD, closing).action, Action::kReceipt);
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketB, closing + 1).action, Action::kReject);
+    EXPECT_EQ(t.stats().closing, 1u);
+
+    const ground_session::Result r = t.on_event(kSat, Event::kAckQueueEmpty, closing + 2);
+    EXPECT_EQ(r.to, State::kVacant);
+    EXPECT_EQ(r.action, Action::kWipe);
+    EXPECT_EQ(t.find(kSat), nullptr);
+
+    // A long-silent session runs through CLOSING to VACANT on its own.
+    t.on_event(kSat, Event::kPacketB, 0);
+    EXPECT_EQ(t.state(kSat, ttl + t.policy().closing_ms), State::kVacant);
+    EXPECT_EQ(t.expire(ttl + t.policy().closing_ms, 64), 1u);
+    EXPECT_EQ(t.stats().occupied, 0u);
+}
+
+TEST(GroundSession, RepeatedReplaysBlacklistUntilCooldown) {
+    static SessionTable<64> t(plaintext_policy());
+    t.clear();
+    const Policy& p = t.policy();
+    t.on_event(kSat, Event::kPacketB, 0);
+    for (uint8_t i = 1; i < p.replay_limit; ++i) {
+        EXPECT_EQ(t.on_event(kSat, Event::kPacketBReplay, i).action, Action::kCountReplay);
+    }
+    const ground_session::Result r = t.on_event(kSat, Event::kPacketBReplay, 100);
+    EXPECT_EQ(r.to, State::kBlacklisted);
+    EXPECT_EQ(r.action, Action::kBlacklist);
+
+    EXPECT_EQ(t.on_event(kSat, Event::kPacketB, 200).action, Action::kDrop);
+    EXPECT_FALSE(t.admit(kSat, 300));
+    EXPECT_TRUE(t.admit(kSat + 1, 300));
+    EXPECT_EQ(t.stats().dropped, 2u);
+    EXPECT_EQ(t.stats().blacklisted, 1u);
+    EXPECT_EQ(t.stats().blacklistings, 1u);
+
+    EXPECT_FALSE(t.admit(kSat, 100 + p.cooldown_ms - 1));
+    EXPECT_TRUE(t.admit(kSat, 100 + p.cooldown_ms));
+    EXPECT_EQ(t.find(kSat), nullptr);
+    // Cooled down: the replay count starts again from zero.
+    t.on_event(kSat, Event::kPacketB, 100 + p.cooldown_ms);
+    EXPECT_EQ(t.find(kSat)->replays, 0u);
+}
+
+TEST(GroundSession, SignatureFailureBlacklistsAnOpenSession) {
+    static SessionTable<64> t(plaintext_policy());
+    t.clear();
+    // No session yet: a bad signature is rejected but claims no slot.
+    EXPECT_EQ(t.on_event(kSat, Event::kSigFail, 0).action, Action::kReject);
+    EXPECT_EQ(t.find(kSat), nullptr);
+
+    t.on_event(kSat, Event::kPacketB, 0);
+    EXPECT_EQ(t.on_event(kSat, Event::kSigFail, 1).action, Action::kBlacklist);
+    EXPECT_EQ(t.state(kSat, 2), State::kBlacklisted);
+}
+
+TEST(GroundSession, NewSessionsAreRefusedWhenTheTableIsFull) {
+    static SessionTable<16> t(plaintext_policy());
+    t.clear();
+    const size_t max = SessionTable<16>::kMaxSessions;
+    for (uint32_t sat = 0; sat < max; ++sat) {
+        ASSERT_EQ(t.on_event(sat, Event::kPacketB, 0).action, Action::kOpen);
+    }
+    EXPECT_EQ(t.on_event(1000, Event::kPacketB, 0).action, Action::kExhausted);
+    EXPECT_EQ(t.stats().exhausted, 1u);
+    EXPECT_EQ(t.stats().peak, max);
+    // Existing sessions are unaffected.
+    EXPECT_EQ(t.on_event(3, Event::kPacketB, 1).action, Action::kSettle);
+}
+
+// Thousands of sessions opening and timing out at random times, with
+// incremental expire() sweeps in between: every sat must stay findable
+// exactly while its session is alive, whatever the backward-shift
+// deletions did to the probe chains around it.
+TEST(GroundSession, ThousandsOfSessionsChurnThroughTheTable) {
+    Policy p = plaintext_policy();
+    p.session_ttl_ms = 1000;
+    p.closing_ms     = 500;
+    static SessionTable<4096> t(p);
+    const size_t max = SessionTable<4096>::kMaxSessions;
+    t.clear();
+
+    std::mt19937 rng(19);
+    const size_t kSats = 3000;
+    std::vector<uint32_t> ids(kSats);
+    std::vector<uint64_t> ends(kSats, 0);
+    for (size_t i = 0; i < kSats; ++i) ids[i] = (rng() << 12) | static_cast<uint32_t>(i);
+
+    for (uint64_t now = 0; now < 20000; now += 50) {
+        for (int k = 0; k < 40; ++k) {
+            const size_t i = rng() % kSats;
+            const ground_session::Result r = t.on_event(ids[i], Event::kPacketB, now);
+            ASSERT_TRUE(r.action == Action::kOpen || r.action == Action::kSettle ||
+                        r.action == Action::kReject);
+            if (r.to == State::kActive) ends[i] = now + p.session_ttl_ms + p.closing_ms;
+        }
+        t.expire(now, 512);
+        size_t alive = 0;
+        for (size_t i = 0; i < kSats; ++i) {
+            const bool expect = ends[i] > now;
+            alive += expect ? 1u : 0u;
+            ASSERT_EQ(t.state(ids[i], now) != State::kVacant, expect) << "sat " << i;
+        }
+        ASSERT_LE(t.stats().occupied, max);
+        ASSERT_GE(t.stats().occupied, alive);
+    }
+}
+
+// With a wheel attached, quiet sessions run HANDSHAKE/ACTIVE → CLOSING
+// → VACANT and the blacklist cools down on their own timers: the slots
+// empty on time without expire() ever looking at them.
+TEST(GroundSession, AttachedWheelExpiresQuietSessionsWithoutASweep) {
+    g_clock = 0;
+    static timing_wheel::TimerPool<4096> wheel(test_clock, 100);
+    static SessionTable<4096> t(plaintext_policy());
+    t.attach(nullptr);
+    t.clear();
+    wheel.clear();
+    t.attach(&wheel);
+    const Policy& p = t.policy();
+
+    for (uint32_t sat = 1; sat <= 2000; ++sat) {
+        ASSERT_EQ(t.on_event(sat, Event::kPacketB, 0).action, Action::kOpen);
+    }
+    t.on_event(7, Event::kSigFail, 0);
+    EXPECT_EQ(wheel.stats().armed, 2000u);
+
+    wheel.advance(p.cooldown_ms - 100);
+    EXPECT_EQ(t.find(7)->state, State::kBlacklisted);
+    wheel.advance(p.cooldown_ms);
+    EXPECT_EQ(t.find(7), nullptr);
+    EXPECT_EQ(t.stats().active, 1999u);
+
+    // Traffic keeps sat 1 open; its timer follows the TTL.
+    t.on_event(1, Event::kPacketB, p.session_ttl_ms - 1000);
+    wheel.advance(p.session_ttl_ms);
+    EXPECT_EQ(t.stats().closing, 1998u);
+    EXPECT_EQ(t.stats().active, 1u);
+    EXPECT_EQ(t.find(2)->state, State::kClosing);
+
+    wheel.advance(p.session_ttl_ms + p.closing_ms);
+    EXPECT_EQ(t.stats().occupied, 1u);
+    EXPECT_EQ(t.find(2), nullptr);
+    EXPECT_EQ(t.find(1)->state, State::kActive);
+
+    wheel.advance(2 * p.session_ttl_ms + p.closing_ms);
+    EXPECT_EQ(t.stats().occupied, 0u);
+    EXPECT_EQ(wheel.stats().armed, 0u);
+    t.attach(nullptr);
+}
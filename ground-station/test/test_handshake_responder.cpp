@@ -0,0 +1,314 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_handshake_responder.cpp
+ * Desc:      Ground Packet H responder: both sides derive one key, the
+ *            response is signed and routable in either tier, forged,
+ *            stale or replayed inits are refused, and the keypair pool
+ *            refills.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <sodium.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "frame_dispatch.h"
+#include "handshake_responder.h"
+#include "security_context.h"
+
+using handshake_responder::KeyPool;
+using handshake_responder::Keypair;
+using handshake_responder::Responder;
+using handshake_responder::Verdict;
+using security_context::Identity;
+using security_context::Session;
+using security_context::SessionStore;
+
+namespace {
+
+constexpr uint32_t kSat = 0xCAFEBABEu;
+constexpr uint64_t kT0  = 1790985600000ull;
+
+uint64_t g_wall = 0;
+uint64_t wall_clock() { return g_wall; }
+
+void make_identity(Identity& id, uint8_t tag) {
+    ASSERT_GE(sodium_init(), 0);
+    uint8_t seed[security_context::kSeedSize];
+    std::memset(seed, tag, sizeof(seed));
+    ASSERT_TRUE(id.init_from_seed(seed));
+}
+
+Session idle_session() {
+    Session s;
+    std::memset(&s, 0, sizeof(s));
+    return s;
+}
+
+// A CCSDS Packet H (Init) built by hand: the firmware path only emits
+// its build tier (SNLP here).
+void ccsds_init(const Identity& sat_id, const uint8_t eph_pub[32], ccsds::PacketH_t& pkt) {
+    std::memset(&pkt, 0, sizeof(pkt));
+    frame_dispatch::Codec<frame_dispatch::Tier::kCcsds>::write_header(
+        reinterpret_cast<uint8_t*>(&pkt.header), sizeof(pkt.header), 0xB2u, true, 0u,
+        sizeof(pkt));
+    pkt.session_ttl = 600;
+    pkt.timestamp   = kT0;
+    std::memcpy(pkt.eph_pub_key, eph_pub, 32);
+    sat_id.sign(reinterpret_cast<const uint8_t*>(&pkt), offsetof(ccsds::PacketH_t, signature),
+                pkt.signature);
+}
+
+// Same plaintext through the ground store and the sat's key must agree.
+bool same_key(SessionStore& store, const uint8_t sat_key[32], uint64_t now) {
+    uint8_t plain[64], via_store[64], via_sat[64];
+    for (size_t i = 0; i < sizeof(plain); ++i) plain[i] = static_cast<uint8_t>(i * 7u);
+    if (!store.crypt(kSat, kT0, plain, sizeof(plain), via_store, now)) return false;
+    security_context::chacha20_xor(sat_key, kSat, kT0, plain, sizeof(plain), via_sat);
+    return std::memcmp(via_store, via_sat, sizeof(via_sat)) == 0;
+}
+
+SessionStore g_store;
+
+} // namespace
+
+TEST(HandshakeResponder, SatAndGroundDeriveTheSameSessionKey) {
+    Identity sat_id, ground_id;
+    make_identity(sat_id, 1);
+    make_identity(ground_id, 2);
+    g_store.clear();
+    KeyPool pool;
+    pool.fill();
+    Responder responder(ground_id, g_store, pool);
+
+    // The sat side is the firmware's own begin/complete_handshake.
+    Session sat = idle_session();
+    PacketH_t init = {};
+    security_context::begin_handshake(sat, sat_id, init, 600, kT0);
+
+    uint8_t resp[handshake_responder::kMaxPacketH];
+    size_t  resp_len = 0;
+    ASSERT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&init), sizeof(init), kSat,
+                                sat_id.public_key(), 1000, resp, sizeof(resp), &resp_len),
+              Verdict::kResponded);
+    ASSERT_EQ(resp_len, sizeof(PacketH_t));
+
+    // Packet H (Resp): routable, signed by the ground, TTL echoed.
+    frame_dispatch::FrameInfo info;
+    ASSERT_EQ(frame_dispatch::classify(resp, resp_len, &info), frame_dispatch::Status::kOk);
+    EXPECT_EQ(info.kind, frame_dispatch::FrameKind::kH);
+    EXPECT_EQ(info.apid, handshake_responder::kResponseApid);
+    PacketH_t out;
+    std::memcpy(&out, resp, sizeof(out));
+    const uint16_t ttl = out.session_ttl;  // packed: no reference binding
+    EXPECT_EQ(ttl, 600u);
+    EXPECT_EQ(crypto_sign_verify_detached(out.signature, resp, offsetof(PacketH_t, signature),
+                                          ground_id.public_key()),
+              0);
+
+    ASSERT_TRUE(security_context::complete_handshake(sat, out.eph_pub_key));
+    EXPECT_TRUE(same_key(g_store, sat.key, 1000));
+    EXPECT_EQ(pool.stats().taken, 1u);
+    EXPECT_EQ(pool.stats().misses, 0u);
+
+    // TTL counts from the store clock passed to respond().
+    EXPECT_TRUE(g_store.active(kSat, 1000 + 600000));
+    EXPECT_FALSE(g_store.active(kSat, 1000 + 600001));
+}
+
+TEST(HandshakeResponder, AnswersCcsdsInitsInTheirOwnTier) {
+    Identity sat_id, ground_id;
+    make_identity(sat_id, 3);
+    make_identity(ground_id, 4);
+    g_store.clear();
+    KeyPool pool;
+    Responder responder(ground_id, g_store, pool);
+
+    uint8_t eph_pub[32], eph_priv[32];
+    crypto_box_keypair(eph_pub, eph_priv);
+    ccsds::PacketH_t init;
+    ccsds_init(sat_id, eph_pub, init);
+
+    uint8_t resp[handshake_responder::kMaxPacketH];
+    size_t  resp_len = 0;
+    ASSERT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&init), sizeof(init), kSat,
+                                sat_id.public_key(), 0, resp, sizeof(resp), &resp_len),
+              Verdict::kResponded);
+    ASSERT_EQ(resp_len, sizeof(ccsds::PacketH_t));
+    EXPECT_EQ(frame_dispatch::detect_tier(resp, resp_len), frame_dispatch::Tier::kCcsds);
+    EXPECT_EQ(pool.stats().misses, 1u);  // never filled: keygen inline
+
+    ccsds::PacketH_t out;
+    std::memcpy(&out, resp, sizeof(out));
+    Session sat = idle_session();
+    std::memcpy(sat.eph_priv, eph_priv, sizeof(eph_priv));
+    ASSERT_TRUE(security_context::complete_handshake(sat, out.eph_pub_key));
+    EXPECT_TRUE(same_key(g_store, sat.key, 0));
+}
+
+TEST(HandshakeResponder, RefusesForgedStaleAndMalformedInits) {
+    Identity sat_id, ground_id, impostor;
+    make_identity(sat_id, 5);
+    make_identity(ground_id, 6);
+    make_identity(impostor, 7);
+    g_store.clear();
+    KeyPool pool;
+    pool.fill();
+    Responder responder(ground_id, g_store, pool);
+
+    Session sat = idle_session();
+    PacketH_t init = {};
+    security_context::begin_handshake(sat, impostor, init, 600, kT0);
+    const uint8_t* raw = reinterpret_cast<const uint8_t*>(&init);
+    uint8_t resp[handshake_responder::kMaxPacketH];
+    size_t  resp_len = 0;
+
+    EXPECT_EQ(responder.respond(raw, sizeof(init), kSat, sat_id.public_key(), 0, resp,
+                                sizeof(resp), &resp_len),
+              Verdict::kBadSignature);
+
+    security_context::begin_handshake(sat, sat_id, init, 600, kT0);
+    EXPECT_EQ(responder.respond(raw, sizeof(init) - 1, kSat, sat_id.public_key(), 0, resp,
+                                sizeof(resp), &resp_len),
+              Verdict::kBadSize);
+    EXPECT_EQ(responder.respond(raw, sizeof(init), kSat, sat_id.public_key(), 0, resp, 16,
+                                &resp_len),
+              Verdict::kBadSize);
+
+    // Liveness, once a wall clock is set.
+    responder.set_clock(&wall_clock);
+    g_wall = kT0 + handshake_responder::kLivenessMs + 1;
+    EXPECT_EQ(responder.respond(raw, sizeof(init), kSat, sat_id.public_key(), 0, resp,
+                                sizeof(resp), &resp_len),
+              Verdict::kStale);
+    g_wall = kT0 - handshake_responder::kLivenessMs;
+    EXPECT_EQ(responder.respond(raw, sizeof(init), kSat, sat_id.public_key(), 0, resp,
+                                sizeof(resp), &resp_len),
+              Verdict::kResponded);
+
+    // Nothing was installed for the refused inits, and no pool key spent.
+    EXPECT_EQ(g_store.size(), 1u);
+    EXPECT_EQ(pool.stats().taken, 1u);
+    EXPECT_EQ(responder.stats().rejected, 4u);
+    EXPECT_STREQ(handshake_responder::verdict_name(Verdict::kStale), "stale");
+
+    Identity none;
+    Responder unready(none, g_store, pool);
+    EXPECT_EQ(unready.respond(raw, sizeof(init), kSat, sat_id.public_key(), 0, resp,
+                              sizeof(resp), &resp_len),
+              Verdict::kNoIdentity);
+}
+
+// No wall clock (flat-sat millis() stamps): a recorded Init replayed
+// while its session is live must not swap the key out from under the
+// sat. A newer Init may, and once the session has expired nothing live
+// is left to protect.
+TEST(HandshakeResponder, ReplayedInitNeverReplacesALiveSession) {
+    Identity sat_id, ground_id;
+    make_identity(sat_id, 8);
+    make_identity(ground_id, 9);
+    g_store.clear();
+    KeyPool pool;
+    pool.fill();
+    Responder responder(ground_id, g_store, pool);
+
+    Session sat = idle_session();
+    PacketH_t init = {};
+    security_context::begin_handshake(sat, sat_id, init, 600, kT0);
+    const PacketH_t recorded = init;  // what an eavesdropper keeps
+    uint8_t resp[handshake_responder::kMaxPacketH];
+    size_t  resp_len = 0;
+    ASSERT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&init), sizeof(init), kSat,
+                                sat_id.public_key(), 1000, resp, sizeof(resp), &resp_len),
+              Verdict::kResponded);
+    PacketH_t out;
+    std::memcpy(&out, resp, sizeof(out));
+    ASSERT_TRUE(security_context::complete_handshake(sat, out.eph_pub_key));
+    ASSERT_TRUE(same_key(g_store, sat.key, 2000));
+
+    EXPECT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&recorded), sizeof(recorded),
+                                kSat, sat_id.public_key(), 2000, resp, sizeof(resp), &resp_len),
+              Verdict::kReplay);
+    EXPECT_TRUE(same_key(g_store, sat.key, 2000));
+    EXPECT_STREQ(handshake_responder::verdict_name(Verdict::kReplay), "replay");
+
+    // The sat re-keys: a newer Init replaces the session.
+    Session sat2 = idle_session();
+    PacketH_t newer = {};
+    security_context::begin_handshake(sat2, sat_id, newer, 600, kT0 + 1);
+    ASSERT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&newer), sizeof(newer), kSat,
+                                sat_id.public_key(), 3000, resp, sizeof(resp), &resp_len),
+              Verdict::kResponded);
+    std::memcpy(&out, resp, sizeof(out));
+    ASSERT_TRUE(security_context::complete_handshake(sat2, out.eph_pub_key));
+    EXPECT_TRUE(same_key(g_store, sat2.key, 3000));
+
+    // ... and the first Init is now older still.
+    EXPECT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&recorded), sizeof(recorded),
+                                kSat, sat_id.public_key(), 4000, resp, sizeof(resp), &resp_len),
+              Verdict::kReplay);
+    EXPECT_TRUE(same_key(g_store, sat2.key, 4000));
+
+    // Past the TTL the old session is gone; an old timestamp installs.
+    const uint64_t expired = 3000 + 600000 + 1;
+    EXPECT_EQ(responder.respond(reinterpret_cast<const uint8_t*>(&recorded), sizeof(recorded),
+                                kSat, sat_id.public_key(), expired, resp, sizeof(resp), &resp_len),
+              Verdict::kResponded);
+    EXPECT_EQ(g_store.size(), 1u);
+}
+
+TEST(HandshakeResponder, PoolRefillsInTheBackgroundWithFreshKeys) {
+    ASSERT_GE(sodium_init(), 0);
+    KeyPool pool;
+    pool.fill();
+    ASSERT_EQ(pool.available(), handshake_responder::kPoolSlots);
+
+    std::set<std::string> seen;
+    Keypair kp;
+    for (size_t i = 0; i < handshake_responder::kPoolSlots; ++i) {
+        pool.take(kp);
+        seen.insert(std::string(reinterpret_cast<const char*>(kp.pub), sizeof(kp.pub)));
+        // The public half matches the private half.
+        uint8_t pub[32];
+        crypto_scalarmult_base(pub, kp.priv);
+        ASSERT_EQ(std::memcmp(pub, kp.pub, sizeof(pub)), 0);
+    }
+    EXPECT_EQ(seen.size(), handshake_responder::kPoolSlots);
+    EXPECT_EQ(pool.available(), 0u);
+    EXPECT_EQ(pool.stats().misses, 0u);
+
+    // Empty and no refill thread yet: the keypair is made inline.
+    pool.take(kp);
+    EXPECT_EQ(pool.stats().misses, 1u);
+    EXPECT_EQ(pool.available(), 0u);
+
+    pool.start();
+    for (int i = 0; i < 10000 && pool.available() < handshake_responder::kPoolSlots; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(pool.available(), handshake_responder::kPoolSlots);
+
+    // Below half, take() wakes it again.
+    for (size_t i = 0; i <= handshake_responder::kPoolSlots / 2; ++i) pool.take(kp);
+    for (int i = 0; i < 10000 && pool.available() < handshake_responder::kPoolSlots; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(pool.available(), handshake_responder::kPoolSlots);
+    pool.stop();
+
+    // Every keypair the ring ever held was either handed out or is
+    // still there; how the refills were batched is up to the scheduler.
+    const handshake_responder::PoolStats st = pool.stats();
+    EXPECT_EQ(st.generated, st.taken + pool.available());
+    EXPECT_EQ(st.misses, 1u);
+}
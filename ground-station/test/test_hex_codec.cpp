@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_hex_codec.cpp
+ * Desc:      SIMD hex codec must match the scalar reference byte for
+ *            byte, and stay fail-closed on every non-hex char.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "hex_codec.h"
+
+namespace {
+
+bool is_hex(int c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+} // namespace
+
+TEST(HexCodec, BackendIsNamed) {
+    const std::string name = hex_codec::backend();
+    EXPECT_TRUE(name == "avx2" || name == "sse2" || name == "neon" || name == "scalar") << name;
+}
+
+// Lengths cross every kernel's block size (16/32 bytes) and tail; the
+// offsets make the loads unaligned.
+TEST(HexCodec, RoundTripMatchesScalarAtEveryLengthAndOffset) {
+    std::mt19937 rng(0x5EED);
+    uint8_t in[200 + 4];
+    char    hex[2 * sizeof(in)];
+    char    ref[2 * sizeof(in)];
+    uint8_t back[sizeof(in)];
+    for (size_t off = 0; off < 4; ++off) {
+        for (size_t len = 1; len <= 200; ++len) {
+            for (size_t i = 0; i < len; ++i) in[off + i] = static_cast<uint8_t>(rng());
+            ASSERT_EQ(hex_codec::encode(in + off, len, hex + off, sizeof(hex) - off), 2 * len);
+            ASSERT_EQ(hex_codec::encode_scalar(in + off, len, ref, sizeof(ref)), 2 * len);
+            ASSERT_EQ(std::memcmp(hex + off, ref, 2 * len), 0) << "len " << len;
+
+            ASSERT_TRUE(hex_codec::decode(hex + off, 2 * len, back, sizeof(back)));
+            ASSERT_EQ(std::memcmp(back, in + off, len), 0) << "len " << len;
+
+            for (size_t i = 0; i < 2 * len; ++i) {
+                hex[off + i] = static_cast<char>(std::toupper(hex[off + i]));
+            }
+            std::memset(back, 0, sizeof(back));
+            ASSERT_TRUE(hex_codec::decode(hex + off, 2 * len, back, sizeof(back)));
+            ASSERT_EQ(std::memcmp(back, in + off, len), 0) << "upper, len " << len;
+        }
+    }
+}
+
+// 96 chars = one AVX2 block + one SSE2 block + no tail; 70 leaves a
+// scalar tail after the SSE2 block. Every byte value at every position.
+TEST(HexCodec, RejectsEveryNonHexByteAtEveryPosition) {
+    for (size_t len : {size_t{96}, size_t{70}}) {
+        std::string hex(len, '0');
+        for (size_t i = 0; i < len; ++i) hex[i] = "0123456789abcdefABCDEF"[i % 22];
+        uint8_t out[48];
+        ASSERT_TRUE(hex_codec::decode(hex.data(), len, out, sizeof(out)));
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (int c = 0; c < 256; ++c) {
+                if (is_hex(c)) continue;
+                std::string bad = hex;
+                bad[pos] = static_cast<char>(c);
+                ASSERT_FALSE(hex_codec::decode(bad.data(), len, out, sizeof(out)))
+                    << "len " << len << " pos " << pos << " byte " << c;
+                ASSERT_FALSE(hex_codec::decode_scalar(bad.data(), len, out, sizeof(out)));
+            }
+        }
+    }
+}
+
+TEST(HexCodec, RejectsBadArguments) {
+    uint8_t bytes[16] = {0};
+    char    hex[32];
+    EXPECT_FALSE(hex_codec::decode("abc", 3, bytes, sizeof(bytes)));          // odd
+    EXPECT_FALSE(hex_codec::decode(hex, 32, bytes, 15));                      // cap
+    EXPECT_FALSE(hex_codec::decode(nullptr, 2, bytes, sizeof(bytes)));
+    EXPECT_EQ(hex_codec::encode(bytes, sizeof(bytes), hex, sizeof(hex) - 1), 0u);
+    EXPECT_EQ(hex_codec::encode(bytes, sizeof(bytes), nullptr, sizeof(hex)), 0u);
+    EXPECT_EQ(hex_codec::encode(bytes, 0, hex, sizeof(hex)), 0u);
+    EXPECT_TRUE(hex_codec::decode("", 0, bytes, sizeof(bytes)));
+}
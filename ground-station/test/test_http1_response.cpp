@@ -0,0 +1,212 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_http1_response.cpp
+ * Desc:      Resumable HTTP/1.1 response parser: every framing, split at
+ *            every byte, exact end-of-response, keep-alive, rejects.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "http1_response.h"
+
+namespace {
+
+using Parser = http1::ResponseParser;
+using Result = http1::ResponseParser::Result;
+
+bool append(const uint8_t* data, size_t len, void* user) {
+    static_cast<std::string*>(user)->append(reinterpret_cast<const char*>(data), len);
+    return true;
+}
+
+bool refuse(const uint8_t*, size_t, void*) { return false; }
+
+// Feeds `wire` in two pieces split at `cut`, the way a caller drives
+// the parser: after kHeaders the rest of the same read is fed again.
+// Returns the final result; `consumed` is how far into `wire` it got.
+Result drive(Parser& p, const std::string& wire, size_t cut, std::string& body,
+             size_t& consumed) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(wire.data());
+    const size_t   ends[2] = {cut, wire.size()};
+    size_t         pos     = 0;
+    Result         r       = Result::kMore;
+    for (size_t end : ends) {
+        while (pos <= end) {
+            size_t used = 0;
+            r = p.feed(data + pos, end - pos, &append, &body, &used);
+            pos += used;
+            if (r != Result::kHeaders) break;
+        }
+        if (r == Result::kDone || r == Result::kFail) break;
+    }
+    consumed = pos;
+    return r;
+}
+
+const char kChunked[] =
+    "HTTP/1.1 200 OK\r\n"
+    "transfer-encoding: Chunked\r\n"
+    "\r\n"
+    "5;name=val\r\nhello\r\n"
+    "1\r\n \r\n"
+    "0a\r\n0123456789\r\n"
+    "0\r\n"
+    "X-Trailer: yes\r\n"
+    "\r\n";
+
+} // namespace
+
+TEST(HttpResponse, ContentLengthSplitAnywhere) {
+    const std::string wire =
+        "HTTP/1.1 201 Created\r\nContent-Type: application/json\r\n"
+        "Content-Length:  12 \r\n\r\n{\"ok\":true }";
+    for (size_t cut = 0; cut <= wire.size(); ++cut) {
+        Parser      p;
+        std::string body;
+        size_t      consumed = 0;
+        ASSERT_EQ(drive(p, wire, cut, body, consumed), Result::kDone) << cut;
+        EXPECT_EQ(p.status(), 201);
+        EXPECT_EQ(body, "{\"ok\":true }");
+        EXPECT_EQ(consumed, wire.size());
+        EXPECT_TRUE(p.keep_alive());
+    }
+}
+
+TEST(HttpResponse, ChunkedDecodedSplitAnywhere) {
+    const std::string wire = kChunked;
+    for (size_t cut = 0; cut <= wire.size(); ++cut) {
+        Parser      p;
+        std::string body;
+        size_t      consumed = 0;
+        ASSERT_EQ(drive(p, wire, cut, body, consumed), Result::kDone) << cut;
+        EXPECT_EQ(body, "hello 0123456789");
+        EXPECT_EQ(consumed, wire.size());
+        EXPECT_TRUE(p.keep_alive());
+    }
+}
+
+TEST(HttpResponse, StopsExactlyAtTheEndOfTheResponse) {
+    // A pipelined second response must be left for the next parser.
+    const std::string first  = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n[]";
+    const std::string second = "HTTP/1.1 204 No Content\r\n\r\n";
+    const std::string wire   = first + second;
+    Parser      p;
+    std::string body;
+    size_t      consumed = 0;
+    ASSERT_EQ(drive(p, wire, wire.size(), body, consumed), Result::kDone);
+    EXPECT_EQ(consumed, first.size());
+
+    Parser next;
+    ASSERT_EQ(drive(next, second, second.size(), body, consumed), Result::kDone);
+    EXPECT_EQ(next.status(), 204);
+    EXPECT_EQ(body, "[]"); // no body for 204
+}
+
+TEST(HttpResponse, CloseDelimitedBodyEndsAtEof) {
+    const std::string wire = "HTTP/1.0 200 OK\nContent-Type: text/plain\n\nuntil close";
+    Parser      p;
+    std::string body;
+    size_t      consumed = 0;
+    EXPECT_EQ(drive(p, wire, 20, body, consumed), Result::kMore);
+    EXPECT_EQ(p.finish(), Result::kDone);
+    EXPECT_EQ(body, "until close");
+    EXPECT_FALSE(p.keep_alive());
+
+    // EOF anywhere in a framed response is a failure.
+    Parser framed;
+    const std::string cut = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nshort";
+    EXPECT_EQ(drive(framed, cut, cut.size(), body, consumed), Result::kMore);
+    EXPECT_EQ(framed.finish(), Result::kFail);
+}
+
+TEST(HttpResponse, InterimResponsesAreSkipped) {
+    const std::string wire =
+        "HTTP/1.1 100 Continue\r\n\r\n"
+        "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\nabc";
+    Parser      p;
+    std::string body;
+    size_t      consumed = 0;
+    ASSERT_EQ(drive(p, wire, 10, body, consumed), Result::kDone);
+    EXPECT_EQ(p.status(), 200);
+    EXPECT_EQ(body, "abc");
+}
+
+TEST(HttpResponse, ConnectionHeaderDecidesKeepAlive) {
+    struct Case {
+        const char* head;
+        bool        keep;
+    } cases[] = {
+        {"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n", true},
+        {"HTTP/1.1 200 OK\r\nConnection: Close\r\nContent-Length: 0\r\n\r\n", false},
+        {"HTTP/1.0 200 OK\r\nContent-Length: 0\r\n\r\n", false},
+        {"HTTP/1.0 200 OK\r\nConnection: keep-alive\r\nContent-Length: 0\r\n\r\n", true},
+    };
+    for (const Case& c : cases) {
+        Parser      p;
+        std::string body;
+        size_t      consumed = 0;
+        const std::string wire = c.head;
+        ASSERT_EQ(drive(p, wire, wire.size(), body, consumed), Result::kDone) << c.head;
+        EXPECT_EQ(p.keep_alive(), c.keep) << c.head;
+    }
+}
+
+TEST(HttpResponse, MalformedResponsesAreRejected) {
+    const char* bad[] = {
+        "HTTP/2 200 OK\r\n\r\n",
+        "HTTP/1.1 2x0 OK\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nno colon here\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nContent-Length: 12a\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nContent-Length: 3\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nContent-Length: 99999999999999999999999\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n2\r\nabX\r\n",
+    };
+    for (const char* wire : bad) {
+        Parser      p;
+        std::string body;
+        size_t      consumed = 0;
+        EXPECT_EQ(drive(p, wire, 0, body, consumed), Result::kFail) << wire;
+    }
+
+    // Header block over the limit, even in valid-looking lines.
+    Parser      p;
+    std::string wire = "HTTP/1.1 200 OK\r\n";
+    while (wire.size() <= Parser::kMaxHeaders) wire += "X-Pad: 0123456789abcdef\r\n";
+    std::string body;
+    size_t      consumed = 0;
+    EXPECT_EQ(drive(p, wire, wire.size(), body, consumed), Result::kFail);
+}
+
+TEST(HttpResponse, OverlongUnrelatedHeaderIsSkippedButNotAFramingOne) {
+    const std::string pad(Parser::kMaxLine + 100, 'x');
+    Parser      p;
+    std::string body;
+    size_t      consumed = 0;
+    const std::string ok =
+        "HTTP/1.1 200 OK\r\nX-Long: " + pad + "\r\nContent-Length: 1\r\n\r\nk";
+    ASSERT_EQ(drive(p, ok, ok.size(), body, consumed), Result::kDone);
+    EXPECT_EQ(body, "k");
+
+    Parser framed;
+    const std::string bad = "HTTP/1.1 200 OK\r\nTransfer-Encoding: " + pad + "\r\n\r\n";
+    EXPECT_EQ(drive(framed, bad, bad.size(), body, consumed), Result::kFail);
+}
+
+TEST(HttpResponse, SinkRefusalFailsTheResponse) {
+    const std::string wire = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n[]";
+    Parser p;
+    size_t used = 0;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(wire.data());
+    ASSERT_EQ(p.feed(data, wire.size(), &refuse, nullptr, &used), Result::kHeaders);
+    EXPECT_EQ(p.feed(data + used, wire.size() - used, &refuse, nullptr, &used), Result::kFail);
+    EXPECT_EQ(p.feed(data, wire.size(), &refuse, nullptr, &used), Result::kFail); // sticky
+}
@@ -0,0 +1,150 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_http_pool.cpp
+ * Desc:      Keep-alive connection pool: reuse across ingest / poll /
+ *            ACK, transparent reconnect after the gateway drops a
+ *            connection, chunked and unframed responses.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+
+#include "egress_poll_client.h"
+#include "gateway_client.h"
+#include "http_pool.h"
+
+#ifndef _WIN32
+#include "loopback_http_server.h"
+
+namespace {
+
+// Stand-in gateway serving many requests per connection, in one of a
+// few response framings (loopback_http_server.h does the sockets).
+class KeepAliveServer {
+public:
+    enum class Mode {
+        kContentLength,   // framed, keep-alive
+        kChunked,         // Transfer-Encoding: chunked, keep-alive
+        kUnframed,        // no length; close ends the body
+        kDropSecondOnFirstConn, // first conn: answer 1 request, read the 2nd, hang up
+    };
+
+    explicit KeepAliveServer(Mode mode)
+        : srv_([mode](const loopback_http::Request& req) { return reply(mode, req); }) {}
+
+    uint16_t    port() const     { return srv_.port(); }
+    int         accepts() const  { return srv_.accepts(); }
+    int         requests() const { return srv_.requests(); }
+    std::string last_body() const { return srv_.last_request().body; }
+
+private:
+    static loopback_http::Reply reply(Mode mode, const loopback_http::Request& req) {
+        switch (mode) {
+        case Mode::kChunked:
+            return {"HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                    "1\r\n[\r\n1;ext=1\r\n]\r\n0\r\n\r\n", false};
+        case Mode::kUnframed:
+            return {"HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n[]", true};
+        case Mode::kDropSecondOnFirstConn:
+            if (req.conn == 0 && req.seq == 1) return {"", true};
+            break;
+        case Mode::kContentLength:
+            break;
+        }
+        return {loopback_http::response("200 OK", "[]"), false};
+    }
+
+    loopback_http::Server srv_;
+};
+
+bool AppendBody(const uint8_t* data, size_t len, void* user) {
+    static_cast<std::string*>(user)->append(reinterpret_cast<const char*>(data), len);
+    return true;
+}
+
+// The poll path streams (round_trip_stream): exercises its framing and
+// de-chunking in every server mode.
+bool FetchEmpty(egress::EgressPollClient& c) {
+    std::string body;
+    int         status = 0;
+    return c.fetch_pending(&AppendBody, &body, status) && status == 200 && body == "[]";
+}
+
+}  // namespace
+
+TEST(HttpPool, SequentialPollsReuseOneConnection) {
+    KeepAliveServer srv(KeepAliveServer::Mode::kContentLength);
+    egress::EgressPollClient client("127.0.0.1", srv.port());
+    for (int i = 0; i < 5; ++i) ASSERT_TRUE(FetchEmpty(client)) << i;
+
+    const http_pool::Stats s = client.pool_stats();
+    EXPECT_EQ(s.requests, 5u);
+    EXPECT_EQ(s.connects, 1u);
+    EXPECT_EQ(s.reuses, 4u);
+    EXPECT_EQ(s.failures, 0u);
+    EXPECT_EQ(srv.accepts(), 1);
+}
+
+TEST(HttpPool, IngestPollAndAckShareConnections) {
+    KeepAliveServer srv(KeepAliveServer::Mode::kContentLength);
+    http_pool::ConnectionPool pool("127.0.0.1", srv.port());
+    GatewayClient            ingest(pool);
+    egress::EgressPollClient egress_client(pool);
+
+    // Binary frame with embedded NULs goes through byte-exact.
+    const uint8_t frame[] = {0x1D, 0x01, 0x00, 0xA5, 0x00, 0x00, 0xFF};
+    ASSERT_TRUE(ingest.push_to_l2(frame, sizeof(frame)));
+    EXPECT_EQ(srv.last_body(), std::string(reinterpret_cast<const char*>(frame), sizeof(frame)));
+
+    ASSERT_TRUE(FetchEmpty(egress_client));
+    int status = 0;
+    ASSERT_TRUE(egress_client.ack_dispatched("42", "0xbeef", status));
+    EXPECT_EQ(status, 200);
+    ASSERT_TRUE(ingest.push_to_l2(frame, sizeof(frame)));
+
+    EXPECT_EQ(srv.accepts(), 1);
+    EXPECT_EQ(srv.requests(), 4);
+    EXPECT_EQ(pool.stats().reuses, 3u);
+}
+
+TEST(HttpPool, DroppedKeepAliveIsRetriedOnFreshConnection) {
+    KeepAliveServer srv(KeepAliveServer::Mode::kDropSecondOnFirstConn);
+    egress::EgressPollClient client("127.0.0.1", srv.port());
+    ASSERT_TRUE(FetchEmpty(client));
+    ASSERT_TRUE(FetchEmpty(client)); // server hangs up mid-request; caller never notices
+    ASSERT_TRUE(FetchEmpty(client));
+
+    const http_pool::Stats s = client.pool_stats();
+    EXPECT_EQ(s.stale_retries, 1u);
+    EXPECT_EQ(s.connects, 2u);
+    EXPECT_EQ(s.failures, 0u);
+    EXPECT_EQ(srv.accepts(), 2);
+}
+
+TEST(HttpPool, ChunkedResponseIsDecodedAndKeptAlive) {
+    KeepAliveServer srv(KeepAliveServer::Mode::kChunked);
+    egress::EgressPollClient client("127.0.0.1", srv.port());
+    ASSERT_TRUE(FetchEmpty(client));
+    ASSERT_TRUE(FetchEmpty(client));
+    EXPECT_EQ(client.pool_stats().connects, 1u);
+    EXPECT_EQ(srv.accepts(), 1);
+}
+
+TEST(HttpPool, UnframedResponseReadsToCloseAndIsNotReused) {
+    KeepAliveServer srv(KeepAliveServer::Mode::kUnframed);
+    egress::EgressPollClient client("127.0.0.1", srv.port());
+    ASSERT_TRUE(FetchEmpty(client));
+    ASSERT_TRUE(FetchEmpty(client));
+    const http_pool::Stats s = client.pool_stats();
+    EXPECT_EQ(s.connects, 2u);
+    EXPECT_EQ(s.reuses, 0u);
+    EXPECT_EQ(srv.accepts(), 2);
+}
+
+#endif  // !_WIN32
@@ -0,0 +1,107 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_line_framer.cpp
+ * Desc:      Serial/stdin line framer: in-place slicing, carry across
+ *            reads, early stop for a framing switch, truncation.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "line_framer.h"
+
+namespace {
+
+struct Collected {
+    std::vector<std::string> lines;
+    std::vector<const char*> ptrs;
+};
+
+template <size_t N>
+size_t feed_all(line_framer::LineFramer<N>& f, std::string& data, Collected& out) {
+    return f.feed(reinterpret_cast<uint8_t*>(&data[0]), data.size(),
+                  [&out](char* line, size_t len) {
+                      EXPECT_EQ(std::strlen(line), len);
+                      out.lines.emplace_back(line, len);
+                      out.ptrs.push_back(line);
+                      return true;
+                  });
+}
+
+} // namespace
+
+TEST(LineFramer, FindEolMatchesScalar) {
+    std::mt19937 rng(7);
+    uint8_t buf[80];
+    for (size_t len = 0; len <= sizeof(buf); ++len) {
+        for (size_t at = 0; at <= len; ++at) {
+            for (size_t i = 0; i < len; ++i) buf[i] = static_cast<uint8_t>('0' + rng() % 40);
+            if (at < len) buf[at] = (at & 1) ? '\r' : '\n';
+            ASSERT_EQ(line_framer::find_eol(buf, len), at) << len << "/" << at;
+            ASSERT_EQ(line_framer::find_eol_scalar(buf, len), at);
+        }
+    }
+}
+
+TEST(LineFramer, CompleteLinesAreSlicedInPlace) {
+    line_framer::LineFramer<64> f;
+    std::string data = "PACKET_B:00ff\r\nH\n\npartial";
+    Collected   got;
+    EXPECT_EQ(feed_all(f, data, got), data.size());
+    ASSERT_EQ(got.lines.size(), 2u);
+    EXPECT_EQ(got.lines[0], "PACKET_B:00ff");
+    EXPECT_EQ(got.lines[1], "H");
+    EXPECT_EQ(got.ptrs[0], &data[0]);  // no copy
+    EXPECT_EQ(got.ptrs[1], &data[15]);
+
+    std::string rest = "_line\n";
+    EXPECT_EQ(feed_all(f, rest, got), rest.size());
+    ASSERT_EQ(got.lines.size(), 3u);
+    EXPECT_EQ(got.lines[2], "partial_line"); // joined through the carry buffer
+}
+
+TEST(LineFramer, StopReportsBytesConsumed) {
+    line_framer::LineFramer<64> f;
+    std::string data = "FRAMING_OK:COBS\n\x02\x11\x00";
+    std::vector<std::string> lines;
+    const size_t used = f.feed(reinterpret_cast<uint8_t*>(&data[0]), data.size(),
+                               [&lines](char* line, size_t len) {
+                                   lines.emplace_back(line, len);
+                                   return false;
+                               });
+    EXPECT_EQ(used, 16u); // the COBS bytes are left for the other decoder
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0], "FRAMING_OK:COBS");
+}
+
+TEST(LineFramer, OverlongLinesAreTruncated) {
+    line_framer::LineFramer<8> f;
+    Collected   got;
+    std::string whole = "0123456789\n";
+    feed_all(f, whole, got);
+    std::string head = "abcde";
+    std::string tail = "fghij\n";
+    feed_all(f, head, got);
+    feed_all(f, tail, got);
+    ASSERT_EQ(got.lines.size(), 2u);
+    EXPECT_EQ(got.lines[0], "0123456");
+    EXPECT_EQ(got.lines[1], "abcdefg");
+
+    std::string dropped = "stale";
+    feed_all(f, dropped, got);
+    f.reset();
+    std::string fresh = "new\n";
+    feed_all(f, fresh, got);
+    ASSERT_EQ(got.lines.size(), 3u);
+    EXPECT_EQ(got.lines[2], "new");
+}
@@ -0,0 +1,148 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_reactor.cpp
+ * Desc:      Reactor wake-up semantics over real pipes — readiness,
+ *            timers, one-shot deadlines, hang-up and idle blocking.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstddef>
+
+#include "reactor.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+
+namespace {
+
+struct ReadLog {
+    int     calls;
+    uint8_t last;
+};
+
+void OnReadable(int fd, void* user) {
+    ReadLog* log = static_cast<ReadLog*>(user);
+    uint8_t b = 0;
+    if (::read(fd, &b, 1) == 1) log->last = b;
+    ++log->calls;
+}
+
+void OnTimer(void* user) {
+    ++*static_cast<int*>(user);
+}
+
+class ReactorTest : public ::testing::Test {
+protected:
+    reactor::Reactor loop;
+    int fds[2] = {-1, -1};
+
+    void SetUp() override {
+        ASSERT_TRUE(loop.open());
+        ASSERT_EQ(::pipe(fds), 0);
+    }
+    void TearDown() override {
+        if (fds[0] >= 0) ::close(fds[0]);
+        if (fds[1] >= 0) ::close(fds[1]);
+    }
+};
+
+}  // namespace
+
+TEST_F(ReactorTest, IdleWaitTimesOutWithoutCallbacks) {
+    ReadLog log = {0, 0};
+    ASSERT_TRUE(loop.add_fd(fds[0], OnReadable, &log));
+    const uint64_t t0 = reactor::now_ms();
+    EXPECT_EQ(loop.run_once(30), 0);
+    EXPECT_GE(reactor::now_ms() - t0, 25u);
+    EXPECT_EQ(log.calls, 0);
+}
+
+TEST_F(ReactorTest, WakesWhenBytesArrive) {
+    ReadLog log = {0, 0};
+    ASSERT_TRUE(loop.add_fd(fds[0], OnReadable, &log));
+    const uint8_t b = 0xA5u;
+    ASSERT_EQ(::write(fds[1], &b, 1), 1);
+
+    const uint64_t t0 = reactor::now_ms();
+    EXPECT_EQ(loop.run_once(5000), 1);
+    EXPECT_LT(reactor::now_ms() - t0, 1000u); // woke on data, not timeout
+    EXPECT_EQ(log.calls, 1);
+    EXPECT_EQ(log.last, 0xA5u);
+}
+
+TEST_F(ReactorTest, TimerBoundsTheWait) {
+    int fired = 0;
+    ASSERT_TRUE(loop.add_timer(20, OnTimer, &fired));
+    const uint64_t t0 = reactor::now_ms();
+    while (fired == 0 && reactor::now_ms() - t0 < 2000u) {
+        loop.run_once(-1);
+    }
+    EXPECT_EQ(fired, 1);
+    EXPECT_LT(reactor::now_ms() - t0, 1000u);
+}
+
+TEST_F(ReactorTest, DeadlineFiresOnceAndOnlyWhenArmed) {
+    int fired = 0;
+    const int id = loop.add_deadline(OnTimer, &fired);
+    ASSERT_GE(id, 0);
+    EXPECT_EQ(loop.deadline(id), reactor::kNoDeadline);
+    EXPECT_FALSE(loop.add_timer(0, OnTimer, &fired));
+
+    // Disarmed: the wait runs to the caller's bound, nothing fires.
+    uint64_t t0 = reactor::now_ms();
+    EXPECT_EQ(loop.run_once(30), 0);
+    EXPECT_GE(reactor::now_ms() - t0, 25u);
+
+    // Armed: bounds a run_once(-1) and fires exactly once.
+    t0 = reactor::now_ms();
+    ASSERT_TRUE(loop.set_deadline(id, t0 + 20));
+    EXPECT_EQ(loop.run_once(-1), 1);
+    EXPECT_GE(reactor::now_ms() - t0, 15u);
+    EXPECT_LT(reactor::now_ms() - t0, 1000u);
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(loop.deadline(id), reactor::kNoDeadline);
+    EXPECT_EQ(loop.run_once(30), 0);
+    EXPECT_EQ(fired, 1);
+
+    // Moved earlier before it was due; a past time fires right away.
+    ASSERT_TRUE(loop.set_deadline(id, reactor::now_ms() + 60000));
+    ASSERT_TRUE(loop.set_deadline(id, 0));
+    t0 = reactor::now_ms();
+    EXPECT_EQ(loop.run_once(5000), 1);
+    EXPECT_LT(reactor::now_ms() - t0, 1000u);
+    EXPECT_EQ(fired, 2);
+
+    // Periodic timers are not deadlines.
+    ASSERT_TRUE(loop.add_timer(1000, OnTimer, &fired));
+    EXPECT_FALSE(loop.set_deadline(id + 1, 0));
+    EXPECT_FALSE(loop.set_deadline(-1, 0));
+}
+
+TEST_F(ReactorTest, HangUpDropsSource) {
+    ReadLog log = {0, 0};
+    ASSERT_TRUE(loop.add_fd(fds[0], OnReadable, &log));
+    ::close(fds[1]);
+    fds[1] = -1;
+
+    EXPECT_EQ(loop.run_once(1000), 1);
+    EXPECT_FALSE(loop.watching(fds[0]));
+    EXPECT_EQ(loop.run_once(0), 0);
+    EXPECT_EQ(log.calls, 1);
+}
+
+TEST_F(ReactorTest, RejectsDuplicateAndUnpollableSources) {
+    ReadLog log = {0, 0};
+    EXPECT_TRUE(loop.add_fd(fds[0], OnReadable, &log));
+    EXPECT_FALSE(loop.add_fd(fds[0], OnReadable, &log));
+    EXPECT_FALSE(loop.add_fd(-1, OnReadable, &log));
+    EXPECT_TRUE(loop.remove_fd(fds[0]));
+    EXPECT_FALSE(loop.remove_fd(fds[0]));
+}
+
+#endif  // !_WIN32
@@ -0,0 +1,196 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_replay_window.cpp
+ * Desc:      Per-sat replay window: monotonic epochs, out-of-order
+ *            arrivals inside the window, retransmit vs replay, the
+ *            retransmit cap, eviction horizon, and the open-addressing
+ *            tracker's load limit.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+
+#include "replay_window.h"
+
+using replay_window::Check;
+using replay_window::kRecent;
+using replay_window::kWindowMs;
+
+namespace {
+
+constexpr uint64_t kT0 = 1790985600000ull;
+
+// check() then, unless it is a replay, commit() — what the Bouncer does
+// for a frame whose signature verifies.
+Check admit(replay_window::Window& w, uint64_t epoch, uint32_t crc) {
+    const Check c = replay_window::check(w, epoch, crc);
+    if (c == Check::kFresh || c == Check::kRetransmit) replay_window::commit(w, epoch, crc);
+    return c;
+}
+
+} // namespace
+
+TEST(ReplayWindow, NewerEpochsAreFreshAndEachIsUsedOnce) {
+    replay_window::Window w;
+    replay_window::start(w, kT0, 1);
+    EXPECT_EQ(admit(w, kT0 + 1000, 2), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + 2000, 3), Check::kFresh);
+
+    EXPECT_EQ(admit(w, kT0 + 2000, 3), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 + 1000, 2), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 + 2000, 9), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0 + 1000, 9), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0, 9), Check::kReplay);
+}
+
+TEST(ReplayWindow, OutOfOrderInsideTheWindowIsAcceptedOnce) {
+    replay_window::Window w;
+    replay_window::start(w, kT0 + 5000, 1);
+    EXPECT_EQ(admit(w, kT0 + 3000, 2), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + 4000, 3), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + 3000, 2), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 + 4000, 7), Check::kReplay);
+
+    // Still remembered after the window slides past them.
+    EXPECT_EQ(admit(w, kT0 + 9000, 4), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + 3000, 7), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0 + 5000, 1), Check::kRetransmit);
+}
+
+// With no clock to age it out, the newest frame would otherwise be a
+// retransmit for as long as the satellite sends nothing newer.
+TEST(ReplayWindow, RetransmitsOfOneFrameAreCapped) {
+    replay_window::Window w;
+    replay_window::start(w, kT0, 1);
+    for (uint8_t i = 0; i < replay_window::kMaxRetransmits; ++i) {
+        ASSERT_EQ(admit(w, kT0, 1), Check::kRetransmit);
+    }
+    EXPECT_EQ(admit(w, kT0, 1), Check::kReplay);
+
+    // An older record keeps its own count, and keeps it as it ages.
+    EXPECT_EQ(admit(w, kT0 - 1000, 2), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 - 1000, 2), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 + 1000, 3), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0, 1), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0 - 1000, 2), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 - 1000, 2), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 - 1000, 2), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0 + 1000, 3), Check::kRetransmit);
+}
+
+TEST(ReplayWindow, FramesBehindTheWindowAreReplays) {
+    replay_window::Window w;
+    replay_window::start(w, kT0 + kWindowMs + 10, 1);
+    EXPECT_EQ(admit(w, kT0 + 10, 2), Check::kFresh); // exactly kWindowMs behind
+    EXPECT_EQ(admit(w, kT0 + 9, 3), Check::kReplay);
+    EXPECT_EQ(admit(w, 0, 4), Check::kReplay);
+
+    // A long gap drops every record; the old newest is now far behind.
+    EXPECT_EQ(admit(w, kT0 + 10 * kWindowMs, 5), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + kWindowMs + 10, 6), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0 + 10 * kWindowMs - 1, 6), Check::kFresh);
+}
+
+TEST(ReplayWindow, EvictedEpochsAreNeverAcceptedAgain) {
+    replay_window::Window w;
+    replay_window::start(w, kT0 + 50000, 100);
+    // Fill the records with out-of-order arrivals, oldest first.
+    for (uint32_t i = 0; i < kRecent; ++i) {
+        ASSERT_EQ(admit(w, kT0 + 10000 + 1000 * i, i), Check::kFresh);
+    }
+    // One more evicts kT0 + 10000; the horizon moves up to it.
+    EXPECT_EQ(admit(w, kT0 + 20000, 50), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + 10000, 0), Check::kReplay);
+    EXPECT_EQ(admit(w, kT0 + 9000, 51), Check::kReplay);
+    // Anything between the horizon and the newest is still decided exactly.
+    EXPECT_EQ(admit(w, kT0 + 11000, 1), Check::kRetransmit);
+    EXPECT_EQ(admit(w, kT0 + 11000, 9), Check::kReplay);
+
+    // An arrival older than every record is itself the one dropped.
+    EXPECT_EQ(admit(w, kT0 + 10500, 52), Check::kFresh);
+    EXPECT_EQ(admit(w, kT0 + 10500, 52), Check::kReplay);
+}
+
+// Against a reference set of every epoch ever accepted: the window may
+// refuse an unseen epoch (that is the bounded-memory price) but must
+// never accept one twice, and must accept anything newer.
+TEST(ReplayWindow, NeverAcceptsAnEpochTwiceUnderRandomArrivals) {
+    std::mt19937_64 rng(18);
+    replay_window::Window w;
+    replay_window::start(w, kT0, 0);
+    std::set<uint64_t> accepted = {kT0};
+    uint64_t newest = kT0;
+    for (int i = 0; i < 20000; ++i) {
+        const uint64_t step = rng() % 3000;
+        const uint64_t epoch = (rng() % 4 == 0) ? newest + 1 + step
+                                                : (newest > step * 40 ? newest - step * 40 : 0);
+        const Check c = admit(w, epoch, 7);
+        if (epoch > newest) {
+            ASSERT_EQ(c, Check::kFresh);
+        }
+        if (c == Check::kFresh) {
+            ASSERT_TRUE(accepted.insert(epoch).second) << "epoch accepted twice";
+        } else if (c == Check::kRetransmit) {
+            ASSERT_EQ(accepted.count(epoch), 1u);
+        }
+        if (epoch > newest) newest = epoch;
+    }
+}
+
+TEST(ReplayTracker, KeepsOneWindowPerSatAndLink) {
+    static replay_window::Tracker<1024> t;
+    t.clear();
+    EXPECT_EQ(t.check(7, 0, kT0, 1), Check::kFresh);
+    ASSERT_TRUE(t.commit(7, 0, kT0, 1));
+    EXPECT_EQ(t.check(7, 0, kT0, 2), Check::kReplay);
+    EXPECT_EQ(t.check(8, 0, kT0, 2), Check::kFresh);
+    EXPECT_EQ(t.check(7, 1, kT0, 2), Check::kFresh);
+    ASSERT_TRUE(t.commit(7, 0, kT0 + 1, 3));
+    EXPECT_EQ(t.size(), 1u);
+
+    t.clear();
+    EXPECT_EQ(t.size(), 0u);
+    EXPECT_EQ(t.check(7, 0, kT0, 2), Check::kFresh);
+}
+
+TEST(ReplayTracker, StopsAdmittingNewSatsAtItsLoadLimit) {
+    static replay_window::Tracker<64> t;
+    const size_t max_sats = replay_window::Tracker<64>::kMaxSats;
+    t.clear();
+    for (uint32_t sat = 0; sat < max_sats; ++sat) {
+        ASSERT_TRUE(t.commit(sat * 64, 0, kT0, sat));
+    }
+    EXPECT_EQ(t.size(), max_sats);
+    EXPECT_EQ(t.check(0xFFFFu, 0, kT0, 1), Check::kFull);
+    EXPECT_FALSE(t.commit(0xFFFFu, 0, kT0, 1));
+
+    // Sats already tracked carry on.
+    EXPECT_EQ(t.check(64, 0, kT0 + 1, 9), Check::kFresh);
+    EXPECT_TRUE(t.commit(64, 0, kT0 + 1, 9));
+    EXPECT_EQ(t.check(64, 0, kT0, 1), Check::kRetransmit);
+}
+
+TEST(ReplayTracker, TensOfThousandsOfSatsFitInAFewMegabytes) {
+    using Big = replay_window::Tracker<65536>;
+    EXPECT_LE(sizeof(Big), 4u * 1024 * 1024);
+    const size_t max_sats = Big::kMaxSats;
+    EXPECT_GE(max_sats, 40000u);
+
+    static Big t;
+    t.clear();
+    for (uint32_t sat = 1; sat <= 40000; ++sat) {
+        ASSERT_TRUE(t.commit(sat, 0, kT0, sat));
+    }
+    for (uint32_t sat = 1; sat <= 40000; ++sat) {
+        ASSERT_EQ(t.check(sat, 0, kT0, sat), Check::kRetransmit);
+        ASSERT_EQ(t.check(sat, 0, kT0, sat + 1), Check::kReplay);
+    }
+}
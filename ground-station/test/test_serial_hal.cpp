@@ -0,0 +1,173 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_serial_hal.cpp
+ * Desc:      SerialPort instances over pseudo-terminals — two "radios"
+ *            open at once, independent I/O, baud validation, hang-up,
+ *            whole-buffer writes against a full OS buffer.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "serial_hal.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+
+// A pty pair stands in for one Heltec board: the test drives the
+// master side, SerialPort opens the slave like /dev/ttyUSBn.
+struct FakeRadio {
+    int  master = -1;
+    char path[64] = {0};
+
+    bool open() {
+        master = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) return false;
+        const char* name = ::ptsname(master);
+        if (name == nullptr) return false;
+        std::strncpy(path, name, sizeof(path) - 1);
+        return true;
+    }
+    ~FakeRadio() {
+        if (master >= 0) ::close(master);
+    }
+};
+
+// Reads until `want` bytes arrive or a bounded number of tries passes.
+int ReadSome(SerialPort& port, uint8_t* buf, size_t want) {
+    size_t got = 0;
+    for (int tries = 0; tries < 200 && got < want; ++tries) {
+        const int n = port.read(buf + got, want - got);
+        if (n < 0) return n;
+        got += static_cast<size_t>(n);
+        if (got < want) ::usleep(1000);
+    }
+    return static_cast<int>(got);
+}
+
+}  // namespace
+
+TEST(SerialPort, TwoPortsCarryIndependentTraffic) {
+    FakeRadio r433, r868;
+    ASSERT_TRUE(r433.open());
+    ASSERT_TRUE(r868.open());
+
+    SerialPort a, b;
+    ASSERT_TRUE(a.open(r433.path, 115200));
+    ASSERT_TRUE(b.open(r868.path, 57600));
+    EXPECT_NE(a.fd(), b.fd());
+    EXPECT_EQ(a.baud(), 115200u);
+    EXPECT_EQ(b.baud(), 57600u);
+    EXPECT_STREQ(a.name(), r433.path);
+
+    ASSERT_EQ(::write(r433.master, "A\n", 2), 2);
+    ASSERT_EQ(::write(r868.master, "BB\n", 3), 3);
+
+    uint8_t buf[8] = {0};
+    ASSERT_EQ(ReadSome(a, buf, 2), 2);
+    EXPECT_EQ(std::memcmp(buf, "A\n", 2), 0);
+    ASSERT_EQ(ReadSome(b, buf, 3), 3);
+    EXPECT_EQ(std::memcmp(buf, "BB\n", 3), 0);
+
+    // Nothing pending is 0, not an error.
+    EXPECT_EQ(a.read(buf, sizeof(buf)), 0);
+
+    const uint8_t cmd[] = {'H', '\n'};
+    EXPECT_EQ(b.write(cmd, sizeof(cmd)), 2);
+    char echo[2] = {0};
+    ASSERT_EQ(::read(r868.master, echo, sizeof(echo)), 2);
+    EXPECT_EQ(std::memcmp(echo, cmd, 2), 0);
+}
+
+TEST(SerialPort, RejectsUnsupportedBaud) {
+    FakeRadio r;
+    ASSERT_TRUE(r.open());
+    SerialPort p;
+    EXPECT_FALSE(SerialPort::supports_baud(12345));
+    EXPECT_FALSE(p.open(r.path, 12345));
+    EXPECT_FALSE(p.is_open());
+    EXPECT_TRUE(p.open(r.path, 9600));
+}
+
+TEST(SerialPort, ClosedPortReportsErrors) {
+    SerialPort p;
+    uint8_t b = 0;
+    EXPECT_FALSE(p.is_open());
+    EXPECT_EQ(p.fd(), -1);
+    EXPECT_EQ(p.read(&b, 1), -1);
+    EXPECT_EQ(p.write(&b, 1), -1);
+    EXPECT_FALSE(p.open("/dev/void-no-such-radio", 115200));
+}
+
+TEST(SerialPort, HangUpIsAnErrorNotSilence) {
+    FakeRadio r;
+    ASSERT_TRUE(r.open());
+    SerialPort p;
+    ASSERT_TRUE(p.open(r.path, 115200));
+    ::close(r.master); // board unplugged
+    r.master = -1;
+    uint8_t buf[4];
+    EXPECT_EQ(p.read(buf, sizeof(buf)), -1);
+}
+
+// More than the pty buffer holds: write() alone goes short, write_all()
+// waits for the reader and delivers every byte in order.
+TEST(SerialPort, WriteAllWaitsForRoomAndDeliversEverything) {
+    FakeRadio r;
+    ASSERT_TRUE(r.open());
+    SerialPort p;
+    ASSERT_TRUE(p.open(r.path, 115200));
+
+    std::vector<uint8_t> out(256 * 1024);
+    for (size_t i = 0; i < out.size(); ++i) out[i] = static_cast<uint8_t>(i * 7u);
+    const int first = p.write(out.data(), out.size());
+    ASSERT_GE(first, 0);
+    EXPECT_LT(static_cast<size_t>(first), out.size());
+
+    std::vector<uint8_t> in;
+    std::thread board([&r, &in, &out]() {
+        uint8_t buf[4096];
+        while (in.size() < out.size()) {
+            const ssize_t n = ::read(r.master, buf, sizeof(buf));
+            if (n <= 0) break;
+            in.insert(in.end(), buf, buf + n);
+        }
+    });
+    const size_t done = static_cast<size_t>(first);
+    EXPECT_TRUE(p.write_all(out.data() + done, out.size() - done, 10000));
+    board.join();
+    ASSERT_EQ(in.size(), out.size());
+    EXPECT_EQ(in, out);
+}
+
+// Nobody reads: write_all() gives up after its timeout instead of
+// reporting success.
+TEST(SerialPort, WriteAllTimesOutWhenThePortStalls) {
+    FakeRadio r;
+    ASSERT_TRUE(r.open());
+    SerialPort p;
+    ASSERT_TRUE(p.open(r.path, 115200));
+
+    std::vector<uint8_t> out(256 * 1024, 0x55u);
+    const auto t0 = std::chrono::steady_clock::now();
+    EXPECT_FALSE(p.write_all(out.data(), out.size(), 50));
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - t0).count();
+    EXPECT_GE(ms, 40);
+    EXPECT_LT(ms, 5000);
+}
+
+#endif  // !_WIN32
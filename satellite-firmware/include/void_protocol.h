@@ -21,6 +21,7 @@
 #include "SSD1306Wire.h"
 #include "void_packets.h" // Your Packet Structs
 #include "void_config.h" // Your Packet Structs
+#include "serial_frame.h"  // COBS ground-link framing (shared with the ground station)
 
 class VoidProtocol {
 public:
@@ -32,9 +33,31 @@ public:
     void hexDump(const uint8_t* data, size_t len);
     uint32_t calculateCRC(const uint8_t* data, size_t len);
 
+    // --- Ground link (USB-serial) ---
+    // Boots in ASCII hex lines. When the ground station sends
+    // serial_frame::kOfferLine we answer kAcceptLine and switch every
+    // subsequent emitFrame()/logLine() to binary COBS frames, until
+    // serial_frame::kRevertLine puts the link back on ASCII.
+    bool binaryLink() const { return _link.binary(); }
+
+    // A VOID frame for the ground: "<tag><hex>\n" (tag e.g. "PACKET_B:")
+    // on an ASCII link, a serial_frame::Type::kFrame on a binary one.
+    void emitFrame(const char* tag, const uint8_t* data, size_t len);
+
+    // A status / log line: println() or a Type::kLine frame.
+    void logLine(const char* text);
+
+    // Non-blocking: drains Serial and returns the length of one complete
+    // ground command copied (NUL-terminated) into `out`, or 0 if none is
+    // ready yet. Handles the framing offer / revert itself.
+    size_t pollCommand(char* out, size_t cap);
+
     #ifdef DEMO
     void pollDemoTriggers();
     #endif
+
+private:
+    serial_frame::CommandLink _link; // command / offer parser, link mode
 };
 
 extern VoidProtocol Void; // Global instance
@@ -126,7 +126,8 @@ void runBuyerLoop() {
     // =====================================================================
     // 1. LoRa space-link receive (ISR-gated, sized read)
     // =====================================================================
-    if (rx_flag) {
+    const bool rx_pending = rx_flag;
+    if (rx_pending) {
         rx_flag = false;
         static uint8_t rx_buffer[VOID_MAX_PACKET_SIZE];
         const size_t len = Void.radio.getPacketLength();
@@ -152,7 +153,7 @@ void runBuyerLoop() {
                     const uint32_t wire_crc = loadLE32(rx_buffer + crc_end);
                     if (calc_crc != wire_crc) {
                         Void.updateDisplay("BUYER", "PacketA CRC fail — drop");
-                        Serial.println("WARN:PacketA CRC mismatch, dropped");
+                        Void.logLine("WARN:PacketA CRC mismatch, dropped");
                         Void.radio.startReceive();
                         return;
                     }
@@ -161,14 +162,12 @@ void runBuyerLoop() {
                     memcpy(&pending_invoice, rx_buffer, SIZE_PACKET_A);
                     invoice_pending = true;
 
-                    Serial.print("INVOICE:");
-                    Void.hexDump(rx_buffer, len);
+                    Void.emitFrame("INVOICE:", rx_buffer, len);
                 }
                 // --- RX PacketC: Receipt from Sat A (downlink passthrough) ---
                 else if (apid == SELLER_APID && len == SIZE_PACKET_C) {
                     Void.updateDisplay("BUYER", "RX Receipt! Wrapping Packet D...");
-                    Serial.print("PACKET_D:");
-                    Void.hexDump(rx_buffer, len);
+                    Void.emitFrame("PACKET_D:", rx_buffer, len);
                 }
             }
         }
@@ -178,11 +177,9 @@ void runBuyerLoop() {
     // =====================================================================
     // 2. Serial ground-link commands
     // =====================================================================
-    if (Serial.available() > 0) {
-        static char serial_buf[256];
-        const size_t bytesRead =
-            Serial.readBytesUntil('\n', serial_buf, sizeof(serial_buf) - 1);
-        serial_buf[bytesRead] = '\0';
+    static char serial_buf[256];
+    const size_t bytesRead = Void.pollCommand(serial_buf, sizeof(serial_buf));
+    if (bytesRead > 0) {
 
         // TODO: look into using (strncmp(serial_buf, "ACK_BUY", 7) == 0) for all command parsing to avoid the single-char command edge case. 
         // This would also allow us to add more commands without worrying about the "H" vs "HANDSHAKE_ACK" overlap.
@@ -196,9 +193,8 @@ void runBuyerLoop() {
             Security.prepareHandshake(
                 handshake_pkt, VOID_SESSION_TTL_DEF, millis());
 
-            Serial.print("HANDSHAKE_TX:");
-            Void.hexDump(
-                reinterpret_cast<uint8_t*>(&handshake_pkt), SIZE_PACKET_H);
+            Void.emitFrame("HANDSHAKE_TX:",
+                reinterpret_cast<const uint8_t*>(&handshake_pkt), SIZE_PACKET_H);
             Void.updateDisplay("AUTH", "Handshake Sent");
         }
         // -----------------------------------------------------------------
@@ -215,7 +211,7 @@ void runBuyerLoop() {
                          gap,
                          static_cast<unsigned>(DUTY_CYCLE_TARGET_MS),
                          (gap < DUTY_CYCLE_TARGET_MS) ? " UNDER" : " OK");
-                Serial.println(gap_line);
+                Void.logLine(gap_line);
             }
 
             Void.updateDisplay("BUYER", "Building Packet B...");
@@ -263,7 +259,7 @@ void runBuyerLoop() {
                     reinterpret_cast<const uint8_t*>(&inner),
                     sizeof(InvoicePayload_t))) {
                 Void.updateDisplay("ERROR", "encryptPacketB failed");
-                Serial.println("ERROR:encryptPacketB returned false");
+                Void.logLine("ERROR:encryptPacketB returned false");
                 invoice_pending = false;
                 return;
             }
@@ -279,8 +275,7 @@ void runBuyerLoop() {
                 reinterpret_cast<uint8_t*>(&packet_b), SIZE_PACKET_B);
             Void.radio.startReceive();
 
-            Serial.print("PACKET_B:");
-            Void.hexDump(reinterpret_cast<const uint8_t*>(&packet_b), SIZE_PACKET_B);
+            Void.emitFrame("PACKET_B:", reinterpret_cast<const uint8_t*>(&packet_b), SIZE_PACKET_B);
 
             last_tx_ms      = millis();
             invoice_pending = false;
@@ -317,10 +312,19 @@ void runBuyerLoop() {
 
             if (Security.processHandshakeResponse(mock_resp)) {
                 Void.updateDisplay("AUTH", "Session ACTIVE");
-                Serial.println("SAT_READY: Session Key Derived locally.");
+                Void.logLine("SAT_READY: Session Key Derived locally.");
             } else {
                 Void.updateDisplay("ERROR", "ECDH Math Failed");
             }
         }
     }
+
+    // =====================================================================
+    // 3. Idle slice: expire the session (zeroising unused cached keys) and
+    //    pre-generate one ephemeral keypair, so the next 'H' only signs.
+    // =====================================================================
+    if (!rx_pending && bytesRead == 0) {
+        Security.isSessionActive(millis());
+        Security.refillKeyCache();
+    }
 }
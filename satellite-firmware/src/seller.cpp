@@ -94,7 +94,7 @@ static void handlePacketCReceipt(const uint8_t* buf, size_t len) {
         | (static_cast<uint32_t>(buf[107]) << 24);
     const uint32_t calculated = Void.calculateCRC(buf, 104);
     if (advertised != calculated) {
-        Serial.println("WARN: PacketC CRC mismatch — receipt dropped.");
+        Void.logLine("WARN: PacketC CRC mismatch — receipt dropped.");
         return;
     }
 
@@ -110,7 +110,7 @@ static void handlePacketCReceipt(const uint8_t* buf, size_t len) {
 
     static uint8_t d_frame[packet_d_builder::kPacketDSize];
     if (!packet_d_builder::build(d_in, d_frame, sizeof(d_frame))) {
-        Serial.println("ERR: packet_d_builder::build failed.");
+        Void.logLine("ERR: packet_d_builder::build failed.");
         return;
     }
 
@@ -163,9 +163,8 @@ void runSellerLoop() {
 
         // 4. Transmit
         Void.radio.transmit(reinterpret_cast<uint8_t*>(&invoice), SIZE_PACKET_A);
-        Serial.println("SELLER: Broadcasted Invoice (PacketA)");
-        Serial.print("INVOICE_TX:");
-        Void.hexDump(reinterpret_cast<const uint8_t*>(&invoice), SIZE_PACKET_A);
+        Void.logLine("SELLER: Broadcasted Invoice (PacketA)");
+        Void.emitFrame("INVOICE_TX:", reinterpret_cast<const uint8_t*>(&invoice), SIZE_PACKET_A);
         Void.updateDisplay("SELLER", "Broadcasting Invoice...");
         
         lastTx = millis();
@@ -233,7 +232,7 @@ void runSellerLoop() {
                     Void.radio.transmit(reinterpret_cast<uint8_t*>(&receipt), SIZE_PACKET_C);
                     Void.radio.startReceive();
                 } else {
-                    Serial.println("WARN: Tunnel command not recognized.");
+                    Void.logLine("WARN: Tunnel command not recognized.");
                 }
             }
         }
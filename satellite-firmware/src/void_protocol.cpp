@@ -11,6 +11,8 @@
 #include "void_protocol.h"
 #include "void_config.h"
 #include "security_manager.h"
+#include "crc32_ieee.h"
+#include <cstring>
 
 VoidProtocol Void;
 
@@ -110,21 +112,73 @@ void VoidProtocol::hexDump(const uint8_t *data, size_t len)
     Serial.println();
 }
 
+void VoidProtocol::emitFrame(const char *tag, const uint8_t *data, size_t len)
+{
+    if (binaryLink())
+    {
+        static uint8_t wire[serial_frame::kMaxEncoded];
+        const size_t n = serial_frame::encode(serial_frame::Type::kFrame, data, len, wire, sizeof(wire));
+        if (n > 0)
+            Serial.write(wire, n);
+        return;
+    }
+    Serial.print(tag);
+    hexDump(data, len);
+}
+
+void VoidProtocol::logLine(const char *text)
+{
+    if (binaryLink())
+    {
+        static uint8_t wire[serial_frame::kMaxEncoded];
+        const size_t n = serial_frame::encode(serial_frame::Type::kLine,
+                                              reinterpret_cast<const uint8_t *>(text),
+                                              strnlen(text, serial_frame::kMaxPayload),
+                                              wire, sizeof(wire));
+        if (n > 0)
+            Serial.write(wire, n);
+        return;
+    }
+    Serial.println(text);
+}
+
+size_t VoidProtocol::pollCommand(char *out, size_t cap)
+{
+    if (out == nullptr || cap == 0)
+        return 0;
+    while (Serial.available() > 0)
+    {
+        switch (_link.push(static_cast<uint8_t>(Serial.read())))
+        {
+        case serial_frame::CommandLink::Event::kOffer:
+            // Leading newline ends whatever COBS bytes a restarted ground
+            // station's line reader has buffered. Last ASCII line.
+            Serial.println();
+            Serial.println(serial_frame::kAcceptLine);
+            break;
+        case serial_frame::CommandLink::Event::kCommand:
+        {
+            const size_t n = (_link.command_len() < cap - 1) ? _link.command_len() : cap - 1;
+            memcpy(out, _link.command(), n);
+            out[n] = '\0';
+            return n;
+        }
+        case serial_frame::CommandLink::Event::kRevert:
+        case serial_frame::CommandLink::Event::kNone:
+            break;
+        }
+    }
+    return 0;
+}
+
 // IEEE 802.3 CRC32 (reflected, polynomial 0xEDB88320, init/final 0xFFFFFFFF).
 // Byte-identical to Go's hash/crc32.ChecksumIEEE — required so firmware
 // PacketB.global_crc matches the gateway-side parser and the checked-in
-// golden vectors under test/vectors/.
+// golden vectors under test/vectors/. Delegates to the shared void-core
+// engine, which stays table-free (bit-serial) on the ESP32.
 uint32_t VoidProtocol::calculateCRC(const uint8_t *data, size_t len)
 {
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < len; ++i) {
-        crc ^= data[i];
-        for (int b = 0; b < 8; ++b) {
-            const uint32_t mask = (crc & 1u) ? 0xEDB88320u : 0u;
-            crc = (crc >> 1) ^ mask;
-        }
-    }
-    return ~crc;
+    return crc32_ieee::compute(data, len);
 }
 
 #ifdef DEMO
@@ -139,9 +193,7 @@ void VoidProtocol::pollDemoTriggers() {
             static PacketH_t handshake_pkt;
             Security.prepareHandshake(handshake_pkt, VOID_SESSION_TTL_DEF, millis());
             
-            Serial.print("HANDSHAKE_TX:");
-            // hexDump((uint8_t*)&handshake_pkt, SIZE_PACKET_H);
-            hexDump(reinterpret_cast<uint8_t*>(&handshake_pkt), SIZE_PACKET_H);
+            emitFrame("HANDSHAKE_TX:", reinterpret_cast<const uint8_t*>(&handshake_pkt), SIZE_PACKET_H);
             updateDisplay("AUTH", "Handshake Sent");
         }
     }
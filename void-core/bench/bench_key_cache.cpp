@@ -0,0 +1,81 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      bench_key_cache.cpp
+ * Desc:      Micro-benchmark: SecurityManager::prepareHandshake with the
+ *            ephemeral keypair cache cold (inline keygen) and warm
+ *            (sign only), and the refill cost an idle slice pays.
+ *            Built with -DVOID_CORE_BENCH=ON.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * "cold" is the pre-cache handshake: keygen + sign on the caller. "warm"
+ * refills before each call, outside the timed region, so the figure is
+ * what runBuyerLoop now blocks for when the ground sends 'H'. Host
+ * ratios carry over to the ESP32; absolute numbers do not.
+ * -------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "key_cache.h"
+#include "security_manager.h"
+
+namespace {
+
+volatile uint64_t g_sink = 0;
+
+using BenchClock = std::chrono::steady_clock;
+
+double ns_since(BenchClock::time_point t0) {
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - t0).count());
+}
+
+SecurityManager g_sm;
+
+} // namespace
+
+int main() {
+    if (!g_sm.begin()) {
+        std::printf("sodium_init failed\n");
+        return 1;
+    }
+    const size_t kIters = 2000;
+    PacketH_t pkt;
+
+    // Cold: the cache stays empty, every call generates inline.
+    g_sm.wipeSession();
+    double cold_ns = 0.0;
+    for (size_t i = 0; i < kIters; ++i) {
+        const BenchClock::time_point t0 = BenchClock::now();
+        g_sm.prepareHandshake(pkt, 600, i);
+        cold_ns += ns_since(t0);
+        g_sink = g_sink + pkt.signature[0];
+    }
+
+    // Warm: one refill per call, timed separately.
+    double warm_ns = 0.0, refill_ns = 0.0;
+    for (size_t i = 0; i < kIters; ++i) {
+        BenchClock::time_point t0 = BenchClock::now();
+        g_sm.refillKeyCache();
+        refill_ns += ns_since(t0);
+        t0 = BenchClock::now();
+        g_sm.prepareHandshake(pkt, 600, i);
+        warm_ns += ns_since(t0);
+        g_sink = g_sink + pkt.signature[0];
+    }
+
+    const key_cache::Stats st = g_sm.keyCache().stats();
+    const double n = static_cast<double>(kIters);
+    std::printf("prepareHandshake cold   %9.1f us  (keygen + sign)\n", cold_ns / n / 1e3);
+    std::printf("prepareHandshake warm   %9.1f us  (sign only, %.2fx)\n", warm_ns / n / 1e3,
+                cold_ns / warm_ns);
+    std::printf("refillKeyCache (1 slot) %9.1f us  (idle-slice cost)\n", refill_ns / n / 1e3);
+    std::printf("cache: generated %u taken %u misses %u\n", st.generated, st.taken, st.misses);
+    return 0;
+}
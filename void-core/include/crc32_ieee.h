@@ -0,0 +1,65 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      crc32_ieee.h
+ * Desc:      Shared IEEE 802.3 CRC-32 engine (runtime-dispatched).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Single source of truth for every frame CRC in the tree: PacketA/B/C/D,
+ * PacketAck, Heartbeat. Byte-identical to Go's hash/crc32.ChecksumIEEE
+ * (reflected poly 0xEDB88320, init/final 0xFFFFFFFF) so firmware,
+ * bouncer, gateway and the golden vectors under test/vectors/ agree.
+ *
+ * Engines, picked once on first use:
+ *   kPclmul    — x86-64 PCLMULQDQ 4×128-bit folding (≥ 64 B inputs)
+ *   kArmv8     — AArch64 CRC32 instructions (__crc32d / __crc32b)
+ *   kSlice8    — table-driven slicing-by-8 (8 KiB const tables, flash)
+ *   kBitSerial — table-free, 8 shifts per byte (ESP32 default: no
+ *                8 KiB table in IRAM/flash for a ~200 B frame)
+ * The hardware engines hand their sub-block tail to kSlice8, so every
+ * engine returns the same value for every input.
+ * -------------------------------------------------------------------------*/
+
+#ifndef VOID_CRC32_IEEE_H
+#define VOID_CRC32_IEEE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace crc32_ieee {
+
+enum class Engine : uint8_t {
+    kBitSerial = 0,
+    kSlice8    = 1,
+    kPclmul    = 2,
+    kArmv8     = 3,
+};
+
+// One-shot CRC over `data[0..len)`. Same result as Go's
+// crc32.ChecksumIEEE(data[:len]). `data` may be nullptr iff len == 0.
+uint32_t compute(const uint8_t* data, size_t len);
+
+// Streaming form with Go's crc32.Update semantics: `crc` is a
+// previously *finalised* checksum (0 for an empty prefix), the return
+// value is finalised too. compute(a||b) == update(compute(a), b).
+uint32_t update(uint32_t crc, const uint8_t* data, size_t len);
+
+// Engine selected by the runtime dispatcher on this host.
+Engine active_engine();
+
+// True iff `e` is compiled in AND supported by the running CPU.
+bool engine_available(Engine e);
+
+// Force a specific engine — conformance tests and benchmarks only.
+// Falls back to kBitSerial if `e` is not available on this host.
+uint32_t compute_with(Engine e, const uint8_t* data, size_t len);
+
+// Short human-readable engine name for logs ("pclmul", "slice8", …).
+const char* engine_name(Engine e);
+
+}  // namespace crc32_ieee
+
+#endif  // VOID_CRC32_IEEE_H
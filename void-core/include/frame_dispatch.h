@@ -0,0 +1,288 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      frame_dispatch.h
+ * Desc:      Dual-tier frame codec, zero-copy typed views and dispatch table.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * One place that turns "some bytes off the radio" into "a PacketX_t".
+ * Codec<T>::classify() decodes the Big-Endian header once and checks,
+ * in order:
+ *   sync word (SNLP) → CCSDS version → APID (idle 0x7FF rejected) →
+ *   packet_len + 1 == len - header → body length → F-03 magic (D/ACK).
+ * The body-length → type mapping mirrors the gateway Kaitai root switch,
+ * including dispatch_122 (SNLP D vs ACK share a 122-byte body).
+ *
+ * Both tiers live side by side (snlp::, ccsds::) and do NOT depend on
+ * VOID_PROTOCOL_TYPE. Codec<Tier::kSnlp> / Codec<Tier::kCcsds> are
+ * compile-time specialisations with no tier branch on the hot path;
+ * classify() / Dispatcher::dispatch() add one sync-word probe on top
+ * for processes that serve a LoRa and an S-band front-end at once.
+ *
+ * FrameView<T> is a bounds-checked, non-owning view: no memcpy, the
+ * packed struct (alignment 1) is read in place.
+ * -------------------------------------------------------------------------*/
+
+#ifndef VOID_FRAME_DISPATCH_H
+#define VOID_FRAME_DISPATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include "void_packets_ccsds.h"
+#include "void_packets_snlp.h"
+
+namespace frame_dispatch {
+
+// Values match VOID_PROTOCOL_TYPE.
+enum class Tier : uint8_t {
+    kCcsds = 1,   // S-band, 6-byte header
+    kSnlp  = 2,   // LoRa, 14-byte header with sync word
+};
+static constexpr size_t kTierCount = 2;
+
+enum class FrameKind : uint8_t {
+    kUnknown = 0,
+    kH,     // Handshake
+    kA,     // Invoice
+    kB,     // Payment
+    kC,     // Receipt
+    kD,     // Delivery
+    kAck,   // Acknowledgement (downlink)
+    kL,     // Heartbeat
+};
+static constexpr size_t kFrameKindCount = 8;
+
+enum class Status : uint8_t {
+    kOk = 0,
+    kTooShort,        // shorter than the tier header
+    kBadSync,         // SNLP sync word != 0x1D01A5A5
+    kBadVersion,      // CCSDS version bits != 0 (C-02)
+    kIdleApid,        // APID 0x7FF is the CCSDS idle packet
+    kLengthMismatch,  // packet_len + 1 != len - header
+    kUnknownLength,   // body length matches no frame type in this tier
+    kBadMagic,        // D/ACK body-offset-0 discriminant mismatch (F-03)
+    kWrongKind,       // FrameView<T>::from() on a frame of another type
+    kApidFiltered,    // Dispatcher entry is bound to a different APID
+    kNoHandler,       // Dispatcher has no entry for this frame type
+};
+
+// Header fields decoded once by classify(); host byte order.
+struct FrameInfo {
+    Tier      tier;
+    FrameKind kind;
+    uint16_t  apid;        // 11-bit
+    bool      is_command;  // CCSDS Type bit
+    uint16_t  seq_count;   // 14-bit
+    uint16_t  body_len;    // packet_len + 1
+};
+
+// --- Per-tier wire types ---
+template <Tier T> struct TierTraits;
+template <> struct TierTraits<Tier::kSnlp> {
+    using Header    = snlp::VoidHeader_t;
+    using PacketH   = snlp::PacketH_t;
+    using PacketA   = snlp::PacketA_t;
+    using PacketB   = snlp::PacketB_t;
+    using PacketC   = snlp::PacketC_t;
+    using PacketD   = snlp::PacketD_t;
+    using PacketAck = snlp::PacketAck_t;
+    using Heartbeat = snlp::HeartbeatPacket_t;
+    static constexpr bool kHasSyncWord = true;
+};
+template <> struct TierTraits<Tier::kCcsds> {
+    using Header    = ccsds::VoidHeader_t;
+    using PacketH   = ccsds::PacketH_t;
+    using PacketA   = ccsds::PacketA_t;
+    using PacketB   = ccsds::PacketB_t;
+    using PacketC   = ccsds::PacketC_t;
+    using PacketD   = ccsds::PacketD_t;
+    using PacketAck = ccsds::PacketAck_t;
+    using Heartbeat = ccsds::HeartbeatPacket_t;
+    static constexpr bool kHasSyncWord = false;
+};
+
+// --- Wire struct → (tier, kind) ---
+template <typename P> struct FrameTraits;
+template <Tier T, FrameKind K> struct FrameTraitsBase {
+    static constexpr Tier      kTier = T;
+    static constexpr FrameKind kKind = K;
+};
+template <Tier T, FrameKind K> constexpr Tier      FrameTraitsBase<T, K>::kTier;
+template <Tier T, FrameKind K> constexpr FrameKind FrameTraitsBase<T, K>::kKind;
+template <> struct FrameTraits<snlp::PacketH_t>          : FrameTraitsBase<Tier::kSnlp,  FrameKind::kH>   {};
+template <> struct FrameTraits<snlp::PacketA_t>          : FrameTraitsBase<Tier::kSnlp,  FrameKind::kA>   {};
+template <> struct FrameTraits<snlp::PacketB_t>          : FrameTraitsBase<Tier::kSnlp,  FrameKind::kB>   {};
+template <> struct FrameTraits<snlp::PacketC_t>          : FrameTraitsBase<Tier::kSnlp,  FrameKind::kC>   {};
+template <> struct FrameTraits<snlp::PacketD_t>          : FrameTraitsBase<Tier::kSnlp,  FrameKind::kD>   {};
+template <> struct FrameTraits<snlp::PacketAck_t>        : FrameTraitsBase<Tier::kSnlp,  FrameKind::kAck> {};
+template <> struct FrameTraits<snlp::HeartbeatPacket_t>  : FrameTraitsBase<Tier::kSnlp,  FrameKind::kL>   {};
+template <> struct FrameTraits<ccsds::PacketH_t>         : FrameTraitsBase<Tier::kCcsds, FrameKind::kH>   {};
+template <> struct FrameTraits<ccsds::PacketA_t>         : FrameTraitsBase<Tier::kCcsds, FrameKind::kA>   {};
+template <> struct FrameTraits<ccsds::PacketB_t>         : FrameTraitsBase<Tier::kCcsds, FrameKind::kB>   {};
+template <> struct FrameTraits<ccsds::PacketC_t>         : FrameTraitsBase<Tier::kCcsds, FrameKind::kC>   {};
+template <> struct FrameTraits<ccsds::PacketD_t>         : FrameTraitsBase<Tier::kCcsds, FrameKind::kD>   {};
+template <> struct FrameTraits<ccsds::PacketAck_t>       : FrameTraitsBase<Tier::kCcsds, FrameKind::kAck> {};
+template <> struct FrameTraits<ccsds::HeartbeatPacket_t> : FrameTraitsBase<Tier::kCcsds, FrameKind::kL>   {};
+
+template <typename P> class FrameView;
+
+// Compile-time tier codec. Instantiated for both tiers in
+// frame_dispatch.cpp; every call resolves statically.
+template <Tier T>
+class Codec {
+public:
+    using Traits = TierTraits<T>;
+    static constexpr size_t kHeaderSize = sizeof(typename Traits::Header);
+
+    // Validates header + length + magic and fills `out` (may be nullptr).
+    static Status classify(const uint8_t* buf, size_t len, FrameInfo* out);
+
+    // Writes this tier's Big-Endian header for a frame of `frame_len`
+    // total bytes, byte-identical to generate_packets.go::buildHeader
+    // (sec_flag=1, unsegmented). False if out_cap < kHeaderSize or
+    // frame_len leaves no body / overflows packet_len.
+    static bool write_header(uint8_t* out, size_t out_cap, uint16_t apid,
+                             bool is_command, uint16_t seq_count, size_t frame_len);
+
+    template <typename P>
+    static FrameView<P> view(const uint8_t* buf, size_t len, Status* status = nullptr);
+};
+
+// Runtime tier probe: the SNLP sync word at offset 0 selects kSnlp,
+// anything else is treated as CCSDS and validated as such.
+Tier detect_tier(const uint8_t* buf, size_t len);
+
+// detect_tier() + Codec<tier>::classify().
+Status classify(const uint8_t* buf, size_t len, FrameInfo* out);
+
+const char* tier_name(Tier t);
+const char* kind_name(FrameKind k);
+const char* status_name(Status s);
+
+class Dispatcher;
+
+template <typename P>
+class FrameView {
+public:
+    FrameView() : _buf(nullptr), _info() {}
+
+    // Bounds-checked cast: the tier's classify() must succeed AND yield
+    // P's kind. On failure returns an empty view and writes the reason
+    // to `status`. The tier is P's, so there is no runtime probe.
+    static FrameView from(const uint8_t* buf, size_t len, Status* status = nullptr) {
+        FrameInfo info = {};
+        Status st = Codec<FrameTraits<P>::kTier>::classify(buf, len, &info);
+        if (st == Status::kOk && info.kind != FrameTraits<P>::kKind) {
+            st = Status::kWrongKind;
+        }
+        if (status != nullptr) *status = st;
+        return (st == Status::kOk) ? FrameView(buf, info) : FrameView();
+    }
+
+    bool valid() const { return _buf != nullptr; }
+    explicit operator bool() const { return valid(); }
+
+    // Packed wire struct read in place. Body fields are Little-Endian,
+    // so direct member reads are only host-correct on LE targets (all
+    // current ones); use info() for header fields.
+    const P* get()        const { return reinterpret_cast<const P*>(_buf); }
+    const P* operator->() const { return get(); }
+    const P& operator*()  const { return *get(); }
+
+    const uint8_t*   bytes() const { return _buf; }
+    const FrameInfo& info()  const { return _info; }
+    static constexpr size_t size() { return sizeof(P); }
+
+private:
+    friend class Dispatcher;
+    FrameView(const uint8_t* buf, const FrameInfo& info) : _buf(buf), _info(info) {}
+
+    const uint8_t* _buf;
+    FrameInfo      _info;
+};
+
+template <Tier T> constexpr size_t Codec<T>::kHeaderSize;
+
+template <Tier T>
+template <typename P>
+FrameView<P> Codec<T>::view(const uint8_t* buf, size_t len, Status* status) {
+    static_assert(FrameTraits<P>::kTier == T, "wire struct belongs to the other tier");
+    return FrameView<P>::from(buf, len, status);
+}
+
+template <typename P>
+inline FrameView<P> view_as(const uint8_t* buf, size_t len, Status* status = nullptr) {
+    return FrameView<P>::from(buf, len, status);
+}
+
+extern template class Codec<Tier::kSnlp>;
+extern template class Codec<Tier::kCcsds>;
+
+// Fixed table of typed handlers indexed by [tier][FrameKind] (no heap,
+// no virtuals). Adding a packet type to a consumer is one on<P>() call;
+// binding snlp:: and ccsds:: structs lets one table serve both radios.
+class Dispatcher {
+public:
+    static constexpr uint16_t kAnyApid = 0xFFFFu;
+
+    template <typename P>
+    using Handler = void (*)(const FrameView<P>& view, void* user);
+
+    Dispatcher();
+
+    // Bind `fn` for frames of wire type P (which fixes the tier). `apid`
+    // restricts the entry to one source/destination; kAnyApid accepts
+    // all. Rebinding replaces.
+    template <typename P>
+    void on(Handler<P> fn, void* user, uint16_t apid = kAnyApid) {
+        Entry& e = _table[TierIndex(FrameTraits<P>::kTier)]
+                         [static_cast<size_t>(FrameTraits<P>::kKind)];
+        e.thunk = &Thunk<P>;
+        e.fn    = reinterpret_cast<void (*)()>(fn);
+        e.user  = user;
+        e.apid  = apid;
+    }
+
+    void off(Tier tier, FrameKind kind);
+
+    // Auto-detects the tier, then classify + table lookup + handler
+    // call. Returns kOk iff a handler ran; otherwise why it did not.
+    Status dispatch(const uint8_t* buf, size_t len) const;
+
+    // Fixed-tier entry for a front-end that knows its radio.
+    template <Tier T>
+    Status dispatch_as(const uint8_t* buf, size_t len) const {
+        FrameInfo info = {};
+        const Status st = Codec<T>::classify(buf, len, &info);
+        if (st != Status::kOk) return st;
+        return deliver(buf, info);
+    }
+
+private:
+    struct Entry {
+        void     (*thunk)(const Entry& e, const uint8_t* buf, const FrameInfo& info);
+        void     (*fn)();
+        void*    user;
+        uint16_t apid;
+    };
+
+    static constexpr size_t TierIndex(Tier t) {
+        return (t == Tier::kSnlp) ? 1u : 0u;
+    }
+
+    template <typename P>
+    static void Thunk(const Entry& e, const uint8_t* buf, const FrameInfo& info) {
+        reinterpret_cast<Handler<P>>(e.fn)(FrameView<P>(buf, info), e.user);
+    }
+
+    Status deliver(const uint8_t* buf, const FrameInfo& info) const;
+
+    Entry _table[kTierCount][kFrameKindCount];
+};
+
+}  // namespace frame_dispatch
+
+#endif  // VOID_FRAME_DISPATCH_H
@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      key_cache.h
+ * Desc:      Small ring of X25519 ephemeral keypairs generated ahead of
+ *            the handshake that spends them.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * On the ESP32 a crypto_box_keypair() is the slow half of building a
+ * Packet H. KeyCache moves it off the handshake: refill_one() makes one
+ * keypair per call, from idle loop slices or a task on the other core,
+ * and take() hands the oldest one to prepareHandshake(), which then only
+ * signs. An empty cache falls back to an inline keygen; the miss is
+ * counted.
+ *
+ * Lock-free single-producer / single-consumer: one context calls
+ * refill_one(), one other context calls take() and wipe(). Each side
+ * owns one index and only reads the other's. No heap.
+ * -------------------------------------------------------------------------*/
+
+#ifndef VOID_KEY_CACHE_H
+#define VOID_KEY_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace key_cache {
+
+constexpr size_t kSlots   = 4;  // power of two
+constexpr size_t kKeySize = 32;
+
+struct Keypair {
+    uint8_t pub[kKeySize];
+    uint8_t priv[kKeySize];
+};
+
+struct Stats {
+    uint32_t generated; // keypairs made by refill_one()
+    uint32_t taken;     // handed out from the ring
+    uint32_t misses;    // ring empty: generated inline in take()
+    uint32_t wiped;     // zeroised unused by wipe()
+};
+
+class KeyCache {
+    static_assert(kSlots >= 2 && (kSlots & (kSlots - 1)) == 0,
+                  "KeyCache capacity must be a power of two");
+
+public:
+    KeyCache();
+    ~KeyCache();
+
+    KeyCache(const KeyCache&)            = delete;
+    KeyCache& operator=(const KeyCache&) = delete;
+
+    // --- Producer side ---
+
+    // Generates one keypair into a free slot. False (nothing done) when
+    // the ring is full. sodium_init() first.
+    bool refill_one();
+
+    // --- Consumer side ---
+
+    // A fresh keypair, from the ring when it has one. The caller wipes
+    // `out.priv` once it is used.
+    void take(Keypair& out);
+
+    // Zeroises every unused keypair and empties the ring. Returns how
+    // many were dropped.
+    size_t wipe();
+
+    // --- Either side (approximate while the other side is running) ---
+
+    size_t available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    Stats stats() const;
+
+private:
+    std::atomic<uint32_t> head_;  // producer-owned
+    std::atomic<uint32_t> tail_;  // consumer-owned
+    Keypair               slots_[kSlots];
+
+    std::atomic<uint32_t> generated_;
+    std::atomic<uint32_t> taken_;
+    std::atomic<uint32_t> misses_;
+    std::atomic<uint32_t> wiped_;
+};
+
+} // namespace key_cache
+
+#endif // VOID_KEY_CACHE_H
@@ -0,0 +1,205 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      security_context.h
+ * Desc:      Re-entrant security context: a shared read-only Ed25519
+ *            identity, per-peer session state, and a sharded session
+ *            store keyed by sat_id.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * SecurityManager keeps one identity and one session behind a global,
+ * which is all a satellite needs. A ground station talks to many sats
+ * from several threads, so the state is split by lifetime:
+ *
+ *   Identity     — long-term signing key. Written once by init, then
+ *                  only read: any number of threads sign with it at once.
+ *   Session      — one peer's handshake keys, ChaCha20 key, TTL and
+ *                  monotonic epoch. Plain data; the free functions below
+ *                  touch nothing else, so one thread per Session is the
+ *                  only rule.
+ *   SessionStore — Sessions keyed by sat_id in kShards independently
+ *                  locked open-addressing shards. A call locks only the
+ *                  shard its sat hashes to, so work for different sats
+ *                  runs in parallel with no global lock.
+ *
+ * SecurityManager wraps one Identity and one Session, so the firmware
+ * path is unchanged. Call sodium_init() (Identity::init does) before
+ * using any of this from more than one thread.
+ * -------------------------------------------------------------------------*/
+
+#ifndef VOID_SECURITY_CONTEXT_H
+#define VOID_SECURITY_CONTEXT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "void_packets.h"
+
+// NSA Guideline: Explicit State Management
+enum SessionState {
+    SESSION_IDLE = 0,
+    SESSION_HANDSHAKE_INIT,
+    SESSION_HANDSHAKE_WAIT,
+    SESSION_ACTIVE,
+    SESSION_LOCKED
+};
+
+namespace security_context {
+
+constexpr size_t kPubKeySize     = 32;
+constexpr size_t kSecretKeySize  = 64;
+constexpr size_t kSeedSize       = 32;
+constexpr size_t kSessionKeySize = 32;
+constexpr size_t kSignatureSize  = 64;
+
+class Identity {
+public:
+    Identity();
+    ~Identity();
+
+    // Derives the Ed25519 keypair from `seed`. Not thread-safe; call
+    // once before sharing the Identity.
+    bool init_from_seed(const uint8_t seed[kSeedSize]);
+    bool ready() const { return ready_; }
+
+    const uint8_t* public_key() const { return pub_; }
+
+    // Detached Ed25519 signature over data[0..len). Thread-safe.
+    bool sign(const uint8_t* data, size_t len, uint8_t sig_out[kSignatureSize]) const;
+
+private:
+    uint8_t pub_[kPubKeySize];
+    uint8_t priv_[kSecretKeySize];
+    bool    ready_;
+};
+
+struct Session {
+    SessionState state;
+    uint32_t     ttl_s;
+    uint64_t     start_ms;
+    uint64_t     last_tx_epoch_ms;  // VOID-110 monotonic guardrail
+    uint8_t      eph_pub[kPubKeySize];
+    uint8_t      eph_priv[kPubKeySize];
+    uint8_t      key[kSessionKeySize];
+};
+
+// Zeroes every key and returns the session to SESSION_IDLE. Keeps
+// last_tx_epoch_ms: the guardrail outlives sessions.
+void wipe(Session& s);
+
+// Fresh X25519 ephemeral keypair, Packet H signed by `id`, session in
+// SESSION_HANDSHAKE_INIT with the TTL counting from `now_ms`.
+void begin_handshake(Session& s, const Identity& id, PacketH_t& pkt_out,
+                     uint16_t ttl_seconds, uint64_t now_ms);
+
+// Same, with an ephemeral keypair generated ahead of time (KeyCache).
+// The caller still owns, and wipes, `eph_priv`.
+void begin_handshake(Session& s, const Identity& id, const uint8_t eph_pub[kPubKeySize],
+                     const uint8_t eph_priv[kPubKeySize], PacketH_t& pkt_out,
+                     uint16_t ttl_seconds, uint64_t now_ms);
+
+// ECDH with the peer's ephemeral key, BLAKE2b into the ChaCha20 key,
+// ephemeral secret destroyed. SESSION_ACTIVE on success.
+bool complete_handshake(Session& s, const uint8_t peer_eph_pub[kPubKeySize]);
+
+// Installs an already-derived session key as SESSION_ACTIVE.
+void activate(Session& s, const uint8_t key[kSessionKeySize], uint16_t ttl_seconds,
+              uint64_t now_ms);
+
+// True while SESSION_ACTIVE and inside the TTL; an expired session is
+// wiped.
+bool is_active(Session& s, uint64_t now_ms);
+
+// Encrypts + signs a PacketB exactly as SecurityManager::encryptPacketB
+// documents (VOID-110 nonce, VOID-127 plaintext build, VOID-111 scope).
+bool encrypt_packet_b(Session& s, const Identity& id, PacketB_t& pkt,
+                      const uint8_t* payload_in, size_t len, bool gps_time_valid);
+
+// ChaCha20 with the VOID-110 nonce sat_id[4] || epoch_ts[8]. XOR, so
+// the same call encrypts and decrypts. `in` and `out` may alias.
+void chacha20_xor(const uint8_t key[kSessionKeySize], uint32_t sat_id, uint64_t epoch_ts,
+                  const uint8_t* in, size_t len, uint8_t* out);
+
+class SessionStore {
+public:
+    static constexpr size_t kShards        = 64;
+    static constexpr size_t kShardSlots    = 64;
+    static constexpr size_t kShardSessions = kShardSlots / 4 * 3;
+    static constexpr size_t kMaxSessions   = kShards * kShardSessions;
+
+    SessionStore();
+    ~SessionStore();
+
+    SessionStore(const SessionStore&)            = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // Installs (or replaces) `sat_id`'s session as SESSION_ACTIVE with
+    // `key`. False when its shard is full.
+    bool install(uint32_t sat_id, const uint8_t key[kSessionKeySize], uint16_t ttl_seconds,
+                 uint64_t now_ms);
+
+    enum class Install : uint8_t {
+        kInstalled = 0,
+        kFull,      // no slot left in the sat's shard
+        kNotNewer,  // active session from an Init at least as new
+    };
+
+    // Packet H (Init) path: install() tagged with the Init's timestamp.
+    // A session still inside its TTL is replaced only by an Init with a
+    // strictly newer timestamp, so a replayed Init cannot swap out a
+    // live key; an expired or plainly install()ed one always is.
+    Install install_handshake(uint32_t sat_id, const uint8_t key[kSessionKeySize],
+                              uint16_t ttl_seconds, uint64_t now_ms, uint64_t init_ts);
+
+    // Wipes and forgets `sat_id`'s session. False if there was none.
+    bool erase(uint32_t sat_id);
+    bool active(uint32_t sat_id, uint64_t now_ms);
+
+    // chacha20_xor() under `sat_id`'s session key. False when the sat
+    // has no active session (an expired one is wiped and dropped).
+    bool crypt(uint32_t sat_id, uint64_t epoch_ts, const uint8_t* in, size_t len,
+               uint8_t* out, uint64_t now_ms);
+
+    // One frame's worth of in-place crypt() for crypt_many().
+    struct CryptJob {
+        uint64_t epoch_ts;
+        uint8_t* data;
+        size_t   len;
+    };
+
+    // crypt() in place over `count` payloads of the same sat under one
+    // shard lock and one TTL check. False (nothing touched) when the sat
+    // has no active session.
+    bool crypt_many(uint32_t sat_id, const CryptJob* jobs, size_t count, uint64_t now_ms);
+
+    size_t size() const;
+    void   clear();
+
+private:
+    struct Slot {
+        uint32_t sat_id;
+        bool     used;
+        uint64_t init_ts;  // Packet H (Init) timestamp; 0 for install()
+        Session  session;
+    };
+    struct Shard {
+        mutable std::mutex lock;
+        size_t             count;
+        Slot               slots[kShardSlots];
+    };
+
+    static size_t shard_of(uint32_t sat_id);
+    static size_t home(uint32_t sat_id);
+    static size_t probe(const Shard& sh, uint32_t sat_id);
+    static void   remove(Shard& sh, size_t i);
+
+    Shard shards_[kShards];
+};
+
+} // namespace security_context
+
+#endif // VOID_SECURITY_CONTEXT_H
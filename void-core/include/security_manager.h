@@ -13,52 +13,55 @@
 #define SECURITY_MANAGER_H
 
 #include "void_packets.h"
+#include "key_cache.h"
+#include "security_context.h"
 #include <sodium.h>
 
-
-// NSA Guideline: Explicit State Management
-enum SessionState {
-    SESSION_IDLE = 0,
-    SESSION_HANDSHAKE_INIT,
-    SESSION_HANDSHAKE_WAIT,
-    SESSION_ACTIVE,
-    SESSION_LOCKED
-};
-
+// The satellite's single security context: one Identity and one
+// Session from security_context.h behind the global `Security`. Ground
+// code that needs many sessions or many threads uses those types (and
+// security_context::SessionStore) directly.
 class SecurityManager {
 private:
     // --- IDENTITY (PERSISTENT) ---
     // In production, these come from PUF/NVS. For Demo, we hardcode or generate.
-    uint8_t _identity_pub[32];
-    uint8_t _identity_priv[64];
+    security_context::Identity _identity;
 
     // --- SESSION (EPHEMERAL) ---
-    uint8_t _eph_pub[32];
-    uint8_t _eph_priv[32];
-    uint8_t _session_key[32];
-
-    SessionState _state;
-    uint64_t     _session_start_ts;
-    uint32_t     _session_ttl;
-
-    // --- MONOTONIC EPOCH GUARDRAIL (VOID-110) ---
-    // Tracks the highest epoch_ms ever used to derive a ChaCha20 nonce.
-    // Persisted to NVS on every N transmits and reloaded on boot.
-    // Without this, a clock rollback would cause nonce reuse with the
-    // same session key and fully break ChaCha20.
-    uint64_t _last_tx_epoch_ms;
-    bool     _gps_time_valid;
+    // Ephemeral keypair, session key, TTL and the VOID-110 monotonic
+    // epoch guardrail: the highest epoch_ms ever used to derive a
+    // ChaCha20 nonce. Persisted to NVS on every N transmits and
+    // reloaded on boot. Without it, a clock rollback would cause nonce
+    // reuse with the same session key and fully break ChaCha20.
+    security_context::Session _session;
+    bool                      _gps_time_valid;
+
+    // --- EPHEMERAL KEYPAIRS (PRECOMPUTED) ---
+    // Filled by refillKeyCache() between handshakes so prepareHandshake()
+    // only has to sign. Unused keys are zeroised when the session ends.
+    key_cache::KeyCache _keys;
 
 public:
     SecurityManager();
 
+    // Holds private keys: never copied.
+    SecurityManager(const SecurityManager&)            = delete;
+    SecurityManager& operator=(const SecurityManager&) = delete;
+
     // 1. Initialization
     bool begin(); // Loads Identity Keys + reloads _last_tx_epoch_ms from NVS
 
     // 2. Handshake Logic (Packet H)
-    // Generates the "Hello" packet to start a session
+    // Generates the "Hello" packet to start a session. Takes the
+    // ephemeral keypair from the cache; an empty cache generates inline.
     void prepareHandshake(PacketH_t& pkt_out, uint16_t ttl_seconds, uint64_t current_time_ms);
 
+    // Generates at most one ephemeral keypair into the cache; false when
+    // it is already full. Call from idle loop slices, or from a task on
+    // the other core — but only ever from one of them (single producer).
+    bool refillKeyCache() { return _keys.refill_one(); }
+    const key_cache::KeyCache& keyCache() const { return _keys; }
+
     // Processes the response from Ground and derives the Session Key
     bool processHandshakeResponse(const PacketH_t& pkt_in);
 
@@ -87,11 +90,12 @@ public:
     // Called by main loop once GPS time is fixed and monotonic-vs-NVS check passes.
     void setGpsTimeValid(bool valid) { _gps_time_valid = valid; }
     bool isGpsTimeValid() const { return _gps_time_valid; }
-    uint64_t lastTxEpochMs() const { return _last_tx_epoch_ms; }
+    uint64_t lastTxEpochMs() const { return _session.last_tx_epoch_ms; }
 
     // 5. Utility
+    // An expiring TTL wipes the session and every unused cached keypair.
     bool isSessionActive(uint64_t current_time_ms);
-    void wipeSession(); // Secure zeroing of keys
+    void wipeSession(); // Secure zeroing of keys (session and cache)
 };
 
 // Singleton Instance
@@ -0,0 +1,131 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      serial_frame.h
+ * Desc:      Binary COBS framing for the firmware <-> ground-station
+ *            USB-serial link.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Wire format (one frame):
+ *
+ *   COBS( type:u8 | payload[0..256] | crc32_le(type | payload) ) | 0x00
+ *
+ * COBS guarantees 0x00 never appears inside a frame, so the delimiter
+ * resynchronises the stream after any glitch. A 192-byte PacketB costs
+ * 199 bytes on the wire vs 394 as "PACKET_B:<hex>\n", and ingest is a
+ * byte copy instead of a hex parse.
+ *
+ * Negotiation: the link boots in ASCII hex lines. The ground station
+ * sends kOfferLine; firmware that understands binary framing answers
+ * kAcceptLine (still ASCII) and from then on emits only COBS frames —
+ * log chatter travels as Type::kLine. Older firmware ignores the offer
+ * and the link stays ASCII, which is also the debug fallback.
+ *
+ * A binary board still listens for ASCII lines: a restarted ground
+ * station re-offers and is answered again, and kRevertLine (as an ASCII
+ * line or a kLine frame) puts the board back on hex lines.
+ * -------------------------------------------------------------------------*/
+
+#ifndef VOID_SERIAL_FRAME_H
+#define VOID_SERIAL_FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace serial_frame {
+
+enum class Type : uint8_t {
+    kLine    = 0x01, // ASCII text: log chatter up, commands ("H", "ACK_BUY") down
+    kFrame   = 0x02, // VOID wire frame the board heard / sent (INVOICE:, PACKET_B:, …)
+    kTxFrame = 0x03, // VOID wire frame the ground asks the board to transmit
+};
+
+constexpr size_t kMaxPayload = 256;
+constexpr size_t kCrcSize    = 4;
+constexpr size_t kMaxRaw     = 1 + kMaxPayload + kCrcSize;
+// COBS adds one code byte per 254 data bytes (+1), plus the delimiter.
+constexpr size_t kMaxEncoded = kMaxRaw + kMaxRaw / 254 + 1 + 1;
+
+// ASCII handshake lines (sent without the trailing '\n').
+constexpr char kOfferLine[]  = "FRAMING:COBS";
+constexpr char kAcceptLine[] = "FRAMING_OK:COBS";
+constexpr char kRevertLine[] = "FRAMING:HEX";
+
+// Encodes one frame, delimiter included, into `out`. Returns the
+// number of bytes written, or 0 if payload_len > kMaxPayload or
+// `out_cap` is too small (kMaxEncoded always suffices).
+size_t encode(Type type, const uint8_t* payload, size_t payload_len,
+              uint8_t* out, size_t out_cap);
+
+// Streaming decoder: push every received byte. Fixed-size buffer,
+// decodes in place, no heap. Safe to keep one per serial port.
+class Decoder {
+public:
+    enum class Result : uint8_t {
+        kPending = 0, // need more bytes (also: empty frame / bare delimiter)
+        kFrame,       // complete, CRC-checked frame ready via type()/payload()
+        kError,       // frame discarded: bad COBS, short, CRC, unknown type
+        kOverflow,    // no delimiter within kMaxEncoded: peer is not speaking COBS
+    };
+
+    Decoder();
+
+    Result push(uint8_t byte);
+    void   reset();
+
+    // Valid only immediately after push() returned kFrame.
+    Type           type() const { return _type; }
+    const uint8_t* payload() const { return _buf + 1; }
+    size_t         payload_len() const { return _payload_len; }
+
+private:
+    Result finish();
+
+    uint8_t _buf[kMaxEncoded];
+    size_t  _len;
+    size_t  _payload_len;
+    Type    _type;
+    bool    _overflow;
+};
+
+// Board side of the link: turns received bytes into ground commands and
+// tracks the negotiated mode. ASCII lines are parsed in both modes so
+// the offer / revert lines always get through; in binary mode the
+// ASCII accumulator is cleared at every 0x00 and decoded frame, so COBS
+// bytes never prefix a later line, and any other ASCII line is dropped.
+class CommandLink {
+public:
+    enum class Event : uint8_t {
+        kNone = 0,
+        kCommand, // command() holds one NUL-terminated ground command
+        kOffer,   // kOfferLine heard: answer kAcceptLine in ASCII; now binary
+        kRevert,  // kRevertLine heard: now ASCII
+    };
+
+    CommandLink();
+
+    Event push(uint8_t byte);
+    void  reset(); // back to ASCII, partial input dropped
+
+    bool binary() const { return _binary; }
+
+    // Valid only immediately after push() returned kCommand.
+    const char* command() const { return _line; }
+    size_t      command_len() const { return _cmd_len; }
+
+private:
+    Event line_event(const char* text, size_t len, bool from_frame);
+
+    Decoder _rx;
+    char    _line[kMaxPayload + 1];
+    size_t  _len;
+    size_t  _cmd_len;
+    bool    _binary;
+};
+
+}  // namespace serial_frame
+
+#endif  // VOID_SERIAL_FRAME_H
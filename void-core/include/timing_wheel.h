@@ -0,0 +1,159 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      timing_wheel.h
+ * Desc:      Hierarchical timing wheel: O(1) arm / cancel / expire for
+ *            session TTL, handshake, CLOSING and blacklist deadlines.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Four levels of 64 slots. Level L slot s holds the timers due in the
+ * 64^L-tick span that s names; when the wheel reaches that span the slot
+ * is cascaded one level down, and level 0 slots fire. A timer is moved
+ * at most three times however long its deadline, and arming or
+ * cancelling one is a doubly-linked-list splice on a preallocated node.
+ *
+ * Each level keeps a 64-bit occupancy mask, so advance() jumps straight
+ * to the next slot holding work instead of stepping every tick: a quiet
+ * wheel costs nothing to advance across hours.
+ *
+ * Time comes from an injected clock (reactor::now_ms on the ground,
+ * millis() on the board, a fake in tests). A timer never fires before
+ * its deadline and at most one tick after the advance() that passes it.
+ * Deadlines further out than 64^4 ticks park in the top level and are
+ * re-filed as the wheel approaches them.
+ *
+ * Node storage is supplied by the caller (or embedded by TimerPool<N>);
+ * nothing is allocated after construction. Not thread-safe.
+ * -------------------------------------------------------------------------*/
+
+#ifndef VOID_TIMING_WHEEL_H
+#define VOID_TIMING_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace timing_wheel {
+
+constexpr unsigned kLevels    = 4;
+constexpr unsigned kSlotBits  = 6;
+constexpr unsigned kSlots     = 1u << kSlotBits;
+constexpr uint64_t kSpanTicks = 1ull << (kSlotBits * kLevels);
+
+// Monotonic milliseconds.
+using Clock = uint64_t (*)();
+
+// Runs when a timer expires. `ctx` and `tag` are what arm() was given,
+// so one callback can serve a whole table (tag = sat_id). The timer is
+// already free: the callback may re-arm it or arm others.
+using Callback = void (*)(void* ctx, uint32_t tag);
+
+// Opaque timer handle: node index plus a generation, so cancelling a
+// handle whose timer already fired (and whose node was reused) is a
+// harmless no-op. Fits in a spare word of a session slot.
+using Handle = uint32_t;
+constexpr Handle   kNoTimer   = 0;
+constexpr unsigned kIndexBits = 20;
+constexpr size_t   kMaxTimers = (1u << kIndexBits) - 1;
+
+// One preallocated timer. 40 bytes.
+struct Node {
+    uint32_t next;
+    uint32_t prev;
+    uint32_t gen;
+    uint8_t  level;  // kIdle when not armed
+    uint8_t  slot;
+    uint16_t pad;
+    uint64_t deadline;  // in ticks
+    Callback fn;
+    void*    ctx;
+    uint32_t tag;
+};
+
+struct Stats {
+    size_t   capacity;
+    size_t   armed;
+    size_t   peak;
+    uint64_t fired;
+    uint64_t cascaded;  // node moves to a lower level
+    uint64_t exhausted; // arm() refused: every node in use
+};
+
+class Wheel {
+public:
+    // `storage[0..capacity)` is owned by the wheel for its lifetime.
+    // Times are counted from the clock's reading here, in `tick_ms` units.
+    Wheel(Node* storage, size_t capacity, Clock clock, uint32_t tick_ms);
+
+    Wheel(const Wheel&)            = delete;
+    Wheel& operator=(const Wheel&) = delete;
+
+    // Arms a timer for `deadline_ms` (clock time). A deadline that has
+    // already passed fires on the next advance(). Returns kNoTimer when
+    // every node is in use.
+    Handle arm(uint64_t deadline_ms, Callback fn, void* ctx, uint32_t tag);
+    Handle arm_in(uint32_t delay_ms, Callback fn, void* ctx, uint32_t tag);
+
+    // Moves an armed timer to a new deadline, or arms a fresh one if
+    // `h` is kNoTimer or has fired. Returns the handle to keep.
+    Handle rearm(Handle h, uint64_t deadline_ms, Callback fn, void* ctx, uint32_t tag);
+
+    // True if the timer was armed and is now cancelled.
+    bool cancel(Handle h);
+    bool armed(Handle h) const;
+
+    // Fires every timer due by `now_ms`; returns how many fired.
+    size_t advance(uint64_t now_ms);
+    // advance(clock()).
+    size_t poll();
+
+    // Earliest clock time at which advance() has anything to do (a
+    // slot to fire or cascade), or UINT64_MAX when nothing is armed.
+    uint64_t next_wake_ms() const;
+
+    // Clock time of the last tick advanced to.
+    uint64_t now_ms() const { return origin_ + now_ * tick_ms_; }
+    uint32_t tick_ms() const { return tick_ms_; }
+    Stats    stats() const { return stats_; }
+
+    // Cancels every timer without running it.
+    void clear();
+
+private:
+    uint32_t index_of(Handle h) const;
+    uint64_t to_ticks(uint64_t deadline_ms) const;
+    void     file(uint32_t i);
+    void     unlink(uint32_t i);
+    void     fire_slot(uint64_t tick);
+    void     cascade(unsigned level, uint64_t tick);
+    uint64_t next_event() const;
+
+    Node*    nodes_;
+    uint32_t capacity_;
+    uint32_t tick_ms_;
+    uint32_t free_;
+    Clock    clock_;
+    uint64_t origin_;
+    uint64_t now_;  // ticks processed
+    uint64_t occupied_[kLevels];
+    uint32_t head_[kLevels][kSlots];
+    Stats    stats_;
+};
+
+// Wheel with its nodes embedded: `static TimerPool<4096> timers(...)`.
+template <size_t N>
+class TimerPool : public Wheel {
+    static_assert(N >= 1 && N <= kMaxTimers, "TimerPool size out of range");
+
+public:
+    TimerPool(Clock clock, uint32_t tick_ms) : Wheel(storage_, N, clock, tick_ms) {}
+
+private:
+    Node storage_[N];
+};
+
+} // namespace timing_wheel
+
+#endif // VOID_TIMING_WHEEL_H
@@ -37,6 +37,7 @@
     #define SIZE_VOID_HEADER        SIZE_CCSDS_HEADER
 
     #include "void_packets_ccsds.h"
+    namespace void_build_tier = ccsds;
 
 
 #elif VOID_PROTOCOL_TYPE == 2
@@ -57,10 +58,39 @@
     #define SIZE_VOID_HEADER        SIZE_SNLP_HEADER
 
     #include "void_packets_snlp.h"
+    namespace void_build_tier = snlp;
 
 
 #else
     #error "Unknown VOID_PROTOCOL_TYPE! Use 1 (CCSDS) or 2 (SNLP)."
 #endif
 
+// --- BUILD-TIER RE-EXPORT ---
+// The tier headers are namespaced (snlp::, ccsds::) so a dual-tier
+// consumer can include both (see frame_dispatch.h). Single-tier code —
+// firmware, the per-tier test binaries — keeps using the unqualified
+// names, bound here to the tier selected above.
+using void_build_tier::VoidHeader_t;
+using void_build_tier::PacketH_t;
+using void_build_tier::PacketA_t;
+using void_build_tier::PacketB_t;
+using void_build_tier::RelayOps_t;
+using void_build_tier::TunnelData_t;
+using void_build_tier::PacketAck_t;
+using void_build_tier::PacketC_t;
+using void_build_tier::PacketD_t;
+using void_build_tier::HeartbeatPacket_t;
+using void_build_tier::PACKET_ACK_MAGIC;
+using void_build_tier::PACKET_D_MAGIC;
+
+static_assert(SIZE_VOID_HEADER   == void_build_tier::kSizeHeader,     "SIZE_VOID_HEADER drift");
+static_assert(SIZE_PACKET_A      == void_build_tier::kSizePacketA,    "SIZE_PACKET_A drift");
+static_assert(SIZE_PACKET_B      == void_build_tier::kSizePacketB,    "SIZE_PACKET_B drift");
+static_assert(SIZE_PACKET_C      == void_build_tier::kSizePacketC,    "SIZE_PACKET_C drift");
+static_assert(SIZE_PACKET_D      == void_build_tier::kSizePacketD,    "SIZE_PACKET_D drift");
+static_assert(SIZE_PACKET_H      == void_build_tier::kSizePacketH,    "SIZE_PACKET_H drift");
+static_assert(SIZE_PACKET_ACK    == void_build_tier::kSizePacketAck,  "SIZE_PACKET_ACK drift");
+static_assert(SIZE_TUNNEL_DATA   == void_build_tier::kSizeTunnelData, "SIZE_TUNNEL_DATA drift");
+static_assert(SIZE_HEARTBEAT_PCK == void_build_tier::kSizeHeartbeat,  "SIZE_HEARTBEAT_PCK drift");
+
 #endif // VOID_PACKETS_H
\ No newline at end of file
@@ -4,8 +4,8 @@
  * Authority: Tiny Innovation Group Ltd
  * License:   Apache 2.0
  * Status:    Authenticated Clean Room Spec
- * File:      void_packets.h
- * Desc:      Packed structures for OTA serialization.
+ * File:      void_packets_ccsds.h
+ * Desc:      Packed structures for OTA serialization (CCSDS / Enterprise tier).
  * -------------------------------------------------------------------------
  * WARNING: Payloads are Little-Endian. Headers are Big-Endian.
  * -------------------------------------------------------------------------*/
@@ -14,7 +14,22 @@
 #define VOID_CCSDS_PACKETS_H
 
 #include "void_types.h"
-#include "void_packets.h" // For size constants
+
+// Self-contained: every wire struct lives in namespace ccsds so both
+// tiers can coexist in one translation unit (frame_dispatch::Codec).
+// void_packets.h re-exports the build tier's names at global scope.
+namespace ccsds {
+
+// Frame sizes (CCSDS / Enterprise tier)
+static constexpr size_t kSizeHeader     =   6;  // CCSDS Primary Header
+static constexpr size_t kSizePacketA    =  72;  // Invoice
+static constexpr size_t kSizePacketB    = 184;  // Payment
+static constexpr size_t kSizePacketC    = 104;  // Receipt
+static constexpr size_t kSizePacketD    = 128;  // Delivery
+static constexpr size_t kSizePacketH    = 112;  // Handshake
+static constexpr size_t kSizePacketAck  = 120;  // Acknowledgement
+static constexpr size_t kSizeTunnelData =  88;  // Tunnel Data (PacketAck_t::enc_tunnel)
+static constexpr size_t kSizeHeartbeat  =  40;  // Heartbeat: 6 (Head) + 34 (Body)
 
 // Enforce 1-byte alignment for wire-format structures
 #pragma pack(push, 1)
@@ -35,7 +50,7 @@ typedef struct __attribute__((packed)) {
     uint16_t packet_len;        // Total Length - 1
 } VoidHeader_t;
 
-static_assert(sizeof(VoidHeader_t) == SIZE_CCSDS_HEADER, "VoidHeader_t CCSDS size mismatch");
+static_assert(sizeof(VoidHeader_t) == kSizeHeader, "VoidHeader_t CCSDS size mismatch");
 
 
 /* --------------------------------------------------------------------------
@@ -57,7 +72,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      signature[64];   // 48-111: Ed25519 Identity Sig
 } PacketH_t;
 
-static_assert(sizeof(PacketH_t) == SIZE_PACKET_H, "PacketH_t size mismatch");
+static_assert(sizeof(PacketH_t) == kSizePacketH, "PacketH_t size mismatch");
 static_assert(sizeof(PacketH_t) % 4 == 0, "PacketH_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(PacketH_t) % 8 == 0, "PacketH_t not 64-bit word aligned (CCSDS)");
 
@@ -83,7 +98,7 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 68-71: Little-Endian (4-aligned ✅)
 } PacketA_t;
 
-static_assert(sizeof(PacketA_t) == SIZE_PACKET_A, "PacketA_t size mismatch");
+static_assert(sizeof(PacketA_t) == kSizePacketA, "PacketA_t size mismatch");
 static_assert(sizeof(PacketA_t) % 4 == 0, "PacketA_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(PacketA_t) % 8 == 0, "PacketA_t not 64-bit word aligned (CCSDS)");
 
@@ -118,7 +133,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      _tail_pad[4]; // 180-183: Tail pad — frame total 184 (÷8 ✅)
 } PacketB_t;
 
-static_assert(sizeof(PacketB_t) == SIZE_PACKET_B, "PacketB_t size mismatch");
+static_assert(sizeof(PacketB_t) == kSizePacketB, "PacketB_t size mismatch");
 static_assert(sizeof(PacketB_t) % 4 == 0, "PacketB_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(PacketB_t) % 8 == 0, "PacketB_t not 64-bit word aligned (CCSDS)");
 
@@ -154,7 +169,7 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 84-87: Little-Endian (Inner Checksum)
 } TunnelData_t;
 
-static_assert(sizeof(TunnelData_t) == SIZE_TUNNEL_DATA, "TunnelData_t size mismatch");
+static_assert(sizeof(TunnelData_t) == kSizeTunnelData, "TunnelData_t size mismatch");
 static_assert(sizeof(TunnelData_t) % 4 == 0, "TunnelData_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(TunnelData_t) % 8 == 0, "TunnelData_t not 64-bit word aligned (CCSDS)");
 
@@ -182,7 +197,7 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 116-119: Outer Checksum
 } PacketAck_t;
 
-static_assert(sizeof(PacketAck_t) == SIZE_PACKET_ACK, "PacketAck_t size mismatch");
+static_assert(sizeof(PacketAck_t) == kSizePacketAck, "PacketAck_t size mismatch");
 static_assert(sizeof(PacketAck_t) % 4 == 0, "PacketAck_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(PacketAck_t) % 8 == 0, "PacketAck_t not 64-bit word aligned (CCSDS)");
 static_assert(offsetof(PacketAck_t, magic) == sizeof(VoidHeader_t),
@@ -211,7 +226,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      _tail_pad[4];  // 100-103: Final Alignment
 } PacketC_t;
 
-static_assert(sizeof(PacketC_t) == SIZE_PACKET_C, "PacketC_t size mismatch");
+static_assert(sizeof(PacketC_t) == kSizePacketC, "PacketC_t size mismatch");
 static_assert(sizeof(PacketC_t) % 4 == 0, "PacketC_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(PacketC_t) % 8 == 0, "PacketC_t not 64-bit word aligned (CCSDS)");
 
@@ -238,7 +253,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      _tail[6];      // 122-127: Final Alignment
 } PacketD_t;
 
-static_assert(sizeof(PacketD_t) == SIZE_PACKET_D, "PacketD_t size mismatch");
+static_assert(sizeof(PacketD_t) == kSizePacketD, "PacketD_t size mismatch");
 static_assert(sizeof(PacketD_t) % 4 == 0, "PacketD_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(PacketD_t) % 8 == 0, "PacketD_t not 64-bit word aligned (CCSDS)");
 static_assert(offsetof(PacketD_t, magic) == sizeof(VoidHeader_t),
@@ -272,11 +287,13 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 30-33: Checksum (4-aligned ✅)
 } HeartbeatPacket_t;
 
-static_assert(sizeof(HeartbeatPacket_t) == SIZE_HEARTBEAT_PCK, "HeartbeatPacket_t size mismatch");
+static_assert(sizeof(HeartbeatPacket_t) == kSizeHeartbeat, "HeartbeatPacket_t size mismatch");
 static_assert(sizeof(HeartbeatPacket_t) % 4 == 0, "HeartbeatPacket_t not 32-bit word aligned (CCSDS)");
 static_assert(sizeof(HeartbeatPacket_t) % 8 == 0, "HeartbeatPacket_t not 64-bit word aligned (CCSDS)");
 
 // Restore default alignment
 #pragma pack(pop)
 
-#endif // VOID_PACKETS_H
\ No newline at end of file
+}  // namespace ccsds
+
+#endif // VOID_CCSDS_PACKETS_H
\ No newline at end of file
@@ -14,7 +14,22 @@
 #define VOID_SNLP_PACKETS_H
 
 #include "void_types.h"
-#include "void_packets.h" // For size constants
+
+// Self-contained: every wire struct lives in namespace snlp so both
+// tiers can coexist in one translation unit (frame_dispatch::Codec).
+// void_packets.h re-exports the build tier's names at global scope.
+namespace snlp {
+
+// Frame sizes (SNLP / Community tier)
+static constexpr size_t kSizeHeader     =  14;  // SNLP Header (sync word + CCSDS primary + pad)
+static constexpr size_t kSizePacketA    =  80;  // Invoice
+static constexpr size_t kSizePacketB    = 192;  // Payment
+static constexpr size_t kSizePacketC    = 112;  // Receipt
+static constexpr size_t kSizePacketD    = 136;  // Delivery
+static constexpr size_t kSizePacketH    = 120;  // Handshake
+static constexpr size_t kSizePacketAck  = 136;  // Acknowledgement
+static constexpr size_t kSizeTunnelData =  96;  // Tunnel Data (PacketAck_t::enc_tunnel)
+static constexpr size_t kSizeHeartbeat  =  48;  // Heartbeat: 14 (Head) + 34 (Body)
 
 // Enforce 1-byte alignment for wire-format structures
 #pragma pack(push, 1)
@@ -37,7 +52,7 @@ typedef struct __attribute__((packed)) {
     uint32_t align_pad;        // Alignment Padding so all packetes are still optimised for 32/64-bit access
 } VoidHeader_t;
 
-static_assert(sizeof(VoidHeader_t) == SIZE_SNLP_HEADER, "VoidHeader_t SNLP size mismatch");
+static_assert(sizeof(VoidHeader_t) == kSizeHeader, "VoidHeader_t SNLP size mismatch");
 
 /* --------------------------------------------------------------------------
  * PHASE 1: HANDSHAKE (Packet H)
@@ -56,7 +71,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      signature[64];   // 56-119: Ed25519 Identity Sig
 } PacketH_t;
 
-static_assert(sizeof(PacketH_t) == SIZE_PACKET_H, "PacketH_t size mismatch");
+static_assert(sizeof(PacketH_t) == kSizePacketH, "PacketH_t size mismatch");
 static_assert(sizeof(PacketH_t) % 4 == 0, "PacketH_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(PacketH_t) % 8 == 0, "PacketH_t not 64-bit word aligned (SNLP)");
 
@@ -82,7 +97,7 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 76-79: Little-Endian (4-aligned ✅)
 } PacketA_t;
 
-static_assert(sizeof(PacketA_t) == SIZE_PACKET_A, "PacketA_t size mismatch");
+static_assert(sizeof(PacketA_t) == kSizePacketA, "PacketA_t size mismatch");
 static_assert(sizeof(PacketA_t) % 4 == 0, "PacketA_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(PacketA_t) % 8 == 0, "PacketA_t not 64-bit word aligned (SNLP)");
 
@@ -116,7 +131,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      _tail_pad[4]; // 188-191: Tail pad — frame total 192 (÷64 ✅ cache line)
 } PacketB_t;
 
-static_assert(sizeof(PacketB_t) == SIZE_PACKET_B, "PacketB_t size mismatch");
+static_assert(sizeof(PacketB_t) == kSizePacketB, "PacketB_t size mismatch");
 static_assert(sizeof(PacketB_t) % 4 == 0, "PacketB_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(PacketB_t) % 8 == 0, "PacketB_t not 64-bit word aligned (SNLP)");
 
@@ -152,7 +167,7 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 92-95: Little-Endian (Inner Checksum)
 } TunnelData_t;
 
-static_assert(sizeof(TunnelData_t) == SIZE_TUNNEL_DATA, "TunnelData_t size mismatch");
+static_assert(sizeof(TunnelData_t) == kSizeTunnelData, "TunnelData_t size mismatch");
 static_assert(sizeof(TunnelData_t) % 4 == 0, "TunnelData_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(TunnelData_t) % 8 == 0, "TunnelData_t not 64-bit word aligned (SNLP)");
 
@@ -182,7 +197,7 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 132-135: Outer Checksum
 } PacketAck_t;
 
-static_assert(sizeof(PacketAck_t) == SIZE_PACKET_ACK, "PacketAck_t size mismatch");
+static_assert(sizeof(PacketAck_t) == kSizePacketAck, "PacketAck_t size mismatch");
 static_assert(sizeof(PacketAck_t) % 4 == 0, "PacketAck_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(PacketAck_t) % 8 == 0, "PacketAck_t not 64-bit word aligned (SNLP)");
 static_assert(offsetof(PacketAck_t, magic) == sizeof(VoidHeader_t),
@@ -210,7 +225,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      _tail_pad[4];  // 108-111: Final Alignment
 } PacketC_t;
 
-static_assert(sizeof(PacketC_t) == SIZE_PACKET_C, "PacketC_t size mismatch");
+static_assert(sizeof(PacketC_t) == kSizePacketC, "PacketC_t size mismatch");
 static_assert(sizeof(PacketC_t) % 4 == 0, "PacketC_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(PacketC_t) % 8 == 0, "PacketC_t not 64-bit word aligned (SNLP)");
 
@@ -235,7 +250,7 @@ typedef struct __attribute__((packed)) {
     uint8_t      _tail[6];      // 130-135: Final Alignment
 } PacketD_t;
 
-static_assert(sizeof(PacketD_t) == SIZE_PACKET_D, "PacketD_t size mismatch");
+static_assert(sizeof(PacketD_t) == kSizePacketD, "PacketD_t size mismatch");
 static_assert(sizeof(PacketD_t) % 4 == 0, "PacketD_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(PacketD_t) % 8 == 0, "PacketD_t not 64-bit word aligned (SNLP)");
 static_assert(offsetof(PacketD_t, magic) == sizeof(VoidHeader_t),
@@ -270,11 +285,13 @@ typedef struct __attribute__((packed)) {
     uint32_t     crc32;         // 44-47: Checksum (4-aligned ✅)
 } HeartbeatPacket_t;
 
-static_assert(sizeof(HeartbeatPacket_t) == SIZE_HEARTBEAT_PCK, "HeartbeatPacket_t size mismatch");
+static_assert(sizeof(HeartbeatPacket_t) == kSizeHeartbeat, "HeartbeatPacket_t size mismatch");
 static_assert(sizeof(HeartbeatPacket_t) % 4 == 0, "HeartbeatPacket_t not 32-bit word aligned (SNLP)");
 static_assert(sizeof(HeartbeatPacket_t) % 8 == 0, "HeartbeatPacket_t not 64-bit word aligned (SNLP)");
 
 // Restore default alignment
 #pragma pack(pop)
 
+}  // namespace snlp
+
 #endif // VOID_SNLP_PACKETS_H
\ No newline at end of file
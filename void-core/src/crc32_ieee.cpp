@@ -0,0 +1,350 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      crc32_ieee.cpp
+ * Desc:      Shared IEEE 802.3 CRC-32 engine (runtime-dispatched).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------
+ * Every engine below works on the RAW register (pre-inverted, no final
+ * XOR); compute()/update() own the 0xFFFFFFFF pre/post conditioning so
+ * the engines can be chained on arbitrary split points.
+ *
+ * No heap. Tables are constexpr-generated into .rodata (flash on the
+ * ESP32) — nothing is built at runtime.
+ * -------------------------------------------------------------------------*/
+
+#include "crc32_ieee.h"
+
+#include <cstring>
+
+// --- Engine availability (compile-time) ---
+// ESP32 / Arduino builds stay table-free unless explicitly opted in via
+// -D VOID_CRC32_SLICE8: the Xtensa core has no CRC instructions, and a
+// 200-byte LoRa frame doesn't repay an 8 KiB table.
+#if (defined(ARDUINO) || defined(ESP_PLATFORM)) && !defined(VOID_CRC32_SLICE8)
+    #define VOID_CRC32_BIT_SERIAL_ONLY 1
+#endif
+
+#if !defined(VOID_CRC32_BIT_SERIAL_ONLY) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+    #define VOID_CRC32_HAVE_PCLMUL 1
+    #include <immintrin.h>
+#endif
+
+#if !defined(VOID_CRC32_BIT_SERIAL_ONLY) && defined(__GNUC__) && \
+    defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+    #define VOID_CRC32_HAVE_ARMV8 1
+    #include <arm_acle.h>
+    #if defined(__linux__)
+        #include <sys/auxv.h>
+        #include <asm/hwcap.h>
+    #endif
+#endif
+
+namespace crc32_ieee {
+namespace {
+
+constexpr uint32_t kPoly = 0xEDB88320u; // reflected 0x04C11DB7
+
+using RawFn = uint32_t (*)(uint32_t reg, const uint8_t* p, size_t len);
+
+// --- Bit-serial (always compiled) ---
+// The original firmware/bouncer loop, branch-free: the mask trick turns
+// the low-bit test into an AND so Xtensa doesn't stall on a branch.
+uint32_t RawBitSerial(uint32_t reg, const uint8_t* p, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        reg ^= p[i];
+        for (int b = 0; b < 8; ++b) {
+            const uint32_t mask = static_cast<uint32_t>(
+                -static_cast<int32_t>(reg & 1u));
+            reg = (reg >> 1) ^ (kPoly & mask);
+        }
+    }
+    return reg;
+}
+
+#ifndef VOID_CRC32_BIT_SERIAL_ONLY
+// --- Slicing-by-8 ---
+// t[0] is the classic Sarwate byte table; t[k][i] advances t[k-1][i]
+// through one more zero byte, so eight lookups consume eight input
+// bytes per iteration with no loop-carried dependency between them.
+struct SliceTables {
+    uint32_t t[8][256];
+};
+
+constexpr SliceTables MakeSliceTables() {
+    SliceTables s{};
+    for (uint32_t i = 0; i < 256u; ++i) {
+        uint32_t c = i;
+        for (int b = 0; b < 8; ++b) {
+            c = (c & 1u) ? ((c >> 1) ^ kPoly) : (c >> 1);
+        }
+        s.t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256u; ++i) {
+        for (int k = 1; k < 8; ++k) {
+            const uint32_t prev = s.t[k - 1][i];
+            s.t[k][i] = (prev >> 8) ^ s.t[0][prev & 0xFFu];
+        }
+    }
+    return s;
+}
+
+constexpr SliceTables kTables = MakeSliceTables();
+
+// Little-endian u32 load by explicit shifts — endian-safe and
+// alignment-safe; GCC/Clang fold it into one load on LE hosts.
+inline uint32_t LoadLE32(const uint8_t* p) {
+    return  static_cast<uint32_t>(p[0])
+         | (static_cast<uint32_t>(p[1]) <<  8)
+         | (static_cast<uint32_t>(p[2]) << 16)
+         | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint32_t RawSlice8(uint32_t reg, const uint8_t* p, size_t len) {
+    const auto& t = kTables.t;
+    while (len >= 8u) {
+        const uint32_t one = reg ^ LoadLE32(p);
+        const uint32_t two = LoadLE32(p + 4);
+        reg = t[7][one & 0xFFu]         ^ t[6][(one >> 8) & 0xFFu]
+            ^ t[5][(one >> 16) & 0xFFu] ^ t[4][one >> 24]
+            ^ t[3][two & 0xFFu]         ^ t[2][(two >> 8) & 0xFFu]
+            ^ t[1][(two >> 16) & 0xFFu] ^ t[0][two >> 24];
+        p   += 8;
+        len -= 8u;
+    }
+    while (len-- > 0u) {
+        reg = (reg >> 8) ^ t[0][(reg ^ *p++) & 0xFFu];
+    }
+    return reg;
+}
+#endif // !VOID_CRC32_BIT_SERIAL_ONLY
+
+#ifdef VOID_CRC32_HAVE_PCLMUL
+// --- x86 PCLMULQDQ folding ---
+// Gopal et al., "Fast CRC Computation for Generic Polynomials Using
+// PCLMULQDQ Instruction" (Intel, 2009), bit-reflected constants for
+// 0xEDB88320. Four 128-bit lanes are folded 64 bytes at a time, then
+// collapsed to 128 → 64 bits and Barrett-reduced to 32. Compiled with a
+// per-function target attribute so the TU itself needs no -m flags and
+// still runs on hosts without PCLMUL (the dispatcher never calls it).
+constexpr size_t kPclmulMinLen = 64;
+
+alignas(16) const uint64_t kK1K2[2] = { 0x0154442bd4ull, 0x01c6e41596ull };
+alignas(16) const uint64_t kK3K4[2] = { 0x01751997d0ull, 0x00ccaa009eull };
+alignas(16) const uint64_t kK5K0[2] = { 0x0163cd6124ull, 0x0000000000ull };
+alignas(16) const uint64_t kPoly2[2] = { 0x01db710641ull, 0x01f7011641ull };
+
+inline __attribute__((target("pclmul,sse4.1")))
+__m128i Load128(const uint8_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline __attribute__((target("pclmul,sse4.1")))
+__m128i Fold(__m128i acc, __m128i k, __m128i next) {
+    const __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+}
+
+// Requires len >= kPclmulMinLen; consumes the largest multiple of 16
+// and hands the remainder to slicing-by-8.
+__attribute__((target("pclmul,sse4.1")))
+uint32_t RawPclmulBlocks(uint32_t reg, const uint8_t* p, size_t len) {
+    __m128i x1 = Load128(p + 0x00);
+    __m128i x2 = Load128(p + 0x10);
+    __m128i x3 = Load128(p + 0x20);
+    __m128i x4 = Load128(p + 0x30);
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(reg)));
+
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(kK1K2));
+    p   += 64;
+    len -= 64u;
+
+    // Parallel fold, 64 bytes per iteration.
+    while (len >= 64u) {
+        x1 = Fold(x1, k, Load128(p + 0x00));
+        x2 = Fold(x2, k, Load128(p + 0x10));
+        x3 = Fold(x3, k, Load128(p + 0x20));
+        x4 = Fold(x4, k, Load128(p + 0x30));
+        p   += 64;
+        len -= 64u;
+    }
+
+    // Collapse the four lanes into one.
+    k  = _mm_load_si128(reinterpret_cast<const __m128i*>(kK3K4));
+    x1 = Fold(x1, k, x2);
+    x1 = Fold(x1, k, x3);
+    x1 = Fold(x1, k, x4);
+
+    // Single-lane fold, 16 bytes per iteration.
+    while (len >= 16u) {
+        x1 = Fold(x1, k, Load128(p));
+        p   += 16;
+        len -= 16u;
+    }
+
+    // 128 → 64 bits.
+    const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    __m128i x2r = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2r);
+
+    k   = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(kK5K0));
+    x2r = _mm_srli_si128(x1, 4);
+    x1  = _mm_and_si128(x1, mask32);
+    x1  = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1  = _mm_xor_si128(x1, x2r);
+
+    // Barrett reduction 64 → 32 bits.
+    k   = _mm_load_si128(reinterpret_cast<const __m128i*>(kPoly2));
+    x2r = _mm_and_si128(x1, mask32);
+    x2r = _mm_clmulepi64_si128(x2r, k, 0x10);
+    x2r = _mm_and_si128(x2r, mask32);
+    x2r = _mm_clmulepi64_si128(x2r, k, 0x00);
+    x1  = _mm_xor_si128(x1, x2r);
+
+    reg = static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+    return RawSlice8(reg, p, len);
+}
+
+uint32_t RawPclmul(uint32_t reg, const uint8_t* p, size_t len) {
+    if (len < kPclmulMinLen) return RawSlice8(reg, p, len);
+    return RawPclmulBlocks(reg, p, len);
+}
+
+bool CpuHasPclmul() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul") &&
+           __builtin_cpu_supports("sse4.1");
+}
+#endif // VOID_CRC32_HAVE_PCLMUL
+
+#ifdef VOID_CRC32_HAVE_ARMV8
+// --- AArch64 CRC32 extension ---
+// CRC32X/CRC32B implement exactly the reflected 0x04C11DB7 register
+// update, so no post-processing is needed.
+#if defined(__clang__)
+    #define VOID_CRC32_ARM_TARGET __attribute__((target("crc")))
+#else
+    #define VOID_CRC32_ARM_TARGET __attribute__((target("+crc")))
+#endif
+
+VOID_CRC32_ARM_TARGET
+uint32_t RawArmv8(uint32_t reg, const uint8_t* p, size_t len) {
+    while (len >= 8u) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v)); // alignment-safe load
+        reg = __crc32d(reg, v);
+        p   += 8;
+        len -= 8u;
+    }
+    while (len-- > 0u) {
+        reg = __crc32b(reg, *p++);
+    }
+    return reg;
+}
+
+bool CpuHasArmv8Crc() {
+#if defined(__APPLE__)
+    return true; // every Apple AArch64 core implements FEAT_CRC32
+#else
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0u;
+#endif
+}
+#endif // VOID_CRC32_HAVE_ARMV8
+
+RawFn RawFor(Engine e) {
+    switch (e) {
+#ifdef VOID_CRC32_HAVE_PCLMUL
+        case Engine::kPclmul:    return RawPclmul;
+#endif
+#ifdef VOID_CRC32_HAVE_ARMV8
+        case Engine::kArmv8:     return RawArmv8;
+#endif
+#ifndef VOID_CRC32_BIT_SERIAL_ONLY
+        case Engine::kSlice8:    return RawSlice8;
+#endif
+        default:                 return RawBitSerial;
+    }
+}
+
+Engine SelectEngine() {
+#ifdef VOID_CRC32_HAVE_PCLMUL
+    if (CpuHasPclmul()) return Engine::kPclmul;
+#endif
+#ifdef VOID_CRC32_HAVE_ARMV8
+    if (CpuHasArmv8Crc()) return Engine::kArmv8;
+#endif
+#ifndef VOID_CRC32_BIT_SERIAL_ONLY
+    return Engine::kSlice8;
+#else
+    return Engine::kBitSerial;
+#endif
+}
+
+// Resolved once; C++11 guarantees thread-safe static-local init, so
+// concurrent first calls from bouncer threads are fine.
+struct Dispatch {
+    Engine engine;
+    RawFn  fn;
+};
+
+const Dispatch& GetDispatch() {
+    static const Dispatch d = []() {
+        const Engine e = SelectEngine();
+        return Dispatch{e, RawFor(e)};
+    }();
+    return d;
+}
+
+}  // namespace
+
+uint32_t compute(const uint8_t* data, size_t len) {
+    return update(0u, data, len);
+}
+
+uint32_t update(uint32_t crc, const uint8_t* data, size_t len) {
+    if (data == nullptr || len == 0u) return crc;
+    return ~GetDispatch().fn(~crc, data, len);
+}
+
+Engine active_engine() {
+    return GetDispatch().engine;
+}
+
+bool engine_available(Engine e) {
+    switch (e) {
+        case Engine::kBitSerial: return true;
+#ifndef VOID_CRC32_BIT_SERIAL_ONLY
+        case Engine::kSlice8:    return true;
+#endif
+#ifdef VOID_CRC32_HAVE_PCLMUL
+        case Engine::kPclmul:    return CpuHasPclmul();
+#endif
+#ifdef VOID_CRC32_HAVE_ARMV8
+        case Engine::kArmv8:     return CpuHasArmv8Crc();
+#endif
+        default:                 return false;
+    }
+}
+
+uint32_t compute_with(Engine e, const uint8_t* data, size_t len) {
+    if (data == nullptr || len == 0u) return 0u;
+    const RawFn fn = engine_available(e) ? RawFor(e) : RawBitSerial;
+    return ~fn(0xFFFFFFFFu, data, len);
+}
+
+const char* engine_name(Engine e) {
+    switch (e) {
+        case Engine::kBitSerial: return "bit-serial";
+        case Engine::kSlice8:    return "slice8";
+        case Engine::kPclmul:    return "pclmul";
+        case Engine::kArmv8:     return "armv8-crc";
+    }
+    return "unknown";
+}
+
+}  // namespace crc32_ieee
@@ -0,0 +1,220 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      frame_dispatch.cpp
+ * Desc:      Per-tier header codec + body-length/magic routing.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "frame_dispatch.h"
+
+namespace frame_dispatch {
+namespace {
+
+constexpr uint32_t kSnlpSyncWord = 0x1D01A5A5u; // VOID-113
+constexpr uint16_t kIdleApid     = 0x07FFu;
+constexpr uint8_t  kNoMagic      = 0x00u;
+constexpr uint16_t kSecHdrFlag   = 0x0800u;
+constexpr uint16_t kTypeCmdFlag  = 0x1000u;
+constexpr uint16_t kSeqUnsegmented = 0xC000u;
+
+struct Route {
+    FrameKind kind;
+    size_t    frame_size;
+    uint8_t   magic;  // body offset 0 discriminant, kNoMagic if none
+};
+
+uint16_t LoadBE16(const uint8_t* p) {
+    return static_cast<uint16_t>((static_cast<uint16_t>(p[0]) << 8) | p[1]);
+}
+
+uint32_t LoadBE32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24)
+         | (static_cast<uint32_t>(p[1]) << 16)
+         | (static_cast<uint32_t>(p[2]) <<  8)
+         |  static_cast<uint32_t>(p[3]);
+}
+
+void StoreBE16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v >> 8);
+    p[1] = static_cast<uint8_t>(v & 0xFFu);
+}
+
+}  // namespace
+
+template <Tier T>
+Status Codec<T>::classify(const uint8_t* buf, size_t len, FrameInfo* out) {
+    using H = typename Traits::Header;
+    constexpr size_t kIdOff   = offsetof(H, ver_type_sec);
+    constexpr size_t kSeqOff  = offsetof(H, seq_flags);
+    constexpr size_t kPlenOff = offsetof(H, packet_len);
+
+    // Mirrors the gateway Kaitai root switch on body length. Entries that
+    // share a body length (SNLP D/ACK at 122) are told apart by magic.
+    static constexpr Route kRoutes[] = {
+        {FrameKind::kH,   sizeof(typename Traits::PacketH),   kNoMagic},
+        {FrameKind::kA,   sizeof(typename Traits::PacketA),   kNoMagic},
+        {FrameKind::kB,   sizeof(typename Traits::PacketB),   kNoMagic},
+        {FrameKind::kC,   sizeof(typename Traits::PacketC),   kNoMagic},
+        {FrameKind::kD,   sizeof(typename Traits::PacketD),   snlp::PACKET_D_MAGIC},
+        {FrameKind::kAck, sizeof(typename Traits::PacketAck), snlp::PACKET_ACK_MAGIC},
+        {FrameKind::kL,   sizeof(typename Traits::Heartbeat), kNoMagic},
+    };
+
+    if (buf == nullptr || len < kHeaderSize) return Status::kTooShort;
+
+    if (Traits::kHasSyncWord && LoadBE32(buf) != kSnlpSyncWord) {
+        return Status::kBadSync;
+    }
+
+    if ((buf[kIdOff] & CCSDS_VER_MASK) != 0) return Status::kBadVersion;
+
+    const uint16_t apid = static_cast<uint16_t>(LoadBE16(buf + kIdOff) & CCSDS_APID_MASK);
+    if (apid == kIdleApid) return Status::kIdleApid;
+
+    const size_t body_len = static_cast<size_t>(LoadBE16(buf + kPlenOff)) + 1u;
+    if (len - kHeaderSize != body_len) return Status::kLengthMismatch;
+
+    FrameKind kind = FrameKind::kUnknown;
+    bool length_known = false;
+    for (const Route& r : kRoutes) {
+        if (r.frame_size != len) continue;
+        length_known = true;
+        if (r.magic == kNoMagic || buf[kHeaderSize] == r.magic) {
+            kind = r.kind;
+            break;
+        }
+    }
+    if (!length_known) return Status::kUnknownLength;
+    if (kind == FrameKind::kUnknown) return Status::kBadMagic;
+
+    if (out != nullptr) {
+        out->tier       = T;
+        out->kind       = kind;
+        out->apid       = apid;
+        out->is_command = (buf[kIdOff] & CCSDS_TYPE_MASK) != 0;
+        out->seq_count  = static_cast<uint16_t>(LoadBE16(buf + kSeqOff) & 0x3FFFu);
+        out->body_len   = static_cast<uint16_t>(body_len);
+    }
+    return Status::kOk;
+}
+
+template <Tier T>
+bool Codec<T>::write_header(uint8_t* out, size_t out_cap, uint16_t apid,
+                            bool is_command, uint16_t seq_count, size_t frame_len) {
+    using H = typename Traits::Header;
+    if (out == nullptr || out_cap < kHeaderSize) return false;
+    if (frame_len <= kHeaderSize || frame_len - kHeaderSize > 0x10000u) return false;
+
+    if (Traits::kHasSyncWord) {
+        out[0] = 0x1Du; out[1] = 0x01u; out[2] = 0xA5u; out[3] = 0xA5u;
+    }
+    const uint16_t id = static_cast<uint16_t>(kSecHdrFlag
+                                              | (is_command ? kTypeCmdFlag : 0u)
+                                              | (apid & CCSDS_APID_MASK));
+    StoreBE16(out + offsetof(H, ver_type_sec), id);
+    StoreBE16(out + offsetof(H, seq_flags),
+              static_cast<uint16_t>(kSeqUnsegmented | (seq_count & 0x3FFFu)));
+    StoreBE16(out + offsetof(H, packet_len),
+              static_cast<uint16_t>(frame_len - kHeaderSize - 1u));
+    for (size_t i = offsetof(H, packet_len) + 2u; i < kHeaderSize; ++i) {
+        out[i] = 0u; // SNLP align_pad
+    }
+    return true;
+}
+
+template class Codec<Tier::kSnlp>;
+template class Codec<Tier::kCcsds>;
+
+Tier detect_tier(const uint8_t* buf, size_t len) {
+    if (buf != nullptr && len >= 4u && LoadBE32(buf) == kSnlpSyncWord) {
+        return Tier::kSnlp;
+    }
+    return Tier::kCcsds;
+}
+
+Status classify(const uint8_t* buf, size_t len, FrameInfo* out) {
+    return (detect_tier(buf, len) == Tier::kSnlp)
+               ? Codec<Tier::kSnlp>::classify(buf, len, out)
+               : Codec<Tier::kCcsds>::classify(buf, len, out);
+}
+
+constexpr uint16_t Dispatcher::kAnyApid;
+
+Dispatcher::Dispatcher() {
+    for (size_t t = 0; t < kTierCount; ++t) {
+        for (Entry& e : _table[t]) {
+            e.thunk = nullptr;
+            e.fn    = nullptr;
+            e.user  = nullptr;
+            e.apid  = kAnyApid;
+        }
+    }
+}
+
+void Dispatcher::off(Tier tier, FrameKind kind) {
+    Entry& e = _table[TierIndex(tier)][static_cast<size_t>(kind)];
+    e.thunk = nullptr;
+    e.fn    = nullptr;
+    e.user  = nullptr;
+    e.apid  = kAnyApid;
+}
+
+Status Dispatcher::dispatch(const uint8_t* buf, size_t len) const {
+    return (detect_tier(buf, len) == Tier::kSnlp)
+               ? dispatch_as<Tier::kSnlp>(buf, len)
+               : dispatch_as<Tier::kCcsds>(buf, len);
+}
+
+Status Dispatcher::deliver(const uint8_t* buf, const FrameInfo& info) const {
+    const Entry& e = _table[TierIndex(info.tier)][static_cast<size_t>(info.kind)];
+    if (e.thunk == nullptr) return Status::kNoHandler;
+    if (e.apid != kAnyApid && e.apid != info.apid) return Status::kApidFiltered;
+
+    e.thunk(e, buf, info);
+    return Status::kOk;
+}
+
+const char* tier_name(Tier t) {
+    switch (t) {
+        case Tier::kCcsds: return "ccsds";
+        case Tier::kSnlp:  return "snlp";
+    }
+    return "unknown";
+}
+
+const char* kind_name(FrameKind k) {
+    switch (k) {
+        case FrameKind::kUnknown: return "unknown";
+        case FrameKind::kH:       return "H";
+        case FrameKind::kA:       return "A";
+        case FrameKind::kB:       return "B";
+        case FrameKind::kC:       return "C";
+        case FrameKind::kD:       return "D";
+        case FrameKind::kAck:     return "ACK";
+        case FrameKind::kL:       return "L";
+    }
+    return "unknown";
+}
+
+const char* status_name(Status s) {
+    switch (s) {
+        case Status::kOk:             return "ok";
+        case Status::kTooShort:       return "too-short";
+        case Status::kBadSync:        return "bad-sync";
+        case Status::kBadVersion:     return "bad-version";
+        case Status::kIdleApid:       return "idle-apid";
+        case Status::kLengthMismatch: return "length-mismatch";
+        case Status::kUnknownLength:  return "unknown-length";
+        case Status::kBadMagic:       return "bad-magic";
+        case Status::kWrongKind:      return "wrong-kind";
+        case Status::kApidFiltered:   return "apid-filtered";
+        case Status::kNoHandler:      return "no-handler";
+    }
+    return "unknown";
+}
+
+}  // namespace frame_dispatch
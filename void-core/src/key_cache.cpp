@@ -0,0 +1,71 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      key_cache.cpp
+ * Desc:      Ephemeral X25519 keypair ring (see key_cache.h).
+ * Compliant: NSA Clean C++ (RAII, No-Heap, Forward Secrecy).
+ * -------------------------------------------------------------------------*/
+
+#include "key_cache.h"
+
+#include <sodium.h>
+#include <cstring>
+
+namespace key_cache {
+
+KeyCache::KeyCache()
+    : head_(0), tail_(0), generated_(0), taken_(0), misses_(0), wiped_(0) {
+    std::memset(slots_, 0, sizeof(slots_));
+}
+
+KeyCache::~KeyCache() { sodium_memzero(slots_, sizeof(slots_)); }
+
+bool KeyCache::refill_one() {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) == kSlots) return false;
+    Keypair& slot = slots_[head & (kSlots - 1)];
+    crypto_box_keypair(slot.pub, slot.priv);
+    head_.store(head + 1, std::memory_order_release);
+    generated_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void KeyCache::take(Keypair& out) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+        crypto_box_keypair(out.pub, out.priv);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Keypair& slot = slots_[tail & (kSlots - 1)];
+    std::memcpy(&out, &slot, sizeof(out));
+    sodium_memzero(slot.priv, sizeof(slot.priv));
+    tail_.store(tail + 1, std::memory_order_release);
+    taken_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t KeyCache::wipe() {
+    uint32_t       tail = tail_.load(std::memory_order_relaxed);
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    size_t dropped = 0;
+    for (; tail != head; ++tail, ++dropped) {
+        sodium_memzero(&slots_[tail & (kSlots - 1)], sizeof(Keypair));
+    }
+    tail_.store(tail, std::memory_order_release);
+    wiped_.fetch_add(static_cast<uint32_t>(dropped), std::memory_order_relaxed);
+    return dropped;
+}
+
+Stats KeyCache::stats() const {
+    Stats s;
+    s.generated = generated_.load(std::memory_order_relaxed);
+    s.taken     = taken_.load(std::memory_order_relaxed);
+    s.misses    = misses_.load(std::memory_order_relaxed);
+    s.wiped     = wiped_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace key_cache
@@ -13,6 +13,8 @@
 
 #include <cstring>
 
+#include "crc32_ieee.h"
+
 namespace packet_d_builder {
 namespace {
 
@@ -58,24 +60,6 @@ void WriteU32BE(uint8_t* dst, size_t& off, uint32_t v) {
     dst[off++] = static_cast<uint8_t>(v & 0xFFu);
 }
 
-// Table-free IEEE-802.3 CRC-32 — byte-identical to Go's
-// hash/crc32.ChecksumIEEE. Same helper is embedded in
-// ground-station/src/ack_builder.cpp and in void-core/test/
-// test_sign_verify.cpp; we keep a third copy here so void-core's
-// runtime library stays standalone (no cross-module link).
-uint32_t Crc32Ieee(const uint8_t* data, size_t len) {
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < len; ++i) {
-        crc ^= data[i];
-        for (int b = 0; b < 8; ++b) {
-            const uint32_t mask = static_cast<uint32_t>(
-                -static_cast<int32_t>(crc & 1u));
-            crc = (crc >> 1) ^ (0xEDB88320u & mask);
-        }
-    }
-    return ~crc;
-}
-
 }  // namespace
 
 bool build(const DeliveryInputs& in, uint8_t* out, size_t out_cap) {
@@ -100,7 +84,7 @@ bool build(const DeliveryInputs& in, uint8_t* out, size_t out_cap) {
     off += kPayloadSize;
 
     // --- CRC32 over everything written so far (header + body-ex-CRC-ex-tail) ---
-    const uint32_t crc = Crc32Ieee(out, off);
+    const uint32_t crc = crc32_ieee::compute(out, off);
     WriteU32LE(out, off, crc);                                      // 126-129
 
     // --- 6-byte tail pad (already zeroed by the memset, but advance the
@@ -0,0 +1,350 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      security_context.cpp
+ * Desc:      Identity / Session / SessionStore (see security_context.h).
+ *            VOID-127: When VOID_ALPHA_PLAINTEXT is defined, PacketB
+ *            encryption is bypassed — enc_payload carries cleartext.
+ * Compliant: NSA Clean C++ (RAII, No-Heap, Forward Secrecy).
+ * -------------------------------------------------------------------------*/
+
+#include "security_context.h"
+
+#include <sodium.h>
+#include <cstddef>
+#include <cstring>
+
+#include "frame_dispatch.h"
+
+namespace security_context {
+
+// ---------------------------------------------------------------------------
+// Identity
+// ---------------------------------------------------------------------------
+Identity::Identity() : ready_(false) {
+    std::memset(pub_, 0, sizeof(pub_));
+    std::memset(priv_, 0, sizeof(priv_));
+}
+
+Identity::~Identity() { sodium_memzero(priv_, sizeof(priv_)); }
+
+bool Identity::init_from_seed(const uint8_t seed[kSeedSize]) {
+    // Idempotent and thread-safe; makes libsodium safe to share.
+    if (sodium_init() < 0) return false;
+    crypto_sign_seed_keypair(pub_, priv_, seed);
+    ready_ = true;
+    return true;
+}
+
+bool Identity::sign(const uint8_t* data, size_t len, uint8_t sig_out[kSignatureSize]) const {
+    if (!ready_) return false;
+    unsigned long long sig_len = 0;
+    crypto_sign_detached(sig_out, &sig_len, data, len, priv_);
+    return sig_len == kSignatureSize;
+}
+
+// ---------------------------------------------------------------------------
+// Session
+// ---------------------------------------------------------------------------
+void wipe(Session& s) {
+    sodium_memzero(s.key, sizeof(s.key));
+    sodium_memzero(s.eph_priv, sizeof(s.eph_priv));
+    s.state = SESSION_IDLE;
+}
+
+// --- PHASE 2: HANDSHAKE (Sat B -> Ground) ---
+void begin_handshake(Session& s, const Identity& id, PacketH_t& pkt, uint16_t ttl_seconds,
+                     uint64_t now_ms) {
+    // 1. Generate Ephemeral X25519 Keypair (The "Throwaway" Keys)
+    uint8_t eph_pub[kPubKeySize], eph_priv[kPubKeySize];
+    crypto_box_keypair(eph_pub, eph_priv);
+    begin_handshake(s, id, eph_pub, eph_priv, pkt, ttl_seconds, now_ms);
+    sodium_memzero(eph_priv, sizeof(eph_priv));
+}
+
+void begin_handshake(Session& s, const Identity& id, const uint8_t eph_pub[kPubKeySize],
+                     const uint8_t eph_priv[kPubKeySize], PacketH_t& pkt, uint16_t ttl_seconds,
+                     uint64_t now_ms) {
+    // 1. Adopt the Ephemeral X25519 Keypair (The "Throwaway" Keys)
+    std::memcpy(s.eph_pub, eph_pub, kPubKeySize);
+    std::memcpy(s.eph_priv, eph_priv, kPubKeySize);
+
+    // 2. Set State
+    s.state    = SESSION_HANDSHAKE_INIT;
+    s.ttl_s    = ttl_seconds;
+    s.start_ms = now_ms;
+
+    // 3. Populate Packet Header: command, APID 0xB2 (Sat B),
+    // unsegmented, counter 0 (mock). The codec writes the tier's whole
+    // header, SNLP sync word included, so the ground can route it.
+    frame_dispatch::Codec<frame_dispatch::FrameTraits<PacketH_t>::kTier>::write_header(
+        reinterpret_cast<uint8_t*>(&pkt.header), sizeof(pkt.header), 0xB2u, true, 0u,
+        sizeof(PacketH_t));
+
+    // 4. Fill Data
+    pkt.session_ttl = ttl_seconds;
+    pkt.timestamp = now_ms; // Demo: Use millis. Prod: Use GPS Epoch.
+    std::memcpy(pkt.eph_pub_key, s.eph_pub, kPubKeySize);
+
+    // 5. SIGNATURE (Identity binds the Ephemeral Key)
+    // Header + TTL + TS + PubKey: bytes 0-47 on CCSDS, 0-55 on SNLP.
+    if (!id.sign(reinterpret_cast<const uint8_t*>(&pkt), offsetof(PacketH_t, signature),
+                 pkt.signature)) {
+        // Embedded fail-stop: never transmit an unsigned handshake.
+        while (1) {}
+    }
+}
+
+// --- PHASE 2: RESPONSE (Ground -> Sat B) ---
+bool complete_handshake(Session& s, const uint8_t peer_eph_pub[kPubKeySize]) {
+    // DERIVE SESSION KEY (ECDH): own ephemeral private + peer public.
+    if (crypto_scalarmult(s.key, s.eph_priv, peer_eph_pub) != 0) {
+        return false; // Math failed (e.g. weak point)
+    }
+    // Hash the raw ECDH output to get a clean ChaCha20 key (BLAKE2b).
+    crypto_generichash(s.key, kSessionKeySize, s.key, kSessionKeySize, NULL, 0);
+
+    // CLEANUP (Forward Secrecy): destroy the ephemeral private key.
+    sodium_memzero(s.eph_priv, sizeof(s.eph_priv));
+
+    s.state = SESSION_ACTIVE;
+    return true;
+}
+
+void activate(Session& s, const uint8_t key[kSessionKeySize], uint16_t ttl_seconds,
+              uint64_t now_ms) {
+    std::memcpy(s.key, key, kSessionKeySize);
+    sodium_memzero(s.eph_priv, sizeof(s.eph_priv));
+    s.ttl_s    = ttl_seconds;
+    s.start_ms = now_ms;
+    s.state    = SESSION_ACTIVE;
+}
+
+bool is_active(Session& s, uint64_t now_ms) {
+    if (s.state != SESSION_ACTIVE) return false;
+    if ((now_ms - s.start_ms) > static_cast<uint64_t>(s.ttl_s) * 1000u) {
+        wipe(s); // Time's up!
+        return false;
+    }
+    return true;
+}
+
+void chacha20_xor(const uint8_t key[kSessionKeySize], uint32_t sat_id, uint64_t epoch_ts,
+                  const uint8_t* in, size_t len, uint8_t* out) {
+    // VOID-110 nonce: sat_id[4] || epoch_ts[8], both little-endian.
+    uint8_t nonce[12];
+    std::memcpy(nonce,     &sat_id,   4);
+    std::memcpy(nonce + 4, &epoch_ts, 8);
+    crypto_stream_chacha20_ietf_xor(out, in, len, nonce, key);
+    sodium_memzero(nonce, sizeof(nonce));
+}
+
+// --- PHASE 3: ENCRYPT PACKET B (Payment) ---
+// See SecurityManager::encryptPacketB and Protocol-spec-CCSDS.md §3
+// "Nonce Derivation" for why the nonce needs no randomness.
+bool encrypt_packet_b(Session& s, const Identity& id, PacketB_t& pkt,
+                      const uint8_t* payload_in, size_t len, bool gps_time_valid) {
+    if (len > sizeof(pkt.enc_payload)) return false;
+
+#ifdef VOID_ALPHA_PLAINTEXT
+    // VOID-127: payload copied verbatim; the session, GPS-gate and
+    // monotonic-epoch guards exist only for ChaCha20 nonce uniqueness.
+    (void)s;
+    (void)gps_time_valid;
+    std::memcpy(pkt.enc_payload, payload_in, len);
+    if (len < sizeof(pkt.enc_payload)) {
+        std::memset(pkt.enc_payload + len, 0, sizeof(pkt.enc_payload) - len);
+    }
+#else
+    if (s.state != SESSION_ACTIVE) return false;
+    if (!gps_time_valid) return false;                    // GPS gate
+    if (pkt.epoch_ts <= s.last_tx_epoch_ms) return false; // monotonic guardrail
+
+    // The outer Ed25519 signature provides authenticity; no Poly1305.
+    chacha20_xor(s.key, pkt.sat_id, pkt.epoch_ts, payload_in, len, pkt.enc_payload);
+#endif
+
+    // VOID-111: sign header + body up to the signature field, in both
+    // plaintext and encrypted modes (CCSDS 104 bytes, SNLP 112 bytes).
+    if (!id.sign(reinterpret_cast<const uint8_t*>(&pkt), offsetof(PacketB_t, signature),
+                 pkt.signature)) {
+        while (1) {}
+    }
+
+#ifndef VOID_ALPHA_PLAINTEXT
+    s.last_tx_epoch_ms = pkt.epoch_ts;
+    // TODO(VOID-110): Persist last_tx_epoch_ms to NVS every N calls.
+#endif
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SessionStore
+// ---------------------------------------------------------------------------
+namespace {
+
+inline uint64_t mix(uint32_t sat_id) {
+    // Fibonacci hashing: the top bits pick the shard, the next its slot.
+    return static_cast<uint64_t>(sat_id) * 0x9E3779B97F4A7C15ull;
+}
+
+} // anonymous namespace
+
+SessionStore::SessionStore() {
+    for (size_t k = 0; k < kShards; ++k) {
+        shards_[k].count = 0;
+        std::memset(shards_[k].slots, 0, sizeof(shards_[k].slots));
+    }
+}
+
+SessionStore::~SessionStore() { clear(); }
+
+size_t SessionStore::shard_of(uint32_t sat_id) {
+    return static_cast<size_t>(mix(sat_id) >> 58);
+}
+
+size_t SessionStore::home(uint32_t sat_id) {
+    return static_cast<size_t>((mix(sat_id) >> 52) & (kShardSlots - 1));
+}
+
+// Slot holding `sat_id` in its shard, or the free slot where it would go.
+size_t SessionStore::probe(const Shard& sh, uint32_t sat_id) {
+    size_t i = home(sat_id);
+    while (sh.slots[i].used && sh.slots[i].sat_id != sat_id) i = (i + 1) & (kShardSlots - 1);
+    return i;
+}
+
+// Wipes slot i and shifts later members of its probe chain back, as in
+// ground_session::SessionTable, so lookups never need tombstones.
+void SessionStore::remove(Shard& sh, size_t i) {
+    wipe(sh.slots[i].session);
+    --sh.count;
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & (kShardSlots - 1);
+        if (!sh.slots[j].used) break;
+        const size_t k = home(sh.slots[j].sat_id);
+        const bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (!stays) {
+            sh.slots[i] = sh.slots[j];
+            i = j;
+        }
+    }
+    sodium_memzero(&sh.slots[i], sizeof(sh.slots[i]));
+}
+
+bool SessionStore::install(uint32_t sat_id, const uint8_t key[kSessionKeySize],
+                           uint16_t ttl_seconds, uint64_t now_ms) {
+    Shard& sh = shards_[shard_of(sat_id)];
+    std::lock_guard<std::mutex> guard(sh.lock);
+    const size_t i = probe(sh, sat_id);
+    Slot& slot = sh.slots[i];
+    if (!slot.used) {
+        if (sh.count >= kShardSessions) return false;
+        ++sh.count;
+        slot.used   = true;
+        slot.sat_id = sat_id;
+    }
+    slot.init_ts = 0;
+    activate(slot.session, key, ttl_seconds, now_ms);
+    return true;
+}
+
+SessionStore::Install SessionStore::install_handshake(uint32_t sat_id,
+                                                      const uint8_t key[kSessionKeySize],
+                                                      uint16_t ttl_seconds, uint64_t now_ms,
+                                                      uint64_t init_ts) {
+    Shard& sh = shards_[shard_of(sat_id)];
+    std::lock_guard<std::mutex> guard(sh.lock);
+    const size_t i = probe(sh, sat_id);
+    Slot& slot = sh.slots[i];
+    if (slot.used) {
+        if (slot.init_ts != 0 && init_ts <= slot.init_ts && is_active(slot.session, now_ms)) {
+            return Install::kNotNewer;
+        }
+    } else {
+        if (sh.count >= kShardSessions) return Install::kFull;
+        ++sh.count;
+        slot.used   = true;
+        slot.sat_id = sat_id;
+    }
+    slot.init_ts = init_ts;
+    activate(slot.session, key, ttl_seconds, now_ms);
+    return Install::kInstalled;
+}
+
+bool SessionStore::erase(uint32_t sat_id) {
+    Shard& sh = shards_[shard_of(sat_id)];
+    std::lock_guard<std::mutex> guard(sh.lock);
+    const size_t i = probe(sh, sat_id);
+    if (!sh.slots[i].used) return false;
+    remove(sh, i);
+    return true;
+}
+
+bool SessionStore::active(uint32_t sat_id, uint64_t now_ms) {
+    Shard& sh = shards_[shard_of(sat_id)];
+    std::lock_guard<std::mutex> guard(sh.lock);
+    const size_t i = probe(sh, sat_id);
+    if (!sh.slots[i].used) return false;
+    if (is_active(sh.slots[i].session, now_ms)) return true;
+    remove(sh, i);
+    return false;
+}
+
+bool SessionStore::crypt(uint32_t sat_id, uint64_t epoch_ts, const uint8_t* in, size_t len,
+                         uint8_t* out, uint64_t now_ms) {
+    Shard& sh = shards_[shard_of(sat_id)];
+    std::lock_guard<std::mutex> guard(sh.lock);
+    const size_t i = probe(sh, sat_id);
+    if (!sh.slots[i].used) return false;
+    if (!is_active(sh.slots[i].session, now_ms)) {
+        remove(sh, i);
+        return false;
+    }
+    // A ~100-byte ChaCha20 block under the shard lock is cheaper than
+    // copying the key out and wiping the copy.
+    chacha20_xor(sh.slots[i].session.key, sat_id, epoch_ts, in, len, out);
+    return true;
+}
+
+bool SessionStore::crypt_many(uint32_t sat_id, const CryptJob* jobs, size_t count,
+                              uint64_t now_ms) {
+    if (jobs == nullptr && count != 0) return false;
+    Shard& sh = shards_[shard_of(sat_id)];
+    std::lock_guard<std::mutex> guard(sh.lock);
+    const size_t i = probe(sh, sat_id);
+    if (!sh.slots[i].used) return false;
+    if (!is_active(sh.slots[i].session, now_ms)) {
+        remove(sh, i);
+        return false;
+    }
+    for (size_t j = 0; j < count; ++j) {
+        chacha20_xor(sh.slots[i].session.key, sat_id, jobs[j].epoch_ts,
+                     jobs[j].data, jobs[j].len, jobs[j].data);
+    }
+    return true;
+}
+
+size_t SessionStore::size() const {
+    size_t n = 0;
+    for (size_t k = 0; k < kShards; ++k) {
+        std::lock_guard<std::mutex> guard(shards_[k].lock);
+        n += shards_[k].count;
+    }
+    return n;
+}
+
+void SessionStore::clear() {
+    for (size_t k = 0; k < kShards; ++k) {
+        Shard& sh = shards_[k];
+        std::lock_guard<std::mutex> guard(sh.lock);
+        sodium_memzero(sh.slots, sizeof(sh.slots));
+        sh.count = 0;
+    }
+}
+
+} // namespace security_context
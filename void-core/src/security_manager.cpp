@@ -22,22 +22,20 @@
 
 SecurityManager Security;
 
-SecurityManager::SecurityManager()
-    : _state(SESSION_IDLE),
-      _session_start_ts(0),
-      _session_ttl(0),
-      _last_tx_epoch_ms(0),
-      _gps_time_valid(false) {}
+SecurityManager::SecurityManager() : _gps_time_valid(false) {
+    std::memset(&_session, 0, sizeof(_session));
+    _session.state = SESSION_IDLE;
+}
 
 
 bool SecurityManager::begin() {
     if (sodium_init() < 0) return false;
-    // TODO(VOID-110): Reload _last_tx_epoch_ms from NVS here.
+    // TODO(VOID-110): Reload _session.last_tx_epoch_ms from NVS here.
     //   e.g. Preferences prefs; prefs.begin("void", true);
-    //        _last_tx_epoch_ms = prefs.getULong64("last_epoch_ms", 0);
+    //        _session.last_tx_epoch_ms = prefs.getULong64("last_epoch_ms", 0);
     //        prefs.end();
     // The main loop is responsible for calling setGpsTimeValid(true) only
-    // once GPS time is fixed AND exceeds _last_tx_epoch_ms by a safety margin.
+    // once GPS time is fixed AND exceeds last_tx_epoch_ms by a safety margin.
 
     uint8_t seed[crypto_sign_SEEDBYTES];
 
@@ -72,80 +70,30 @@ bool SecurityManager::begin() {
     crypto_hash_sha256(seed, reinterpret_cast<const uint8_t*>(env_key), strlen(env_key));
 #endif
 
-    crypto_sign_seed_keypair(_identity_pub, _identity_priv, seed);
+    const bool ok = _identity.init_from_seed(seed);
     sodium_memzero(seed, sizeof(seed));
 
-    return true;
+    return ok;
 }
 
 
 
 // --- PHASE 2: HANDSHAKE (Sat B -> Ground) ---
 void SecurityManager::prepareHandshake(PacketH_t& pkt, uint16_t ttl_seconds, uint64_t current_time_ms) {
-    // 1. Generate Ephemeral X25519 Keypair (The "Throwaway" Keys)
-    crypto_box_keypair(_eph_pub, _eph_priv);
-
-    // 2. Set State
-    _state = SESSION_HANDSHAKE_INIT;
-    _session_ttl = ttl_seconds;
-    _session_start_ts = current_time_ms;
-
-    // 3. Populate Packet Header
-    pkt.header.ver_type_sec = 0x18; // Version 0, Type 1, Sec 1, APID (Upper)
-    pkt.header.apid_lo = 0xB2;      // APID: Sat B
-    pkt.header.seq_flags = 0xC0;    // Unsegmented (11)
-    pkt.header.seq_count_lo = 0x00; // Counter (Mock)
-
-    // Packet Length: Swap to Big-Endian
-    uint16_t raw_len = SIZE_PACKET_H - 1;
-    // pkt.header.packet_len = (raw_len >> 8) | (raw_len << 8);
-    /*
-    Integer Promotion: In C++, whenever you do bitwise math (<<, >>, |) on 
-    an 8-bit or 16-bit integer, the compiler automatically promotes it to a 32-bit int under the hood. When you try to save it back into a uint16_t, it throws a -Wconversion error because it thinks you might lose data. 
-    We fix this by wrapping the math in a static_cast<uint16_t>(...).*/
-    pkt.header.packet_len = static_cast<uint16_t>((raw_len >> 8) | (raw_len << 8));
-
-    // 4. Fill Data
-    pkt.session_ttl = ttl_seconds;
-    pkt.timestamp = current_time_ms; // Demo: Use millis. Prod: Use GPS Epoch.
-    memcpy(pkt.eph_pub_key, _eph_pub, 32);
-
-    // 5. SIGNATURE (Identity binds the Ephemeral Key)
-    // Sign bytes 0 to 47 (Header + TTL + TS + PubKey)
-    unsigned long long sig_len;
-    // crypto_sign_detached(pkt.signature, &sig_len, (uint8_t*)&pkt, 48, _identity_priv);
-    crypto_sign_detached(pkt.signature, &sig_len, reinterpret_cast<uint8_t*>(&pkt), 48, _identity_priv);
-    // Defensive: Ensure signature length is as expected (Ed25519 = 64 bytes)
-    if (sig_len != 64) {
-        // Handle error: signature length mismatch (could log, assert, or set error state)
-        // For embedded, a simple infinite loop is a safe fail-stop
-        while (1) {}
-    }
+    // Keygen happened earlier in an idle slice; only the signature is
+    // left on the radio loop.
+    key_cache::Keypair kp;
+    _keys.take(kp);
+    security_context::begin_handshake(_session, _identity, kp.pub, kp.priv, pkt, ttl_seconds,
+                                      current_time_ms);
+    sodium_memzero(kp.priv, sizeof(kp.priv));
 }
 
 // --- PHASE 2: RESPONSE (Ground -> Sat B) ---
 bool SecurityManager::processHandshakeResponse(const PacketH_t& pkt_in) {
-    // 1. Verify Ground Signature (Validation)
-    // For demo, we assume Ground is trusted if sig validates.  
     // For demo, we skip checking the Ground's signature against a root CA.
     // In Prod, we check pkt_in.signature against a stored Ground Public Key.
-    
-    // 2. DERIVE SESSION KEY (ECDH)
-    // Sat B Private + Ground Public = Shared Secret
-    if (crypto_scalarmult(_session_key, _eph_priv, pkt_in.eph_pub_key) != 0) {
-        return false; // Math failed (e.g. weak point)
-    }
-
-    // 3. Hash the raw ECDH output to get a clean ChaCha20 Key
-    // Use Generic Hash (BLAKE2b)
-    crypto_generichash(_session_key, 32, _session_key, 32, NULL, 0);
-
-    // 4. CLEANUP (Forward Secrecy)
-    // Destroy the private ephemeral key immediately!
-    sodium_memzero(_eph_priv, sizeof(_eph_priv));
-    
-    _state = SESSION_ACTIVE;
-    return true;
+    return security_context::complete_handshake(_session, pkt_in.eph_pub_key);
 }
 
 // --- PHASE 3: ENCRYPT PACKET B (Payment) ---
@@ -164,75 +112,20 @@ bool SecurityManager::processHandshakeResponse(const PacketH_t& pkt_in) {
 //
 // See Protocol-spec-CCSDS.md §3 "Nonce Derivation" for the full proof.
 bool SecurityManager::encryptPacketB(PacketB_t& pkt, const uint8_t* payload_in, size_t len) {
-    if (len > sizeof(pkt.enc_payload)) return false;
-
-#ifdef VOID_ALPHA_PLAINTEXT
-    // VOID-127: Alpha plaintext path
-    // ChaCha20 encryption is bypassed — payload is copied verbatim into
-    // enc_payload. The session, GPS-gate, and monotonic-epoch guards are
-    // skipped because they exist solely to protect ChaCha20 nonce
-    // uniqueness, which is irrelevant when no cipher runs.
-    //
-    // The nonce (sat_id[4] || epoch_ts[8]) remains derivable from fields
-    // already on the wire but is NOT consumed by any cipher here.
-    //
-    // Ed25519 signature scope is UNCHANGED (VOID-111).
-    memcpy(pkt.enc_payload, payload_in, len);
-    if (len < sizeof(pkt.enc_payload)) {
-        memset(pkt.enc_payload + len, 0, sizeof(pkt.enc_payload) - len);
-    }
-#else
-    // Standard encrypted path
-    if (_state != SESSION_ACTIVE) return false;
-    if (!_gps_time_valid) return false;                    // GPS gate
-    if (pkt.epoch_ts <= _last_tx_epoch_ms) return false;   // monotonic guardrail
-
-    // 1. Derive the 12-byte nonce from fields already in the packet.
-    uint8_t nonce[12];
-    memcpy(nonce,     &pkt.sat_id,   4);   // LE u32
-    memcpy(nonce + 4, &pkt.epoch_ts, 8);   // LE u64
-
-    // 2. ChaCha20 stream encrypt. The outer Ed25519 signature provides
-    //    authenticity; we intentionally do not use Poly1305 here because the
-    //    signature covers (header + body - signature_suffix).
-    crypto_stream_chacha20_xor(pkt.enc_payload, payload_in, len, nonce, _session_key);
-#endif
-
-    // Sign (header + body up to signature offset). With the nonce field
-    // removed the signed region is exactly offsetof(PacketB_t, signature).
-    //    CCSDS: 104 bytes.   SNLP: 112 bytes.
-    // Identical in both plaintext and encrypted modes (VOID-111).
-    unsigned long long sig_len;
-    const size_t sign_len = offsetof(PacketB_t, signature);
-    crypto_sign_detached(pkt.signature, &sig_len,
-                         reinterpret_cast<uint8_t*>(&pkt),
-                         sign_len, _identity_priv);
-    if (sig_len != 64) {
-        while (1) {}
-    }
-
-#ifndef VOID_ALPHA_PLAINTEXT
-    // Advance the monotonic guardrail and zero the stack nonce.
-    _last_tx_epoch_ms = pkt.epoch_ts;
-    sodium_memzero(nonce, sizeof(nonce));
-    // TODO(VOID-110): Persist _last_tx_epoch_ms to NVS every N calls.
-#endif
-    return true;
+    return security_context::encrypt_packet_b(_session, _identity, pkt, payload_in, len,
+                                              _gps_time_valid);
 }
 
 // --- UTILITIES ---
 bool SecurityManager::isSessionActive(uint64_t current_time_ms) {
-    if (_state != SESSION_ACTIVE) return false;
-    // Check TTL
-    if ((current_time_ms - _session_start_ts) > (_session_ttl * 1000)) {
-        wipeSession(); // Time's up!
-        return false;
-    }
-    return true;
+    const bool was_active = _session.state == SESSION_ACTIVE;
+    const bool active     = security_context::is_active(_session, current_time_ms);
+    // TTL over: keys made during the session go with it.
+    if (was_active && !active) _keys.wipe();
+    return active;
 }
 
 void SecurityManager::wipeSession() {
-    sodium_memzero(_session_key, 32);
-    sodium_memzero(_eph_priv, 32); // Just in case
-    _state = SESSION_IDLE;
-}
\ No newline at end of file
+    security_context::wipe(_session);
+    _keys.wipe();
+}
@@ -0,0 +1,183 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      serial_frame.cpp
+ * Desc:      COBS encoder / streaming decoder for the USB-serial link.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "serial_frame.h"
+
+#include <cstring>
+
+#include "crc32_ieee.h"
+
+namespace serial_frame {
+namespace {
+
+// Incremental COBS writer: `code_at` is the slot reserved for the
+// current block's length byte.
+struct CobsWriter {
+    uint8_t* out;
+    size_t   pos;
+    size_t   code_at;
+    uint8_t  code;
+
+    explicit CobsWriter(uint8_t* o) : out(o), pos(1), code_at(0), code(1) {}
+
+    void put(uint8_t b) {
+        if (b == 0) {
+            close_block();
+            return;
+        }
+        out[pos++] = b;
+        if (++code == 0xFFu) close_block();
+    }
+    void close_block() {
+        out[code_at] = code;
+        code_at = pos++;
+        code = 1;
+    }
+    size_t finish() {
+        out[code_at] = code;
+        out[pos++] = 0x00; // delimiter
+        return pos;
+    }
+};
+
+bool KnownType(uint8_t t) {
+    return t >= static_cast<uint8_t>(Type::kLine) &&
+           t <= static_cast<uint8_t>(Type::kTxFrame);
+}
+
+}  // namespace
+
+size_t encode(Type type, const uint8_t* payload, size_t payload_len,
+              uint8_t* out, size_t out_cap) {
+    if (out == nullptr || payload_len > kMaxPayload) return 0;
+    if (payload == nullptr && payload_len != 0) return 0;
+    const size_t raw_len = 1 + payload_len + kCrcSize;
+    if (out_cap < raw_len + raw_len / 254 + 2) return 0;
+
+    const uint8_t t = static_cast<uint8_t>(type);
+    uint32_t crc = crc32_ieee::compute(&t, 1);
+    crc = crc32_ieee::update(crc, payload, payload_len);
+
+    CobsWriter w(out);
+    w.put(t);
+    for (size_t i = 0; i < payload_len; ++i) w.put(payload[i]);
+    for (size_t i = 0; i < kCrcSize; ++i) w.put(static_cast<uint8_t>(crc >> (8 * i)));
+    return w.finish();
+}
+
+Decoder::Decoder() : _buf{}, _len(0), _payload_len(0), _type(Type::kLine), _overflow(false) {}
+
+void Decoder::reset() {
+    _len = 0;
+    _payload_len = 0;
+    _overflow = false;
+}
+
+Decoder::Result Decoder::push(uint8_t byte) {
+    if (byte == 0x00) return finish();
+    if (_overflow) return Result::kPending; // already reported; wait for delimiter
+    if (_len == sizeof(_buf)) {
+        _overflow = true;
+        return Result::kOverflow;
+    }
+    _buf[_len++] = byte;
+    return Result::kPending;
+}
+
+Decoder::Result Decoder::finish() {
+    const size_t enc_len = _len;
+    const bool overflowed = _overflow;
+    reset();
+    if (overflowed) return Result::kPending;
+    if (enc_len == 0) return Result::kPending; // bare delimiter (resync)
+
+    // In-place COBS decode: the write cursor never passes the read cursor.
+    size_t r = 0;
+    size_t w = 0;
+    while (r < enc_len) {
+        const uint8_t code = _buf[r++];
+        if (code == 0) return Result::kError;
+        for (uint8_t i = 1; i < code; ++i) {
+            if (r >= enc_len) return Result::kError;
+            _buf[w++] = _buf[r++];
+        }
+        if (code != 0xFFu && r < enc_len) _buf[w++] = 0x00;
+    }
+
+    if (w < 1 + kCrcSize || !KnownType(_buf[0])) return Result::kError;
+    const size_t body = w - kCrcSize;
+    const uint32_t want = static_cast<uint32_t>(_buf[body])
+                        | (static_cast<uint32_t>(_buf[body + 1]) <<  8)
+                        | (static_cast<uint32_t>(_buf[body + 2]) << 16)
+                        | (static_cast<uint32_t>(_buf[body + 3]) << 24);
+    if (crc32_ieee::compute(_buf, body) != want) return Result::kError;
+
+    _type        = static_cast<Type>(_buf[0]);
+    _payload_len = body - 1;
+    return Result::kFrame;
+}
+
+CommandLink::CommandLink() : _line{}, _len(0), _cmd_len(0), _binary(false) {}
+
+void CommandLink::reset() {
+    _rx.reset();
+    _len     = 0;
+    _cmd_len = 0;
+    _binary  = false;
+}
+
+CommandLink::Event CommandLink::push(uint8_t byte) {
+    if (_binary) {
+        const Decoder::Result r = _rx.push(byte);
+        if (byte == 0x00) _len = 0;
+        if (r == Decoder::Result::kFrame) {
+            _len = 0;
+            if (_rx.type() != Type::kLine) return Event::kNone;
+            return line_event(reinterpret_cast<const char*>(_rx.payload()),
+                              _rx.payload_len(), true);
+        }
+        if (byte == 0x00) return Event::kNone;
+    }
+    if (byte == '\n' || byte == '\r') {
+        if (_len == 0) return Event::kNone;
+        const size_t n = _len;
+        _len = 0;
+        return line_event(_line, n, false);
+    }
+    if (_len < sizeof(_line) - 1) _line[_len++] = static_cast<char>(byte);
+    return Event::kNone;
+}
+
+// `text` is either _line itself or a decoded frame payload.
+CommandLink::Event CommandLink::line_event(const char* text, size_t len, bool from_frame) {
+    if (len == sizeof(kOfferLine) - 1 && std::memcmp(text, kOfferLine, len) == 0) {
+        // A framed offer would be answered in a mode the peer is not
+        // reading; only the ASCII one switches.
+        if (from_frame) return Event::kNone;
+        _binary = true;
+        _rx.reset();
+        return Event::kOffer;
+    }
+    if (len == sizeof(kRevertLine) - 1 && std::memcmp(text, kRevertLine, len) == 0) {
+        _binary = false;
+        _rx.reset();
+        return Event::kRevert;
+    }
+    // Stray bytes of a binary stream that happen to hold '\n'.
+    if (_binary && !from_frame) return Event::kNone;
+    const size_t n = (len < sizeof(_line) - 1) ? len : sizeof(_line) - 1;
+    if (text != _line) std::memmove(_line, text, n);
+    _line[n] = '\0';
+    _cmd_len = n;
+    return Event::kCommand;
+}
+
+}  // namespace serial_frame
@@ -0,0 +1,248 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      timing_wheel.cpp
+ * Desc:      Hierarchical timing wheel (see timing_wheel.h).
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include "timing_wheel.h"
+
+namespace timing_wheel {
+namespace {
+
+constexpr uint32_t kNil       = 0xFFFFFFFFu;
+constexpr uint8_t  kIdle      = 0xFFu;
+constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1u;
+constexpr uint32_t kGenMask   = (1u << (32 - kIndexBits)) - 1u;
+constexpr uint64_t kNever     = UINT64_MAX;
+
+inline unsigned shift_of(unsigned level) { return kSlotBits * level; }
+
+inline uint64_t rotr(uint64_t x, unsigned r) {
+    return r == 0 ? x : (x >> r) | (x << (64u - r));
+}
+
+inline unsigned lowest_bit(uint64_t x) {
+    return static_cast<unsigned>(__builtin_ctzll(x));
+}
+
+inline Handle make_handle(uint32_t index, uint32_t gen) {
+    return ((gen & kGenMask) << kIndexBits) | (index + 1u);
+}
+
+} // anonymous namespace
+
+Wheel::Wheel(Node* storage, size_t capacity, Clock clock, uint32_t tick_ms)
+    : nodes_(storage),
+      capacity_(static_cast<uint32_t>(capacity < kMaxTimers ? capacity : kMaxTimers)),
+      tick_ms_(tick_ms == 0 ? 1u : tick_ms),
+      free_(kNil),
+      clock_(clock),
+      origin_(clock()),
+      now_(0) {
+    for (uint32_t i = 0; i < capacity_; ++i) nodes_[i].gen = 0;
+    stats_ = Stats();
+    stats_.capacity = capacity_;
+    clear();
+}
+
+void Wheel::clear() {
+    for (unsigned l = 0; l < kLevels; ++l) {
+        occupied_[l] = 0;
+        for (unsigned s = 0; s < kSlots; ++s) head_[l][s] = kNil;
+    }
+    // Free list in index order; generations survive so old handles
+    // stay dead.
+    for (uint32_t i = capacity_; i-- > 0;) {
+        nodes_[i].level = kIdle;
+        nodes_[i].prev  = kNil;
+        nodes_[i].next  = (i + 1 < capacity_) ? i + 1 : kNil;
+    }
+    free_ = capacity_ == 0 ? kNil : 0;
+    stats_.armed = 0;
+}
+
+uint64_t Wheel::to_ticks(uint64_t deadline_ms) const {
+    if (deadline_ms <= origin_) return 0;
+    // Round up: a timer never fires before its deadline.
+    return (deadline_ms - origin_ + tick_ms_ - 1) / tick_ms_;
+}
+
+uint32_t Wheel::index_of(Handle h) const {
+    const uint32_t i = (h & kIndexMask);
+    if (i == 0 || i > capacity_) return kNil;
+    const Node& n = nodes_[i - 1];
+    if (n.level == kIdle || (n.gen & kGenMask) != (h >> kIndexBits)) return kNil;
+    return i - 1;
+}
+
+// Puts node i in the slot its deadline falls in, relative to now_:
+// level L holds deltas in [64^L, 64^(L+1)).
+void Wheel::file(uint32_t i) {
+    Node& n = nodes_[i];
+    uint64_t d     = n.deadline;
+    uint64_t delta = d > now_ ? d - now_ : 0;
+    if (delta >= kSpanTicks) {
+        // Beyond the wheel: park in the furthest slot, re-filed on cascade.
+        delta = kSpanTicks - 1;
+        d     = now_ + delta;
+    }
+    unsigned level = 0;
+    while (delta >= (1ull << shift_of(level + 1))) ++level;
+    const unsigned slot = static_cast<unsigned>((d >> shift_of(level)) & (kSlots - 1));
+
+    n.level = static_cast<uint8_t>(level);
+    n.slot  = static_cast<uint8_t>(slot);
+    n.prev  = kNil;
+    n.next  = head_[level][slot];
+    if (n.next != kNil) nodes_[n.next].prev = i;
+    head_[level][slot] = i;
+    occupied_[level] |= 1ull << slot;
+}
+
+void Wheel::unlink(uint32_t i) {
+    Node& n = nodes_[i];
+    if (n.prev != kNil) {
+        nodes_[n.prev].next = n.next;
+    } else {
+        head_[n.level][n.slot] = n.next;
+        if (n.next == kNil) occupied_[n.level] &= ~(1ull << n.slot);
+    }
+    if (n.next != kNil) nodes_[n.next].prev = n.prev;
+}
+
+Handle Wheel::arm(uint64_t deadline_ms, Callback fn, void* ctx, uint32_t tag) {
+    if (free_ == kNil) {
+        ++stats_.exhausted;
+        return kNoTimer;
+    }
+    const uint32_t i = free_;
+    Node& n = nodes_[i];
+    free_ = n.next;
+    ++n.gen;
+
+    const uint64_t t = to_ticks(deadline_ms);
+    n.deadline = t > now_ ? t : now_ + 1;
+    n.fn       = fn;
+    n.ctx      = ctx;
+    n.tag      = tag;
+    file(i);
+
+    if (++stats_.armed > stats_.peak) stats_.peak = stats_.armed;
+    return make_handle(i, n.gen);
+}
+
+Handle Wheel::arm_in(uint32_t delay_ms, Callback fn, void* ctx, uint32_t tag) {
+    return arm(clock_() + delay_ms, fn, ctx, tag);
+}
+
+Handle Wheel::rearm(Handle h, uint64_t deadline_ms, Callback fn, void* ctx, uint32_t tag) {
+    const uint32_t i = index_of(h);
+    if (i == kNil) return arm(deadline_ms, fn, ctx, tag);
+
+    unlink(i);
+    Node& n = nodes_[i];
+    const uint64_t t = to_ticks(deadline_ms);
+    n.deadline = t > now_ ? t : now_ + 1;
+    n.fn       = fn;
+    n.ctx      = ctx;
+    n.tag      = tag;
+    file(i);
+    return h;
+}
+
+bool Wheel::cancel(Handle h) {
+    const uint32_t i = index_of(h);
+    if (i == kNil) return false;
+    unlink(i);
+    nodes_[i].level = kIdle;
+    nodes_[i].next  = free_;
+    free_ = i;
+    --stats_.armed;
+    return true;
+}
+
+bool Wheel::armed(Handle h) const { return index_of(h) != kNil; }
+
+// First tick after now_ at which some occupied slot is due: level L
+// slot s is due at the next 64^L-aligned tick whose level-L digit is s.
+uint64_t Wheel::next_event() const {
+    uint64_t best = kNever;
+    for (unsigned l = 0; l < kLevels; ++l) {
+        if (occupied_[l] == 0) continue;
+        const uint64_t base = now_ >> shift_of(l);
+        const unsigned from = static_cast<unsigned>((base + 1) & (kSlots - 1));
+        const unsigned k    = lowest_bit(rotr(occupied_[l], from));
+        const uint64_t t    = (base + 1 + k) << shift_of(l);
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+void Wheel::cascade(unsigned level, uint64_t tick) {
+    const unsigned slot = static_cast<unsigned>((tick >> shift_of(level)) & (kSlots - 1));
+    uint32_t i = head_[level][slot];
+    head_[level][slot] = kNil;
+    occupied_[level] &= ~(1ull << slot);
+    while (i != kNil) {
+        const uint32_t next = nodes_[i].next;
+        file(i);
+        ++stats_.cascaded;
+        i = next;
+    }
+}
+
+void Wheel::fire_slot(uint64_t tick) {
+    const unsigned slot = static_cast<unsigned>(tick & (kSlots - 1));
+    // One at a time off the live list: a callback may cancel a timer
+    // that shares this slot.
+    while (head_[0][slot] != kNil) {
+        const uint32_t i = head_[0][slot];
+        unlink(i);
+        Node& n = nodes_[i];
+        const Callback fn  = n.fn;
+        void* const    ctx = n.ctx;
+        const uint32_t tag = n.tag;
+        n.level = kIdle;
+        n.next  = free_;
+        free_ = i;
+        --stats_.armed;
+        ++stats_.fired;
+        fn(ctx, tag);
+    }
+}
+
+size_t Wheel::advance(uint64_t now_ms) {
+    const uint64_t target = now_ms <= origin_ ? 0 : (now_ms - origin_) / tick_ms_;
+    const uint64_t fired  = stats_.fired;
+    while (now_ < target) {
+        const uint64_t t = next_event();
+        if (t > target) {
+            now_ = target;
+            break;
+        }
+        now_ = t;
+        // Higher levels first: what they cascade may be due right now.
+        for (unsigned l = kLevels - 1; l > 0; --l) {
+            const uint64_t span = 1ull << shift_of(l);
+            if ((t & (span - 1)) != 0) continue;
+            const unsigned slot = static_cast<unsigned>((t >> shift_of(l)) & (kSlots - 1));
+            if ((occupied_[l] >> slot) & 1u) cascade(l, t);
+        }
+        fire_slot(t);
+    }
+    return static_cast<size_t>(stats_.fired - fired);
+}
+
+size_t Wheel::poll() { return advance(clock_()); }
+
+uint64_t Wheel::next_wake_ms() const {
+    const uint64_t t = next_event();
+    return t == kNever ? kNever : origin_ + t * tick_ms_;
+}
+
+} // namespace timing_wheel
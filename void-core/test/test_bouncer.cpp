@@ -29,4 +29,440 @@ TEST_F(BouncerTest, ProtectsOutputBuffer) {
     // Bouncer should detect the output buffer is too small for decryption
     bool result = edge_gate.process_packet(valid_pkt_b, 176, tiny_out, sizeof(tiny_out));
     EXPECT_FALSE(result) << "Bouncer allowed a potential stack overflow into out_buf.";
-}
\ No newline at end of file
+}
+// ---------------------------------------------------------------------
+// Ed25519 identity registry + batch path. Runs against the checked-in
+// golden PacketB for the active tier (signed by generate_packets.go).
+// ---------------------------------------------------------------------
+
+#include <sodium.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "crc32_ieee.h"
+
+#ifndef VOID_TEST_VECTORS_DIR
+#error "VOID_TEST_VECTORS_DIR must be defined by CMake."
+#endif
+#ifndef VOID_TEST_VECTORS_TIER
+#error "VOID_TEST_VECTORS_TIER must be defined by CMake."
+#endif
+
+namespace {
+
+constexpr uint32_t kSatId = 0xCAFEBABEu;
+
+// Must match detSeedHex in gateway/test/utils/generate_packets.go.
+constexpr uint8_t kDetSeed[32] = {
+    0xbc, 0x1d, 0xf4, 0xfa, 0x6e, 0x3d, 0x70, 0x48,
+    0x99, 0x2f, 0x14, 0xe6, 0x55, 0x06, 0x0c, 0xbb,
+    0x21, 0x90, 0xbd, 0xed, 0x90, 0x02, 0x52, 0x4c,
+    0x06, 0xe7, 0xcb, 0xb1, 0x63, 0xdf, 0x15, 0xfb,
+};
+
+size_t ReadTierVector(const char* tier, const char* name, uint8_t* buf, size_t buf_cap) {
+    std::string path = VOID_TEST_VECTORS_DIR "/";
+    path += tier;
+    path += "/";
+    path += name;
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) return 0;
+    const size_t n = std::fread(buf, 1, buf_cap, f);
+    std::fclose(f);
+    return n;
+}
+
+size_t ReadVector(const char* name, uint8_t* buf, size_t buf_cap) {
+    return ReadTierVector(VOID_TEST_VECTORS_TIER, name, buf, buf_cap);
+}
+
+// Re-seal global_crc after a deliberate body mutation so the frame
+// reaches the signature stage instead of failing the CRC prefilter.
+void ResealCrc(uint8_t* frame) {
+    const size_t off = offsetof(PacketB_t, global_crc);
+    const uint32_t crc = crc32_ieee::compute(frame, off);
+    frame[off + 0] = static_cast<uint8_t>(crc & 0xFFu);
+    frame[off + 1] = static_cast<uint8_t>((crc >> 8) & 0xFFu);
+    frame[off + 2] = static_cast<uint8_t>((crc >> 16) & 0xFFu);
+    frame[off + 3] = static_cast<uint8_t>((crc >> 24) & 0xFFu);
+}
+
+}  // namespace
+
+class BouncerSigTest : public ::testing::Test {
+protected:
+    Bouncer edge_gate;
+    uint8_t out_buf[512];
+    uint8_t golden[sizeof(PacketB_t)];
+
+    void SetUp() override {
+        ASSERT_GE(sodium_init(), 0);
+        ASSERT_EQ(ReadVector("packet_b.bin", golden, sizeof(golden)),
+                  sizeof(PacketB_t));
+        uint8_t pub[crypto_sign_PUBLICKEYBYTES];
+        uint8_t priv[crypto_sign_SECRETKEYBYTES];
+        ASSERT_EQ(crypto_sign_seed_keypair(pub, priv, kDetSeed), 0);
+        sodium_memzero(priv, sizeof(priv));
+        ASSERT_TRUE(edge_gate.register_sat_key(kSatId, pub, sizeof(pub)));
+    }
+};
+
+TEST_F(BouncerSigTest, AcceptsGoldenPacketB) {
+    EXPECT_TRUE(edge_gate.process_packet(golden, sizeof(golden), out_buf, sizeof(out_buf)));
+}
+
+TEST_F(BouncerSigTest, RejectsUnregisteredSatellite) {
+    edge_gate.clear_sat_keys();
+    BouncerFrame f = {golden, sizeof(golden)};
+    BouncerVerdict v = BouncerVerdict::kAccepted;
+    EXPECT_EQ(edge_gate.process_batch(&f, 1, &v), 0u);
+    EXPECT_EQ(v, BouncerVerdict::kUnknownSat);
+}
+
+TEST_F(BouncerSigTest, RejectsForgedSignatureWithValidCrc) {
+    golden[offsetof(PacketB_t, signature)] ^= 0x01u;
+    ResealCrc(golden);
+    EXPECT_FALSE(edge_gate.process_packet(golden, sizeof(golden), out_buf, sizeof(out_buf)));
+    BouncerFrame f = {golden, sizeof(golden)};
+    BouncerVerdict v = BouncerVerdict::kAccepted;
+    edge_gate.process_batch(&f, 1, &v);
+    EXPECT_EQ(v, BouncerVerdict::kBadSignature);
+}
+
+TEST_F(BouncerSigTest, RejectsTamperedBodyUnderSignature) {
+    golden[offsetof(PacketB_t, enc_payload)] ^= 0x80u;
+    ResealCrc(golden);
+    BouncerFrame f = {golden, sizeof(golden)};
+    BouncerVerdict v = BouncerVerdict::kAccepted;
+    edge_gate.process_batch(&f, 1, &v);
+    EXPECT_EQ(v, BouncerVerdict::kBadSignature);
+}
+
+TEST_F(BouncerSigTest, CrcPrefilterRunsBeforeVerify) {
+    golden[offsetof(PacketB_t, global_crc)] ^= 0xFFu;
+    BouncerFrame f = {golden, sizeof(golden)};
+    BouncerVerdict v = BouncerVerdict::kAccepted;
+    edge_gate.process_batch(&f, 1, &v);
+    EXPECT_EQ(v, BouncerVerdict::kBadCrc);
+}
+
+TEST_F(BouncerSigTest, BatchReportsPerFrameVerdicts) {
+    uint8_t forged[sizeof(PacketB_t)];
+    std::memcpy(forged, golden, sizeof(forged));
+    // Its own epoch_ts, or the replay window would reject it first.
+    forged[offsetof(PacketB_t, epoch_ts)] ^= 0x01u;
+    forged[offsetof(PacketB_t, signature) + 10] ^= 0x40u;
+    ResealCrc(forged);
+    uint8_t runt[16] = {0};
+
+    const BouncerFrame frames[] = {
+        {golden, sizeof(golden)},
+        {forged, sizeof(forged)},
+        {runt,   sizeof(runt)},
+        {golden, sizeof(golden)},   // retransmit: shares frame 0's verdict
+    };
+    BouncerVerdict v[4];
+    EXPECT_EQ(edge_gate.process_batch(frames, 4, v), 2u);
+    EXPECT_EQ(v[0], BouncerVerdict::kAccepted);
+    EXPECT_EQ(v[1], BouncerVerdict::kBadSignature);
+    EXPECT_EQ(v[2], BouncerVerdict::kBadSize);
+    EXPECT_EQ(v[3], BouncerVerdict::kAccepted);
+}
+
+TEST_F(BouncerSigTest, BatchRejectsOversizedCall) {
+    BouncerFrame frames[Bouncer::kMaxBatch + 1];
+    BouncerVerdict v[Bouncer::kMaxBatch + 1];
+    for (BouncerFrame& f : frames) f = {golden, sizeof(golden)};
+    EXPECT_EQ(edge_gate.process_batch(frames, Bouncer::kMaxBatch + 1, v), 0u);
+}
+
+// A dual-front-end station (LoRa SNLP + S-band CCSDS) feeds one Bouncer;
+// the tier is taken from each frame, not from VOID_PROTOCOL_TYPE.
+TEST_F(BouncerSigTest, BatchAcceptsBothTiersInOneCall) {
+    uint8_t snlp_b[sizeof(snlp::PacketB_t)];
+    uint8_t ccsds_b[sizeof(ccsds::PacketB_t)];
+    ASSERT_EQ(ReadTierVector("snlp", "packet_b.bin", snlp_b, sizeof(snlp_b)), sizeof(snlp_b));
+    ASSERT_EQ(ReadTierVector("ccsds", "packet_b.bin", ccsds_b, sizeof(ccsds_b)), sizeof(ccsds_b));
+
+    // An SNLP-sized frame without the sync word is neither tier.
+    uint8_t unsynced[sizeof(snlp::PacketB_t)];
+    std::memcpy(unsynced, snlp_b, sizeof(unsynced));
+    unsynced[0] ^= 0xFFu;
+
+    const BouncerFrame frames[] = {
+        {snlp_b,   sizeof(snlp_b)},
+        {ccsds_b,  sizeof(ccsds_b)},
+        {unsynced, sizeof(unsynced)},
+    };
+    BouncerVerdict v[3];
+    EXPECT_EQ(edge_gate.process_batch(frames, 3, v), 2u);
+    EXPECT_EQ(v[0], BouncerVerdict::kAccepted);
+    EXPECT_EQ(v[1], BouncerVerdict::kAccepted);
+    EXPECT_EQ(v[2], BouncerVerdict::kBadSize);
+    EXPECT_TRUE(edge_gate.process_packet(ccsds_b, sizeof(ccsds_b), out_buf, sizeof(out_buf)));
+}
+
+// ---------------------------------------------------------------------
+// Replay window: each sat's epoch_ts is spent once, and a replay is
+// turned away before the signature stage.
+// ---------------------------------------------------------------------
+
+namespace {
+
+// Rewrites epoch_ts (and optionally a body byte), then re-signs with the
+// deterministic flat-sat key and re-seals the CRC: a genuine new frame.
+void Resign(uint8_t* frame, uint64_t epoch, uint8_t body_xor = 0) {
+    for (size_t i = 0; i < 8; ++i) {
+        frame[offsetof(PacketB_t, epoch_ts) + i] = static_cast<uint8_t>(epoch >> (8 * i));
+    }
+    frame[offsetof(PacketB_t, enc_payload)] ^= body_xor;
+    uint8_t pub[crypto_sign_PUBLICKEYBYTES];
+    uint8_t priv[crypto_sign_SECRETKEYBYTES];
+    crypto_sign_seed_keypair(pub, priv, kDetSeed);
+    crypto_sign_detached(frame + offsetof(PacketB_t, signature), nullptr,
+                         frame, offsetof(PacketB_t, signature), priv);
+    sodium_memzero(priv, sizeof(priv));
+    ResealCrc(frame);
+}
+
+uint64_t GoldenEpoch(const uint8_t* frame) {
+    uint64_t e = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        e |= static_cast<uint64_t>(frame[offsetof(PacketB_t, epoch_ts) + i]) << (8 * i);
+    }
+    return e;
+}
+
+uint64_t g_now_ms = 0;
+uint64_t FakeClock() { return g_now_ms; }
+
+BouncerVerdict Check(Bouncer& b, const uint8_t* frame) {
+    BouncerFrame f = {frame, sizeof(PacketB_t)};
+    BouncerVerdict v = BouncerVerdict::kAccepted;
+    b.process_batch(&f, 1, &v);
+    return v;
+}
+
+}  // namespace
+
+TEST_F(BouncerSigTest, RetransmitOfAcceptedFrameIsAcceptedAgain) {
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+    EXPECT_TRUE(edge_gate.process_packet(golden, sizeof(golden), out_buf, sizeof(out_buf)));
+}
+
+// No clock set: only the retransmit cap stops a captured frame being
+// fed back in for as long as the satellite sends nothing newer.
+TEST_F(BouncerSigTest, RetransmitsOfOneFrameAreCapped) {
+    ASSERT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+    for (uint8_t i = 0; i < replay_window::kMaxRetransmits; ++i) {
+        ASSERT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+    }
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kReplay);
+    EXPECT_FALSE(edge_gate.process_packet(golden, sizeof(golden), out_buf, sizeof(out_buf)));
+}
+
+TEST_F(BouncerSigTest, CopiesInOneBatchSpendTheRetransmitCap) {
+    constexpr size_t kCopies = 8;
+    BouncerFrame   frames[kCopies];
+    BouncerVerdict verdicts[kCopies];
+    for (BouncerFrame& f : frames) f = {golden, sizeof(golden)};
+    EXPECT_EQ(edge_gate.process_batch(frames, kCopies, verdicts),
+              1u + replay_window::kMaxRetransmits);
+    for (size_t i = 0; i < kCopies; ++i) {
+        EXPECT_EQ(verdicts[i], i <= replay_window::kMaxRetransmits ? BouncerVerdict::kAccepted
+                                                                   : BouncerVerdict::kReplay);
+    }
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kReplay);
+}
+
+TEST_F(BouncerSigTest, ReusedEpochIsRejectedBeforeVerify) {
+    const uint64_t epoch = GoldenEpoch(golden);
+    ASSERT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+
+    uint8_t other[sizeof(PacketB_t)];
+    std::memcpy(other, golden, sizeof(other));
+    Resign(other, epoch, 0x01u);
+    EXPECT_EQ(Check(edge_gate, other), BouncerVerdict::kReplay);
+
+    // Even with a broken signature the verdict is kReplay: the verify
+    // never ran.
+    other[offsetof(PacketB_t, signature)] ^= 0x01u;
+    ResealCrc(other);
+    EXPECT_EQ(Check(edge_gate, other), BouncerVerdict::kReplay);
+
+    edge_gate.clear_replay_state();
+    Resign(other, epoch, 0x00u);
+    EXPECT_EQ(Check(edge_gate, other), BouncerVerdict::kAccepted);
+}
+
+TEST_F(BouncerSigTest, WindowAcceptsReorderingButNotOldFrames) {
+    const uint64_t epoch = GoldenEpoch(golden);
+    uint8_t f[sizeof(PacketB_t)];
+
+    std::memcpy(f, golden, sizeof(f));
+    Resign(f, epoch + 90000);
+    ASSERT_EQ(Check(edge_gate, f), BouncerVerdict::kAccepted);
+
+    std::memcpy(f, golden, sizeof(f));
+    Resign(f, epoch + 60000);   // 30 s late: inside the window
+    EXPECT_EQ(Check(edge_gate, f), BouncerVerdict::kAccepted);
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kReplay);   // 90 s late
+}
+
+TEST_F(BouncerSigTest, ForgedFrameDoesNotAdvanceTheWindow) {
+    const uint64_t epoch = GoldenEpoch(golden);
+    uint8_t forged[sizeof(PacketB_t)];
+    std::memcpy(forged, golden, sizeof(forged));
+    Resign(forged, epoch + 500000);
+    forged[offsetof(PacketB_t, signature) + 3] ^= 0x10u;
+    ResealCrc(forged);
+    EXPECT_EQ(Check(edge_gate, forged), BouncerVerdict::kBadSignature);
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+}
+
+TEST_F(BouncerSigTest, StaleEpochRejectedWhenAClockIsSet) {
+    const uint64_t epoch = GoldenEpoch(golden);
+    edge_gate.set_clock(&FakeClock);
+
+    g_now_ms = epoch + Bouncer::kFreshnessMs + 1;
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kStale);
+    g_now_ms = epoch - Bouncer::kFreshnessMs - 1;
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kStale);
+    g_now_ms = epoch + Bouncer::kFreshnessMs;
+    EXPECT_EQ(Check(edge_gate, golden), BouncerVerdict::kAccepted);
+}
+
+// ---------------------------------------------------------------------
+// Payload decrypt: CCSDS enc_payload is ChaCha20 under the sat's session
+// key (VOID-110 nonce), SNLP is plaintext. Decrypts happen in the frame.
+// ---------------------------------------------------------------------
+
+namespace {
+
+void SessionKey(uint8_t* key) {
+    for (size_t i = 0; i < security_context::kSessionKeySize; ++i) {
+        key[i] = static_cast<uint8_t>(0xA0u + i);
+    }
+}
+
+void StoreLE32(uint8_t* p, uint32_t v) {
+    for (size_t i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+uint64_t CcsdsEpoch(const uint8_t* frame) {
+    uint64_t e = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        e |= static_cast<uint64_t>(frame[offsetof(ccsds::PacketB_t, epoch_ts) + i]) << (8 * i);
+    }
+    return e;
+}
+
+// What the satellite's encryptPacketB would have put on the air.
+void Expected(const uint8_t* frame, uint32_t sat_id, uint8_t* out) {
+    uint8_t key[security_context::kSessionKeySize];
+    SessionKey(key);
+    security_context::chacha20_xor(key, sat_id, CcsdsEpoch(frame),
+                                   frame + offsetof(ccsds::PacketB_t, enc_payload),
+                                   sizeof(ccsds::PacketB_t::enc_payload), out);
+}
+
+security_context::SessionStore g_sessions;
+
+}  // namespace
+
+TEST_F(BouncerSigTest, CcsdsPayloadDecryptsInPlaceUnderTheSessionKey) {
+    uint8_t ccsds_b[sizeof(ccsds::PacketB_t)];
+    uint8_t snlp_b[sizeof(snlp::PacketB_t)];
+    ASSERT_EQ(ReadTierVector("ccsds", "packet_b.bin", ccsds_b, sizeof(ccsds_b)), sizeof(ccsds_b));
+    ASSERT_EQ(ReadTierVector("snlp", "packet_b.bin", snlp_b, sizeof(snlp_b)), sizeof(snlp_b));
+    constexpr size_t kEnc = offsetof(ccsds::PacketB_t, enc_payload);
+    constexpr size_t kLen = sizeof(ccsds::PacketB_t::enc_payload);
+    uint8_t expect[kLen];
+    Expected(ccsds_b, kSatId, expect);
+
+    g_now_ms = 5000;
+    g_sessions.clear();
+    uint8_t key[security_context::kSessionKeySize];
+    SessionKey(key);
+    ASSERT_TRUE(g_sessions.install(kSatId, key, 600, g_now_ms));
+    edge_gate.set_session_store(&g_sessions, &FakeClock);
+
+    EXPECT_TRUE(edge_gate.process_packet(ccsds_b, sizeof(ccsds_b), out_buf, sizeof(out_buf)));
+    EXPECT_EQ(std::memcmp(out_buf, expect, kLen), 0);
+
+    uint8_t frame[sizeof(ccsds_b)];
+    std::memcpy(frame, ccsds_b, sizeof(frame));
+    EXPECT_EQ(edge_gate.decrypt_in_place(frame, sizeof(frame)), BouncerVerdict::kAccepted);
+    EXPECT_EQ(std::memcmp(frame + kEnc, expect, kLen), 0);
+    EXPECT_EQ(std::memcmp(frame, ccsds_b, kEnc), 0);  // header untouched
+
+    // SNLP is plaintext by law: the bytes stay as received.
+    uint8_t snlp_copy[sizeof(snlp_b)];
+    std::memcpy(snlp_copy, snlp_b, sizeof(snlp_copy));
+    EXPECT_EQ(edge_gate.decrypt_in_place(snlp_copy, sizeof(snlp_copy)), BouncerVerdict::kAccepted);
+    EXPECT_EQ(std::memcmp(snlp_copy, snlp_b, sizeof(snlp_b)), 0);
+
+    // No live session: the CCSDS payload is refused, not passed on.
+    g_now_ms += 600001;
+    std::memcpy(frame, ccsds_b, sizeof(frame));
+    EXPECT_EQ(edge_gate.decrypt_in_place(frame, sizeof(frame)), BouncerVerdict::kNoSession);
+    EXPECT_EQ(std::memcmp(frame, ccsds_b, sizeof(frame)), 0);
+    edge_gate.clear_replay_state();
+    EXPECT_FALSE(edge_gate.process_packet(ccsds_b, sizeof(ccsds_b), out_buf, sizeof(out_buf)));
+    EXPECT_EQ(edge_gate.decrypt_in_place(frame, 10), BouncerVerdict::kBadSize);
+}
+
+TEST_F(BouncerSigTest, BatchDecryptsAcceptedFramesPerSat) {
+    uint8_t a[sizeof(ccsds::PacketB_t)], b[sizeof(a)], stranger[sizeof(a)], rejected[sizeof(a)];
+    uint8_t snlp_b[sizeof(snlp::PacketB_t)];
+    ASSERT_EQ(ReadTierVector("ccsds", "packet_b.bin", a, sizeof(a)), sizeof(a));
+    ASSERT_EQ(ReadTierVector("snlp", "packet_b.bin", snlp_b, sizeof(snlp_b)), sizeof(snlp_b));
+    std::memcpy(b, a, sizeof(b));
+    b[offsetof(ccsds::PacketB_t, epoch_ts)] ^= 0x01u;  // next nonce, same sat
+    std::memcpy(stranger, a, sizeof(stranger));
+    StoreLE32(stranger + offsetof(ccsds::PacketB_t, sat_id), 0x0BADF00Du);
+    std::memcpy(rejected, a, sizeof(rejected));
+
+    constexpr size_t kEnc = offsetof(ccsds::PacketB_t, enc_payload);
+    constexpr size_t kLen = sizeof(ccsds::PacketB_t::enc_payload);
+    uint8_t expect_a[kLen], expect_b[kLen];
+    Expected(a, kSatId, expect_a);
+    Expected(b, kSatId, expect_b);
+    uint8_t snlp_orig[sizeof(snlp_b)];
+    std::memcpy(snlp_orig, snlp_b, sizeof(snlp_orig));
+
+    g_now_ms = 5000;
+    g_sessions.clear();
+    uint8_t key[security_context::kSessionKeySize];
+    SessionKey(key);
+    ASSERT_TRUE(g_sessions.install(kSatId, key, 600, g_now_ms));
+    edge_gate.set_session_store(&g_sessions, &FakeClock);
+
+    // Verdicts as process_batch() would leave them; `a` is listed twice.
+    const BouncerMutableFrame frames[] = {
+        {a, sizeof(a)}, {stranger, sizeof(stranger)}, {snlp_b, sizeof(snlp_b)},
+        {b, sizeof(b)}, {rejected, sizeof(rejected)}, {a, sizeof(a)},
+    };
+    BouncerVerdict v[] = {
+        BouncerVerdict::kAccepted, BouncerVerdict::kAccepted, BouncerVerdict::kAccepted,
+        BouncerVerdict::kAccepted, BouncerVerdict::kBadCrc,   BouncerVerdict::kAccepted,
+    };
+    EXPECT_EQ(edge_gate.decrypt_batch(frames, 6, v), 4u);
+    EXPECT_EQ(v[1], BouncerVerdict::kNoSession);
+    EXPECT_EQ(v[4], BouncerVerdict::kBadCrc);
+    EXPECT_EQ(v[5], BouncerVerdict::kAccepted);
+    EXPECT_EQ(std::memcmp(a + kEnc, expect_a, kLen), 0);  // once, not twice
+    EXPECT_EQ(std::memcmp(b + kEnc, expect_b, kLen), 0);
+    EXPECT_EQ(std::memcmp(snlp_b, snlp_orig, sizeof(snlp_b)), 0);
+    EXPECT_EQ(std::memcmp(rejected + kEnc, stranger + kEnc, kLen), 0);  // untouched
+
+    // Without a store every payload is the alpha plaintext.
+    edge_gate.set_session_store(nullptr, nullptr);
+    std::memcpy(b, a, sizeof(b));
+    const BouncerMutableFrame one = {b, sizeof(b)};
+    BouncerVerdict ok = BouncerVerdict::kAccepted;
+    EXPECT_EQ(edge_gate.decrypt_batch(&one, 1, &ok), 1u);
+    EXPECT_EQ(std::memcmp(b, a, sizeof(b)), 0);
+    EXPECT_EQ(edge_gate.decrypt_batch(frames, Bouncer::kMaxBatch + 1, v), 0u);
+}
@@ -0,0 +1,363 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_frame_dispatch.cpp
+ * Desc:      Frame codec, typed views and dispatch table vs the golden
+ *            vectors of the active tier, plus both tiers in one binary.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "void_packets.h"
+#include "frame_dispatch.h"
+
+#ifndef VOID_TEST_VECTORS_DIR
+#error "VOID_TEST_VECTORS_DIR must be defined by CMake."
+#endif
+#ifndef VOID_TEST_VECTORS_TIER
+#error "VOID_TEST_VECTORS_TIER must be defined by CMake."
+#endif
+
+using frame_dispatch::Codec;
+using frame_dispatch::Dispatcher;
+using frame_dispatch::FrameInfo;
+using frame_dispatch::FrameKind;
+using frame_dispatch::FrameView;
+using frame_dispatch::Status;
+using frame_dispatch::Tier;
+
+namespace {
+
+constexpr uint16_t kApidSatA = 100;
+constexpr uint16_t kApidSatB = 101;
+
+// Tier this binary was built for (VOID_PROTOCOL_TYPE 1 = CCSDS, 2 = SNLP).
+constexpr Tier kBuildTier = static_cast<Tier>(VOID_PROTOCOL_TYPE);
+
+size_t ReadTierVector(const char* tier, const char* name, uint8_t* buf, size_t buf_cap) {
+    std::string path = VOID_TEST_VECTORS_DIR "/";
+    path += tier;
+    path += "/";
+    path += name;
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) return 0;
+    const size_t n = std::fread(buf, 1, buf_cap, f);
+    std::fclose(f);
+    return n;
+}
+
+size_t ReadVector(const char* name, uint8_t* buf, size_t buf_cap) {
+    return ReadTierVector(VOID_TEST_VECTORS_TIER, name, buf, buf_cap);
+}
+
+struct Golden {
+    const char* name;
+    FrameKind   kind;
+    uint16_t    apid;
+};
+
+// APIDs as emitted by generate_packets.go.
+const Golden kGoldens[] = {
+    {"packet_h.bin",   FrameKind::kH,   kApidSatB},
+    {"packet_a.bin",   FrameKind::kA,   kApidSatA},
+    {"packet_b.bin",   FrameKind::kB,   kApidSatB},
+    {"packet_c.bin",   FrameKind::kC,   kApidSatA},
+    {"packet_d.bin",   FrameKind::kD,   kApidSatB},
+    {"packet_ack.bin", FrameKind::kAck, kApidSatB},
+    {"packet_l.bin",   FrameKind::kL,   kApidSatB},
+};
+
+struct Seen {
+    int       calls;
+    FrameKind kind;
+    uint32_t  sat_id;
+    const uint8_t* base;
+};
+
+void OnPacketB(const FrameView<PacketB_t>& v, void* user) {
+    Seen* s = static_cast<Seen*>(user);
+    ++s->calls;
+    s->kind   = v.info().kind;
+    s->sat_id = v->sat_id;
+    s->base   = v.bytes();
+}
+
+void OnPacketD(const FrameView<PacketD_t>& v, void* user) {
+    Seen* s = static_cast<Seen*>(user);
+    ++s->calls;
+    s->kind = v.info().kind;
+    s->base = v.bytes();
+}
+
+void OnPacketAck(const FrameView<PacketAck_t>& v, void* user) {
+    Seen* s = static_cast<Seen*>(user);
+    ++s->calls;
+    s->kind = v.info().kind;
+    s->base = v.bytes();
+}
+
+}  // namespace
+
+TEST(FrameDispatchTest, ClassifiesEveryGoldenFrame) {
+    for (const Golden& g : kGoldens) {
+        uint8_t buf[256] = {0};
+        const size_t n = ReadVector(g.name, buf, sizeof(buf));
+        ASSERT_GT(n, 0u) << g.name;
+        FrameInfo info = {};
+        ASSERT_EQ(frame_dispatch::classify(buf, n, &info), Status::kOk) << g.name;
+        EXPECT_EQ(info.tier, kBuildTier) << g.name;
+        EXPECT_EQ(info.kind, g.kind) << g.name;
+        EXPECT_EQ(info.apid, g.apid) << g.name;
+        EXPECT_EQ(info.body_len, n - sizeof(VoidHeader_t)) << g.name;
+        EXPECT_EQ(info.is_command, g.kind == FrameKind::kAck) << g.name;
+    }
+}
+
+TEST(FrameDispatchTest, ViewIsZeroCopyAndTyped) {
+    uint8_t buf[256] = {0};
+    const size_t n = ReadVector("packet_b.bin", buf, sizeof(buf));
+    Status st = Status::kNoHandler;
+    const FrameView<PacketB_t> v = frame_dispatch::view_as<PacketB_t>(buf, n, &st);
+    ASSERT_TRUE(v) << frame_dispatch::status_name(st);
+    EXPECT_EQ(st, Status::kOk);
+    EXPECT_EQ(v.bytes(), buf);
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(v.get()), buf);
+    EXPECT_EQ(v->sat_id, 0xCAFEBABEu);
+    EXPECT_EQ(FrameView<PacketB_t>::size(), sizeof(PacketB_t));
+}
+
+TEST(FrameDispatchTest, ViewRejectsOtherKind) {
+    uint8_t buf[256] = {0};
+    const size_t n = ReadVector("packet_a.bin", buf, sizeof(buf));
+    Status st = Status::kOk;
+    EXPECT_FALSE(frame_dispatch::view_as<PacketB_t>(buf, n, &st));
+    EXPECT_EQ(st, Status::kWrongKind);
+}
+
+TEST(FrameDispatchTest, RejectsTruncatedAndPaddedFrames) {
+    uint8_t buf[256] = {0};
+    const size_t n = ReadVector("packet_b.bin", buf, sizeof(buf));
+    EXPECT_EQ(frame_dispatch::classify(buf, sizeof(VoidHeader_t) - 1, nullptr),
+              Status::kTooShort);
+    EXPECT_EQ(frame_dispatch::classify(buf, n - 1, nullptr), Status::kLengthMismatch);
+    EXPECT_EQ(frame_dispatch::classify(buf, n + 1, nullptr), Status::kLengthMismatch);
+}
+
+TEST(FrameDispatchTest, RejectsCorruptHeaderFields) {
+    uint8_t golden[256] = {0};
+    const size_t n = ReadVector("packet_b.bin", golden, sizeof(golden));
+    uint8_t buf[256];
+    const size_t id_off = offsetof(VoidHeader_t, ver_type_sec);
+
+#if VOID_PROTOCOL_TYPE == 2
+    // A broken sync word is indistinguishable from a CCSDS frame to the
+    // auto-detector; the fixed-tier codec names the real fault.
+    std::memcpy(buf, golden, n);
+    buf[0] ^= 0x01u;
+    EXPECT_EQ(Codec<Tier::kSnlp>::classify(buf, n, nullptr), Status::kBadSync);
+    EXPECT_NE(frame_dispatch::classify(buf, n, nullptr), Status::kOk);
+#endif
+
+    std::memcpy(buf, golden, n);
+    buf[id_off] |= 0x20u; // version 1
+    EXPECT_EQ(frame_dispatch::classify(buf, n, nullptr), Status::kBadVersion);
+
+    std::memcpy(buf, golden, n);
+    buf[id_off] |= 0x07u;
+    buf[id_off + 1] = 0xFFu; // APID 0x7FF (idle)
+    EXPECT_EQ(frame_dispatch::classify(buf, n, nullptr), Status::kIdleApid);
+}
+
+TEST(FrameDispatchTest, UnknownBodyLengthIsRejected) {
+    uint8_t buf[256] = {0};
+    const size_t n = ReadVector("packet_b.bin", buf, sizeof(buf));
+    // Shrink packet_len + len consistently to a length no type uses.
+    const size_t odd_len = n - 3;
+    const uint16_t plen = static_cast<uint16_t>(odd_len - sizeof(VoidHeader_t) - 1);
+    buf[offsetof(VoidHeader_t, packet_len)]     = static_cast<uint8_t>(plen >> 8);
+    buf[offsetof(VoidHeader_t, packet_len) + 1] = static_cast<uint8_t>(plen & 0xFFu);
+    EXPECT_EQ(frame_dispatch::classify(buf, odd_len, nullptr), Status::kUnknownLength);
+}
+
+// F-03: D and ACK are discriminated by body offset 0, not by length
+// alone. A zeroed magic must never be routed as either.
+TEST(FrameDispatchTest, MagicByteDiscriminatesDeliveryAndAck) {
+    const char* const names[] = {"packet_d.bin", "packet_ack.bin"};
+    for (const char* name : names) {
+        uint8_t buf[256] = {0};
+        const size_t n = ReadVector(name, buf, sizeof(buf));
+        buf[sizeof(VoidHeader_t)] = 0x00u;
+        EXPECT_EQ(frame_dispatch::classify(buf, n, nullptr), Status::kBadMagic) << name;
+    }
+#if VOID_PROTOCOL_TYPE == 2
+    // SNLP dispatch_122: same length, magic alone picks the type.
+    uint8_t buf[256] = {0};
+    const size_t n = ReadVector("packet_d.bin", buf, sizeof(buf));
+    buf[sizeof(VoidHeader_t)] = PACKET_ACK_MAGIC;
+    FrameInfo info = {};
+    ASSERT_EQ(frame_dispatch::classify(buf, n, &info), Status::kOk);
+    EXPECT_EQ(info.kind, FrameKind::kAck);
+#endif
+}
+
+TEST(FrameDispatchTest, DispatcherRoutesToTypedHandlers) {
+    Dispatcher d;
+    Seen seen_b = {}, seen_d = {}, seen_ack = {};
+    d.on<PacketB_t>(&OnPacketB, &seen_b);
+    d.on<PacketD_t>(&OnPacketD, &seen_d);
+    d.on<PacketAck_t>(&OnPacketAck, &seen_ack);
+
+    uint8_t b[256] = {0}, dd[256] = {0}, ack[256] = {0}, a[256] = {0};
+    const size_t nb   = ReadVector("packet_b.bin", b, sizeof(b));
+    const size_t nd   = ReadVector("packet_d.bin", dd, sizeof(dd));
+    const size_t nack = ReadVector("packet_ack.bin", ack, sizeof(ack));
+    const size_t na   = ReadVector("packet_a.bin", a, sizeof(a));
+
+    EXPECT_EQ(d.dispatch(b, nb), Status::kOk);
+    EXPECT_EQ(d.dispatch(dd, nd), Status::kOk);
+    EXPECT_EQ(d.dispatch(ack, nack), Status::kOk);
+    EXPECT_EQ(d.dispatch(a, na), Status::kNoHandler);
+
+    EXPECT_EQ(seen_b.calls, 1);
+    EXPECT_EQ(seen_b.kind, FrameKind::kB);
+    EXPECT_EQ(seen_b.sat_id, 0xCAFEBABEu);
+    EXPECT_EQ(seen_b.base, b);
+    EXPECT_EQ(seen_d.calls, 1);
+    EXPECT_EQ(seen_d.kind, FrameKind::kD);
+    EXPECT_EQ(seen_ack.calls, 1);
+    EXPECT_EQ(seen_ack.kind, FrameKind::kAck);
+
+    d.off(kBuildTier, FrameKind::kB);
+    EXPECT_EQ(d.dispatch(b, nb), Status::kNoHandler);
+    EXPECT_EQ(seen_b.calls, 1);
+}
+
+TEST(FrameDispatchTest, DispatcherHonoursApidFilter) {
+    Dispatcher d;
+    Seen seen = {};
+    uint8_t b[256] = {0};
+    const size_t nb = ReadVector("packet_b.bin", b, sizeof(b));
+
+    d.on<PacketB_t>(&OnPacketB, &seen, kApidSatA);
+    EXPECT_EQ(d.dispatch(b, nb), Status::kApidFiltered);
+    EXPECT_EQ(seen.calls, 0);
+
+    d.on<PacketB_t>(&OnPacketB, &seen, kApidSatB);
+    EXPECT_EQ(d.dispatch(b, nb), Status::kOk);
+    EXPECT_EQ(seen.calls, 1);
+}
+
+// ---------------------------------------------------------------------
+// Dual-tier: both wire formats decoded by one binary, no
+// VOID_PROTOCOL_TYPE involved.
+// ---------------------------------------------------------------------
+
+namespace {
+
+struct DualSeen {
+    int      snlp_b;
+    int      ccsds_b;
+    uint32_t last_sat_id;
+};
+
+void OnSnlpB(const FrameView<snlp::PacketB_t>& v, void* user) {
+    DualSeen* s = static_cast<DualSeen*>(user);
+    ++s->snlp_b;
+    s->last_sat_id = v->sat_id;
+}
+
+void OnCcsdsB(const FrameView<ccsds::PacketB_t>& v, void* user) {
+    DualSeen* s = static_cast<DualSeen*>(user);
+    ++s->ccsds_b;
+    s->last_sat_id = v->sat_id;
+}
+
+}  // namespace
+
+TEST(DualTierCodecTest, AutoDetectsBothTiersInOneBinary) {
+    const char* const tiers[] = {"snlp", "ccsds"};
+    for (const char* tier : tiers) {
+        const Tier want = (std::strcmp(tier, "snlp") == 0) ? Tier::kSnlp : Tier::kCcsds;
+        for (const Golden& g : kGoldens) {
+            uint8_t buf[256] = {0};
+            const size_t n = ReadTierVector(tier, g.name, buf, sizeof(buf));
+            ASSERT_GT(n, 0u) << tier << "/" << g.name;
+            EXPECT_EQ(frame_dispatch::detect_tier(buf, n), want) << tier << "/" << g.name;
+            FrameInfo info = {};
+            ASSERT_EQ(frame_dispatch::classify(buf, n, &info), Status::kOk)
+                << tier << "/" << g.name;
+            EXPECT_EQ(info.tier, want);
+            EXPECT_EQ(info.kind, g.kind) << tier << "/" << g.name;
+        }
+    }
+}
+
+TEST(DualTierCodecTest, FixedTierCodecRejectsOtherTier) {
+    uint8_t snlp_b[256] = {0}, ccsds_b[256] = {0};
+    const size_t ns = ReadTierVector("snlp", "packet_b.bin", snlp_b, sizeof(snlp_b));
+    const size_t nc = ReadTierVector("ccsds", "packet_b.bin", ccsds_b, sizeof(ccsds_b));
+    EXPECT_EQ(Codec<Tier::kSnlp>::classify(snlp_b, ns, nullptr), Status::kOk);
+    EXPECT_EQ(Codec<Tier::kCcsds>::classify(ccsds_b, nc, nullptr), Status::kOk);
+    EXPECT_EQ(Codec<Tier::kSnlp>::classify(ccsds_b, nc, nullptr), Status::kBadSync);
+    EXPECT_NE(Codec<Tier::kCcsds>::classify(snlp_b, ns, nullptr), Status::kOk);
+
+    EXPECT_TRUE(Codec<Tier::kSnlp>::view<snlp::PacketB_t>(snlp_b, ns));
+    EXPECT_TRUE(Codec<Tier::kCcsds>::view<ccsds::PacketB_t>(ccsds_b, nc));
+    EXPECT_FALSE(frame_dispatch::view_as<snlp::PacketB_t>(ccsds_b, nc));
+}
+
+TEST(DualTierCodecTest, OneDispatcherServesBothRadios) {
+    Dispatcher d;
+    DualSeen seen = {};
+    d.on<snlp::PacketB_t>(&OnSnlpB, &seen);
+    d.on<ccsds::PacketB_t>(&OnCcsdsB, &seen);
+
+    uint8_t snlp_b[256] = {0}, ccsds_b[256] = {0};
+    const size_t ns = ReadTierVector("snlp", "packet_b.bin", snlp_b, sizeof(snlp_b));
+    const size_t nc = ReadTierVector("ccsds", "packet_b.bin", ccsds_b, sizeof(ccsds_b));
+
+    EXPECT_EQ(d.dispatch(snlp_b, ns), Status::kOk);
+    EXPECT_EQ(d.dispatch(ccsds_b, nc), Status::kOk);
+    EXPECT_EQ(d.dispatch_as<Tier::kCcsds>(ccsds_b, nc), Status::kOk);
+    EXPECT_EQ(d.dispatch_as<Tier::kSnlp>(ccsds_b, nc), Status::kBadSync);
+    EXPECT_EQ(seen.snlp_b, 1);
+    EXPECT_EQ(seen.ccsds_b, 2);
+    EXPECT_EQ(seen.last_sat_id, 0xCAFEBABEu);
+}
+
+// write_header() must reproduce generate_packets.go::buildHeader for
+// every golden frame in both tiers.
+TEST(DualTierCodecTest, WriteHeaderMatchesGoldenHeaders) {
+    const char* const tiers[] = {"snlp", "ccsds"};
+    for (const char* tier : tiers) {
+        const bool is_snlp = std::strcmp(tier, "snlp") == 0;
+        const size_t hdr_len = is_snlp ? Codec<Tier::kSnlp>::kHeaderSize
+                                       : Codec<Tier::kCcsds>::kHeaderSize;
+        for (const Golden& g : kGoldens) {
+            uint8_t golden[256] = {0};
+            const size_t n = ReadTierVector(tier, g.name, golden, sizeof(golden));
+            FrameInfo info = {};
+            ASSERT_EQ(frame_dispatch::classify(golden, n, &info), Status::kOk);
+
+            uint8_t hdr[16] = {0};
+            const bool ok = is_snlp
+                ? Codec<Tier::kSnlp>::write_header(hdr, sizeof(hdr), info.apid,
+                                                   info.is_command, info.seq_count, n)
+                : Codec<Tier::kCcsds>::write_header(hdr, sizeof(hdr), info.apid,
+                                                    info.is_command, info.seq_count, n);
+            ASSERT_TRUE(ok);
+            EXPECT_EQ(std::memcmp(hdr, golden, hdr_len), 0) << tier << "/" << g.name;
+        }
+    }
+    uint8_t tiny[4];
+    EXPECT_FALSE(Codec<Tier::kSnlp>::write_header(tiny, sizeof(tiny), 101, false, 0, 192));
+    EXPECT_FALSE(Codec<Tier::kCcsds>::write_header(tiny, 6, 101, false, 0, 6));
+}
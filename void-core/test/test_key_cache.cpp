@@ -0,0 +1,136 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_key_cache.cpp
+ * Desc:      Ephemeral keypair cache: FIFO of fresh valid keys, inline
+ *            fallback when empty, refill from another thread, and
+ *            SecurityManager spending and zeroising cached keys.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <sodium.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "key_cache.h"
+#include "security_manager.h"
+
+using key_cache::KeyCache;
+using key_cache::Keypair;
+
+namespace {
+
+bool pub_matches_priv(const Keypair& kp) {
+    uint8_t pub[key_cache::kKeySize];
+    crypto_scalarmult_base(pub, kp.priv);
+    return std::memcmp(pub, kp.pub, sizeof(pub)) == 0;
+}
+
+} // namespace
+
+TEST(KeyCache, HandsOutFreshKeysOldestFirstAndFallsBackInline) {
+    ASSERT_GE(sodium_init(), 0);
+    KeyCache cache;
+    EXPECT_EQ(cache.available(), 0u);
+
+    size_t made = 0;
+    while (cache.refill_one()) ++made;
+    EXPECT_EQ(made, key_cache::kSlots);
+    EXPECT_EQ(cache.available(), key_cache::kSlots);
+
+    std::set<std::string> seen;
+    Keypair kp;
+    for (size_t i = 0; i < key_cache::kSlots; ++i) {
+        cache.take(kp);
+        ASSERT_TRUE(pub_matches_priv(kp));
+        seen.insert(std::string(reinterpret_cast<const char*>(kp.pub), sizeof(kp.pub)));
+    }
+    EXPECT_EQ(seen.size(), key_cache::kSlots);
+    EXPECT_EQ(cache.stats().misses, 0u);
+
+    // Empty: still a valid, unseen keypair, counted as a miss.
+    cache.take(kp);
+    EXPECT_TRUE(pub_matches_priv(kp));
+    EXPECT_EQ(seen.count(std::string(reinterpret_cast<const char*>(kp.pub), sizeof(kp.pub))), 0u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+    EXPECT_EQ(cache.stats().taken, key_cache::kSlots);
+
+    // wipe() drops what is left and makes room again.
+    cache.refill_one();
+    cache.refill_one();
+    EXPECT_EQ(cache.wipe(), 2u);
+    EXPECT_EQ(cache.available(), 0u);
+    EXPECT_EQ(cache.stats().wiped, 2u);
+    EXPECT_TRUE(cache.refill_one());
+}
+
+// The second-core layout: one thread refills, the other takes. Every key
+// taken must be whole (pub derived from priv) and none handed out twice.
+TEST(KeyCache, RefillsFromAnotherThreadWithoutTearing) {
+    ASSERT_GE(sodium_init(), 0);
+    KeyCache cache;
+    std::atomic<bool> done(false);
+    std::thread producer([&cache, &done]() {
+        while (!done.load()) {
+            if (!cache.refill_one()) std::this_thread::yield();
+        }
+    });
+
+    std::set<std::string> seen;
+    size_t torn = 0;
+    Keypair kp;
+    for (int i = 0; i < 400; ++i) {
+        cache.take(kp);
+        if (!pub_matches_priv(kp)) ++torn;
+        seen.insert(std::string(reinterpret_cast<const char*>(kp.pub), sizeof(kp.pub)));
+        if (i % 50 == 0) cache.wipe();
+    }
+    done.store(true);
+    producer.join();
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(seen.size(), 400u);
+    const key_cache::Stats st = cache.stats();
+    EXPECT_EQ(st.taken + st.misses, 400u);
+    EXPECT_EQ(st.generated, st.taken + st.wiped + cache.available());
+}
+
+TEST(KeyCache, SecurityManagerSpendsCachedKeysAndWipesThemAtTtl) {
+    SecurityManager sm;
+    ASSERT_TRUE(sm.begin());
+    while (sm.refillKeyCache()) {}
+    ASSERT_EQ(sm.keyCache().available(), key_cache::kSlots);
+
+    PacketH_t init = {};
+    sm.prepareHandshake(init, 10, 1000);
+    EXPECT_EQ(sm.keyCache().stats().taken, 1u);
+    EXPECT_EQ(sm.keyCache().stats().misses, 0u);
+
+    // Ground side of the exchange; the session goes ACTIVE.
+    uint8_t ground_pub[32], ground_priv[32];
+    crypto_box_keypair(ground_pub, ground_priv);
+    PacketH_t resp = {};
+    std::memcpy(resp.eph_pub_key, ground_pub, sizeof(ground_pub));
+    ASSERT_TRUE(sm.processHandshakeResponse(resp));
+
+    EXPECT_TRUE(sm.isSessionActive(1000 + 10000));
+    EXPECT_EQ(sm.keyCache().available(), key_cache::kSlots - 1);
+    EXPECT_FALSE(sm.isSessionActive(1000 + 10001));  // TTL over
+    EXPECT_EQ(sm.keyCache().available(), 0u);
+    EXPECT_EQ(sm.keyCache().stats().wiped, key_cache::kSlots - 1);
+
+    // Already idle: no further wipe on later checks.
+    sm.refillKeyCache();
+    EXPECT_FALSE(sm.isSessionActive(1000 + 20000));
+    EXPECT_EQ(sm.keyCache().available(), 1u);
+    sm.wipeSession();
+    EXPECT_EQ(sm.keyCache().available(), 0u);
+}
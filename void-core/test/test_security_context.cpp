@@ -0,0 +1,224 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_security_context.cpp
+ * Desc:      Re-entrant security context: shared identity signing,
+ *            two-sided handshake, PacketB encrypt → store decrypt,
+ *            sharded store churn, and concurrent crypto across threads.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <sodium.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include "void_packets.h"
+#include "security_context.h"
+
+using security_context::Identity;
+using security_context::Session;
+using security_context::SessionStore;
+
+namespace {
+
+void make_identity(Identity& id, uint8_t tag) {
+    uint8_t seed[security_context::kSeedSize];
+    std::memset(seed, tag, sizeof(seed));
+    ASSERT_TRUE(id.init_from_seed(seed));
+}
+
+Session idle_session() {
+    Session s;
+    std::memset(&s, 0, sizeof(s));
+    return s;
+}
+
+void fill_key(uint8_t* key, uint32_t sat_id) {
+    for (size_t i = 0; i < security_context::kSessionKeySize; ++i) {
+        key[i] = static_cast<uint8_t>(sat_id * 31u + i);
+    }
+}
+
+} // namespace
+
+TEST(SecurityContext, IdentitySignsWithItsPublicKey) {
+    Identity id;
+    EXPECT_FALSE(id.ready());
+    uint8_t sig[security_context::kSignatureSize];
+    const uint8_t msg[] = "VOID";
+    EXPECT_FALSE(id.sign(msg, sizeof(msg), sig));
+
+    make_identity(id, 0x42);
+    ASSERT_TRUE(id.sign(msg, sizeof(msg), sig));
+    EXPECT_EQ(crypto_sign_verify_detached(sig, msg, sizeof(msg), id.public_key()), 0);
+}
+
+TEST(SecurityContext, BothHandshakeSidesDeriveTheSameKey) {
+    Identity sat_id, ground_id;
+    make_identity(sat_id, 1);
+    make_identity(ground_id, 2);
+    Session sat = idle_session(), ground = idle_session();
+
+    PacketH_t init = {}, resp = {};
+    security_context::begin_handshake(sat, sat_id, init, 600, 1000);
+    security_context::begin_handshake(ground, ground_id, resp, 600, 1000);
+    EXPECT_EQ(sat.state, SESSION_HANDSHAKE_INIT);
+    EXPECT_EQ(crypto_sign_verify_detached(init.signature, reinterpret_cast<const uint8_t*>(&init),
+                                          offsetof(PacketH_t, signature), sat_id.public_key()),
+              0);
+
+    ASSERT_TRUE(security_context::complete_handshake(sat, resp.eph_pub_key));
+    ASSERT_TRUE(security_context::complete_handshake(ground, init.eph_pub_key));
+    EXPECT_EQ(std::memcmp(sat.key, ground.key, sizeof(sat.key)), 0);
+    const uint8_t zero[security_context::kPubKeySize] = {};
+    EXPECT_EQ(std::memcmp(sat.eph_priv, zero, sizeof(zero)), 0);  // forward secrecy
+    EXPECT_TRUE(security_context::is_active(sat, 1000 + 600000));
+    EXPECT_FALSE(security_context::is_active(sat, 1000 + 600001));
+    EXPECT_EQ(sat.state, SESSION_IDLE);
+}
+
+TEST(SecurityContext, PacketBEncryptedOnBoardDecryptsThroughTheStore) {
+    Identity id;
+    make_identity(id, 3);
+    uint8_t key[security_context::kSessionKeySize];
+    fill_key(key, 7);
+    Session sat = idle_session();
+    security_context::activate(sat, key, 600, 0);
+
+    static SessionStore store;
+    store.clear();
+    ASSERT_TRUE(store.install(0xCAFE0007u, key, 600, 0));
+
+    PacketB_t pkt = {};
+    pkt.sat_id   = 0xCAFE0007u;
+    pkt.epoch_ts = 1790985600000ull;
+    uint8_t payload[sizeof(pkt.enc_payload)];
+    for (size_t i = 0; i < sizeof(payload); ++i) payload[i] = static_cast<uint8_t>(i);
+
+    EXPECT_FALSE(security_context::encrypt_packet_b(sat, id, pkt, payload, sizeof(payload), false));
+    ASSERT_TRUE(security_context::encrypt_packet_b(sat, id, pkt, payload, sizeof(payload), true));
+    EXPECT_NE(std::memcmp(pkt.enc_payload, payload, sizeof(payload)), 0);
+    EXPECT_EQ(crypto_sign_verify_detached(pkt.signature, reinterpret_cast<const uint8_t*>(&pkt),
+                                          offsetof(PacketB_t, signature), id.public_key()),
+              0);
+    // VOID-110: the same epoch never encrypts twice.
+    EXPECT_FALSE(security_context::encrypt_packet_b(sat, id, pkt, payload, sizeof(payload), true));
+
+    uint8_t plain[sizeof(pkt.enc_payload)];
+    ASSERT_TRUE(store.crypt(pkt.sat_id, pkt.epoch_ts, pkt.enc_payload, sizeof(plain), plain, 10));
+    EXPECT_EQ(std::memcmp(plain, payload, sizeof(payload)), 0);
+    EXPECT_FALSE(store.crypt(pkt.sat_id + 1, pkt.epoch_ts, pkt.enc_payload, sizeof(plain), plain, 10));
+}
+
+TEST(SecurityContext, StoreExpiresErasesAndReplacesSessions) {
+    static SessionStore store;
+    store.clear();
+    uint8_t key[security_context::kSessionKeySize];
+    fill_key(key, 1);
+    uint8_t buf[16] = {};
+
+    ASSERT_TRUE(store.install(1, key, 10, 0));
+    ASSERT_TRUE(store.install(2, key, 10, 0));
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_TRUE(store.crypt(1, 0, buf, sizeof(buf), buf, 10000));
+    EXPECT_FALSE(store.crypt(1, 0, buf, sizeof(buf), buf, 10001));  // expired: dropped
+    EXPECT_EQ(store.size(), 1u);
+
+    EXPECT_TRUE(store.erase(2));
+    EXPECT_FALSE(store.erase(2));
+    EXPECT_FALSE(store.active(2, 0));
+
+    // Re-installing a live sat replaces its key and restarts its TTL.
+    ASSERT_TRUE(store.install(3, key, 10, 0));
+    ASSERT_TRUE(store.install(3, key, 10, 9000));
+    EXPECT_TRUE(store.active(3, 18000));
+    EXPECT_EQ(store.size(), 1u);
+}
+
+// Random installs and erases against a reference set: backward-shift
+// deletion inside a shard must never lose a live sat, and a full shard
+// refuses new sats without disturbing the others.
+TEST(SecurityContext, StoreChurnMatchesAReferenceSet) {
+    static SessionStore store;
+    store.clear();
+    uint8_t key[security_context::kSessionKeySize];
+    std::set<uint32_t> live;
+    std::mt19937 rng(21);
+    size_t refused = 0;
+    for (int i = 0; i < 40000; ++i) {
+        const uint32_t sat = rng() % 6000;
+        if (rng() % 3 == 0) {
+            ASSERT_EQ(store.erase(sat), live.erase(sat) == 1);
+            continue;
+        }
+        fill_key(key, sat);
+        if (store.install(sat, key, 600, 0)) {
+            live.insert(sat);
+        } else {
+            ASSERT_EQ(live.count(sat), 0u);
+            ++refused;
+        }
+    }
+    EXPECT_GT(refused, 0u);
+    EXPECT_EQ(store.size(), live.size());
+    EXPECT_LE(store.size(), SessionStore::kMaxSessions + 0u);
+    for (uint32_t sat = 0; sat < 6000; ++sat) {
+        ASSERT_EQ(store.active(sat, 1), live.count(sat) == 1) << "sat " << sat;
+    }
+}
+
+// Threads decrypting for their own sats while others install and
+// erase in the same shards: every round trip must come back intact and
+// match a single-threaded reference computed with the sat's key.
+TEST(SecurityContext, CryptRunsConcurrentlyAcrossThreads) {
+    static SessionStore store;
+    store.clear();
+    constexpr uint32_t kSatsPerThread = 200;
+    constexpr unsigned kThreads = 8;
+    uint8_t key[security_context::kSessionKeySize];
+    for (uint32_t sat = 0; sat < kSatsPerThread * kThreads; ++sat) {
+        fill_key(key, sat);
+        ASSERT_TRUE(store.install(sat, key, 600, 0));
+    }
+
+    std::atomic<size_t> failures(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < kThreads; ++t) {
+        workers.emplace_back([t, &failures]() {
+            std::mt19937 rng(t);
+            uint8_t k[security_context::kSessionKeySize];
+            uint8_t plain[96], cipher[96], expect[96], back[96];
+            for (int i = 0; i < 3000; ++i) {
+                const uint32_t sat = t * kSatsPerThread + static_cast<uint32_t>(rng() % kSatsPerThread);
+                const uint64_t epoch = rng();
+                for (size_t b = 0; b < sizeof(plain); ++b) plain[b] = static_cast<uint8_t>(rng());
+                fill_key(k, sat);
+                security_context::chacha20_xor(k, sat, epoch, plain, sizeof(plain), expect);
+                if (!store.crypt(sat, epoch, plain, sizeof(plain), cipher, 1) ||
+                    std::memcmp(cipher, expect, sizeof(cipher)) != 0 ||
+                    !store.crypt(sat, epoch, cipher, sizeof(cipher), back, 1) ||
+                    std::memcmp(back, plain, sizeof(back)) != 0) {
+                    ++failures;
+                }
+                // Churn sats no worker decrypts for.
+                const uint32_t other = 100000u + static_cast<uint32_t>(rng() % 2000);
+                if (i % 2 == 0) {
+                    store.install(other, k, 600, 0);
+                } else {
+                    store.erase(other);
+                }
+            }
+        });
+    }
+    for (std::thread& w : workers) w.join();
+    EXPECT_EQ(failures.load(), 0u);
+}
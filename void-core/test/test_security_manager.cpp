@@ -19,7 +19,6 @@ class SecurityManagerTest : public ::testing::Test {
 protected:
     SecurityManager secman;
     void SetUp() override {
-        secman = SecurityManager();
         secman.begin();
     }
 };
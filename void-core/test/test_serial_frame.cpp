@@ -0,0 +1,248 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_serial_frame.cpp
+ * Desc:      COBS serial-link framing: round trips, zero-run edge
+ *            cases, CRC rejection and resync on the 0x00 delimiter;
+ *            the board-side command link's offer / revert handling.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "void_packets.h"
+#include "serial_frame.h"
+
+using serial_frame::CommandLink;
+using serial_frame::Decoder;
+using serial_frame::Type;
+
+namespace {
+
+// Counts decoder outcomes and keeps a copy of the last good frame.
+struct Sink {
+    Decoder  dec;
+    int      frames = 0;
+    int      errors = 0;
+    int      overflows = 0;
+    Type     type   = Type::kLine;
+    uint8_t  last[serial_frame::kMaxPayload];
+    size_t   last_len = 0;
+
+    void feed(const uint8_t* p, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            const Decoder::Result r = dec.push(p[i]);
+            if (r == Decoder::Result::kFrame) {
+                ++frames;
+                type = dec.type();
+                last_len = dec.payload_len();
+                std::memcpy(last, dec.payload(), last_len);
+            } else if (r == Decoder::Result::kError) {
+                ++errors;
+            } else if (r == Decoder::Result::kOverflow) {
+                ++overflows;
+            }
+        }
+    }
+};
+
+size_t ReadVector(const char* name, uint8_t* buf, size_t buf_cap) {
+    std::string path = VOID_TEST_VECTORS_DIR "/" VOID_TEST_VECTORS_TIER "/";
+    path += name;
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (f == nullptr) return 0;
+    const size_t n = std::fread(buf, 1, buf_cap, f);
+    std::fclose(f);
+    return n;
+}
+
+// Feeds `len` bytes to the link; returns the last non-kNone event and
+// counts commands.
+struct LinkFeed {
+    CommandLink link;
+    int         commands = 0;
+    std::string last_cmd;
+
+    CommandLink::Event feed(const uint8_t* p, size_t len) {
+        CommandLink::Event ev = CommandLink::Event::kNone;
+        for (size_t i = 0; i < len; ++i) {
+            const CommandLink::Event e = link.push(p[i]);
+            if (e == CommandLink::Event::kNone) continue;
+            ev = e;
+            if (e == CommandLink::Event::kCommand) {
+                ++commands;
+                last_cmd.assign(link.command(), link.command_len());
+            }
+        }
+        return ev;
+    }
+    CommandLink::Event ascii(const char* text) {
+        return feed(reinterpret_cast<const uint8_t*>(text), std::strlen(text));
+    }
+    CommandLink::Event framed(Type type, const char* text) {
+        uint8_t wire[serial_frame::kMaxEncoded];
+        const size_t n = serial_frame::encode(type, reinterpret_cast<const uint8_t*>(text),
+                                              std::strlen(text), wire, sizeof(wire));
+        return feed(wire, n);
+    }
+};
+
+}  // namespace
+
+TEST(SerialFrame, GoldenPacketBRoundTripsWithSmallOverhead) {
+    uint8_t pkt[sizeof(PacketB_t)];
+    ASSERT_EQ(ReadVector("packet_b.bin", pkt, sizeof(pkt)), sizeof(pkt));
+
+    uint8_t wire[serial_frame::kMaxEncoded];
+    const size_t n = serial_frame::encode(Type::kFrame, pkt, sizeof(pkt), wire, sizeof(wire));
+    ASSERT_GT(n, 0u);
+    EXPECT_EQ(wire[n - 1], 0x00u);
+    EXPECT_EQ(std::memchr(wire, 0x00, n - 1), nullptr); // no zero inside the frame
+    EXPECT_LE(n, sizeof(pkt) + 8u); // vs 2 * sizeof(pkt) + 10 as a hex line
+
+    Sink s;
+    s.feed(wire, n);
+    ASSERT_EQ(s.frames, 1);
+    EXPECT_EQ(s.type, Type::kFrame);
+    ASSERT_EQ(s.last_len, sizeof(pkt));
+    EXPECT_EQ(std::memcmp(s.last, pkt, sizeof(pkt)), 0);
+}
+
+TEST(SerialFrame, ZeroRunsAndLongBlocksRoundTrip) {
+    // All-zero, no-zero (forces 254-byte COBS blocks) and mixed payloads
+    // at every interesting length around the block boundary.
+    const size_t lens[] = {0, 1, 2, 253, 254, 255, serial_frame::kMaxPayload};
+    for (const size_t len : lens) {
+        for (int pattern = 0; pattern < 3; ++pattern) {
+            uint8_t p[serial_frame::kMaxPayload];
+            for (size_t i = 0; i < len; ++i) {
+                p[i] = (pattern == 0) ? 0x00u
+                     : (pattern == 1) ? static_cast<uint8_t>(1 + (i % 255))
+                     : static_cast<uint8_t>((i % 3 == 0) ? 0 : i);
+            }
+            uint8_t wire[serial_frame::kMaxEncoded];
+            const size_t n = serial_frame::encode(Type::kTxFrame, p, len, wire, sizeof(wire));
+            ASSERT_GT(n, 0u) << len;
+            Sink s;
+            s.feed(wire, n);
+            ASSERT_EQ(s.frames, 1) << "len=" << len << " pattern=" << pattern;
+            ASSERT_EQ(s.last_len, len);
+            EXPECT_EQ(std::memcmp(s.last, p, len), 0);
+        }
+    }
+}
+
+TEST(SerialFrame, CorruptFrameIsDroppedAndStreamResyncs) {
+    const uint8_t a[] = {'W', 'A', 'R', 'N'};
+    const uint8_t b[] = {'S', 'A', 'T', '_', 'R', 'E', 'A', 'D', 'Y'};
+    uint8_t wire[2 * serial_frame::kMaxEncoded];
+    const size_t na = serial_frame::encode(Type::kLine, a, sizeof(a), wire, sizeof(wire));
+    const size_t nb = serial_frame::encode(Type::kLine, b, sizeof(b), wire + na, sizeof(wire) - na);
+    wire[2] ^= 0x20u; // flip a bit inside frame 1
+
+    Sink s;
+    s.feed(wire, na + nb);
+    EXPECT_EQ(s.errors, 1);
+    ASSERT_EQ(s.frames, 1);
+    ASSERT_EQ(s.last_len, sizeof(b));
+    EXPECT_EQ(std::memcmp(s.last, b, sizeof(b)), 0);
+}
+
+TEST(SerialFrame, OverflowAndStrayBytesAreRejected) {
+    Sink s;
+    // ASCII text with no delimiter (e.g. a board that rebooted into
+    // hex mode) overflows once, then is discarded up to the next 0x00.
+    uint8_t junk[serial_frame::kMaxEncoded + 40];
+    std::memset(junk, 'A', sizeof(junk));
+    s.feed(junk, sizeof(junk));
+    EXPECT_EQ(s.overflows, 1);
+    EXPECT_EQ(s.errors, 0);
+    const uint8_t zero = 0x00;
+    s.feed(&zero, 1);
+    s.feed(&zero, 1); // bare delimiters are ignored
+    EXPECT_EQ(s.overflows, 1);
+    EXPECT_EQ(s.errors, 0);
+    EXPECT_EQ(s.frames, 0);
+
+    // Too short to hold type + CRC.
+    const uint8_t runt[] = {0x03, 0x01, 0x02, 0x00};
+    s.feed(runt, sizeof(runt));
+    EXPECT_EQ(s.errors, 1);
+
+    const uint8_t p[] = {1, 2, 3};
+    uint8_t wire[serial_frame::kMaxEncoded];
+    const size_t n = serial_frame::encode(Type::kLine, p, sizeof(p), wire, sizeof(wire));
+    wire[1] = 0x7Fu; // corrupt the type byte (first data byte after the COBS code)
+    s.feed(wire, n);
+    EXPECT_EQ(s.errors, 2);
+    EXPECT_EQ(s.frames, 0);
+}
+
+TEST(SerialFrame, EncodeRejectsOversizeAndShortOutput) {
+    uint8_t big[serial_frame::kMaxPayload + 1] = {0};
+    uint8_t wire[serial_frame::kMaxEncoded + 8];
+    EXPECT_EQ(serial_frame::encode(Type::kFrame, big, sizeof(big), wire, sizeof(wire)), 0u);
+    EXPECT_EQ(serial_frame::encode(Type::kFrame, big, 16, wire, 16), 0u);
+    EXPECT_EQ(serial_frame::encode(Type::kFrame, nullptr, 4, wire, sizeof(wire)), 0u);
+}
+
+TEST(SerialFrame, CommandLinkNegotiatesAndReverts) {
+    LinkFeed f;
+    EXPECT_EQ(f.ascii("H\r\n"), CommandLink::Event::kCommand);
+    EXPECT_EQ(f.last_cmd, "H");
+    EXPECT_EQ(f.ascii("FRAMING:COBS\n"), CommandLink::Event::kOffer);
+    EXPECT_TRUE(f.link.binary());
+
+    // Binary: commands come framed; bare ASCII lines are dropped.
+    EXPECT_EQ(f.framed(Type::kLine, "ACK_BUY"), CommandLink::Event::kCommand);
+    EXPECT_EQ(f.last_cmd, "ACK_BUY");
+    EXPECT_EQ(f.ascii("H\n"), CommandLink::Event::kNone);
+    EXPECT_EQ(f.framed(Type::kTxFrame, "PACKET"), CommandLink::Event::kNone);
+    EXPECT_EQ(f.commands, 2);
+
+    // Revert as a frame, then ASCII commands work again.
+    EXPECT_EQ(f.framed(Type::kLine, serial_frame::kRevertLine), CommandLink::Event::kRevert);
+    EXPECT_FALSE(f.link.binary());
+    EXPECT_EQ(f.ascii("H\n"), CommandLink::Event::kCommand);
+
+    // ... and as an ASCII line from a station started with
+    // VOID_SERIAL_FRAMING=hex.
+    EXPECT_EQ(f.ascii("FRAMING:COBS\n"), CommandLink::Event::kOffer);
+    EXPECT_EQ(f.ascii("FRAMING:HEX\n"), CommandLink::Event::kRevert);
+    EXPECT_FALSE(f.link.binary());
+    EXPECT_EQ(f.commands, 3);
+}
+
+// The ground station restarts while the board is binary: the new
+// process talks ASCII and re-offers. Neither COBS bytes that contain
+// '\n' nor a frame cut off mid-write may spoil the offer line.
+TEST(SerialFrame, CommandLinkAnswersReofferAfterGroundRestart) {
+    LinkFeed f;
+    ASSERT_EQ(f.ascii("FRAMING:COBS\n"), CommandLink::Event::kOffer);
+
+    // A whole frame whose COBS bytes include 0x0A, then the offer.
+    EXPECT_EQ(f.framed(Type::kLine, "A\nB\nFRAMING:COBS"), CommandLink::Event::kCommand);
+    EXPECT_EQ(f.ascii("FRAMING:COBS\n"), CommandLink::Event::kOffer);
+    EXPECT_TRUE(f.link.binary());
+
+    // The old process died mid-frame: no delimiter. The offer's leading
+    // newline (as main.cpp sends it) ends the fragment.
+    uint8_t wire[serial_frame::kMaxEncoded];
+    const size_t n = serial_frame::encode(Type::kLine,
+                                          reinterpret_cast<const uint8_t*>("ACK_BUY"), 7,
+                                          wire, sizeof(wire));
+    ASSERT_GT(n, 4u);
+    EXPECT_EQ(f.feed(wire, n / 2), CommandLink::Event::kNone);
+    EXPECT_EQ(f.ascii("\nFRAMING:COBS\n"), CommandLink::Event::kOffer);
+
+    // Still in step: the new station's framed commands get through.
+    EXPECT_EQ(f.framed(Type::kLine, "H"), CommandLink::Event::kCommand);
+    EXPECT_EQ(f.last_cmd, "H");
+}
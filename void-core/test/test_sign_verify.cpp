@@ -22,6 +22,7 @@
 #include <cstring>
 #include <string>
 #include "void_packets.h"
+#include "crc32_ieee.h"
 
 #ifndef VOID_TEST_VECTORS_DIR
 #error "VOID_TEST_VECTORS_DIR must be defined by CMake."
@@ -51,20 +52,6 @@ constexpr uint8_t kDetSeed[32] = {
     0x06, 0xe7, 0xcb, 0xb1, 0x63, 0xdf, 0x15, 0xfb,
 };
 
-// Classic CRC32 (IEEE 802.3 / Go hash/crc32.ChecksumIEEE) — table-free,
-// bit-serial. Only used in tests, so footprint matters more than speed.
-uint32_t Crc32Ieee(const uint8_t* data, size_t len) {
-    uint32_t crc = 0xFFFFFFFFu;
-    for (size_t i = 0; i < len; ++i) {
-        crc ^= data[i];
-        for (int b = 0; b < 8; ++b) {
-            const uint32_t mask = static_cast<uint32_t>(-static_cast<int32_t>(crc & 1u));
-            crc = (crc >> 1) ^ (0xEDB88320u & mask);
-        }
-    }
-    return ~crc;
-}
-
 // Store a 16/32/64-bit value little-endian into dst, advancing the cursor.
 void WriteU16LE(uint8_t* dst, size_t* off, uint16_t v) {
     dst[(*off)++] = static_cast<uint8_t>(v & 0xFF);
@@ -222,7 +209,7 @@ TEST(SignVerifyTest, PacketBMatchesGoldenByteForByte) {
 
     // 4) CRC32 covers header + body so far (170 body bytes, no crc/tail_pad).
     const size_t crc_scope = off;
-    const uint32_t crc = Crc32Ieee(frame, crc_scope);
+    const uint32_t crc = crc32_ieee::compute(frame, crc_scope);
     WriteU32LE(frame, &off, crc);
 
     // 5) _tail_pad[4] — already zeroed.
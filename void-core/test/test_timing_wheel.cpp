@@ -0,0 +1,253 @@
+/*-------------------------------------------------------------------------
+ * 🛰️ VOID PROTOCOL v2.1 | Tiny Innovation Group Ltd
+ * -------------------------------------------------------------------------
+ * Authority: Tiny Innovation Group Ltd
+ * License:   Apache 2.0
+ * Status:    Authenticated Clean Room Spec
+ * File:      test_timing_wheel.cpp
+ * Desc:      Hierarchical timing wheel: deadline rounding, cancel and
+ *            stale handles, cascades across levels and past the span,
+ *            re-entrant callbacks, and thousands of random deadlines
+ *            against a reference model.
+ * Compliant: NSA Clean C++ / SEI CERT
+ * -------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "timing_wheel.h"
+
+using timing_wheel::Handle;
+using timing_wheel::kNoTimer;
+using timing_wheel::TimerPool;
+
+namespace {
+
+uint64_t g_now = 0;
+uint64_t fake_clock() { return g_now; }
+
+// Records every expiry: tag and the wheel time it fired at.
+struct Log {
+    timing_wheel::Wheel* wheel = nullptr;
+    std::vector<uint32_t> tags;
+    std::vector<uint64_t> at;
+
+    static void on_fire(void* ctx, uint32_t tag) {
+        Log* log = static_cast<Log*>(ctx);
+        log->tags.push_back(tag);
+        log->at.push_back(log->wheel->now_ms());
+    }
+};
+
+constexpr uint64_t kT0 = 1790985600000ull;
+
+} // namespace
+
+TEST(TimingWheel, FiresOnTheFirstTickAtOrAfterItsDeadline) {
+    g_now = kT0;
+    static TimerPool<16> w(fake_clock, 10);
+    w.clear();
+    Log log;
+    log.wheel = &w;
+
+    w.arm(kT0 + 25, Log::on_fire, &log, 1);  // rounds up to the 30 ms tick
+    w.arm_in(30, Log::on_fire, &log, 2);
+    EXPECT_EQ(w.stats().armed, 2u);
+
+    EXPECT_EQ(w.advance(kT0 + 24), 0u);
+    EXPECT_EQ(w.advance(kT0 + 29), 0u);
+    EXPECT_EQ(w.advance(kT0 + 30), 2u);
+    ASSERT_EQ(log.tags.size(), 2u);
+    EXPECT_EQ(log.at[0], kT0 + 30);
+    EXPECT_EQ(w.stats().armed, 0u);
+
+    // A deadline already behind the wheel fires on the next advance.
+    w.arm(kT0, Log::on_fire, &log, 3);
+    EXPECT_EQ(w.advance(kT0 + 30), 0u);
+    EXPECT_EQ(w.advance(kT0 + 40), 1u);
+    EXPECT_EQ(log.tags.back(), 3u);
+}
+
+TEST(TimingWheel, CancelledAndFiredHandlesAreDead) {
+    g_now = kT0;
+    static TimerPool<4> w(fake_clock, 1);
+    w.clear();
+    Log log;
+    log.wheel = &w;
+
+    const Handle a = w.arm(kT0 + 100, Log::on_fire, &log, 1);
+    const Handle b = w.arm(kT0 + 100, Log::on_fire, &log, 2);
+    ASSERT_NE(a, kNoTimer);
+    EXPECT_TRUE(w.armed(a));
+    EXPECT_TRUE(w.cancel(a));
+    EXPECT_FALSE(w.cancel(a));
+    EXPECT_FALSE(w.armed(a));
+    EXPECT_FALSE(w.cancel(kNoTimer));
+
+    // a's node is reused; the old handle must not reach the new timer.
+    const Handle c = w.arm(kT0 + 100, Log::on_fire, &log, 3);
+    EXPECT_NE(c, a);
+    EXPECT_FALSE(w.cancel(a));
+    EXPECT_TRUE(w.armed(c));
+
+    EXPECT_EQ(w.advance(kT0 + 100), 2u);
+    EXPECT_FALSE(w.armed(b));
+    EXPECT_FALSE(w.cancel(c));
+    // Timers sharing a tick fire in no particular order.
+    ASSERT_EQ(log.tags.size(), 2u);
+    EXPECT_EQ(log.tags[0] + log.tags[1], 5u);
+}
+
+TEST(TimingWheel, RearmMovesTheDeadlineOrArmsAfresh) {
+    g_now = kT0;
+    static TimerPool<4> w(fake_clock, 1);
+    w.clear();
+    Log log;
+    log.wheel = &w;
+
+    Handle h = w.arm(kT0 + 1000, Log::on_fire, &log, 7);
+    // Traffic keeps pushing an idle TTL out; the timer follows it.
+    for (uint64_t t = 500; t <= 5000; t += 500) {
+        w.advance(kT0 + t);
+        h = w.rearm(h, kT0 + t + 1000, Log::on_fire, &log, 7);
+    }
+    EXPECT_TRUE(log.tags.empty());
+    EXPECT_EQ(w.stats().armed, 1u);
+    EXPECT_EQ(w.advance(kT0 + 5999), 0u);
+    EXPECT_EQ(w.advance(kT0 + 6000), 1u);
+
+    // Rearming a fired handle arms a new timer.
+    const Handle again = w.rearm(h, kT0 + 7000, Log::on_fire, &log, 8);
+    EXPECT_NE(again, h);
+    EXPECT_EQ(w.advance(kT0 + 7000), 1u);
+    EXPECT_EQ(log.tags, (std::vector<uint32_t>{7, 8}));
+}
+
+TEST(TimingWheel, LongDeadlinesCascadeDownEveryLevel) {
+    g_now = kT0;
+    static TimerPool<8> w(fake_clock, 1);
+    w.clear();
+    Log log;
+    log.wheel = &w;
+
+    // One deadline per level, one past the span of the whole wheel.
+    const uint64_t span = timing_wheel::kSpanTicks;
+    const uint64_t due[] = {63, 64 * 64 + 5, 64 * 64 * 64 + 77, span - 1, span * 3 + 11};
+    for (uint32_t i = 0; i < 5; ++i) w.arm(kT0 + due[i], Log::on_fire, &log, i);
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(w.next_wake_ms() <= kT0 + due[i], true);
+        EXPECT_EQ(w.advance(kT0 + due[i] - 1), 0u) << "early at level " << i;
+        EXPECT_EQ(w.advance(kT0 + due[i]), 1u) << "late at level " << i;
+        EXPECT_EQ(log.tags.back(), i);
+    }
+    EXPECT_EQ(w.next_wake_ms(), UINT64_MAX);
+    EXPECT_GT(w.stats().cascaded, 0u);
+}
+
+TEST(TimingWheel, CallbacksMayArmAndCancelTimers) {
+    g_now = kT0;
+    static TimerPool<8> w(fake_clock, 1);
+    w.clear();
+
+    struct Ctx {
+        timing_wheel::Wheel* w;
+        Handle victim;
+        int    ticks;
+        static void periodic(void* p, uint32_t tag) {
+            Ctx* c = static_cast<Ctx*>(p);
+            ++c->ticks;
+            c->w->cancel(c->victim);
+            if (c->ticks < 5) c->w->arm(c->w->now_ms() + 10, periodic, p, tag);
+        }
+        static void never(void*, uint32_t) { ADD_FAILURE() << "cancelled timer fired"; }
+    } ctx = {&w, kNoTimer, 0};
+
+    // Same slot; the newest timer in a slot runs first.
+    ctx.victim = w.arm(kT0 + 10, Ctx::never, &ctx, 1);
+    w.arm(kT0 + 10, Ctx::periodic, &ctx, 0);
+    EXPECT_EQ(w.advance(kT0 + 1000), 5u);
+    EXPECT_EQ(ctx.ticks, 5);
+    EXPECT_EQ(w.stats().armed, 0u);
+}
+
+TEST(TimingWheel, ReportsExhaustionWhenEveryNodeIsArmed) {
+    g_now = kT0;
+    static TimerPool<3> w(fake_clock, 1);
+    w.clear();
+    Log log;
+    log.wheel = &w;
+    for (uint32_t i = 0; i < 3; ++i) {
+        ASSERT_NE(w.arm(kT0 + 10, Log::on_fire, &log, i), kNoTimer);
+    }
+    EXPECT_EQ(w.arm(kT0 + 10, Log::on_fire, &log, 9), kNoTimer);
+    EXPECT_EQ(w.stats().exhausted, 1u);
+    EXPECT_EQ(w.stats().peak, 3u);
+    w.advance(kT0 + 10);
+    EXPECT_NE(w.arm(kT0 + 20, Log::on_fire, &log, 9), kNoTimer);
+}
+
+// Thousands of concurrent deadlines armed, re-armed and cancelled at
+// random while the clock moves in uneven steps: every live timer must
+// fire exactly once, on the first advance() at or past its deadline
+// (to the tick), and no cancelled timer may fire.
+TEST(TimingWheel, ThousandsOfRandomDeadlinesMatchAReferenceModel) {
+    g_now = kT0;
+    const uint32_t kTick = 10;
+    static TimerPool<4096> w(fake_clock, kTick);
+    w.clear();
+
+    struct Model {
+        std::vector<Handle>   handle;
+        std::vector<uint64_t> due;   // 0: not armed
+        uint64_t              prev;  // last advance() time
+        uint64_t              now;
+        size_t                errors;
+        static void on_fire(void* p, uint32_t tag) {
+            Model* m = static_cast<Model*>(p);
+            const uint64_t d = m->due[tag];
+            // Due in (prev, now], rounded up to a whole tick.
+            const uint64_t tick_due = kT0 + (d - kT0 + kTick - 1) / kTick * kTick;
+            if (d == 0 || tick_due > m->now || tick_due <= m->prev) ++m->errors;
+            m->due[tag] = 0;
+        }
+    } m;
+    const uint32_t kTimers = 3000;
+    m.handle.assign(kTimers, kNoTimer);
+    m.due.assign(kTimers, 0);
+    m.prev = m.now = kT0;
+    m.errors = 0;
+
+    std::mt19937_64 rng(20);
+    const uint64_t reach[] = {600, 40000, 3000000, 400000000};
+    for (int round = 0; round < 4000; ++round) {
+        for (int k = 0; k < 8; ++k) {
+            const uint32_t i = static_cast<uint32_t>(rng() % kTimers);
+            if (rng() % 5 == 0) {
+                EXPECT_EQ(w.cancel(m.handle[i]), m.due[i] != 0);
+                m.due[i] = 0;
+                continue;
+            }
+            const uint64_t d = m.now + 1 + rng() % reach[rng() % 4];
+            m.handle[i] = w.rearm(m.handle[i], d, Model::on_fire, &m, i);
+            ASSERT_NE(m.handle[i], kNoTimer);
+            m.due[i] = d;
+        }
+        m.prev = m.now;
+        m.now += (rng() % 8 == 0) ? rng() % 5000000 : rng() % 2000;
+        w.advance(m.now);
+        ASSERT_EQ(m.errors, 0u) << "round " << round;
+    }
+    size_t live = 0;
+    for (uint32_t i = 0; i < kTimers; ++i) live += m.due[i] != 0 ? 1u : 0u;
+    EXPECT_EQ(w.stats().armed, live);
+
+    // Drain: everything still armed fires once the clock passes it.
+    m.prev = m.now;
+    m.now += 500000000;
+    EXPECT_EQ(w.advance(m.now), live);
+    EXPECT_EQ(m.errors, 0u);
+    EXPECT_EQ(w.stats().armed, 0u);
+}